@@ -85,7 +85,11 @@ endif()
 if(USE_X86_PLACE)
 	anakin_add_compile_option(-fabi-version=6)
 #	anakin_add_compile_option(-fopenmp)
-	anakin_add_compile_option(-march=native)
+	if(BUILD_X86_MULTI_ISA)
+		anakin_add_compile_option(-msse4.2)
+	else()
+		anakin_add_compile_option(-march=native)
+	endif()
     anakin_add_compile_option(-Ofast)
     anakin_add_compile_option(-ffast-math)
     anakin_add_compile_option(-Wall)
@@ -45,6 +45,9 @@ function(anakin_print_statistic)
 	message(STATUS "  Build static libs         : ${BUILD_STATIC}")
     endif()
 	message(STATUS "  Build with unit test      : ${BUILD_WITH_UNIT_TEST}")
+	if(USE_X86_PLACE)
+	message(STATUS "  Build x86 microbench      : ${BUILD_X86_MICROBENCH}")
+	endif()
 	message(STATUS "")
 	message(STATUS "  Enable verbose message    : ${ENABLE_VERBOSE_MSG}")
 	message(STATUS "  Enable noisy warnings     : ${ENABLE_NOISY_WARNINGS}")
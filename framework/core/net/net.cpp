@@ -1,10 +1,22 @@
+#include <algorithm>
+#include <unordered_set>
 #include "framework/core/net/net.h"
 #include "saber/funcs/timer.h"
 #include "saber/funcs/debug.h"
 #include "framework/core/mem_info.h"
+#include "framework/graph/llvm/optimizer/memory_scheduler.h"
 
 namespace anakin {
 
+/// ops whose outputs only depend on the shapes of their inputs and their parameters
+static const std::vector<std::string> shape_only_ops{
+    "PriorBox"
+};
+
+static bool is_op_in(const std::vector<std::string>& ops, const std::string& op_name) {
+    return std::find(ops.begin(), ops.end(), op_name) != ops.end();
+}
+
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 Net<Ttype, Dtype, Ptype, RunType>::~Net() {
     if(_graph_p) {
@@ -66,6 +78,8 @@ void Net<Ttype, Dtype, Ptype, RunType>::init(graph::Graph<Ttype, Dtype, Ptype>&
     OpContextPtr<Ttype> ctx) {
 
     init_env(graph);
+    // weights of a lazy graph which isn't optimized
+    graph.weights_arena()->materialize();
     // shallow copy
     _graph_p->CopyFrom(graph);
     auto node_names_in_exec_order = graph.get_nodes_in_order();
@@ -87,7 +101,8 @@ void Net<Ttype, Dtype, Ptype, RunType>::init(graph::Graph<Ttype, Dtype, Ptype>&
 
         static_cast<Operator<Ttype, Dtype, Ptype>*>(node_ptr->Op())->_helper->BindParam(node_ptr);
         // parsing parameter
-        static_cast<Operator<Ttype, Dtype, Ptype>*>(node_ptr->Op())->_helper->InitParam();
+        Status status = static_cast<Operator<Ttype, Dtype, Ptype>*>(node_ptr->Op())->_helper->InitParam();
+        CHECK(status) << node_name << ", type " << node_ptr->get_op_name() << ": " << status.info();
     }
 
     // remove null op node
@@ -125,17 +140,22 @@ void Net<Ttype, Dtype, Ptype, RunType>::init(graph::Graph<Ttype, Dtype, Ptype>&
         CHECK_NOTNULL(op_func.op) << "Node(node_name) doesn't have op pointer! ";
 
         op_func.op->_helper->InferShape(op_func.ins, op_func.outs);
+        op_func.bind_ctx();
         op_func.op->_helper->Init(*(op_func.ctx_p), op_func.ins, op_func.outs);
     }
 
     // init memory of _graph_p
+    mark_constants();
     init_memory();
+    fold_constants();
 }
 
 
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 void Net<Ttype, Dtype, Ptype, RunType>::init(graph::Graph<Ttype, Dtype, Ptype>& graph) {
     init_env(graph);
+    // weights of a lazy graph which isn't optimized
+    graph.weights_arena()->materialize();
     // shallow copy
     _graph_p->CopyFrom(graph);
     
@@ -227,7 +247,8 @@ void Net<Ttype, Dtype, Ptype, RunType>::init(graph::Graph<Ttype, Dtype, Ptype>&
         // bind parameter structure
         static_cast<Operator<Ttype, Dtype, Ptype>*>(node_ptr->Op())->_helper->BindParam(node_ptr);
         // parsing parameter
-        static_cast<Operator<Ttype, Dtype, Ptype>*>(node_ptr->Op())->_helper->InitParam();
+        Status status = static_cast<Operator<Ttype, Dtype, Ptype>*>(node_ptr->Op())->_helper->InitParam();
+        CHECK(status) << node_name << ", type " << node_ptr->get_op_name() << ": " << status.info();
     }
 
     // remove null op node
@@ -285,6 +306,7 @@ void Net<Ttype, Dtype, Ptype, RunType>::init(graph::Graph<Ttype, Dtype, Ptype>&
         }
 
 #endif
+        op_func.bind_ctx();
         op_func.op->_helper->Init(*(op_func.ctx_p), op_func.ins, op_func.outs);
 #ifdef ENABLE_DEBUG
         DLOG(INFO)<<"op init success "<<op_func.name;
@@ -294,7 +316,9 @@ void Net<Ttype, Dtype, Ptype, RunType>::init(graph::Graph<Ttype, Dtype, Ptype>&
     double curr_mem_in_mb_end = MemoryInfo<Ttype>::Global().get_used_mem_in_mb(); 
     this->_graph_p->statistics.template set_info<graph::SYSTEM_MEM>(curr_mem_in_mb_end - curr_mem_in_mb_start);
     // init memory of _graph_p
+    mark_constants();
     init_memory();
+    fold_constants();
     
     graph.statistics = _graph_p->statistics; // copy statistic back
     LOG(INFO) << "Temp mem used:        " << this->_graph_p->statistics.template get_info<graph::TEMP_MEM>() << " MB"; 
@@ -336,6 +360,7 @@ void Net<Ttype, Dtype, Ptype, RunType>::prediction() {
 #endif
 
     int i = 0;
+    bool refold = false;
     for(auto& executer : _exec_funcs) {
         if (RunType == OpRunType::SYNC || executer.need_sync) {
             for(int i = 0; i < executer.ins.size(); i++) {
@@ -360,8 +385,11 @@ void Net<Ttype, Dtype, Ptype, RunType>::prediction() {
     saber::SaberTimer<Ttype> my_time;
     my_time.start(ctx);
 #endif
-      if (executer.op_name != "Input") {
+      if (executer.op_name != "Input" && !is_folded(executer, refold)) {
           executer.infer_shape();
+          if (!_bindings.empty()) {
+              fit_bound_outs(executer);
+          }
           executer.launch();
       }
 
@@ -481,6 +509,7 @@ void Net<Ttype, Dtype, Ptype, RunType>::execute_stop_at_node(std::string node_na
             }
         }
     }
+    bool refold = false;
     for(int i=0; i<_suspended_point; i++) {
         auto& executer = _exec_funcs[i];
         if (RunType == OpRunType::SYNC || executer.need_sync) {
@@ -506,8 +535,11 @@ void Net<Ttype, Dtype, Ptype, RunType>::execute_stop_at_node(std::string node_na
         }
 
 #endif 
-        if (executer.op_name != "Input") { 
+        if (executer.op_name != "Input" && !is_folded(executer, refold)) { 
             executer.infer_shape(); 
+            if (!_bindings.empty()) {
+                fit_bound_outs(executer);
+            }
             executer.launch(); 
         } 
       
@@ -526,6 +558,7 @@ void Net<Ttype, Dtype, Ptype, RunType>::execute_start_from_node(std::string node
             }
         }
     }
+    bool refold = false;
     for(int i=_start_point; i<_exec_funcs.size(); i++) {
         auto& executer = _exec_funcs[i];
         if (RunType == OpRunType::SYNC || executer.need_sync) {
@@ -551,8 +584,11 @@ void Net<Ttype, Dtype, Ptype, RunType>::execute_start_from_node(std::string node
         }
 
 #endif 
-        if (executer.op_name != "Input") { 
+        if (executer.op_name != "Input" && !is_folded(executer, refold)) { 
             executer.infer_shape(); 
+            if (!_bindings.empty()) {
+                fit_bound_outs(executer);
+            }
             executer.launch(); 
         } 
       
@@ -599,6 +635,108 @@ Tensor4dPtr<Ttype, Dtype> Net<Ttype, Dtype, Ptype, RunType>::get_tensor_from_edg
     return _graph_p->get_arc(std::string(from), std::string(to)).weight().get();
 }
 
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Dtype, Ptype, RunType>::bind_in(std::string in_name, Tensor4dPtr<Ttype, Dtype> tensor) {
+    auto& edge_it_list = _graph_p->get_out_arc_its(in_name);
+    CHECK_EQ(edge_it_list.size(), 1) << " Node(" << in_name << ") should have 1 out edge.";
+    return bind(*edge_it_list[0], tensor, false);
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Dtype, Ptype, RunType>::bind_out(std::string out_name, Tensor4dPtr<Ttype, Dtype> tensor) {
+    auto& edge_it_list = _graph_p->get_in_arc_its(out_name);
+    CHECK_EQ(edge_it_list.size(), 1) << " Node(" << out_name << ") should have 1 in edge.";
+    return bind(*edge_it_list[0], tensor, true);
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Dtype, Ptype, RunType>::bind(graph::Edge<Ttype, Dtype>& edge,
+                                               Tensor4dPtr<Ttype, Dtype> caller, bool is_out) {
+    auto tensor = edge.weight().get();
+    if (caller == nullptr || caller->valid_size() == 0) {
+        return Status::FAIL(" bound tensor is empty");
+    }
+    if (!(caller->valid_shape() == caller->shape())) {
+        return Status::FAIL(" bound tensor must be contiguous");
+    }
+    if (caller->device_id() != tensor->device_id()) {
+        return Status::FAIL(" bound tensor isn't on the device of net");
+    }
+    for (auto& binding : _bindings) {
+        if (binding.tensor == tensor) {
+            return Status::FAIL(" tensor is bound already");
+        }
+    }
+    for (auto& executer : _exec_funcs) {
+        if (executer.folded
+                && std::find(executer.outs.begin(), executer.outs.end(), tensor) != executer.outs.end()) {
+            return Status::FAIL(" tensor is folded into a constant");
+        }
+    }
+    // self shared ops (e.g. Split, Reshape) hold the buffer of their input and don't run,
+    // the other tensors on the buffer wouldn't follow the swap
+    const std::vector<std::string>& self_shared_ops = graph::check_self_shared().ops;
+    auto& neighbor = is_out ? edge.bottom() : edge.top();
+    if (is_op_in(self_shared_ops, (*_graph_p)[neighbor]->get_op_name())) {
+        return Status::FAIL(" tensor is aliased by a self shared op");
+    }
+    _bindings.emplace_back();
+    auto& binding = _bindings.back();
+    binding.tensor = tensor;
+    binding.caller = caller;
+    binding.is_out = is_out;
+    // the stash takes the caller memory, then trades it for the memory of the edge
+    binding.stash.set_shape(caller->valid_shape());
+    binding.stash.share_from(*caller);
+    tensor->swap_buffer(binding.stash);
+    binding.bound = true;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Dtype, Ptype, RunType>::fit_bound_outs(OperatorFunc<Ttype, Dtype, Ptype>& executer) {
+    typedef typename Tensor4d<Ttype, Dtype>::Dtype data_t;
+    for (auto& binding : _bindings) {
+        if (!binding.is_out || !binding.bound) {
+            continue;
+        }
+        for (auto out : executer.outs) {
+            if (out != binding.tensor
+                    || out->valid_size() * sizeof(data_t) <= out->get_buf()->get_capacity()) {
+                continue;
+            }
+            LOG(WARNING) << " output of " << executer.name << " outgrows the bound tensor, it will be copied";
+            out->swap_buffer(binding.stash);
+            binding.bound = false;
+            executer.infer_shape();
+            out->reshape(out->valid_shape());
+        }
+    }
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Dtype, Ptype, RunType>::unbind() {
+    for (auto& binding : _bindings) {
+        if (binding.bound) {
+            binding.tensor->swap_buffer(binding.stash);
+        }
+        if (!binding.is_out) {
+            continue;
+        }
+        // the stash holds the caller memory with the output shapes now
+        auto& result = binding.bound ? binding.stash : *binding.tensor;
+        auto caller = binding.caller;
+        if (result.data() == caller->data()) {
+            caller->set_shape(result.valid_shape());
+        } else {
+            caller->reshape(result.valid_shape());
+            caller->copy_from(result);
+        }
+        caller->set_seq_offset(result.get_seq_offset());
+    }
+    _bindings.clear();
+}
+
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 Status Net<Ttype, Dtype, Ptype, RunType>::init_memory() {
     auto alloc_memory = [this](graph::Edge<Ttype, Dtype>& edge) {
@@ -656,6 +794,96 @@ Status Net<Ttype, Dtype, Ptype, RunType>::init_memory() {
     return Status::OK();
 }
 
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Dtype, Ptype, RunType>::mark_constants() {
+    const std::vector<std::string>& self_shared_ops = graph::check_self_shared().ops;
+    std::unordered_set<std::string> constant_nodes;
+    // constant edges which own their memory
+    std::unordered_set<std::string> folded_roots;
+    for (auto& executer : _exec_funcs) {
+        if (executer.op_name == "Input") {
+            continue;
+        }
+        auto& edge_in_its = _graph_p->get_in_arc_its(executer.name);
+        bool constant = is_op_in(shape_only_ops, executer.op_name);
+        if (!constant) {
+            // no inputs means an op of weights only
+            constant = true;
+            for (auto& edge_it : edge_in_its) {
+                constant = constant && constant_nodes.count(edge_it->bottom()) > 0;
+            }
+        }
+        if (constant) {
+            executer.folded = true;
+            constant_nodes.insert(executer.name);
+        }
+        // self shared ops (e.g. Reshape) alias the memory of their input, constant or not
+        std::string in_root;
+        if (is_op_in(self_shared_ops, executer.op_name) && !edge_in_its.empty()) {
+            auto& in_edge = *edge_in_its[0];
+            in_root = in_edge.shared() ? in_edge.share_from() : in_edge.name();
+            if (folded_roots.count(in_root) == 0) {
+                in_root.clear();
+            }
+        }
+        for (auto& edge_it : _graph_p->get_out_arc_its(executer.name)) {
+            if (!in_root.empty()) {
+                edge_it->shared() = true;
+                edge_it->share_from() = in_root;
+            } else if (constant) {
+                edge_it->shared() = false;
+                folded_roots.insert(edge_it->name());
+            } else if (edge_it->shared() && folded_roots.count(edge_it->share_from())) {
+                // the memory of a constant is never free for reuse
+                edge_it->shared() = false;
+            }
+        }
+    }
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Dtype, Ptype, RunType>::fold_constants() {
+    int folded_num = 0;
+    for (auto& executer : _exec_funcs) {
+        if (!executer.folded) {
+            continue;
+        }
+        executer.infer_shape();
+        executer.launch();
+        for (auto out : executer.outs) {
+            out->record_event(executer.ctx_p->get_compute_stream());
+            out->sync();
+        }
+        executer.folded_shapes.clear();
+        for (auto in : executer.ins) {
+            executer.folded_shapes.push_back(in->valid_shape());
+        }
+        folded_num++;
+    }
+    if (folded_num > 0) {
+        LOG(INFO) << "Constant folded nodes: " << folded_num;
+    }
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+bool Net<Ttype, Dtype, Ptype, RunType>::is_folded(OperatorFunc<Ttype, Dtype, Ptype>& executer, bool& refold) {
+    if (!executer.folded) {
+        return false;
+    }
+    for (int i = 0; !refold && i < executer.ins.size(); i++) {
+        refold = !(executer.ins[i]->valid_shape() == executer.folded_shapes[i]);
+    }
+    if (!refold) {
+        return true;
+    }
+    for (int i = 0; i < executer.ins.size(); i++) {
+        executer.folded_shapes[i] = executer.ins[i]->valid_shape();
+    }
+    return false;
+}
+
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 Status Net<Ttype, Dtype, Ptype, RunType>::init_env(graph::Graph<Ttype, Dtype, Ptype>& graph) {
     LOG(WARNING) << "Detect and initial " << graph.get_ins().size() << " lanes.";
@@ -16,17 +16,22 @@
 #ifndef ANAKIN_NET_H
 #define ANAKIN_NET_H
 
+#include <list>
 #include "framework/graph/graph.h"
 #include "framework/core/net/operator_func.h"
 
 
 namespace anakin {
 
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunTyp>
+class StreamSession;
+
 /** 
  *  \brief Net class used for execution of graph and it is thread safety.
  */
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunTyp = OpRunType::ASYNC>
 class Net {
+    friend class StreamSession<Ttype, Dtype, Ptype, RunTyp>;
 public:
     explicit Net(bool need_summary = false);
 
@@ -112,12 +117,62 @@ public:
      */
     Tensor4dPtr<Ttype, Dtype> get_tensor_from_edge(const char* from, const char* to);
 
+    /**
+     *  \brief Bind caller memory as the tensor of input in_name, no copy is made.
+     *  The binding holds until unbind(), the caller keeps the tensor alive and unchanged meanwhile.
+     *  The tensor must be contiguous (not a roi) and on the device of the net,
+     *  and the input mustn't feed a self shared op (e.g. Split, Reshape) which aliases its memory.
+     *  \return error if it can't be bound, copy it into get_in(in_name) then.
+     */
+    Status bind_in(std::string in_name, Tensor4dPtr<Ttype, Dtype> tensor);
+
+    /**
+     *  \brief Bind caller memory as the tensor of output out_name, the output is computed into it.
+     *  An output outgrowing the capacity of tensor is computed into the net's own memory instead,
+     *  and copied into tensor (reshaped) by unbind().
+     *  An output of a self shared op (e.g. Reshape, Flatten) can't be bound, copy it from get_out(out_name).
+     */
+    Status bind_out(std::string out_name, Tensor4dPtr<Ttype, Dtype> tensor);
+
+    /**
+     *  \brief Give the bound tensors back to the net.
+     *  Shapes and seq offsets of the outputs are set on the caller tensors.
+     */
+    void unbind();
+
 private:
+    /**
+     *  \brief Bind caller to the tensor of a graph edge.
+     */
+    Status bind(graph::Edge<Ttype, Dtype>& edge, Tensor4dPtr<Ttype, Dtype> caller, bool is_out);
+
+    /**
+     *  \brief Move bound outputs of executer that outgrow the caller memory back to the net's memory.
+     */
+    void fit_bound_outs(OperatorFunc<Ttype, Dtype, Ptype>& executer);
+
     /**
      *  \brief Allocate memory for net.
      */
     Status init_memory();
 
+    /**
+     *  \brief Mark the nodes whose outputs only depend on shapes and parameters (e.g. PriorBox),
+     *  and take their output edges out of memory reuse, call it before init_memory.
+     */
+    Status mark_constants();
+
+    /**
+     *  \brief Compute the outputs of the marked nodes once, prediction skips them afterwards.
+     */
+    Status fold_constants();
+
+    /**
+     *  \brief Whether the outputs of executer are up to date for the current input shapes.
+     *  refold is set once a folded node reruns, all the folded nodes after it rerun as well.
+     */
+    bool is_folded(OperatorFunc<Ttype, Dtype, Ptype>& executer, bool& refold);
+
     /**
      *  \brief Initial context environments.
      */
@@ -138,6 +193,17 @@ private:
     ///< A list of out tensor.
     std::vector<Tensor4dPtr<Ttype, Dtype> > _out_tensor_list;
 
+    ///< caller tensor bound to a graph input or output.
+    struct Binding {
+        Tensor4dPtr<Ttype, Dtype> tensor;   ///< tensor of the graph edge.
+        Tensor4dPtr<Ttype, Dtype> caller;
+        Tensor4d<Ttype, Dtype> stash;       ///< memory of the edge while bound, caller memory after.
+        bool is_out{false};
+        bool bound{false};                  ///< the edge is on caller memory.
+    };
+    ///< bindings of the next predictions, a list as the stashes mustn't be copied.
+    std::list<Binding> _bindings;
+
     bool _need_summary{false};
 #ifdef ENABLE_OP_TIMER
     std::vector<float> _op_time;
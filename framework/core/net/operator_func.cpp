@@ -2,11 +2,28 @@
 
 namespace anakin {
 
+/// x86 kernels size their omp and mkl teams by the thread num of the running thread
+template<typename Ttype>
+inline void bind_context(Context<Ttype>& ctx) {}
+
+#ifdef USE_X86_PLACE
+template<>
+inline void bind_context<X86>(Context<X86>& ctx) {
+    ctx.bind_dev();
+}
+#endif
+
 template<typename Ttype, DataType Dtype, Precision Ptype>
 void OperatorFunc<Ttype, Dtype, Ptype>::launch() {
+    bind_ctx();
     (*op)(*ctx_p, ins, outs);
 }
 
+template<typename Ttype, DataType Dtype, Precision Ptype>
+void OperatorFunc<Ttype, Dtype, Ptype>::bind_ctx() {
+    bind_context<Ttype>(*ctx_p);
+}
+
 template<typename Ttype, DataType Dtype, Precision Ptype>
 void OperatorFunc<Ttype, Dtype, Ptype>::infer_shape() {
     op->_helper->InferShape(ins, outs);
@@ -33,6 +33,11 @@ struct OperatorFunc {
      */
     void launch();
 
+    /** 
+     *  \brief Apply the thread num of ctx_p to the calling thread (x86), before init and launch.
+     */
+    void bind_ctx();
+
     /** 
      *  \brief Infer shape.
      */
@@ -61,6 +66,11 @@ struct OperatorFunc {
 
     bool need_sync{false};
 
+    ///< outputs are computed once at init and kept until the input shapes change.
+    bool folded{false};
+    ///< input shapes the folded outputs were computed for.
+    std::vector<Shape> folded_shapes;
+
     Operator<Ttype, Dtype, Ptype>* op;
 
     ///< node name
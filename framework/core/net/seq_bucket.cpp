@@ -0,0 +1,54 @@
+#include "framework/core/net/seq_bucket.h"
+#include <algorithm>
+
+namespace anakin {
+
+SeqBuckets::SeqBuckets(const std::vector<std::vector<int> >& request_offsets, int max_batch,
+                       float min_fill)
+    : _request_offsets(request_offsets) {
+    CHECK_GT(max_batch, 0) << " max batch of a bucket must be positive";
+    std::vector<Member> seqs;
+    for (int r = 0; r < _request_offsets.size(); r++) {
+        const std::vector<int>& offset = _request_offsets[r];
+        CHECK_GE(offset.size(), 2) << " request " << r << " has no seq offset";
+        for (int s = 0; s < offset.size() - 1; s++) {
+            seqs.push_back({r, s, offset[s + 1] - offset[s]});
+        }
+    }
+    // stable, so sequences of the same length keep the order of their requests
+    std::stable_sort(seqs.begin(), seqs.end(), [](const Member& a, const Member& b) {
+        return a.length > b.length;
+    });
+
+    for (auto& seq : seqs) {
+        bool full = _buckets.empty() || _buckets.back().size() >= max_batch
+                    || seq.length < _buckets.back()[0].length * min_fill;
+        if (full) {
+            _buckets.push_back(std::vector<Member>());
+            _bucket_offsets.push_back(std::vector<int>(1, 0));
+        }
+        _buckets.back().push_back(seq);
+        _bucket_offsets.back().push_back(_bucket_offsets.back().back() + seq.length);
+    }
+}
+
+Status SeqBuckets::per_word(const std::vector<int>& bucket_nums, bool& word_rows) const {
+    CHECK_EQ(bucket_nums.size(), _buckets.size()) << " one num per bucket";
+    word_rows = true;
+    for (int b = 0; b < _buckets.size(); b++) {
+        const int words = _bucket_offsets[b].back();
+        const int seqs = _buckets[b].size();
+        if (bucket_nums[b] != words && bucket_nums[b] != seqs) {
+            LOG(ERROR) << " output of bucket " << b << " has " << bucket_nums[b]
+                       << " rows, neither its words nor its sequences";
+            return Status::FAIL("bucket output rows are neither words nor sequences");
+        }
+        // when every sequence has one word both kinds are the same
+        if (words != seqs) {
+            word_rows = bucket_nums[b] == words;
+        }
+    }
+    return Status::OK();
+}
+
+} /* namespace anakin */
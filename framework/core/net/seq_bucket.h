@@ -0,0 +1,147 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SEQ_BUCKET_H
+#define ANAKIN_SEQ_BUCKET_H
+
+#include <cstring>
+#include <vector>
+#include "framework/core/base.h"
+#include "framework/core/parameter.h"
+
+namespace anakin {
+
+/**
+ *  \brief Length buckets over the sequences of several requests.
+ *
+ *   The sequences of all the requests are sorted by length, longest first, and cut in buckets
+ *   of at most max_batch sequences. A bucket also ends where the length drops below min_fill
+ *   of its longest one. Every bucket runs as one batch, so its recurrence takes as many steps
+ *   as its longest sequence, close to the length of all of its sequences, and short requests
+ *   don't wait for long ones.
+ *   \par Usage:
+ *       \code
+ *       SeqBuckets buckets(offsets_of_every_request, 32);
+ *       for (int b = 0; b < buckets.bucket_num(); b++) {
+ *           buckets.gather(b, inputs_of_every_request, merged_in);
+ *           // run merged_in, its seq offset is buckets.seq_offset(b)
+ *           buckets.scatter(b, merged_out, word_rows, outputs_of_every_request);
+ *       }
+ *       \endcode
+ */
+class SeqBuckets {
+public:
+    /// a sequence of a request in a bucket
+    struct Member {
+        int request;
+        int seq;
+        int length;
+    };
+
+    SeqBuckets(const std::vector<std::vector<int> >& request_offsets, int max_batch,
+               float min_fill = 0.5f);
+
+    int bucket_num() const { return _buckets.size(); }
+
+    /// sequences of a bucket in the order of its batch, longest first
+    const std::vector<Member>& members(int bucket) const { return _buckets[bucket]; }
+
+    /// seq offset of a bucket batch
+    const std::vector<int>& seq_offset(int bucket) const { return _bucket_offsets[bucket]; }
+
+    /// words of a request
+    int request_words(int request) const { return _request_offsets[request].back(); }
+
+    /// sequences of a request
+    int request_seqs(int request) const { return _request_offsets[request].size() - 1; }
+
+    /**
+     *  \brief Copy the rows of the members of a bucket from their requests, one tensor per request
+     *  whose num is its words, into the bucket batch.
+     */
+    template<typename TensorType>
+    void gather(int bucket, const std::vector<TensorType*>& request_tensors, TensorType& dst) const;
+
+    /**
+     *  \brief Whether an output holds a row per word, or else a row per sequence.
+     *  \param bucket_nums num of the output of every bucket.
+     *  \param word_rows set to true for a row per word.
+     *  \return fail when a bucket has neither as many rows as its words nor as its sequences,
+     *  such an output can't be split back into the requests.
+     */
+    Status per_word(const std::vector<int>& bucket_nums, bool& word_rows) const;
+
+    /**
+     *  \brief Copy the rows of a bucket output back into the outputs of the requests,
+     *  which already have the shape of their words or sequences, see per_word.
+     */
+    template<typename TensorType>
+    void scatter(int bucket, const TensorType& src, bool word_rows,
+                 std::vector<TensorType*>& request_tensors) const;
+
+private:
+    std::vector<std::vector<int> > _request_offsets;
+    std::vector<std::vector<Member> > _buckets;
+    std::vector<std::vector<int> > _bucket_offsets;
+};
+
+template<typename TensorType>
+void SeqBuckets::gather(int bucket, const std::vector<TensorType*>& request_tensors,
+                        TensorType& dst) const {
+    typedef typename TensorType::Dtype dtype;
+    CHECK_EQ(request_tensors.size(), _request_offsets.size()) << " one tensor per request";
+    const std::vector<Member>& bucket_members = _buckets[bucket];
+    const TensorType* first = request_tensors[bucket_members[0].request];
+    const int width = first->valid_size() / first->num();
+    Shape shape = first->valid_shape();
+    shape[0] = _bucket_offsets[bucket].back();
+    dst.reshape(shape);
+    dtype* dst_ptr = dst.mutable_data();
+    for (int i = 0; i < bucket_members.size(); i++) {
+        const Member& member = bucket_members[i];
+        const TensorType* src = request_tensors[member.request];
+        CHECK_EQ(src->num(), request_words(member.request)) << " seq offset doesn't match the input num";
+        CHECK_EQ(src->valid_size() / src->num(), width) << " requests have different input widths";
+        const int start = _request_offsets[member.request][member.seq];
+        memcpy(dst_ptr + _bucket_offsets[bucket][i] * width, src->data() + start * width,
+               sizeof(dtype) * member.length * width);
+    }
+    dst.set_seq_offset(_bucket_offsets[bucket]);
+}
+
+template<typename TensorType>
+void SeqBuckets::scatter(int bucket, const TensorType& src, bool word_rows,
+                         std::vector<TensorType*>& request_tensors) const {
+    typedef typename TensorType::Dtype dtype;
+    const std::vector<Member>& bucket_members = _buckets[bucket];
+    const int width = src.valid_size() / src.num();
+    const dtype* src_ptr = src.data();
+    for (int i = 0; i < bucket_members.size(); i++) {
+        const Member& member = bucket_members[i];
+        TensorType* dst = request_tensors[member.request];
+        dtype* dst_ptr = dst->mutable_data();
+        if (word_rows) {
+            const int start = _request_offsets[member.request][member.seq];
+            memcpy(dst_ptr + start * width, src_ptr + _bucket_offsets[bucket][i] * width,
+                   sizeof(dtype) * member.length * width);
+        } else {
+            memcpy(dst_ptr + member.seq * width, src_ptr + i * width, sizeof(dtype) * width);
+        }
+    }
+}
+
+} /* namespace anakin */
+
+#endif
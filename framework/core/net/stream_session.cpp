@@ -0,0 +1,168 @@
+#include "framework/core/net/stream_session.h"
+#include <unordered_set>
+
+namespace anakin {
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+StreamSession<Ttype, Dtype, Ptype, RunType>::StreamSession(Net<Ttype, Dtype, Ptype, RunType>& net)
+    : _net(net) {
+    for (auto& executer : _net._exec_funcs) {
+        auto* helper = executer.op->_helper;
+        if (helper == nullptr) {
+            continue;
+        }
+        // only recurrent op accept state binding.
+        if (!helper->BindState(nullptr, nullptr, nullptr, nullptr)) {
+            continue;
+        }
+        std::shared_ptr<StateSlot> slot = std::make_shared<StateSlot>();
+        slot->helper = helper;
+        slot->name = executer.name;
+        slot->has_cell = helper->BindState(nullptr, &slot->init_cell, nullptr, nullptr);
+        helper->BindState(nullptr, nullptr, nullptr, nullptr);
+        _slots.push_back(slot);
+        DLOG(INFO) << " stream session tracks state of op: " << executer.name
+                   << (slot->has_cell ? " (hidden, cell)" : " (hidden)");
+    }
+    if (_slots.empty()) {
+        LOG(WARNING) << " stream session finds no recurrent op, prediction is stateless.";
+    }
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+StreamSession<Ttype, Dtype, Ptype, RunType>::~StreamSession() {
+    unbind();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void StreamSession<Ttype, Dtype, Ptype, RunType>::unbind() {
+    for (auto& slot : _slots) {
+        slot->helper->BindState(nullptr, nullptr, nullptr, nullptr);
+    }
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void StreamSession<Ttype, Dtype, Ptype, RunType>::gather(const std::vector<std::string>& seq_ids,
+                                                         int slot_id, bool cell,
+                                                         Tensor4d<Ttype, Dtype>& dst) {
+    int hidden_size = _slots[slot_id]->hidden_size;
+    int batch_size = seq_ids.size();
+    dst.re_alloc(Shape(batch_size, hidden_size, 1, 1));
+    dtype* dst_ptr = dst.mutable_data();
+    for (int i = 0; i < batch_size; ++i) {
+        dtype* row = dst_ptr + i * hidden_size;
+        auto it = _states.find(seq_ids[i]);
+        if (it == _states.end()) {
+            memset(row, 0, sizeof(dtype) * hidden_size);
+            continue;
+        }
+        const std::vector<dtype>& state = cell ? it->second.cell[slot_id] : it->second.hidden[slot_id];
+        CHECK_EQ(state.size(), hidden_size) << " state size of " << seq_ids[i] << " mismatches op "
+                                            << _slots[slot_id]->name;
+        memcpy(row, state.data(), sizeof(dtype) * hidden_size);
+    }
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void StreamSession<Ttype, Dtype, Ptype, RunType>::scatter(const std::vector<std::string>& seq_ids,
+                                                          int slot_id, bool cell,
+                                                          Tensor4d<Ttype, Dtype>& src) {
+    int batch_size = seq_ids.size();
+    CHECK_EQ(src.valid_size() % batch_size, 0) << " final state of op " << _slots[slot_id]->name
+                                               << " mismatches batch size";
+    int hidden_size = src.valid_size() / batch_size;
+    _slots[slot_id]->hidden_size = hidden_size;
+    const dtype* src_ptr = src.data();
+    for (int i = 0; i < batch_size; ++i) {
+        SeqState& state = _states[seq_ids[i]];
+        state.hidden.resize(_slots.size());
+        state.cell.resize(_slots.size());
+        std::vector<dtype>& dst = cell ? state.cell[slot_id] : state.hidden[slot_id];
+        dst.assign(src_ptr + i * hidden_size, src_ptr + (i + 1) * hidden_size);
+    }
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void StreamSession<Ttype, Dtype, Ptype, RunType>::prediction(const std::vector<std::string>& seq_ids) {
+    auto in_list = _net.get_in_list();
+    CHECK_GT(in_list.size(), 0) << " net has no input";
+    auto seq_offset = in_list[0]->get_seq_offset();
+    int batch_size = seq_offset.size() > 1 ? seq_offset.size() - 1 : in_list[0]->num();
+    CHECK_EQ(seq_ids.size(), batch_size) << " every sequence in the chunk needs an id";
+    std::unordered_set<std::string> unique_ids(seq_ids.begin(), seq_ids.end());
+    CHECK_EQ(unique_ids.size(), seq_ids.size()) << " a sequence can't appear twice in one chunk";
+
+    bool any_state = false;
+    for (auto& id : seq_ids) {
+        if (_states.count(id) > 0) {
+            any_state = true;
+            break;
+        }
+    }
+
+    for (int i = 0; i < _slots.size(); ++i) {
+        auto& slot = _slots[i];
+        Tensor4dPtr<Ttype, Dtype> init_hidden = nullptr;
+        Tensor4dPtr<Ttype, Dtype> init_cell = nullptr;
+        // hidden size is learned from the first chunk, before that every sequence is new.
+        if (any_state && slot->hidden_size > 0) {
+            gather(seq_ids, i, false, slot->init_hidden);
+            init_hidden = &slot->init_hidden;
+            if (slot->has_cell) {
+                gather(seq_ids, i, true, slot->init_cell);
+                init_cell = &slot->init_cell;
+            }
+        }
+        CHECK(slot->helper->BindState(init_hidden, init_cell, &slot->last_hidden,
+                                      slot->has_cell ? &slot->last_cell : nullptr))
+                << " bind state to op " << slot->name << " failed";
+    }
+
+    _net.prediction();
+
+    for (int i = 0; i < _slots.size(); ++i) {
+        scatter(seq_ids, i, false, _slots[i]->last_hidden);
+        if (_slots[i]->has_cell) {
+            scatter(seq_ids, i, true, _slots[i]->last_cell);
+        }
+    }
+    unbind();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+bool StreamSession<Ttype, Dtype, Ptype, RunType>::has_state(const std::string& seq_id) const {
+    return _states.count(seq_id) > 0;
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void StreamSession<Ttype, Dtype, Ptype, RunType>::reset(const std::string& seq_id) {
+    _states.erase(seq_id);
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void StreamSession<Ttype, Dtype, Ptype, RunType>::reset_all() {
+    _states.clear();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+typename StreamSession<Ttype, Dtype, Ptype, RunType>::SeqState
+StreamSession<Ttype, Dtype, Ptype, RunType>::checkpoint(const std::string& seq_id) const {
+    auto it = _states.find(seq_id);
+    CHECK(it != _states.end()) << " no state for sequence " << seq_id;
+    return it->second;
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void StreamSession<Ttype, Dtype, Ptype, RunType>::restore(const std::string& seq_id,
+                                                          const SeqState& state) {
+    CHECK_EQ(state.hidden.size(), _slots.size()) << " state doesn't match recurrent ops of net";
+    CHECK_EQ(state.cell.size(), _slots.size()) << " state doesn't match recurrent ops of net";
+    _states[seq_id] = state;
+}
+
+#ifdef USE_X86_PLACE
+template class StreamSession<X86, AK_FLOAT, Precision::FP32, OpRunType::ASYNC>;
+template class StreamSession<X86, AK_FLOAT, Precision::FP32, OpRunType::SYNC>;
+#endif
+
+} /* namespace */
@@ -0,0 +1,129 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_STREAM_SESSION_H
+#define ANAKIN_STREAM_SESSION_H
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "framework/core/net/net.h"
+
+namespace anakin {
+
+/**
+ *  \brief Stateful streaming session on top of Net for incremental rnn inference.
+ *
+ *   The session keeps final hidden (and cell) state of every recurrent op (Lstm, Gru) per
+ *   sequence id, and feeds it back as the initial state the next time the same id shows up,
+ *   so a chunk only costs O(new tokens) instead of O(prefix).
+ *   \par Usage:
+ *       \code
+ *       Net<X86, AK_FLOAT, Precision::FP32> net(*graph);
+ *       StreamSession<X86, AK_FLOAT, Precision::FP32> session(net);
+ *       // fill net input with one chunk of every sequence, seq offset as usual
+ *       session.prediction({"user_0", "user_1"});
+ *       auto snapshot = session.checkpoint("user_0");
+ *       ...
+ *       session.restore("user_0", snapshot);
+ *       session.reset("user_1");
+ *       \endcode
+ *   NOTE:
+ *       The session binds state tensors into op params, so it's not thread safe,
+ *       use one session per net (and per thread).
+ *       Only the x86 Lstm and Gru return their final state, so the session is x86 only.
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType = OpRunType::ASYNC>
+class StreamSession {
+    static_assert(std::is_same<Ttype, X86>::value,
+                  "stream session needs the final rnn state, which only x86 ops return");
+public:
+    typedef typename DataTrait<Ttype, Dtype>::dtype dtype;
+
+    /**
+     *  \brief State of one sequence, one entry per recurrent op in net execution order.
+     */
+    struct SeqState {
+        std::vector<std::vector<dtype> > hidden;
+        std::vector<std::vector<dtype> > cell;
+    };
+
+    explicit StreamSession(Net<Ttype, Dtype, Ptype, RunType>& net);
+
+    ~StreamSession();
+
+    /**
+     *  \brief Run one chunk, seq_ids[i] names the i-th sequence of the net input seq offset.
+     *  new ids start from zero state.
+     */
+    void prediction(const std::vector<std::string>& seq_ids);
+
+    /**
+     *  \brief Whether the session holds state for a sequence.
+     */
+    bool has_state(const std::string& seq_id) const;
+
+    /**
+     *  \brief Drop state of a sequence, next chunk of it starts from zero state.
+     */
+    void reset(const std::string& seq_id);
+    void reset_all();
+
+    /**
+     *  \brief Snapshot and restore state of a sequence.
+     */
+    SeqState checkpoint(const std::string& seq_id) const;
+    void restore(const std::string& seq_id, const SeqState& state);
+
+    /**
+     *  \brief Get number of recurrent ops the session tracks.
+     */
+    int stateful_op_num() const { return _slots.size(); }
+
+private:
+    /**
+     *  \brief State tensors bound to one recurrent op.
+     */
+    struct StateSlot {
+        OperatorHelper<Ttype, Dtype, Ptype>* helper{nullptr};
+        std::string name;
+        bool has_cell{false};
+        int hidden_size{0};
+        Tensor4d<Ttype, Dtype> init_hidden;
+        Tensor4d<Ttype, Dtype> init_cell;
+        Tensor4d<Ttype, Dtype> last_hidden;
+        Tensor4d<Ttype, Dtype> last_cell;
+    };
+
+    /// gather per sequence state into a batch tensor, missing sequences are zero.
+    void gather(const std::vector<std::string>& seq_ids, int slot_id, bool cell,
+                Tensor4d<Ttype, Dtype>& dst);
+    /// scatter a batch tensor back into per sequence state.
+    void scatter(const std::vector<std::string>& seq_ids, int slot_id, bool cell,
+                 Tensor4d<Ttype, Dtype>& src);
+    void unbind();
+
+private:
+    Net<Ttype, Dtype, Ptype, RunType>& _net;
+    ///< shared_ptr keeps address of bound tensors stable.
+    std::vector<std::shared_ptr<StateSlot> > _slots;
+    std::unordered_map<std::string, SeqState> _states;
+};
+
+} /* namespace */
+
+#endif
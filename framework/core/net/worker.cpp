@@ -1,63 +1,333 @@
 #include "framework/core/net/worker.h"
+#include <algorithm>
+#include <stdexcept>
 #include "saber/funcs/timer.h"
+#ifdef USE_X86_PLACE
+#include "saber/core/impl/x86/x86_thread.h"
+#endif
 
 namespace anakin {
 
-//! \brief a model map between thread_id and net model
+/// weights of host targets are replicated on every numa node, device weights aren't.
+template<typename Ttype>
+inline bool numa_replicate() {
+    return false;
+}
+#ifdef USE_X86_PLACE
+template<>
+inline bool numa_replicate<X86>() {
+    return true;
+}
+#endif
+
+/**
+ * \brief x86 kernels run omp and mkl teams, the cores are split between the threads of all
+ *  the workers and their teams. A worker reserves its threads on top of the other workers'.
+ * \return the first inter-op slot of the worker.
+ */
+template<typename Ttype>
+inline int reserve_inter_op_threads(int thread_num) {
+    return 0;
+}
+
+template<typename Ttype>
+inline void release_inter_op_threads(int first, int thread_num) {}
+
+/**
+ * \brief pin the thread of an inter-op slot, and the kernel team it starts, to its own share of the cores.
+ *  Nothing is pinned for targets without intra-op budget, or when the threads don't fit the cores.
+ * \param node set to the numa node of the share.
+ */
+template<typename Ttype>
+inline bool bind_intra_op_cpus(int slot, int& node) {
+    return false;
+}
+
+#ifdef USE_X86_PLACE
+template<>
+inline int reserve_inter_op_threads<X86>(int thread_num) {
+    return saber::x86_reserve_inter_op_threads(thread_num);
+}
+
+template<>
+inline void release_inter_op_threads<X86>(int first, int thread_num) {
+    saber::x86_release_inter_op_threads(first, thread_num);
+}
+
+template<>
+inline bool bind_intra_op_cpus<X86>(int slot, int& node) {
+    auto budget = saber::x86_thread_budget();
+    if (slot >= budget.inter_op_num || budget.inter_op_num * budget.intra_op_num > budget.core_num) {
+        return false;
+    }
+    // cpus of a node next to each other, so a share stays on one node when it can
+    auto& numa = NumaTopology::Global();
+    std::vector<int> cpus = saber::x86_process_cpus();
+    std::stable_sort(cpus.begin(), cpus.end(), [&numa](int a, int b) {
+        return numa.node_of_cpu(a) < numa.node_of_cpu(b);
+    });
+    int first = slot * budget.intra_op_num;
+    std::vector<int> share(cpus.begin() + first, cpus.begin() + first + budget.intra_op_num);
+    if (!saber::x86_bind_current_thread(share)) {
+        return false;
+    }
+    node = numa.node_of_cpu(share[0]);
+    return true;
+}
+#endif
+
+/// graph tensors of host targets take the caller's host tensors, the other targets copy them.
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType,
+         bool = std::is_same<Ttype, typename target_host<Ttype>::type>::value>
+struct HostBinder {
+    typedef Tensor4dPtr<typename target_host<Ttype>::type, Dtype> host_tensor;
+    static Status bind_in(Net<Ttype, Dtype, Ptype, RunType>&, std::string&, host_tensor) {
+        return Status::FAIL(" device nets can't bind host tensors");
+    }
+    static Status bind_out(Net<Ttype, Dtype, Ptype, RunType>&, std::string&, host_tensor) {
+        return Status::FAIL(" device nets can't bind host tensors");
+    }
+};
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+struct HostBinder<Ttype, Dtype, Ptype, RunType, true> {
+    static Status bind_in(Net<Ttype, Dtype, Ptype, RunType>& net, std::string& name,
+                          Tensor4dPtr<Ttype, Dtype> tensor) {
+        return net.bind_in(name, tensor);
+    }
+    static Status bind_out(Net<Ttype, Dtype, Ptype, RunType>& net, std::string& name,
+                           Tensor4dPtr<Ttype, Dtype> tensor) {
+        return net.bind_out(name, tensor);
+    }
+};
+
+//! \brief host tensors the outputs of async requests are taken from, one free list per output
+template<typename Ttype, DataType Dtype>
+class OutputPool : public std::enable_shared_from_this<OutputPool<Ttype, Dtype> > {
+public:
+    typedef Tensor4d<typename target_host<Ttype>::type, Dtype> tensor_t;
+
+    ~OutputPool() {
+        for (auto& slot : _free) {
+            for (auto tensor : slot) {
+                delete tensor;
+            }
+        }
+    }
+
+    /**
+     * \brief a tensor of output slot reshaped to shape, it goes back to the pool when the last
+     *  reference drops. Reused tensors are only re-allocated to grow.
+     */
+    std::shared_ptr<tensor_t> acquire(int slot, Shape shape) {
+        tensor_t* tensor = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(_mut);
+            if (slot < _free.size() && !_free[slot].empty()) {
+                tensor = _free[slot].back();
+                _free[slot].pop_back();
+            }
+        }
+        if (tensor == nullptr) {
+            tensor = shape.count() > 0 ? new tensor_t(shape) : new tensor_t();
+        } else if (shape.count() > 0) {
+            tensor->reshape(shape);
+        }
+        auto pool = this->shared_from_this();
+        return std::shared_ptr<tensor_t>(tensor, [pool, slot](tensor_t* tensor) {
+            pool->release(slot, tensor);
+        });
+    }
+
+private:
+    void release(int slot, tensor_t* tensor) {
+        std::lock_guard<std::mutex> guard(_mut);
+        if (slot >= _free.size()) {
+            _free.resize(slot + 1);
+        }
+        _free[slot].push_back(tensor);
+    }
+
+    std::vector<std::vector<tensor_t*> > _free GUARDED_BY(_mut);
+    std::mutex _mut;
+};
+
+//! \brief one version of the model: graph replicas (each owns a weights arena) and a net for every thread on it
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 struct NetGraphWrapper {
     typedef std::thread::id key;
 
-    void initial(std::string model_path, std::unordered_map<std::string, std::vector<int>>& shape_map) EXCLUSIVE_LOCKS_REQUIRED(this->_mut) {
+    ~NetGraphWrapper() {
+        // nets before the graphs they were built on, then tell the version is gone
+        _thread_to_net.clear();
+        _graphs.clear();
+        if (_on_release) {
+            _on_release();
+        }
+    }
+
+    /// called once the version is freed, on the thread dropping the last reference to it.
+    void on_release(std::function<void()> callback) {
+        _on_release = callback;
+    }
+
+    /**
+     * \brief load, reshape and optimize the graph, only the first call does the work.
+     *  With more than one replica, every replica is loaded by a thread bound to its numa node,
+     *  so its weights are first touched and allocated on that node.
+     */
+    Status load(std::string model_path, std::unordered_map<std::string, std::vector<int>>& shape_map,
+                int replica_num = 1) EXCLUSIVE_LOCKS_REQUIRED(this->_mut) {
         std::lock_guard<std::mutex> guard(this->_mut);
-        if(_graph_map.count(model_path) <= 0) {
-            // graph load is thread safe
-            _graph_map[model_path].load(model_path);
-            for(auto it = shape_map.begin(); it != shape_map.end();) {
-                // thread safe
-                _graph_map[model_path].Reshape(it->first, it->second);
-                ++it;
+        if (_loaded) {
+            return Status::OK();
+        }
+        _graphs.clear();
+        for (int i = 0; i < replica_num; i++) {
+            _graphs.emplace_back(new graph::Graph<Ttype, Dtype, Ptype>());
+        }
+        std::vector<Status> rets(replica_num);
+        if (replica_num == 1) {
+            rets[0] = load_replica(0, model_path, shape_map);
+        } else {
+            std::vector<std::thread> loaders;
+            for (int i = 0; i < replica_num; i++) {
+                loaders.emplace_back([&, i]() {
+                    NumaTopology::Global().bind_current_thread(i);
+                    rets[i] = load_replica(i, model_path, shape_map);
+                });
             }
-            // thread safe
-            _graph_map[model_path].Optimize();
-            {// make sure thread safety
-                key id = std::this_thread::get_id();
-                LOG(INFO) << "CURRENT thread ID : " << id;
-                if(_thread_to_net.find(id) == _thread_to_net.end()) {
-                    _thread_to_net[id].init(_graph_map[model_path]);
-                }
+            for (auto& loader : loaders) {
+                loader.join();
             }
-        } else {
-            key id = std::this_thread::get_id(); 
-            LOG(INFO) << "CURRENT thread ID : " << id; 
-            if (_thread_to_net.find(id) == _thread_to_net.end()) { 
-                _thread_to_net[id].init(_graph_map[model_path]); 
+        }
+        size_t weights_mbyte = 0;
+        for (int i = 0; i < replica_num; i++) {
+            if (!rets[i]) {
+                return rets[i];
             }
+            weights_mbyte += _graphs[i]->weights_arena()->get_sum_mbyte();
         }
+        _loaded = true;
+        LOG(INFO) << "model " << model_path << " loaded, replicas : " << replica_num
+                  << ", weights : " << weights_mbyte << " mb ";
+        return Status::OK();
     }
 
-    inline Net<Ttype, Dtype, Ptype, RunType>& get_net(key id) {
-        if(_thread_to_net.find(id) != _thread_to_net.end()) { 
-            return _thread_to_net[id];
+    void initial(std::string model_path, std::unordered_map<std::string, std::vector<int>>& shape_map,
+                 int replica_num, int replica) {
+        CHECK(load(model_path, shape_map, replica_num)) << " load model " << model_path << " failed";
+        get_net(std::this_thread::get_id(), replica);
+    }
+
+    /// get net of thread, initial it on the graph replica at the first time.
+    inline Net<Ttype, Dtype, Ptype, RunType>& get_net(key id, int replica = 0) EXCLUSIVE_LOCKS_REQUIRED(this->_mut) {
+        std::lock_guard<std::mutex> guard(this->_mut);
+        CHECK(_loaded) << " net of thread is required before model is loaded";
+        auto it = _thread_to_net.find(id);
+        if (it != _thread_to_net.end()) {
+            return it->second;
         }
-        LOG(FATAL) << " target key(thread_id) not found in NetGraphWrapper";
-        return _thread_to_net[id];
+        LOG(INFO) << "CURRENT thread ID : " << id << " on graph replica " << replica;
+        auto& net = _thread_to_net[id];
+        net.init(*_graphs[replica % _graphs.size()]);
+        return net;
     }
-    
+
 private:
-    std::unordered_map<std::string, graph::Graph<Ttype, Dtype, Ptype>> _graph_map;
+    Status load_replica(int replica, std::string& model_path,
+                        std::unordered_map<std::string, std::vector<int>>& shape_map) {
+        auto& graph = *_graphs[replica];
+        Status ret = graph.load(model_path);
+        if (!ret) {
+            return ret;
+        }
+        for (auto it = shape_map.begin(); it != shape_map.end(); ++it) {
+            graph.Reshape(it->first, it->second);
+        }
+        return graph.Optimize();
+    }
+
+private:
+    std::vector<std::unique_ptr<graph::Graph<Ttype, Dtype, Ptype> > > _graphs GUARDED_BY(this->_mut);
+    bool _loaded{false} GUARDED_BY(this->_mut);
     std::unordered_map<key, Net<Ttype, Dtype, Ptype, RunType>> _thread_to_net GUARDED_BY(this->_mut);
+    std::function<void()> _on_release;
     std::mutex _mut;
 };
 
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
-using MultiThreadModel = Singleton<NetGraphWrapper<Ttype, Dtype, Ptype, RunType>>;
+Worker<Ttype, Dtype, Ptype, RunType>::Worker(std::string model_path, int num_thread) : _model_path(model_path), ThreadPool(num_thread) {
+    _model = std::make_shared<NetGraphWrapper<Ttype, Dtype, Ptype, RunType> >();
+    _node_num = NumaTopology::Global().node_num();
+    _replica_num = numa_replicate<Ttype>() ? _node_num : 1;
+    _output_pool = std::make_shared<OutputPool<Ttype, Dtype> >();
+    _inter_op_num = num_thread;
+    _inter_op_first = reserve_inter_op_threads<Ttype>(num_thread);
+}
 
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
-Worker<Ttype, Dtype, Ptype, RunType>::Worker(std::string model_path, int num_thread) : _model_path(model_path), ThreadPool(num_thread) {}
+Worker<Ttype, Dtype, Ptype, RunType>::~Worker() {
+    // the running requests use the members, the threads are gone before them
+    this->join();
+    // requests still queued never run, they fail to their callbacks and waiters
+    std::unordered_map<size_t, AsyncCallback> queued;
+    {
+        std::lock_guard<std::mutex> guard(this->_ready_mut);
+        queued.swap(_queued_requests);
+    }
+    for (auto& request : queued) {
+        LOG(WARNING) << " async request " << request.first << " dropped, the worker is shut down";
+        AsyncOutputs outs;
+        if (request.second) {
+            request.second(request.first, outs);
+        } else {
+            async_done(request.first, outs,
+                       std::make_exception_ptr(std::runtime_error("worker is shut down")));
+        }
+    }
+    {
+        std::unique_lock<std::mutex> lock(this->_ready_mut);
+        _ready_cv.wait(lock, [this]() { return _waiter_num == 0; });
+    }
+    release_inter_op_threads<Ttype>(_inter_op_first, _inter_op_num);
+}
 
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
-Worker<Ttype, Dtype, Ptype, RunType>::~Worker() {}
+std::shared_ptr<NetGraphWrapper<Ttype, Dtype, Ptype, RunType> > Worker<Ttype, Dtype, Ptype, RunType>::current_model() {
+    std::lock_guard<std::mutex> guard(this->_model_mut);
+    return _model;
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+std::future<Status> Worker<Ttype, Dtype, Ptype, RunType>::reload(std::string model_path) {
+    return std::async(std::launch::async, [this, model_path]() -> Status {
+        std::lock_guard<std::mutex> reload_guard(this->_reload_mut);
+        auto new_model = std::make_shared<NetGraphWrapper<Ttype, Dtype, Ptype, RunType> >();
+        Status ret = new_model->load(model_path, _in_shapes, _replica_num);
+        if (!ret) {
+            LOG(ERROR) << " reload model " << model_path << " failed, keep serving the old one";
+            return ret;
+        }
+        std::shared_ptr<NetGraphWrapper<Ttype, Dtype, Ptype, RunType> > old_model;
+        {
+            std::lock_guard<std::mutex> guard(this->_model_mut);
+            old_model = _model;
+            _model = new_model;
+            _model_path = model_path;
+        }
+        // the old version is unreachable now, the last request in flight on it frees it
+        std::promise<void> released;
+        std::future<void> drained = released.get_future();
+        old_model->on_release([&released]() {
+            released.set_value();
+        });
+        old_model.reset();
+        drained.wait();
+        LOG(INFO) << " worker switched to model " << model_path;
+        return Status::OK();
+    });
+}
 
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 void Worker<Ttype, Dtype, Ptype, RunType>::pause(size_t time) {
@@ -92,7 +362,9 @@ void Worker<Ttype, Dtype, Ptype, RunType>::register_interior_edges(std::string b
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 std::vector<Tensor4dPtr<Ttype, Dtype> > Worker<Ttype, Dtype, Ptype, RunType>::sync_prediction(std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_ins_list) {
     auto task = [&](std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& ins) -> std::vector<Tensor4dPtr<Ttype, Dtype> > {
-        auto& net = MultiThreadModel<Ttype, Dtype, Ptype, RunType>::Global().get_net(std::this_thread::get_id()); 
+        // hold the version until the request is done
+        auto model = current_model();
+        auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
         //fill the graph inputs
 
         for(int i = 0; i < _inputs_in_order.size(); i++) { 
@@ -115,14 +387,8 @@ std::vector<Tensor4dPtr<Ttype, Dtype> > Worker<Ttype, Dtype, Ptype, RunType>::sy
             _thead_id_to_prediction_times_vec_in_ms[std::this_thread::get_id()].push_back(my_time.get_average_ms());
         }
 #endif
-        // get outputs of graph
-        std::vector<Tensor4dPtr<Ttype, Dtype>> ret;
-        for (auto out : _outputs_in_order) {
-            auto d_tensor_out_p = net.get_out(out);
-            ret.push_back(d_tensor_out_p);
-        }
-
-        return ret; 
+        // get outputs of graph, off the net as a reload frees it with its version
+        return thread_outputs(net);
     };
     return this->RunSync(task, net_ins_list);
 }
@@ -130,21 +396,17 @@ std::vector<Tensor4dPtr<Ttype, Dtype> > Worker<Ttype, Dtype, Ptype, RunType>::sy
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 std::vector<Tensor4dPtr<Ttype, Dtype> > Worker<Ttype, Dtype, Ptype, RunType>::sync_prediction_device(std::vector<Tensor4dPtr<Ttype, Dtype> >& net_ins_list) {
     auto task = [&](std::vector<Tensor4dPtr<Ttype, Dtype> >& ins) -> std::vector<Tensor4dPtr<Ttype, Dtype> > {
-        auto& net = MultiThreadModel<Ttype, Dtype, Ptype, RunType>::Global().get_net(std::this_thread::get_id()); 
+        // hold the version until the request is done
+        auto model = current_model();
+        auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
         //fill the graph inputs 
         for (int i = 0; i < _inputs_in_order.size(); i++) { 
             auto d_tensor_in_p = net.get_in(_inputs_in_order[i]); 
             d_tensor_in_p->copy_from(*ins[i]); 
         } 
         net.prediction(); 
-        // get outputs of graph
-        std::vector<Tensor4dPtr<Ttype, Dtype>> ret;
-        for (auto out : _outputs_in_order) {
-            auto d_tensor_out_p = net.get_out(out);
-            ret.push_back(d_tensor_out_p);
-        }
-
-        return ret; 
+        // get outputs of graph, off the net as a reload frees it with its version
+        return thread_outputs(net);
     }; 
     return this->RunSync(task, net_ins_list);
 }
@@ -153,7 +415,9 @@ template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 void Worker<Ttype, Dtype, Ptype, RunType>::async_prediction(std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_ins_list) {
     std::lock_guard<std::mutex> guard(this->_async_que_mut);    
     auto task = [&](std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& ins) -> std::vector<Tensor4dPtr<Ttype, Dtype> > {
-            auto& net = MultiThreadModel<Ttype, Dtype, Ptype, RunType>::Global().get_net(std::this_thread::get_id());
+            // hold the version until the request is done
+            auto model = current_model();
+            auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
             //fill the graph inputs
             for(int i = 0; i < _inputs_in_order.size(); i++) {
                 auto d_tensor_in_p = net.get_in(_inputs_in_order[i]);
@@ -164,18 +428,218 @@ void Worker<Ttype, Dtype, Ptype, RunType>::async_prediction(std::vector<Tensor4d
 
             net.prediction();
 
-            // get outputs of graph
-            std::vector<Tensor4dPtr<Ttype, Dtype>> ret;
-            for(auto out : _outputs_in_order) {
-                auto d_tensor_out_p = net.get_out(out);
-                ret.push_back(d_tensor_out_p);
-            }
-
-            return ret;
+            // get outputs of graph, off the net as a reload frees it with its version
+            return thread_outputs(net);
         }; 
     _async_que.push(this->RunAsync(task, net_ins_list)); 
 } 
 
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+std::vector<Tensor4dPtr<Ttype, Dtype> > Worker<Ttype, Dtype, Ptype, RunType>::thread_outputs(
+        Net<Ttype, Dtype, Ptype, RunType>& net) {
+    std::vector<std::unique_ptr<Tensor4d<Ttype, Dtype> > >* outs = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(this->_thread_outputs_mut);
+        outs = &_thread_outputs[std::this_thread::get_id()];
+    }
+    while (outs->size() < _outputs_in_order.size()) {
+        outs->emplace_back(new Tensor4d<Ttype, Dtype>());
+    }
+    std::vector<Tensor4dPtr<Ttype, Dtype> > ret;
+    for (int i = 0; i < _outputs_in_order.size(); i++) {
+        auto d_tensor_out_p = net.get_out(_outputs_in_order[i]);
+        auto out = (*outs)[i].get();
+        out->reshape(d_tensor_out_p->valid_shape());
+        out->copy_from(*d_tensor_out_p);
+        out->set_seq_offset(d_tensor_out_p->get_seq_offset());
+        ret.push_back(out);
+    }
+    return ret;
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Dtype, Ptype, RunType>::prediction_zero_copy(Net<Ttype, Dtype, Ptype, RunType>& net,
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& ins,
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& outs) {
+    typedef HostBinder<Ttype, Dtype, Ptype, RunType> binder;
+    CHECK_EQ(ins.size(), _inputs_in_order.size()) << " inputs don't match the registered ones";
+    CHECK_EQ(outs.size(), _outputs_in_order.size()) << " outputs don't match the registered ones";
+    for (int i = 0; i < _inputs_in_order.size(); i++) {
+        if (binder::bind_in(net, _inputs_in_order[i], ins[i])) {
+            continue;
+        }
+        auto d_tensor_in_p = net.get_in(_inputs_in_order[i]);
+        d_tensor_in_p->reshape(ins[i]->valid_shape());
+        d_tensor_in_p->copy_from(*ins[i]);
+        d_tensor_in_p->set_seq_offset(ins[i]->get_seq_offset());
+    }
+    std::vector<bool> bound(outs.size());
+    for (int i = 0; i < _outputs_in_order.size(); i++) {
+        bound[i] = binder::bind_out(net, _outputs_in_order[i], outs[i]);
+    }
+
+    net.prediction();
+
+    // unbind copies the outputs which outgrew the caller tensors
+    net.unbind();
+    for (int i = 0; i < _outputs_in_order.size(); i++) {
+        if (bound[i]) {
+            continue;
+        }
+        auto d_tensor_out_p = net.get_out(_outputs_in_order[i]);
+        outs[i]->reshape(d_tensor_out_p->valid_shape());
+        outs[i]->copy_from(*d_tensor_out_p);
+        outs[i]->set_seq_offset(d_tensor_out_p->get_seq_offset());
+    }
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Dtype, Ptype, RunType>::sync_prediction_zero_copy(
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_ins_list,
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_outs_list) {
+    auto task = [&](std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& ins,
+                    std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& outs) {
+        // hold the version until the request is done
+        auto model = current_model();
+        auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
+        prediction_zero_copy(net, ins, outs);
+    };
+    this->RunSync(task, net_ins_list, net_outs_list);
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Dtype, Ptype, RunType>::sync_prediction_bucketed(
+        std::vector<std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> > >& requests_in,
+        std::vector<std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> > >& requests_out,
+        int max_batch) {
+    typedef std::shared_ptr<host_tensor> host_tensor_ptr;
+    CHECK_EQ(requests_in.size(), requests_out.size()) << " every request needs its outputs";
+    std::vector<std::vector<int> > offsets;
+    for (auto& ins : requests_in) {
+        CHECK_EQ(ins.size(), _inputs_in_order.size()) << " inputs don't match the registered ones";
+        offsets.push_back(ins[0]->get_seq_offset());
+    }
+    SeqBuckets buckets(offsets, max_batch);
+    const int bucket_num = buckets.bucket_num();
+    if (bucket_num == 0) {
+        return;
+    }
+    // one version for every batch, so the sequences of a request see the same model
+    auto model = current_model();
+    std::vector<std::vector<host_tensor_ptr> > bucket_outs(bucket_num);
+
+    auto task = [&](int bucket) {
+        auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
+        for (int i = 0; i < _inputs_in_order.size(); i++) {
+            std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> > request_ins;
+            for (auto& ins : requests_in) {
+                request_ins.push_back(ins[i]);
+            }
+            host_tensor merged;
+            buckets.gather(bucket, request_ins, merged);
+            auto d_tensor_in_p = net.get_in(_inputs_in_order[i]);
+            d_tensor_in_p->reshape(merged.valid_shape());
+            d_tensor_in_p->copy_from(merged);
+            d_tensor_in_p->set_seq_offset(merged.get_seq_offset());
+        }
+
+        net.prediction();
+
+        for (auto& out : _outputs_in_order) {
+            auto d_tensor_out_p = net.get_out(out);
+            host_tensor_ptr host_out = std::make_shared<host_tensor>(d_tensor_out_p->valid_shape());
+            host_out->copy_from(*d_tensor_out_p);
+            bucket_outs[bucket].push_back(host_out);
+        }
+    };
+    std::vector<std::future<void> > results;
+    for (int b = 0; b < bucket_num; b++) {
+        results.push_back(this->RunAsync(task, b));
+    }
+    for (auto& result : results) {
+        result.get();
+    }
+
+    // outputs of the requests, per word or per sequence as the batches give them
+    std::vector<bool> word_rows(_outputs_in_order.size());
+    bool split = true;
+    for (int o = 0; o < _outputs_in_order.size() && split; o++) {
+        std::vector<int> bucket_nums;
+        for (int b = 0; b < bucket_num; b++) {
+            bucket_nums.push_back(bucket_outs[b][o]->num());
+        }
+        bool rows = true;
+        split = buckets.per_word(bucket_nums, rows);
+        word_rows[o] = rows;
+    }
+    if (!split) {
+        // an output of the whole batch can't be cut back into the requests, run them one by one
+        LOG(WARNING) << " outputs don't follow words or sequences, run the requests unbucketed";
+        auto request_task = [&](int r) {
+            auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
+            for (int i = 0; i < _inputs_in_order.size(); i++) {
+                auto d_tensor_in_p = net.get_in(_inputs_in_order[i]);
+                d_tensor_in_p->reshape(requests_in[r][i]->valid_shape());
+                d_tensor_in_p->copy_from(*requests_in[r][i]);
+                d_tensor_in_p->set_seq_offset(requests_in[r][i]->get_seq_offset());
+            }
+
+            net.prediction();
+
+            for (int o = 0; o < _outputs_in_order.size(); o++) {
+                auto d_tensor_out_p = net.get_out(_outputs_in_order[o]);
+                requests_out[r][o]->reshape(d_tensor_out_p->valid_shape());
+                requests_out[r][o]->copy_from(*d_tensor_out_p);
+                requests_out[r][o]->set_seq_offset(d_tensor_out_p->get_seq_offset());
+            }
+        };
+        std::vector<std::future<void> > request_results;
+        for (int r = 0; r < requests_in.size(); r++) {
+            CHECK_EQ(requests_out[r].size(), _outputs_in_order.size())
+                    << " outputs don't match the registered ones";
+            request_results.push_back(this->RunAsync(request_task, r));
+        }
+        for (auto& result : request_results) {
+            result.get();
+        }
+        return;
+    }
+    for (int o = 0; o < _outputs_in_order.size(); o++) {
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> > request_outs;
+        for (int r = 0; r < requests_out.size(); r++) {
+            CHECK_EQ(requests_out[r].size(), _outputs_in_order.size())
+                    << " outputs don't match the registered ones";
+            Shape shape = bucket_outs[0][o]->valid_shape();
+            shape[0] = word_rows[o] ? buckets.request_words(r) : buckets.request_seqs(r);
+            requests_out[r][o]->reshape(shape);
+            if (word_rows[o]) {
+                requests_out[r][o]->set_seq_offset(offsets[r]);
+            }
+            request_outs.push_back(requests_out[r][o]);
+        }
+        for (int b = 0; b < bucket_num; b++) {
+            buckets.scatter(b, *bucket_outs[b][o], word_rows[o], request_outs);
+        }
+    }
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Dtype, Ptype, RunType>::async_prediction_zero_copy(
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_ins_list,
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_outs_list) {
+    std::lock_guard<std::mutex> guard(this->_async_que_mut);
+    auto task = [&](std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& ins,
+                    std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& outs)
+            -> std::vector<Tensor4dPtr<Ttype, Dtype> > {
+        // hold the version until the request is done
+        auto model = current_model();
+        auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
+        prediction_zero_copy(net, ins, outs);
+        return std::vector<Tensor4dPtr<Ttype, Dtype> >();
+    };
+    _async_que.push(this->RunAsync(task, net_ins_list, net_outs_list));
+}
+
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 std::vector<Tensor4dPtr<Ttype, Dtype> > Worker<Ttype, Dtype, Ptype, RunType>::async_get_result() {
     std::lock_guard<std::mutex> guard(this->_async_que_mut);    
@@ -184,9 +648,150 @@ std::vector<Tensor4dPtr<Ttype, Dtype> > Worker<Ttype, Dtype, Ptype, RunType>::as
     return result.get();
 } 
 
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+size_t Worker<Ttype, Dtype, Ptype, RunType>::async_submit(
+        std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_ins_list,
+        AsyncCallback callback) {
+    size_t id = _next_request_id++;
+    {
+        std::lock_guard<std::mutex> guard(this->_ready_mut);
+        if (!callback) {
+            _pending_requests.insert(id);
+        }
+        _queued_requests[id] = callback;
+    }
+    auto task = [this, id, callback](std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& ins) {
+        {
+            std::lock_guard<std::mutex> guard(this->_ready_mut);
+            _queued_requests.erase(id);
+        }
+        AsyncOutputs outs;
+        std::exception_ptr error;
+        try {
+            // hold the version until the request is done
+            auto model = current_model();
+            auto& net = model->get_net(std::this_thread::get_id(), replica_of_current_thread());
+            // outputs of the request, shaped as the last outputs of net so they can be bound
+            std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> > out_ptrs;
+            for (int i = 0; i < _outputs_in_order.size(); i++) {
+                outs.push_back(_output_pool->acquire(i, net.get_out(_outputs_in_order[i])->valid_shape()));
+                out_ptrs.push_back(outs.back().get());
+            }
+            prediction_zero_copy(net, ins, out_ptrs);
+        } catch (...) {
+            // nobody reads the future of the task, so the error must reach the waiters here
+            LOG(ERROR) << " async request " << id << " failed";
+            error = std::current_exception();
+            outs.clear();
+        }
+        if (callback) {
+            callback(id, outs);
+        } else {
+            async_done(id, outs, error);
+        }
+    };
+    this->RunAsync(task, net_ins_list);
+    return id;
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Dtype, Ptype, RunType>::async_done(size_t id, AsyncOutputs& outs,
+                                                       std::exception_ptr error) {
+    {
+        std::lock_guard<std::mutex> guard(this->_ready_mut);
+        if (error) {
+            _failed_requests[id] = error;
+        } else {
+            _ready_outputs[id] = outs;
+        }
+        _ready_requests.push_back(id);
+    }
+    _ready_cv.notify_all();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+size_t Worker<Ttype, Dtype, Ptype, RunType>::async_get_ready(AsyncOutputs& outs) {
+    std::unique_lock<std::mutex> lock(this->_ready_mut);
+    // ~Worker waits for the waiters, which don't touch the worker once they unlock
+    _waiter_num++;
+    _ready_cv.wait(lock, [this]() { return !_ready_requests.empty() || _pending_requests.empty(); });
+    _waiter_num--;
+    if (_ready_requests.empty()) {
+        return 0;
+    }
+    size_t id = _ready_requests.front();
+    _ready_requests.pop_front();
+    _pending_requests.erase(id);
+    auto failed = _failed_requests.find(id);
+    if (failed != _failed_requests.end()) {
+        std::exception_ptr error = failed->second;
+        _failed_requests.erase(failed);
+        _ready_cv.notify_all();
+        lock.unlock();
+        std::rethrow_exception(error);
+    }
+    outs = std::move(_ready_outputs[id]);
+    _ready_outputs.erase(id);
+    return id;
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+typename Worker<Ttype, Dtype, Ptype, RunType>::AsyncOutputs Worker<Ttype, Dtype, Ptype, RunType>::async_get(size_t id) {
+    std::unique_lock<std::mutex> lock(this->_ready_mut);
+    CHECK(_pending_requests.count(id)) << " request " << id << " isn't in flight or has a callback";
+    _waiter_num++;
+    _ready_cv.wait(lock, [this, id]() {
+        return _ready_outputs.count(id) > 0 || _failed_requests.count(id) > 0;
+    });
+    _waiter_num--;
+    AsyncOutputs outs = std::move(_ready_outputs[id]);
+    _ready_outputs.erase(id);
+    std::exception_ptr error;
+    auto failed = _failed_requests.find(id);
+    if (failed != _failed_requests.end()) {
+        error = failed->second;
+        _failed_requests.erase(failed);
+    }
+    _ready_requests.erase(std::find(_ready_requests.begin(), _ready_requests.end(), id));
+    _pending_requests.erase(id);
+    // waiters of any request may have nothing in flight now
+    _ready_cv.notify_all();
+    lock.unlock();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return outs;
+}
+
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
 void Worker<Ttype, Dtype, Ptype, RunType>::init() {
-    MultiThreadModel<Ttype, Dtype, Ptype, RunType>::Global().initial(_model_path, _in_shapes);
+    std::string model_path;
+    {
+        std::lock_guard<std::mutex> guard(this->_model_mut);
+        model_path = _model_path;
+    }
+    // pin the thread to its share of the cores, or else spread threads over numa nodes
+    // round robin, single node machines aren't bound then
+    int slot = _launched_thread_num++;
+    int node = slot % _node_num;
+    if (!bind_intra_op_cpus<Ttype>(_inter_op_first + slot % _inter_op_num, node) && _node_num > 1) {
+        NumaTopology::Global().bind_current_thread(node);
+    }
+    {
+        std::lock_guard<std::mutex> guard(this->_node_mut);
+        _thread_to_node[std::this_thread::get_id()] = node;
+    }
+    current_model()->initial(model_path, _in_shapes, _replica_num, replica_of_current_thread());
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+int Worker<Ttype, Dtype, Ptype, RunType>::replica_of_current_thread() {
+    if (_replica_num == 1) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> guard(this->_node_mut);
+    auto it = _thread_to_node.find(std::this_thread::get_id());
+    return it == _thread_to_node.end() ? 0 : it->second % _replica_num;
 }
 
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
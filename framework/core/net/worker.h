@@ -19,18 +19,31 @@
 #include <vector>
 #include <thread>
 #include <queue>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <future>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
+#include <exception>
 #include "framework/core/thread_safe_macros.h"
 #include "framework/core/thread_pool.h"
 #include "framework/core/singleton.h"
+#include "framework/core/numa.h"
 #include "framework/core/net/operator_func.h"
 #include "framework/core/net/net.h"
+#include "framework/core/net/seq_bucket.h"
 
 namespace anakin {
 
+template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunType>
+struct NetGraphWrapper;
+
+template<typename Ttype, DataType Dtype>
+class OutputPool;
+
 /** 
  *  \brief class Worker for multi-thread anakin inference.
  *  \par Usage: 
@@ -60,11 +73,53 @@ namespace anakin {
  *              auto outs = worker_for_vgg_net.async_get_result();         
  *          }
  *          \endcode
+ *      - \p [OUT OF ORDER ASYNC]
+ *          \code
+ *          // results come back as soon as they are done, each on its own output tensors
+ *          size_t id = worker_for_vgg_net.async_submit(net_ins);
+ *          worker_for_vgg_net.async_submit(other_ins, [](size_t id, Worker<...>::AsyncOutputs& outs) {
+ *              reply(id, outs); // runs on the worker thread
+ *          });
+ *          Worker<...>::AsyncOutputs outs;
+ *          size_t ready_id = worker_for_vgg_net.async_get_ready(outs);
+ *          \endcode
+ *      - \p [ZERO COPY]
+ *          \code
+ *          // host targets compute on the caller tensors directly, outs are reshaped to the outputs
+ *          worker_for_vgg_net.sync_prediction_zero_copy(net_ins, net_outs);
+ *          \endcode
+ *      - \p [NUMA]
+ *          On multi-socket hosts the worker threads are bound to numa nodes round robin,
+ *          and x86 weights are replicated per node, every thread runs on a net whose
+ *          weights and activations are node-local.
+ *      - \p [LENGTH BUCKETS]
+ *          \code
+ *          // sequences of a window of requests are regrouped by length in batches of up to 32,
+ *          // the batches run on the worker threads, outputs are split back per request
+ *          worker_for_rnn_net.sync_prediction_bucketed(requests_in, requests_out, 32);
+ *          \endcode
+ *      - \p [THREADS]
+ *          The x86 cores are split between the worker threads and the omp / mkl teams their
+ *          kernels run (see saber/core/impl/x86/x86_thread.h), each thread is pinned to its
+ *          own share when they fit, e.g. 4 threads on 32 cores run kernels with 8 threads each.
+ *      - \p [HOT RELOAD]
+ *          \code
+ *          // load and optimize the new version in background, traffic moves over when it's ready
+ *          auto status = worker_for_vgg_net.reload("/path/to/vgg_net_v2.anakin.bin");
+ *          // the old version is freed once its in-flight requests drain
+ *          status.get();
+ *          \endcode
  *
  */
 template<typename Ttype, DataType Dtype, Precision Ptype, OpRunType RunTyp = OpRunType::ASYNC>
 class Worker : public ThreadPool {
 public:
+    typedef Tensor4d<typename target_host<Ttype>::type, Dtype> host_tensor;
+    /// outputs of an async_submit request, they go back to the worker's pool when the last copy drops.
+    typedef std::vector<std::shared_ptr<host_tensor> > AsyncOutputs;
+    /// called on the worker thread when an async_submit request is done, with its id and outputs.
+    typedef std::function<void(size_t, AsyncOutputs&)> AsyncCallback;
+
     Worker(std::string model_path, int thread_num);
     ~Worker();
 
@@ -104,7 +159,8 @@ public:
     /** 
      *  \brief do sync prediction in multi-thread worker useful in sync rpc server. 
      *  \param host net_in_list the inputs of net graph (note: the len of net_in_list should be equal to the net inputs).  
-     *  \return the net graph outputs.
+     *  \return the net graph outputs, copies which stay valid until the next request of the same
+     *  worker thread, across reloads too.
      */
     std::vector<Tensor4dPtr<Ttype, Dtype> > sync_prediction(\
         std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_in_list);
@@ -124,6 +180,42 @@ public:
      */
     void async_prediction(std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_in_list);
     
+    /** 
+     *  \brief do sync prediction on caller memory, useful for large inputs and outputs.
+     *  For host targets the tensors are bound as the graph inputs and outputs of this prediction
+     *  (see Net::bind_in and Net::bind_out), so inputs aren't copied in nor outputs copied out.
+     *  Other targets copy them. The caller keeps the tensors alive and untouched until it returns.
+     *  \param net_in_list the inputs of net graph in the order of register_inputs.
+     *  \param net_out_list the outputs of net graph in the order of register_outputs, they are
+     *  reshaped to the outputs.
+     */
+    void sync_prediction_zero_copy(std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_in_list,
+                                   std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_out_list);
+
+    /** 
+     *  \brief do sync prediction of several sequence requests in length buckets (see SeqBuckets).
+     *  The sequences of all the requests are sorted by length and cut in batches of at most
+     *  max_batch sequences, so a batch takes about as many recurrent steps as each of its
+     *  sequences needs. The batches run on the worker threads, then their outputs are copied
+     *  back to the requests. All the batches run on the model current at the call. If an output
+     *  has neither a row per word nor a row per sequence, the requests run one by one instead.
+     *  \param requests_in inputs of every request in the order of register_inputs, each input
+     *  carries the seq offset of its request.
+     *  \param requests_out outputs of every request in the order of register_outputs, they are
+     *  reshaped to the words of the request, or to its sequences for outputs of one row per sequence.
+     *  \param max_batch sequences of a batch at most.
+     */
+    void sync_prediction_bucketed(std::vector<std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> > >& requests_in,
+                                  std::vector<std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> > >& requests_out,
+                                  int max_batch);
+
+    /** 
+     *  \brief async version of sync_prediction_zero_copy, the tensors are in use until the request's
+     *  async_get_result returns, which gives an empty vector for it.
+     */
+    void async_prediction_zero_copy(std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_in_list,
+                                    std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_out_list);
+
     /** 
      *  \brief Judge if the async queue is empty.
      *  \return bool return true if it's empty otherwise false.
@@ -133,10 +225,36 @@ public:
     /** 
      *  \brief async get result of multi-thread worker. 
      *  the return order of results from async_get_result is the same as the order of net_in_list called by async_prediction.
-     *  \return the net inference result.
+     *  \return the net inference result, valid as the outputs of sync_prediction are.
      */
     std::vector<Tensor4dPtr<Ttype, Dtype> > async_get_result();
 
+    /** 
+     *  \brief Submit an async request which completes out of order.
+     *  Its outputs are host tensors taken from a pool, owned by the request, so the next requests
+     *  don't overwrite them. With callback, the outputs are passed to it as soon as the request is
+     *  done, otherwise they wait for async_get_ready or async_get. A request which throws passes
+     *  no outputs to its callback, or has its exception rethrown by async_get_ready or async_get.
+     *  Requests not started when the worker is destroyed fail the same way, the running ones finish.
+     *  \param net_in_list the inputs of net graph, kept alive by the caller until the request is done.
+     *  \return id of the request.
+     */
+    size_t async_submit(std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& net_in_list,
+                        AsyncCallback callback = nullptr);
+
+    /** 
+     *  \brief Wait for the first done request (without callback) whose outputs aren't taken yet.
+     *  \return id of the request, 0 if no request is in flight nor done.
+     *  Rethrows the exception of a failed request, which is no longer in flight then.
+     */
+    size_t async_get_ready(AsyncOutputs& outs);
+
+    /** 
+     *  \brief Wait for the outputs of request id (submitted without callback).
+     *  Rethrows the exception of the request if it failed.
+     */
+    AsyncOutputs async_get(size_t id);
+
 public:
     /** 
      *  \biref register auxiliary functions will be lanunched each time when the sync/async is called
@@ -151,6 +269,17 @@ public:
      */
     void pause(size_t time);
 
+    /** 
+     *  \brief Hot reload the model of worker.
+     *  The new version is loaded, reshaped and optimized in background while the old version
+     *  keeps serving. Then traffic is switched over atomically, every thread initials its net
+     *  on the new version at its first request. The old version (graph, nets and weights arena)
+     *  is freed once the requests in flight on it drain. If loading fails the old version stays.
+     *  \param model_path path of the new version.
+     *  \return future of the reload status.
+     */
+    std::future<Status> reload(std::string model_path);
+
 #ifdef ENABLE_OP_TIMER
     /**
      *  \brief get sync prediction times map
@@ -167,8 +296,57 @@ private:
 
     virtual void auxiliary_funcs() override;
 
+    /** 
+     *  \brief Get the model version currently serving.
+     *  The task holds the returned reference until it's done, so the version can't be freed under it.
+     */
+    std::shared_ptr<NetGraphWrapper<Ttype, Dtype, Ptype, RunTyp> > current_model();
+
+    /** 
+     *  \brief Get the graph replica (numa node) of the calling worker thread.
+     */
+    int replica_of_current_thread();
+
+    /** 
+     *  \brief Copy the outputs of net into the output tensors of the calling thread.
+     *  They belong to the worker, not to a model version, and hold until the thread's next request.
+     */
+    std::vector<Tensor4dPtr<Ttype, Dtype> > thread_outputs(Net<Ttype, Dtype, Ptype, RunTyp>& net);
+
+    /** 
+     *  \brief Run net on caller memory, the body of the zero copy predictions.
+     */
+    void prediction_zero_copy(Net<Ttype, Dtype, Ptype, RunTyp>& net,
+                              std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& ins,
+                              std::vector<Tensor4dPtr<typename target_host<Ttype>::type, Dtype> >& outs);
+
+    /** 
+     *  \brief Hand the outputs, or the error, of a done request to whoever waits for it.
+     */
+    void async_done(size_t id, AsyncOutputs& outs, std::exception_ptr error = nullptr);
+
 private:
-    std::string _model_path;
+    std::string _model_path GUARDED_BY(_model_mut);
+    ///< model version currently serving.
+    std::shared_ptr<NetGraphWrapper<Ttype, Dtype, Ptype, RunTyp> > _model GUARDED_BY(_model_mut);
+    std::mutex _model_mut;
+    ///< make reloads run one by one.
+    std::mutex _reload_mut;
+    ///< numa nodes of host.
+    int _node_num{1};
+    ///< graph replicas of model, one per numa node for host targets.
+    int _replica_num{1};
+    ///< threads launched, used to spread threads over nodes.
+    std::atomic<int> _launched_thread_num{0};
+    ///< inter-op slots of the worker threads, their shares of the cores.
+    int _inter_op_first{0};
+    int _inter_op_num{1};
+    std::unordered_map<std::thread::id, int> _thread_to_node GUARDED_BY(_node_mut);
+    std::mutex _node_mut;
+    ///< outputs handed back by sync_prediction and async_prediction, per worker thread.
+    std::unordered_map<std::thread::id, std::vector<std::unique_ptr<Tensor4d<Ttype, Dtype> > > >
+            _thread_outputs GUARDED_BY(_thread_outputs_mut);
+    std::mutex _thread_outputs_mut;
     ///< vector of inputs node in order.
     std::vector<std::string> _inputs_in_order;
     ///< vector of outputs node in order.
@@ -177,6 +355,22 @@ private:
     std::vector<graph::Arc<std::string, int>> _edges_in_order;
     std::queue< std::future< std::vector<Tensor4dPtr<Ttype, Dtype> > > > _async_que GUARDED_BY(_async_que_mut);
     std::mutex _async_que_mut;    
+    ///< tensors the async_submit outputs are taken from.
+    std::shared_ptr<OutputPool<Ttype, Dtype> > _output_pool;
+    ///< id of the next async_submit request, 0 means none.
+    std::atomic<size_t> _next_request_id{1};
+    ///< requests without callback whose outputs aren't taken yet.
+    std::unordered_set<size_t> _pending_requests GUARDED_BY(_ready_mut);
+    ///< outputs, or errors, of the done ones, ids in order of completion.
+    std::unordered_map<size_t, AsyncOutputs> _ready_outputs GUARDED_BY(_ready_mut);
+    std::unordered_map<size_t, std::exception_ptr> _failed_requests GUARDED_BY(_ready_mut);
+    std::deque<size_t> _ready_requests GUARDED_BY(_ready_mut);
+    ///< async_submit requests not started yet, with their callbacks, failed if the worker shuts down.
+    std::unordered_map<size_t, AsyncCallback> _queued_requests GUARDED_BY(_ready_mut);
+    ///< threads waiting in async_get_ready or async_get.
+    int _waiter_num{0} GUARDED_BY(_ready_mut);
+    std::mutex _ready_mut;
+    std::condition_variable _ready_cv;
     std::vector<std::function<void(void)> > _auxiliary_funcs;
     std::unordered_map<std::string, std::vector<int>> _in_shapes;
 #ifdef ENABLE_OP_TIMER
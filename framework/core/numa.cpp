@@ -0,0 +1,95 @@
+#include "framework/core/numa.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "utils/logger/logger.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace anakin {
+
+std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+    std::vector<int> cpus;
+    std::stringstream ss(cpu_list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        auto dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+NumaInfo::NumaInfo(const std::string& node_dir) {
+#ifdef __linux__
+    // node ids may have gaps (offline or cxl memory nodes), take the online ones as listed
+    std::string node_list;
+    std::ifstream online(node_dir + "/online");
+    std::getline(online, node_list);
+    for (auto node : parse_cpu_list(node_list)) {
+        std::ifstream fin(node_dir + "/node" + std::to_string(node) + "/cpulist");
+        if (!fin.is_open()) {
+            continue;
+        }
+        std::string cpu_list;
+        std::getline(fin, cpu_list);
+        auto cpus = parse_cpu_list(cpu_list);
+        // memory only node has no cpu to run workers
+        if (!cpus.empty()) {
+            _node_cpus.push_back(cpus);
+        }
+    }
+#endif
+    if (_node_cpus.empty()) {
+        int cpu_num = std::max(1u, std::thread::hardware_concurrency());
+        _node_cpus.push_back(std::vector<int>());
+        for (int cpu = 0; cpu < cpu_num; ++cpu) {
+            _node_cpus[0].push_back(cpu);
+        }
+    }
+    LOG(INFO) << "numa nodes : " << _node_cpus.size();
+}
+
+const std::vector<int>& NumaInfo::cpus_of_node(int node) const {
+    CHECK_LT(node, _node_cpus.size()) << " numa node " << node << " doesn't exist";
+    return _node_cpus[node];
+}
+
+int NumaInfo::node_of_cpu(int cpu) const {
+    for (int node = 0; node < _node_cpus.size(); ++node) {
+        for (auto node_cpu : _node_cpus[node]) {
+            if (node_cpu == cpu) {
+                return node;
+            }
+        }
+    }
+    return 0;
+}
+
+bool NumaInfo::bind_current_thread(int node) const {
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : cpus_of_node(node)) {
+        CPU_SET(cpu, &cpu_set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+        LOG(WARNING) << " bind thread to numa node " << node << " failed";
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+} /* namespace anakin */
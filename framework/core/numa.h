@@ -0,0 +1,65 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+   
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. 
+*/
+
+#ifndef ANAKIN_NUMA_H
+#define ANAKIN_NUMA_H
+
+#include <vector>
+#include <string>
+#include "framework/core/singleton.h"
+
+namespace anakin {
+
+/**
+ * \brief NUMA topology of host.
+ *  Discovered from /sys/devices/system/node on linux, falls back to one node
+ *  holding all the cpus when it's not available (single-node machines, other systems).
+ *  The online nodes with cpus are numbered from 0 in order of their ids, which may have gaps.
+ */
+class NumaInfo {
+public:
+    explicit NumaInfo(const std::string& node_dir = "/sys/devices/system/node");
+    ~NumaInfo() {}
+
+    /// number of numa nodes, at least 1.
+    int node_num() const { return _node_cpus.size(); }
+
+    /// cpus belong to node.
+    const std::vector<int>& cpus_of_node(int node) const;
+
+    /// node of cpu, 0 if cpu is unknown.
+    int node_of_cpu(int cpu) const;
+
+    /**
+     * \brief bind the calling thread to all the cpus of node,
+     *  memory first touched by the thread after that is allocated on the node.
+     * \return false if binding is not supported or failed.
+     */
+    bool bind_current_thread(int node) const;
+
+private:
+    ///< cpus list of every node.
+    std::vector<std::vector<int> > _node_cpus;
+};
+
+/// parse a cpu (or node) list like "0-3,8,10-11".
+std::vector<int> parse_cpu_list(const std::string& cpu_list);
+
+///< numa topology of host
+using NumaTopology = Singleton<NumaInfo>;
+
+} /* namespace anakin */
+
+#endif
@@ -105,6 +105,16 @@ public:
         return Status::FAIL();
     }
 
+    /** 
+     *  \brief Bind recurrent state tensors for stateful streaming inference, pass nullptr to unbind.
+     *  It's only overrided by recurrent operators (Lstm, Gru), init_* are read before the first step
+     *  and last_* receive the final state (batch_size * hidden_size) of every sequence.
+     */
+    virtual Status BindState(Tensor4dPtr<Ttype, Dtype> init_hidden, Tensor4dPtr<Ttype, Dtype> init_cell,
+                             Tensor4dPtr<Ttype, Dtype> last_hidden, Tensor4dPtr<Ttype, Dtype> last_cell) {
+        return Status::FAIL(" Target op doesn't hold recurrent state.");
+    }
+
     /** 
      *  \brief Bind parameter pack from graph.
      */
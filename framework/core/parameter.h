@@ -229,6 +229,12 @@ public:
 		_h_inner_tensor->re_alloc(shape);
 	}
 
+	// shape the block without storage, which re_alloc allocates later
+	void set_shape(Shape4d shape) {
+		_d_inner_tensor->set_shape(shape);
+		_h_inner_tensor->set_shape(shape);
+	}
+
     /// Get shape.
     Shape4d shape() const { 
         CHECK(_d_inner_tensor->valid_shape() == _h_inner_tensor->valid_shape()) 
@@ -241,6 +247,11 @@ public:
         return this->shape().count();
     }
 
+    /// number of blocks sharing the storage.
+    long use_count() const {
+        return _h_inner_tensor.use_count();
+    }
+
     ~PBlock() {}
 
 private:
@@ -298,6 +309,11 @@ public:
 		_inner_tensor->re_alloc(shape);
 	}
 
+	// shape the block without storage, which re_alloc allocates later
+	void set_shape(Shape4d shape) {
+		_inner_tensor->set_shape(shape);
+	}
+
     /// Get shape.
     Shape4d shape() {
         return _inner_tensor->valid_shape();
@@ -308,6 +324,11 @@ public:
         return this->shape().count();
     }
 
+    /// number of blocks sharing the storage.
+    long use_count() const {
+        return _inner_tensor.use_count();
+    }
+
     ~PBlock() {}
 
 private:
@@ -364,6 +385,11 @@ public:
 		_inner_tensor->re_alloc(shape);
 	}
 
+	// shape the block without storage, which re_alloc allocates later
+	void set_shape(Shape4d shape) {
+		_inner_tensor->set_shape(shape);
+	}
+
     /// Get shape.
     Shape4d shape() {
         return _inner_tensor->valid_shape();
@@ -374,6 +400,11 @@ public:
         return this->shape().count();
     }
 
+    /// number of blocks sharing the storage.
+    long use_count() const {
+        return _inner_tensor.use_count();
+    }
+
     ~PBlock() {}
 
 private:
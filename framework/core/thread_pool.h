@@ -103,12 +103,18 @@ public:
       _stop = true;
     }
 
-     ~ThreadPool() {
+    /// Stop the pool and wait for the running tasks, the queued ones never run.
+    void join() {
       stop();
       this->_cv.notify_all();
       for(auto & worker: _workers){ 
           worker.join(); 
       }
+      _workers.clear();
+    }
+
+     ~ThreadPool() {
+      join();
     }
 
 private:
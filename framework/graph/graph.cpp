@@ -126,6 +126,72 @@ Status Graph<Ttype, Dtype, Ptype>::RegistAllOut() {
     return Status::OK();;
 }
 
+template<typename Ttype, DataType Dtype, Precision Ptype>
+NodePtr<Ttype, Dtype, Ptype> Graph<Ttype, Dtype, Ptype>::merged_node(node& node_merge,
+                                                                     std::string pattern_name) {
+    auto it = std::find(node_merge.mergeNodeNames.begin(), node_merge.mergeNodeNames.end(), pattern_name);
+    if (it == node_merge.mergeNodeNames.end()) {
+        return nullptr;
+    }
+    return (*this)[node_merge.mergeNodes[it - node_merge.mergeNodeNames.begin()].name];
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+bool Graph<Ttype, Dtype, Ptype>::depthwise_pointwise_fusible(node& node_merge) {
+    // a depthwise conv and its 1x1 conv only fuse on x86, which has the fused kernel
+    if (!std::is_same<Ttype, X86>::value) {
+        return false;
+    }
+    auto pw_node = merged_node(node_merge, "conv_1");
+    if (pw_node == nullptr) {
+        return false;
+    }
+    auto& dw_node = (*this)[node_merge.name];
+    using pblock_type = PBlock<typename DataTypeWarpper<Dtype>::type, Ttype>;
+    std::string group_name = "group";
+    std::string filter_num_name = "filter_num";
+    std::string weight_name = "weight_1";
+    std::string kernel_size_name = "kernel_size";
+    std::string strides_name = "strides";
+    std::string padding_name = "padding";
+    auto dw_weights = dw_node->template get_attr<pblock_type>(weight_name);
+    bool depthwise = dw_node->template get_attr<int>(group_name)
+                     == dw_node->template get_attr<int>(filter_num_name)
+                     && dw_weights.shape()[1] == 1;
+    auto kernel_size = pw_node->template get_attr<PTuple<int>>(kernel_size_name);
+    auto strides = pw_node->template get_attr<PTuple<int>>(strides_name);
+    auto padding = pw_node->template get_attr<PTuple<int>>(padding_name);
+    bool pointwise = pw_node->template get_attr<int>(group_name) == 1
+                     && kernel_size[0] == 1 && kernel_size[1] == 1
+                     && strides[0] == 1 && strides[1] == 1
+                     && padding[0] == 0 && padding[1] == 0;
+    return depthwise && pointwise;
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+bool Graph<Ttype, Dtype, Ptype>::dense_softmax_argmax_fusible(node& node_merge) {
+    // only nv and x86 have the fused op
+    if (!std::is_same<Ttype, X86>::value && !std::is_same<Ttype, NV>::value) {
+        return false;
+    }
+    if (!std::is_same<Ttype, X86>::value) {
+        return true;
+    }
+    // and the x86 kernel takes the softmax and argmax along the dense outputs only
+    auto softmax_node = merged_node(node_merge, "softmax_0");
+    auto argmax_node = merged_node(node_merge, "argmax_0");
+    if (softmax_node == nullptr || argmax_node == nullptr) {
+        return false;
+    }
+    std::string axis_name = "axis";
+    std::string axis_term_name = "axis_term";
+    if (softmax_node->template get_attr<int>(axis_name) != 1) {
+        return false;
+    }
+    return !argmax_node->template get_attr<bool>(axis_term_name)
+           || argmax_node->template get_attr<int>(axis_name) == 1;
+}
+
 template<typename Ttype, DataType Dtype, Precision Ptype>
 Status Graph<Ttype, Dtype, Ptype>::Optimize() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
     std::unique_lock<std::mutex> lock(this->_mut);
@@ -148,6 +214,16 @@ Status Graph<Ttype, Dtype, Ptype>::Optimize() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
         } else {
             DLOG(WARNING) << "Exe the graph fusion and combination [ SUPPORT IN-ORDER PATTERM ]";
             // TODO ...
+            // some fusions only pay off, or only run, on some targets and parameters
+            _vgraph->set_fusion_filter([this](const std::string& fusion_op_name, node& node_merge) {
+                if (fusion_op_name == "DepthwisePointwiseConv") {
+                    return depthwise_pointwise_fusible(node_merge);
+                }
+                if (fusion_op_name == "DenseSoftmaxArgmax") {
+                    return dense_softmax_argmax_fusible(node_merge);
+                }
+                return true;
+            });
             auto in_ordered_fusion_op_name_vec = FusionOpRegister::Global().get_list_op_name_in_fusion_order_of(IN_ORDER);
             for (auto& fusion_name : in_ordered_fusion_op_name_vec) {
                 LOG(INFO) << " processing in-ordered fusion : " << fusion_name;
@@ -156,25 +232,38 @@ Status Graph<Ttype, Dtype, Ptype>::Optimize() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
 
             DLOG(WARNING) <<
                           "Schedule the vgraph for memory optimization and exec lanes ,as well as sync flags.";
-            // schedule for exec order
-            Scheduler scheduler;
-            scheduler.RegIOResource(_vgraph);
-            scheduler.Run();
-
-			_nodes_exec_order = scheduler.get_exec_node_in_order();
-
-
-#if 1
-            // get node exec in order
-            _nodes_exec_order = scheduler.get_exec_node_in_order();
-#else		// enable conv+eltwise fusion
-            // optimization
-			ConvElsFusionScheduler conv_eltwise_fusion_scheduler;
-			conv_eltwise_fusion_scheduler.RegIOResource(_vgraph);
-			conv_eltwise_fusion_scheduler.Run();
-			// get node exec in order
-			//_nodes_exec_order = conv_eltwise_fusion_scheduler.get_exec_node_in_order();
-#endif
+            if (std::is_same<Ttype, X86>::value && _conv_eltwise_fusion) {
+                // conv+eltwise fusion, the x86 NCHW conv accumulates a residual sum into its output
+                ConvElsFusionScheduler conv_eltwise_fusion_scheduler;
+                // and only a plain sum folds into the conv accumulators
+                conv_eltwise_fusion_scheduler.set_eltwise_filter([this](node& eltwise_node) {
+                    auto& node_p = (*this)[eltwise_node.name];
+                    std::string type_name = "type";
+                    std::string coeff_name = "coeff";
+                    if (node_p->inspect_attr("chain")
+                            || node_p->template get_attr<std::string>(type_name) != "Add") {
+                        return false;
+                    }
+                    auto coeff = node_p->template get_attr<PTuple<float>>(coeff_name);
+                    for (auto c : coeff.vector()) {
+                        if (c != 1.f) {
+                            return false;
+                        }
+                    }
+                    return true;
+                });
+                conv_eltwise_fusion_scheduler.RegIOResource(_vgraph);
+                conv_eltwise_fusion_scheduler.Run();
+                // get node exec in order, the fused convs run after their residuals
+                _nodes_exec_order = conv_eltwise_fusion_scheduler.get_exec_node_in_order();
+            } else {
+                // schedule for exec order
+                Scheduler scheduler;
+                scheduler.RegIOResource(_vgraph);
+                scheduler.Run();
+                // get node exec in order
+                _nodes_exec_order = scheduler.get_exec_node_in_order();
+            }
 			// optimization again
             MemoryScheduler mem_scheduler;
             mem_scheduler.RegIOResource(_vgraph);
@@ -185,8 +274,8 @@ Status Graph<Ttype, Dtype, Ptype>::Optimize() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
 
             // set info for graph
             statistics.set_info<IS_OPTIMIZED>(true);
-            DLOG(INFO) << " model size : " << graph::GraphGlobalMem<Ttype>::Global().get_sum_mbyte() << " mb ";
-            statistics.set_info<MODEL_MEM>(graph::GraphGlobalMem<Ttype>::Global().get_sum_mbyte());
+            DLOG(INFO) << " model size : " << _weights_arena->get_sum_mbyte() << " mb ";
+            statistics.set_info<MODEL_MEM>(_weights_arena->get_sum_mbyte());
 
             DLOG(WARNING) << "Restore graph from virtual graph of ... ";
             restore_from_vgraph(_vgraph);
@@ -194,6 +283,8 @@ Status Graph<Ttype, Dtype, Ptype>::Optimize() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
 
         _has_graph_optimized = true;
     }
+    // fill the weights still used after optimization
+    _weights_arena->materialize();
 
 #ifdef ENABLE_DEBUG
     auto print_edge_debug_string = [](Edge<Ttype, Dtype>& edge) {
@@ -414,6 +505,8 @@ Status Graph<Ttype, Dtype, Ptype>::CopyFrom(Graph<Ttype, Dtype, Ptype>& graph) {
 	 _outs = graph._outs;
 	// get statistic
 	statistics = graph.statistics;
+    // share the weights
+    _weights_arena = graph._weights_arena;
     return Status::OK();
 }
 
@@ -424,8 +517,9 @@ Status Graph<Ttype, Dtype, Ptype>::Clean() {
     // delete _vgraph pointer
     delete _vgraph;
     _vgraph = nullptr;
-    // clenn all weights
-    graph::GraphGlobalMem<Ttype>::Global().clean_all();
+    // release the weights, the arena is freed once no copied graph refers to it.
+    _weights_arena = std::make_shared<GraphWeightsArena<Ttype>>();
+    _has_graph_optimized = false;
 
     return Status::OK();
 }
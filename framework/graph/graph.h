@@ -40,11 +40,13 @@ public:
     Graph():GraphBase<std::string, 
                       NodePtr<Ttype, Dtype, Ptype>, 
                       Tensor4dPtr<Ttype, Dtype>, 
-                      Edge<Ttype, Dtype> >() {}
+                      Edge<Ttype, Dtype> >(),
+             _weights_arena(std::make_shared<GraphWeightsArena<Ttype>>()) {}
     Graph(size_t size):GraphBase<std::string, 
                                  NodePtr<Ttype, Dtype, Ptype>, 
                                  Tensor4dPtr<Ttype, Dtype>, 
-                                 Edge<Ttype, Dtype> >(size) {}
+                                 Edge<Ttype, Dtype> >(size),
+                       _weights_arena(std::make_shared<GraphWeightsArena<Ttype>>()) {}
 
     ~Graph() {
         if(_vgraph) { 
@@ -64,6 +66,24 @@ public:
     std::vector<std::string>& get_ins() { return _ins; }
     std::vector<std::string>& get_outs() { return _outs; }
 
+    /// weights arena of this graph, shared with the graphs copied from it.
+    GraphWeightsArenaPtr<Ttype> weights_arena() { return _weights_arena; }
+
+    /**
+     * \brief defer filling weights from model to the end of Optimize (call before load).
+     *  weights of nodes removed by optimization are never converted.
+     */
+    void set_lazy_weights(bool lazy) { _lazy_weights = lazy; }
+    bool lazy_weights() { return _lazy_weights; }
+
+    /**
+     * \brief whether Optimize folds a residual eltwise sum into the conv feeding it (x86 only, call before Optimize).
+     *  on by default, the NCHW convs of x86 nets accumulate the sum into their output.
+     *  the jit kernels of the blocked layouts don't take a sum, saber rejects it there.
+     */
+    void set_conv_eltwise_fusion(bool fuse) { _conv_eltwise_fusion = fuse; }
+    bool conv_eltwise_fusion() { return _conv_eltwise_fusion; }
+
     /// Judge if graph is directed graph, must be override.
     virtual bool directed() final { return true; }
 
@@ -113,7 +133,8 @@ public:
 
     /**
      * \biref shallow copy of graph
-     * note: only copy parameters and architecture, but not the weights
+     * note: only copy parameters and architecture, but not the weights.
+     *       the weights arena is shared, so weights live as long as any copy does.
     */
     Status CopyFrom(Graph<Ttype, Dtype, Ptype>& graph);
 
@@ -126,6 +147,13 @@ private:
      */
     Status Clean();
 
+    /// the graph node merged into node_merge as pattern_name, nullptr if none.
+    NodePtr<Ttype, Dtype, Ptype> merged_node(node& node_merge, std::string pattern_name);
+
+    /// fusion filters of Optimize, whether the target runs the fused op for these parameters.
+    bool depthwise_pointwise_fusible(node& node_merge);
+    bool dense_softmax_argmax_fusible(node& node_merge);
+
 private:
     ///< _vgraph stand for graph. default nullptr
     VGraph* _vgraph{nullptr};
@@ -148,6 +176,13 @@ private:
     ///< _registed_outs:outs that needs to be exported
     std::vector<std::pair<std::string, std::string>> _registed_outs;
 
+    ///< _weights_arena owns the weights parsed for this graph
+    GraphWeightsArenaPtr<Ttype> _weights_arena;
+    ///< _lazy_weights decide whether weights are filled after optimization
+    bool _lazy_weights{false};
+    ///< _conv_eltwise_fusion decide whether Optimize fuses residual sums into convs
+    bool _conv_eltwise_fusion{true};
+
 
 private:
     /// this used to holder the name of target parsed model.
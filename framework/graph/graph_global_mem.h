@@ -18,6 +18,11 @@
 
 #include <vector>
 #include <mutex>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <algorithm>
 #include "framework/core/singleton.h"
 #include "framework/core/parameter.h"
 #include "utils/logger/logger.h"
@@ -35,7 +40,7 @@ template<typename Ttype>
 class GraphGlobalMemBase {
 public:
     GraphGlobalMemBase() {}
-    ~GraphGlobalMemBase() {}
+    ~GraphGlobalMemBase() { clean_all(); }
 
     /// create Block memory
     template<DataType Dtype>
@@ -46,6 +51,90 @@ public:
         return block_p;
     }
 
+    /// create empty Block, the storage is allocated when it's filled
+    template<DataType Dtype>
+    PBlock<typename DataTypeWarpper<Dtype>::type, Ttype>* new_block() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::unique_lock<std::mutex> lock(this->_mut); 
+        PBlock<typename DataTypeWarpper<Dtype>::type, Ttype>* block_p = new PBlock<typename DataTypeWarpper<Dtype>::type, Ttype>();
+        _push_mem_pool(block_p, DataTypeWarpper<Dtype>()); 
+        return block_p;
+    }
+
+    /// defer filling of fp32 block to materialize()
+    void defer_fill(PBlock<float, Ttype>* block_p, std::function<void(PBlock<float, Ttype>&)> fill) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::unique_lock<std::mutex> lock(this->_mut); 
+        _pending_fills.emplace_back(block_p, fill);
+    }
+
+    /// keep the source of deferred fills (e.g. the parsed model) alive until materialize()
+    void hold_source(std::shared_ptr<void> source) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::unique_lock<std::mutex> lock(this->_mut); 
+        if (!_pending_fills.empty()) {
+            _pending_sources.push_back(source);
+        }
+    }
+
+    /// get number of blocks waiting to be filled
+    size_t get_pending_size() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::unique_lock<std::mutex> lock(this->_mut); 
+        return _pending_fills.size();
+    }
+
+    /**
+     * \brief fill the deferred blocks in parallel, one task per block.
+     *  Blocks no node refers to any more (e.g. nodes removed by optimization) are released unfilled.
+     * \param thread_num number of threads, 0 means all the cpus.
+     */
+    void materialize(int thread_num = 0) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::vector<std::pair<PBlock<float, Ttype>*, std::function<void(PBlock<float, Ttype>&)> > > pending;
+        std::vector<std::shared_ptr<void> > sources;
+        {
+            std::unique_lock<std::mutex> lock(this->_mut); 
+            pending.swap(_pending_fills);
+            sources.swap(_pending_sources);
+        }
+        if (pending.empty()) {
+            return;
+        }
+        std::vector<std::pair<PBlock<float, Ttype>*, std::function<void(PBlock<float, Ttype>&)> > > tasks;
+        std::vector<PBlock<float, Ttype>*> unused;
+        for (auto& fill : pending) {
+            // the pool holds one reference, any other comes from a node
+            if (fill.first->use_count() > 1) {
+                tasks.push_back(fill);
+            } else {
+                unused.push_back(fill.first);
+            }
+        }
+        if (thread_num <= 0) {
+            thread_num = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_num = std::min<int>(thread_num, tasks.size());
+        std::atomic<size_t> next_task{0};
+        auto run_tasks = [&]() {
+            for (size_t i = next_task++; i < tasks.size(); i = next_task++) {
+                tasks[i].second(*tasks[i].first);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int i = 1; i < thread_num; i++) {
+            threads.emplace_back(run_tasks);
+        }
+        run_tasks();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (!unused.empty()) {
+            std::unique_lock<std::mutex> lock(this->_mut);
+            for (auto block_p : unused) {
+                _fp32_mem_pool.erase(std::remove(_fp32_mem_pool.begin(), _fp32_mem_pool.end(), block_p), 
+                                     _fp32_mem_pool.end());
+                delete block_p;
+            }
+        }
+        DLOG(INFO) << " materialized weights blocks : " << tasks.size() << ", released : " << unused.size();
+    }
+
     /// get sum size in m-btyes
     size_t get_sum_mbyte() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
         std::unique_lock<std::mutex> lock(this->_mut); 
@@ -117,14 +206,30 @@ private:
     std::vector<PBlock<typename DataTypeWarpper<AK_HALF>::type, Ttype>* > _fp16_mem_pool GUARDED_BY(_mut);
     ///< _fp32_mem_pool stand for fp32 type memory
     std::vector<PBlock<typename DataTypeWarpper<AK_FLOAT>::type, Ttype>* > _fp32_mem_pool GUARDED_BY(_mut);
+    ///< _pending_fills stand for fp32 blocks waiting to be filled
+    std::vector<std::pair<PBlock<float, Ttype>*, std::function<void(PBlock<float, Ttype>&)> > > _pending_fills GUARDED_BY(_mut);
+    ///< _pending_sources keep the data of pending fills alive
+    std::vector<std::shared_ptr<void> > _pending_sources GUARDED_BY(_mut);
     ///< _mut
     std::mutex _mut;
 };
 
 /// graph memory pool for graph weights and large parameter
+/// Deprecated: weights are owned by the arena of the graph they belong to.
 template<typename Ttype>
 using GraphGlobalMem = Singleton<GraphGlobalMemBase<Ttype>>;
 
+/**
+ * \brief weights arena of one loaded model.
+ *  It's refcounted: the graph and every graph copied from it (e.g. the graph inside a Net)
+ *  hold a reference, the weights are released when the last one goes away.
+ */
+template<typename Ttype>
+using GraphWeightsArena = GraphGlobalMemBase<Ttype>;
+
+template<typename Ttype>
+using GraphWeightsArenaPtr = std::shared_ptr<GraphWeightsArena<Ttype>>;
+
 /** 
  * \brief InFO enum
  * using number to stand for memory and other info of anakin 
@@ -51,6 +51,46 @@ REGISTER_GRAPH_FUSION_PATTERN(ConvBatchnormScaleReluPool)
 .AddConnect("relu_0", "pooling_0")
 .CreatePattern([](VGraph* graph) {});
 
+/// mobilenet v1 block, a depthwise conv and the 1x1 conv after it,
+/// Graph::Optimize checks the conv kinds, which op names can't tell
+REGISTER_GRAPH_FUSION_PATTERN(DepthwisePointwiseConvRelu)
+.name("DepthwisePointwiseConv")
+.Type(IN_ORDER)
+.AddOpNode("conv_0",  "Convolution")
+.AddOpNode("batchnorm_0", "BatchNorm")
+.AddOpNode("scale_0", "Scale")
+.AddOpNode("relu_0", "ReLU")
+.AddOpNode("conv_1",  "Convolution")
+.AddOpNode("batchnorm_1", "BatchNorm")
+.AddOpNode("scale_1", "Scale")
+.AddOpNode("relu_1", "ReLU")
+.AddConnect("conv_0", "batchnorm_0")
+.AddConnect("batchnorm_0", "scale_0")
+.AddConnect("scale_0", "relu_0")
+.AddConnect("relu_0", "conv_1")
+.AddConnect("conv_1", "batchnorm_1")
+.AddConnect("batchnorm_1", "scale_1")
+.AddConnect("scale_1", "relu_1")
+.CreatePattern([](VGraph* graph) {});
+
+/// mobilenet v2 linear bottleneck, the same without the last relu
+REGISTER_GRAPH_FUSION_PATTERN(DepthwisePointwiseConv)
+.Type(IN_ORDER)
+.AddOpNode("conv_0",  "Convolution")
+.AddOpNode("batchnorm_0", "BatchNorm")
+.AddOpNode("scale_0", "Scale")
+.AddOpNode("relu_0", "ReLU")
+.AddOpNode("conv_1",  "Convolution")
+.AddOpNode("batchnorm_1", "BatchNorm")
+.AddOpNode("scale_1", "Scale")
+.AddConnect("conv_0", "batchnorm_0")
+.AddConnect("batchnorm_0", "scale_0")
+.AddConnect("scale_0", "relu_0")
+.AddConnect("relu_0", "conv_1")
+.AddConnect("conv_1", "batchnorm_1")
+.AddConnect("batchnorm_1", "scale_1")
+.CreatePattern([](VGraph* graph) {});
+
 REGISTER_GRAPH_FUSION_PATTERN(ConvBatchnormScaleRelu)
 .Type(IN_ORDER)
 .AddOpNode("conv_0",  "Convolution")
@@ -78,6 +118,22 @@ REGISTER_GRAPH_FUSION_PATTERN(ConvBatchnorm)
 .AddConnect("conv_0", "batchnorm_0")
 .CreatePattern([](VGraph* graph) {});
 
+REGISTER_GRAPH_FUSION_PATTERN(DenseSoftmaxArgmax)
+.Type(IN_ORDER)
+.AddOpNode("dense_0", "Dense")
+.AddOpNode("softmax_0", "Softmax")
+.AddOpNode("argmax_0", "Argmax")
+.AddConnect("dense_0", "softmax_0")
+.AddConnect("softmax_0", "argmax_0")
+.CreatePattern([](VGraph* graph) {});
+
+REGISTER_GRAPH_FUSION_PATTERN(DenseMultiHeadAttention)
+.Type(IN_ORDER)
+.AddOpNode("dense_0", "Dense")
+.AddOpNode("attention_0", "MultiHeadAttention")
+.AddConnect("dense_0", "attention_0")
+.CreatePattern([](VGraph* graph) {});
+
 REGISTER_GRAPH_FUSION_PATTERN(EltwiseRelu)
 .Type(IN_ORDER)
 .AddOpNode("eltwise_0", "Eltwise")
@@ -50,6 +50,17 @@ std::unordered_map<Fusion, std::function<int(VGraph*, Pattern*)>, FusionHash> Fu
                         pattern_node_name_saves.push_back(pattern_next_node.name);
                     }
 
+                    // the vgraph chain ended before the pattern
+                    if (pattern_arc_out_its.size()) {
+                        return -1;
+                    }
+
+                    node_merge.mergeNodeNames = pattern_node_name_saves;
+                    // conditions the op names of the pattern can't express
+                    if (!vgraph->check_fusion(param_pattern->fusion_op_name(), node_merge)) {
+                        return -1;
+                    }
+
                     // need to replace
                     node_merge.opName = param_pattern->fusion_op_name();
                     // pattern ins and outs in original vgraph
@@ -85,7 +96,6 @@ std::unordered_map<Fusion, std::function<int(VGraph*, Pattern*)>, FusionHash> Fu
 						vgraph->add_out_arc(arc);
 					}
 
-                    node_merge.mergeNodeNames = pattern_node_name_saves;
                     param_node = node_merge;
 
                     return 0;
@@ -5,36 +5,29 @@ namespace anakin {
 namespace graph {
 
 bool ConvElsFusionScheduler::callable(node& node_arg) {
+	// the conv launched last of the two eltwise inputs accumulates into the other one,
+	// so a conv waits for the other input unless that is a conv waiting for it.
+	std::string fused_eltwise;
 	if(_helper.has_node(node_arg)) {
-		auto& node_arc_out_its = _vgraph->get_out_arc_its(node_arg.name);	
-		auto& node_arc_in_its = _vgraph->get_in_arc_its(node_arg.name);
-		CHECK_EQ(node_arc_out_its.size(), 1)<<"Conv+eltwise analysis: Convolution like op should have only one output.";
-		auto& node_next = (*_vgraph)[node_arc_out_its[0]->top()];
-		if(node_next.opName == "EltwiseRelu" /*|| node_next.opName == "Eltwise"*/) {
+		auto& node_arc_out_its = _vgraph->get_out_arc_its(node_arg.name);
+		if(node_arc_out_its.size() == 1) {
+			auto& node_next = (*_vgraph)[node_arc_out_its[0]->top()];
 			auto& elt_node_in_its = _vgraph->get_in_arc_its(node_next.name);
-			for(auto& it : elt_node_in_its) {
-				if(it->bottom() != node_arg.name) {
-					if(!_helper.need_wait(it->bottom())) {
-						_helper.push_wait(node_arg.name);
-						if(!this->have_launched((*_vgraph)[it->bottom()])) {
-							/*std::vector<io> io_in; 
-							for (auto& arc_it : node_arc_in_its) { 
-								io_in.push_back(arc_it->weight()); 
-							}
-							_helper.set_holder(io_in, _vgraph);*/
-							//_helper.register_pair(node_arg.name, node_next.name);
-							if ((*_vgraph)[it->bottom()].opName == "Split") { 
-								_helper.register_pair(node_arg.name, node_next.name); } 
-							else { 
-								_helper.register_pair(it->bottom(), node_next.name); 
-							}
-
-							//_helper.register_pair(it->bottom(), node_next.name);
+			if(node_next.opName == "EltwiseRelu" && elt_node_in_its.size() == 2
+					&& (!_eltwise_filter || _eltwise_filter(node_next))) {
+				std::string other = elt_node_in_its[0]->bottom() == node_arg.name ?
+						elt_node_in_its[1]->bottom() : elt_node_in_its[0]->bottom();
+				if(other != node_arg.name) {
+					if(!this->have_launched((*_vgraph)[other])) {
+						if(!_helper.need_wait(other)) {
+							_helper.push_wait(node_arg.name);
 							return false;
-						} else {
-							_helper.release(node_arg.name);
 						}
-						break;
+					} else {
+						_helper.release(node_arg.name);
+						if(can_accumulate(other, node_next.name)) {
+							fused_eltwise = node_next.name;
+						}
 					}
 				}
 			}
@@ -49,7 +42,39 @@ bool ConvElsFusionScheduler::callable(node& node_arg) {
         io_in.push_back(arc_it->weight());
     }
 
-    return this->check_access(io_in);
+    if(!this->check_access(io_in)) {
+		return false;
+	}
+	if(!fused_eltwise.empty()) {
+		_helper.register_pair(node_arg.name, fused_eltwise);
+	}
+	return true;
+}
+
+bool ConvElsFusionScheduler::can_accumulate(const std::string& producer, const std::string& eltwise_name) {
+	for(auto& out_pair : _vgraph->get_registed_outs()) {
+		if(out_pair.first == eltwise_name || out_pair.first == producer) {
+			return false;
+		}
+	}
+	auto& node_producer = (*_vgraph)[producer];
+	if(node_producer.opName == "Split") {
+		// the residual is the split input, every other reader of it must be done
+		for(auto& arc_it : _vgraph->get_in_arc_its(producer)) {
+			if((*_vgraph)[arc_it->bottom()].opName == "Input") {
+				return false;
+			}
+		}
+		for(auto& arc_it : _vgraph->get_out_arc_its(producer)) {
+			if(arc_it->top() != eltwise_name && !this->have_launched((*_vgraph)[arc_it->top()])) {
+				return false;
+			}
+		}
+		return true;
+	}
+	// other ops sharing their input would expose it to the accumulation
+	return node_producer.opName != "Input" && node_producer.opName != "Reshape"
+		&& node_producer.opName != "Flatten" && node_producer.opName != "Gather";
 }
 
 void ConvElsFusionScheduler::Run() {
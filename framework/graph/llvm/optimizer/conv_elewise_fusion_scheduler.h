@@ -16,6 +16,7 @@
 #ifndef ANAKIN_LLVM_SCHEDULER_CONV_ELEWISE_FUSION_H
 #define ANAKIN_LLVM_SCHEDULER_CONV_ELEWISE_FUSION_H
 
+#include <functional>
 #include "utils/logger/logger.h"
 #include "framework/graph/llvm/schedule_base.h"
 #include "framework/graph/llvm/virtual_graph.h"
@@ -117,6 +118,9 @@ public:
 
 /**
  *  \brief Dependency scheduler for analysing the possibility of conv+eltwise fusion in graph
+ *  A ConvBatchnormScale feeding an EltwiseRelu is merged with it and launched after the other
+ *  eltwise input, the eltwise turns into a Gather sharing one buffer for all its inputs,
+ *  so the conv accumulates into the residual the other input has written.
  */
 class ConvElsFusionScheduler : public Scheduler {
 public:
@@ -129,9 +133,16 @@ public:
 	/// run scheduler
     virtual void Run();
 
+	/// only the eltwise nodes the filter accepts are fused, e.g. those the target's convs can fold
+	void set_eltwise_filter(std::function<bool(node&)> filter) { _eltwise_filter = filter; }
+
+private:
+	/// whether a conv may accumulate into the output of producer, the other input of the eltwise
+	bool can_accumulate(const std::string& producer, const std::string& eltwise_name);
 
 private:
 	ConvElsFusionHelper _helper;
+	std::function<bool(node&)> _eltwise_filter;
 };
 
 
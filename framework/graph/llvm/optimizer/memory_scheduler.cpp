@@ -41,7 +41,7 @@ void IOBlockResource::free_self(std::vector<io>& self_shared_edges, VGraph* vgra
             if (_self_lock_next_tree[*it].size() == 0) {
                 //_free.push(*it);
                 push_free(*it, vgraph_p);
-                it = _lock.erase(it);
+                it = _self_lock.erase(it);
             } else {
                 ++it;
             }
@@ -225,7 +225,20 @@ void MemoryScheduler::launch(node& node_arg) {
 					break;
 				}
 			}
+			// a conv fused with this gather already accumulates into the residual, keep its block
+			for(int i=0; i < node_arc_in_its.size(); i++) {
+				io residual;
+				if(residual_io((*_vgraph)[node_arc_in_its[i]->bottom()], residual)) {
+					for(int j=0; j < node_arc_in_its.size(); j++) {
+						if(node_arc_in_its[j]->weight() == residual) {
+							selected = j;
+						}
+					}
+				}
+			}
 			_io_block_res.push_self_lock(node_arc_in_its[selected]->weight());
+			// the block is released once the consumers of the outputs are done
+			std::vector<io> io_next = io_out;
 			for(int i=0; i<node_arc_in_its.size(); i++) {
 				if(i != selected) {
 					io_out.push_back(node_arc_in_its[i]->weight());
@@ -239,7 +252,7 @@ void MemoryScheduler::launch(node& node_arg) {
                 	io_tmp.share_from = node_arc_in_its[selected]->weight().name;
             	}
 			}
-			_io_block_res.reg_self_lock_tree(node_arc_in_its[selected]->weight(), io_out); 
+			_io_block_res.reg_self_lock_tree(node_arc_in_its[selected]->weight(), io_next); 
 			_io_block_res.map_ios_to_vgraph(io_out, _vgraph); // map changes to _vgraph
 		} else {
 			// original impl
@@ -262,7 +275,16 @@ void MemoryScheduler::launch(node& node_arg) {
 			_io_block_res.map_ios_to_vgraph(io_out, _vgraph); // map changes to _vgraph
 		}
     } else {
-        _io_block_res.lock(io_out); // lock out
+        io residual;
+        if (residual_io(node_arg, residual)) {
+            // the conv accumulates into the residual of the eltwise fused with it
+            for (auto& io_tmp : io_out) {
+                io_tmp.shared = true;
+                io_tmp.share_from = residual.shared ? residual.share_from : residual.name;
+            }
+        } else {
+            _io_block_res.lock(io_out); // lock out
+        }
         _io_block_res.map_ios_to_vgraph(io_out, _vgraph); // map changes to _vgraph
         auto node_arc_in_its = _vgraph->get_in_arc_its(node_arg.name);
         std::vector<io> io_in;
@@ -283,6 +305,24 @@ void MemoryScheduler::launch(node& node_arg) {
     }
 }
 
+bool MemoryScheduler::residual_io(node& node_arg, io& residual) {
+    auto& merge_names = (*_vgraph)[node_arg.name].mergeNodeNames;
+    if (std::find(merge_names.begin(), merge_names.end(), "merge") == merge_names.end()) {
+        return false;
+    }
+    auto& node_arc_out_its = _vgraph->get_out_arc_its(node_arg.name);
+    if (node_arc_out_its.size() != 1 || (*_vgraph)[node_arc_out_its[0]->top()].opName != "Gather") {
+        return false;
+    }
+    for (auto& arc_it : _vgraph->get_in_arc_its(node_arc_out_its[0]->top())) {
+        if (arc_it->bottom() != node_arg.name) {
+            residual = arc_it->weight();
+            return true;
+        }
+    }
+    return false;
+}
+
 void MemoryScheduler::set_fix_io(std::vector<io>& io_vec) {
     for (auto it = io_vec.begin(); it != io_vec.end();) {
         if (this->is_fixed(*it)) {
@@ -116,6 +116,9 @@ public:
 
     /// set fix io
     void set_fix_io(std::vector<io>&);
+
+    /// the residual input of the gather a conv is fused with by ConvElsFusionScheduler
+    bool residual_io(node& node_arg, io& residual);
     
     /// ...TODO
     //
@@ -16,6 +16,7 @@
 #ifndef ANAKIN_LLVM_VIRTUAL_GRAPH_H
 #define ANAKIN_LLVM_VIRTUAL_GRAPH_H
 
+#include <functional>
 #include "framework/core/parameter.h"
 #include "framework/graph/llvm/base.h"
 #include "utils/logger/logger.h"
@@ -166,6 +167,14 @@ public:
     /// register the arc outs 
     void register_outs(std::string, std::string);
 
+    /// set the filter deciding whether a matched pattern is fused, by fusion op name and merged node
+    void set_fusion_filter(std::function<bool(const std::string&, node&)> filter) { _fusion_filter = filter; }
+
+    /// check if the matched pattern may be replaced by its fusion op, true without a filter
+    bool check_fusion(const std::string& fusion_op_name, node& node_merge) {
+        return !_fusion_filter || _fusion_filter(fusion_op_name, node_merge);
+    }
+
     std::vector<std::pair<std::string, std::string>>& get_registed_outs() { return _registed_outs; }
 
 	bool has_exec_order() { return _nodes_exec_order.size() == 0 ? false : true; }
@@ -179,6 +188,8 @@ private:
     std::vector<std::pair<std::string, std::string>> _registed_outs;
 	///< node execute order
 	std::vector<std::string> _nodes_exec_order;
+    ///< _fusion_filter :target or attribute conditions of the fusion patterns
+    std::function<bool(const std::string&, node&)> _fusion_filter;
 };
 
 
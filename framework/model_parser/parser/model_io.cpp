@@ -143,20 +143,25 @@ NodeIO<Ttype, Dtype, Ptype>& NodeIO<Ttype, Dtype, Ptype>::operator>>(const NodeP
                     saber_shape[i] = shape.dim().value()[i];
                 }
 
-                auto* block = graph::GraphGlobalMem<Ttype>::Global().template new_block<AK_FLOAT>(saber_shape);
-                // fill data to block
-                float* cpu_data = static_cast<float*>(block->h_tensor().mutable_data());
-
-                for (int i = 0; i < data.size(); i++) {
-                    cpu_data[i] = data.f()[i];
+                // the storage is allocated and filled later by the arena, in parallel with other weights,
+                // the shape is known right away as optimization looks at it before.
+                CHECK_LE(data.size(), data.f().size()) << "Weights parameter " << key << " has not enough data.";
+                auto* block = _weights_arena->template new_block<AK_FLOAT>();
+                if (saber_shape.count() > 0) {
+                    block->set_shape(saber_shape);
                 }
-
+                const float* src = data.f().data();
+                size_t count = data.size();
+                _weights_arena->defer_fill(block, [saber_shape, src, count](PBlock<float, Ttype>& fill_block) {
+                    fill_block.re_alloc(saber_shape);
+                    memcpy(fill_block.h_tensor().mutable_data(), src, sizeof(float) * count);
 #ifdef USE_CUDA
-                //! map cpu data to GPU
-                //block->tensor().get_gpu_data();
-                block->d_tensor().set_shape(saber_shape);
-                block->d_tensor().copy_from(block->h_tensor());
+                    //! map cpu data to GPU
+                    if (!fill_block.host_only()) {
+                        fill_block.d_tensor().copy_from(fill_block.h_tensor());
+                    }
 #endif
+                });
                 node_p->set_attr(key, *block);
             }
             break;
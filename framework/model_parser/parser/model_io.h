@@ -35,7 +35,9 @@ namespace parser {
 template<typename Ttype, DataType Dtype, Precision Ptype>
 class NodeIO {
 public:
-    NodeIO() {}
+    NodeIO() : _weights_arena(std::make_shared<graph::GraphWeightsArena<Ttype>>()) {}
+    /// weights read from NodeProto are allocated in the given arena
+    explicit NodeIO(graph::GraphWeightsArenaPtr<Ttype> arena) : _weights_arena(arena) {}
     ~NodeIO() {}
 
     size_t size() { return _que.size(); }
@@ -58,6 +60,7 @@ public:
 private:
     std::queue<graph::NodePtr<Ttype, Dtype, Ptype>> _que;
     std::vector<std::string> _que_node_name_in_order;
+    graph::GraphWeightsArenaPtr<Ttype> _weights_arena;
 };
 
 } /* parser */
@@ -109,8 +109,8 @@ Status generate_graph_with_graph_proto(graph::Graph<Ttype, Dtype, Ptype>* graph,
         graph->add_out(out_name);
     }
 
-    // fill the graph with nodes
-    NodeIO<Ttype, Dtype, Ptype> node_io;
+    // fill the graph with nodes, weights go to the arena of the graph
+    NodeIO<Ttype, Dtype, Ptype> node_io(graph->weights_arena());
 
     for (int i = 0; i < graph_proto.nodes().size(); i++) {
         node_io >> graph_proto.nodes()[i];
@@ -118,6 +118,11 @@ Status generate_graph_with_graph_proto(graph::Graph<Ttype, Dtype, Ptype>* graph,
 
     node_io << *graph;
 
+    // copy weights from model in parallel, or leave it to the end of Optimize
+    if (!graph->lazy_weights()) {
+        graph->weights_arena()->materialize();
+    }
+
     // fill the graph with edges
     auto it_in = graph_proto.edges_in().begin();
 
@@ -185,25 +190,34 @@ Status generate_graph_with_graph_proto(graph::Graph<Ttype, Dtype, Ptype>* graph,
 
 template<typename Ttype, DataType Dtype, Precision Ptype>
 Status load(graph::Graph<Ttype, Dtype, Ptype>* graph, const char* model_path) {
-    GraphProto graph_proto;
-    parse_graph_proto(graph_proto, model_path);
-    return generate_graph_with_graph_proto(graph, graph_proto);
+    // lazy weights refer to the model data, the arena holds it until they are filled.
+    std::shared_ptr<GraphProto> graph_proto = std::make_shared<GraphProto>();
+    parse_graph_proto(*graph_proto, model_path);
+    Status ret = generate_graph_with_graph_proto(graph, *graph_proto);
+    graph->weights_arena()->hold_source(graph_proto);
+    return ret;
 }
 
 template<typename Ttype, DataType Dtype, Precision Ptype>
 Status load(graph::Graph<Ttype, Dtype, Ptype>* graph, std::istream* instream) {
 
-    GraphProto graph_proto;
-    parse_graph_proto(graph_proto, instream);
-    return generate_graph_with_graph_proto(graph, graph_proto);;
+    // lazy weights refer to the model data, the arena holds it until they are filled.
+    std::shared_ptr<GraphProto> graph_proto = std::make_shared<GraphProto>();
+    parse_graph_proto(*graph_proto, instream);
+    Status ret = generate_graph_with_graph_proto(graph, *graph_proto);
+    graph->weights_arena()->hold_source(graph_proto);
+    return ret;
 }
 
 template<typename Ttype, DataType Dtype, Precision Ptype>
 Status load(graph::Graph<Ttype, Dtype, Ptype>* graph, const char* buffer, size_t len) {
 
-    GraphProto graph_proto;
-    parse_graph_proto(graph_proto, buffer, len);
-    return generate_graph_with_graph_proto(graph, graph_proto);;
+    // lazy weights refer to the model data, the arena holds it until they are filled.
+    std::shared_ptr<GraphProto> graph_proto = std::make_shared<GraphProto>();
+    parse_graph_proto(*graph_proto, buffer, len);
+    Status ret = generate_graph_with_graph_proto(graph, *graph_proto);
+    graph->weights_arena()->hold_source(graph_proto);
+    return ret;
 }
 
 template<typename Ttype, DataType Dtype, Precision Ptype>
@@ -220,6 +234,9 @@ Status save(graph::Graph<Ttype, Dtype, Ptype>* graph, const char* model_path) {
         return Status::FAIL("File not found");
     }
 
+    // weights must be filled before saving
+    graph->weights_arena()->materialize();
+
     GraphProto graph_proto;
     // TODO...  fill the graph_proto with graph.
     // set graph proto name
@@ -105,7 +105,7 @@ template class DeconvolutionHelper<ARM, AK_FLOAT, Precision::FP32>;
 ANAKIN_REGISTER_OP_HELPER(Deconvolution, DeconvolutionHelper, ARM, AK_FLOAT, Precision::FP32);
 #endif
 
-#if defined(BUILD_LITE)
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
 INSTANCE_DECONV(X86, AK_FLOAT, Precision::FP32);
 template class DeconvolutionHelper<X86, AK_FLOAT, Precision::FP32>;
 ANAKIN_REGISTER_OP_HELPER(Deconvolution, DeconvolutionHelper, X86, AK_FLOAT,
@@ -121,6 +121,9 @@ ANAKIN_REGISTER_OP(Deconvolution)
 #ifdef USE_ARM_PLACE
 .__alias__<ARM, AK_FLOAT, Precision::FP32>("deconvolution")
 #endif
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+.__alias__<X86, AK_FLOAT, Precision::FP32>("deconvolution")
+#endif
 .num_in(1)
 .num_out(1)
 .Args<int>("group", " group of conv ")
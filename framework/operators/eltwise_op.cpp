@@ -31,6 +31,14 @@ Status EltwiseHelper<Ttype, Dtype, Ptype>::InitParam() {
         elt_type = Eltwise_prod;
     }
     saber::EltwiseParam<Tensor4d<Ttype, Dtype> > eltwise_param(elt_type, coeff.vector());
+    // optional fused chain, e.g. ["Mul", "Add"] is (in0 * in1) + in2
+    if (FIND_PARAMETER(chain)) {
+        auto chain = GET_PARAMETER(PTuple<std::string>, chain);
+        Status status = parse_eltwise_chain(chain, eltwise_param.chain_ops);
+        if (!status) {
+            return status;
+        }
+    }
     _param_eltwise = eltwise_param;
     return Status::OK();
 }
@@ -82,7 +90,8 @@ ANAKIN_REGISTER_OP(Eltwise)
 .num_in(1)
 .num_out(1)
 .Args<std::string>("type", " eltwise type( string )")
-.Args<PTuple<float>>("coeff", "coeff of eltwise");
+.Args<PTuple<float>>("coeff", "coeff of eltwise")
+.Args<PTuple<std::string>>("chain", "ops of a fused eltwise chain, one less than inputs");
 
 
 } /* namespace ops */
@@ -29,6 +29,29 @@ namespace ops {
 template<typename Ttype, DataType Dtype, Precision Ptype>
 class EltwiseHelper;
 
+/**
+ * \brief parse the fused chain of an eltwise node, e.g. ["Mul", "Add"] is (in0 * in1) + in2
+ * \param chain stand for the op names of the chain attribute
+ * \param chain_ops stand for the parsed ops, appended in order
+ * \return fail on an op other than Add, Mul (or Multiply) and Max
+ */
+inline Status parse_eltwise_chain(const PTuple<std::string>& chain,
+                                  std::vector<EltwiseType>& chain_ops) {
+    for (auto& op : chain.vector()) {
+        if (op == "Add") {
+            chain_ops.push_back(Eltwise_sum);
+        } else if (op == "Mul" || op == "Multiply") {
+            chain_ops.push_back(Eltwise_prod);
+        } else if (op == "Max") {
+            chain_ops.push_back(Eltwise_max);
+        } else {
+            LOG(ERROR) << "unknown op " << op << " in eltwise chain";
+            return Status::FAIL("unknown op in eltwise chain");
+        }
+    }
+    return Status::OK();
+}
+
 /// pooling op
 /**
  * \brief Eltwise implementation class
@@ -79,8 +79,28 @@ Status ConvBatchnormScaleHelper<Ttype, Dtype, Ptype>::InitParam() {
     /*auto alpha = GET_PARAMETER(float, relu_0_alpha);
     ActivationParam<Tensor4d<Ttype, Dtype>> active_param(Active_relu);//, alpha); // TEMP */
 
-	ConvActiveParam<Tensor4d<Ttype, Dtype>> conv_act_param(_conv_param, batchnorm_param, scale_param); 
-	_param_conv_batchnorm_scale = conv_act_param;
+    // the residual eltwise relu merged by ConvElsFusionScheduler, the output holds the residual
+    if (this->check_attr("merge_type")) {
+        auto type = GET_PARAMETER(std::string, merge_type);
+        auto coeff = GET_PARAMETER(PTuple<float>, merge_coeff);
+        ActivationParam<Tensor4d<Ttype, Dtype>> activation_param(Active_relu);
+        EltwiseType elt_type;
+        if (type == "Add") {
+            elt_type = Eltwise_sum;
+        } else if (type == "Max") {
+            elt_type = Eltwise_max;
+        } else {
+            elt_type = Eltwise_prod;
+        }
+        saber::EltwiseParam<Tensor4d<Ttype, Dtype>> eltwise_param(elt_type, coeff.vector());
+        EltwiseActiveParam<Tensor4d<Ttype, Dtype>> eltwise_relu_param(eltwise_param, activation_param);
+        ConvActiveParam<Tensor4d<Ttype, Dtype>> conv_act_param(_conv_param, batchnorm_param,
+                                                               scale_param, eltwise_relu_param);
+        _param_conv_batchnorm_scale = conv_act_param;
+    } else {
+        ConvActiveParam<Tensor4d<Ttype, Dtype>> conv_act_param(_conv_param, batchnorm_param, scale_param);
+        _param_conv_batchnorm_scale = conv_act_param;
+    }
 
 	
     return Status::OK();
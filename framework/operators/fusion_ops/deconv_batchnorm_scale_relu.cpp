@@ -153,6 +153,22 @@ ANAKIN_REGISTER_OP_HELPER(DeconvBatchnormScaleRelu, DeconvBatchnormScaleReluHelp
                           Precision::FP32);
 #endif
 
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+INSTANCE_DECONVBATCHNORMSCALERELU(X86, AK_FLOAT, Precision::FP32);
+template<>
+Status DeconvBatchnormScaleReluHelper<X86, AK_FLOAT, Precision::FP32>::Init(OpContext<X86>& ctx,
+        const std::vector<Tensor4dPtr<X86, AK_FLOAT> >& ins,
+        std::vector<Tensor4dPtr<X86, AK_FLOAT> >& outs) {
+    // x86 has no vender deconv, saber takes both the depthwise and the gemm cases
+    SABER_CHECK(_funcs_deconv_batchnorm_scale_relu.init(ins, outs, _param_deconv_batchnorm_scale_relu,
+                                                        SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+template class DeconvBatchnormScaleReluHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(DeconvBatchnormScaleRelu, DeconvBatchnormScaleReluHelper, X86, AK_FLOAT,
+                          Precision::FP32);
+#endif
+
 //! register op
 ANAKIN_REGISTER_OP(DeconvBatchnormScaleRelu)
 .Doc("DeconvBatchnormScaleRelu fusion operator")
@@ -162,6 +178,9 @@ ANAKIN_REGISTER_OP(DeconvBatchnormScaleRelu)
 #ifdef USE_ARM_PLACE
 .__alias__<ARM, AK_FLOAT, Precision::FP32>("convolution_batchnorm_scale_relu")
 #endif
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+.__alias__<X86, AK_FLOAT, Precision::FP32>("deconv_batchnorm_scale_relu")
+#endif
 .num_in(1)
 .num_out(1)
 .Args<int>("group", " group of conv ")
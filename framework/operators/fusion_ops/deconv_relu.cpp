@@ -124,7 +124,7 @@ template class DeconvReluHelper<ARM, AK_FLOAT, Precision::FP32>;
 ANAKIN_REGISTER_OP_HELPER(DeconvRelu, DeconvReluHelper, ARM, AK_FLOAT, Precision::FP32);
 #endif
 
-#ifdef BUILD_LITE
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
 INSTANCE_DECONVRELU(X86, AK_FLOAT, Precision::FP32);
 template class DeconvReluHelper<X86, AK_FLOAT, Precision::FP32>;
 ANAKIN_REGISTER_OP_HELPER(DeconvRelu, DeconvReluHelper, X86, AK_FLOAT, Precision::FP32);
@@ -139,6 +139,9 @@ ANAKIN_REGISTER_OP(DeconvRelu)
 #ifdef USE_ARM_PLACE
 .__alias__<ARM, AK_FLOAT, Precision::FP32>("deconv_relu")
 #endif
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+.__alias__<X86, AK_FLOAT, Precision::FP32>("deconv_relu")
+#endif
 .num_in(1)
 .num_out(1)
 .Args<int>("group", " group of conv ")
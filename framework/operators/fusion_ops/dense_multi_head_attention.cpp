@@ -0,0 +1,82 @@
+#include "framework/operators/fusion_ops/dense_multi_head_attention.h"
+
+namespace anakin {
+
+namespace ops {
+
+#define INSTANCE_DENSE_MULTI_HEAD_ATTENTION(Ttype, Dtype, Ptype) \
+template<> \
+void DenseMultiHeadAttention<Ttype, Dtype, Ptype>::operator()(OpContext<Ttype>& ctx, \
+        const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) { \
+    auto* impl = static_cast<DenseMultiHeadAttentionHelper<Ttype, Dtype, Ptype>*>(this->_helper); \
+    auto& param = impl->_param_dense_multi_head_attention; \
+    impl->_funcs_dense_multi_head_attention(ins, outs, param, ctx); \
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DenseMultiHeadAttentionHelper<Ttype, Dtype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing DenseMultiHeadAttention op parameter.";
+    auto axis = GET_PARAMETER(int, axis);
+    auto out_dim = GET_PARAMETER(int, out_dim);
+    auto bias_term = GET_PARAMETER(bool, bias_term);
+
+    using pblock_type = PBlock<typename DataTypeWarpper<Dtype>::type, Ttype>;
+    auto weights = GET_PARAMETER(pblock_type, weight_1);
+    Tensor4d<Ttype, Dtype>* bias = nullptr;
+    if (bias_term) {
+        auto bias_block = GET_PARAMETER(pblock_type, weight_2);
+        bias = &(bias_block.d_tensor());
+    }
+    saber::FcParam<Tensor4d<Ttype, Dtype>> fc_param(&(weights.d_tensor()), bias, out_dim, axis);
+
+    auto head_num = GET_PARAMETER(int, attention_0_head_num);
+    auto scale = GET_PARAMETER(float, attention_0_scale);
+
+    saber::MultiHeadAttentionParam<Tensor4d<Ttype, Dtype>> param(fc_param, head_num, scale);
+    _param_dense_multi_head_attention = param;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DenseMultiHeadAttentionHelper<Ttype, Dtype, Ptype>::Init(OpContext<Ttype>& ctx,
+        const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_dense_multi_head_attention.init(ins, outs, _param_dense_multi_head_attention,
+                                                       SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DenseMultiHeadAttentionHelper<Ttype, Dtype, Ptype>::InferShape(const
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_dense_multi_head_attention.compute_output_shape(ins, outs,
+                                                                       _param_dense_multi_head_attention));
+    return Status::OK();
+}
+
+#ifdef USE_X86_PLACE
+INSTANCE_DENSE_MULTI_HEAD_ATTENTION(X86, AK_FLOAT, Precision::FP32);
+template class DenseMultiHeadAttentionHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(DenseMultiHeadAttention, DenseMultiHeadAttentionHelper, X86, AK_FLOAT,
+                          Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(DenseMultiHeadAttention)
+.Doc("DenseMultiHeadAttention fusion operator")
+#ifdef USE_X86_PLACE
+.__alias__<X86, AK_FLOAT, Precision::FP32>("dense_multi_head_attention")
+#endif
+.num_in(1)
+.num_out(1)
+.Args<int>("axis", " axis to compute ")
+.Args<int>("out_dim", " out dim ")
+.Args<bool>("bias_term", " whether fc weights have bias")
+.Args<int>("attention_0_head_num", " number of attention heads")
+.Args<float>("attention_0_scale", " scale of the attention scores");
+
+} /* namespace ops */
+
+} /* namespace anakin */
@@ -0,0 +1,98 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_OPERATOR_DENSE_MULTI_HEAD_ATTENTION_H
+#define ANAKIN_OPERATOR_DENSE_MULTI_HEAD_ATTENTION_H
+
+#include "framework/core/base.h"
+#include "framework/core/data_types.h"
+#include "framework/core/operator/operator.h"
+#include "utils/logger/logger.h"
+#include "saber/funcs/multi_head_attention.h"
+
+namespace anakin {
+
+namespace ops {
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class DenseMultiHeadAttentionHelper;
+
+/// q k v projection and self attention fusion op
+/**
+ * \brief DenseMultiHeadAttention implementation class
+ * public inherit Operator
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class DenseMultiHeadAttention : public Operator<Ttype, Dtype, Ptype> {
+public:
+    DenseMultiHeadAttention() {}
+
+    /// forward impl
+    virtual void operator() (OpContext<Ttype> &ctx, 
+                             const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, 
+                             std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+        LOG(ERROR) << "Not Impl Yet Operator DenseMultiHeadAttention<TargetType:"<<"unknown"<<","
+                   <<type_id<typename DataTypeWarpper<Dtype>::type>().type_info()<<">";
+    }
+
+    friend class DenseMultiHeadAttentionHelper<Ttype, Dtype, Ptype>;
+};
+
+/**
+ * \brief DenseMultiHeadAttention helper class to implement it
+ * public inherit OperatorHelper
+ * including init resource and shape size in DenseMultiHeadAttention context
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class DenseMultiHeadAttentionHelper : public OperatorHelper<Ttype, Dtype, Ptype> {
+public:
+    DenseMultiHeadAttentionHelper()=default;
+
+    ~DenseMultiHeadAttentionHelper() {}
+
+    Status InitParam() override;
+
+    /**
+    * \brief initial all the resource needed by dense multi head attention
+    * \param ctx stand for DenseMultiHeadAttention operation context
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status Init(OpContext<Ttype> &ctx,
+                const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, 
+                std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+    /**
+    * \brief infer the shape of output and input.
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                      std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+public:
+    ///< _param_dense_multi_head_attention stand for DenseMultiHeadAttention parameter
+    saber::MultiHeadAttentionParam<Tensor4d<Ttype, Dtype>> _param_dense_multi_head_attention;
+    ///< _funcs_dense_multi_head_attention stand for the fused function
+    saber::MultiHeadAttention<Ttype, Dtype> _funcs_dense_multi_head_attention;
+};
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
+#endif
@@ -0,0 +1,142 @@
+#include "framework/operators/fusion_ops/dense_softmax_argmax.h"
+
+namespace anakin {
+
+namespace ops {
+
+#define INSTANCE_DENSE_SOFTMAX_ARGMAX(Ttype, Dtype, Ptype) \
+template<> \
+void DenseSoftmaxArgmax<Ttype, Dtype, Ptype>::operator()(OpContext<Ttype>& ctx, \
+        const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) { \
+    auto* impl = static_cast<DenseSoftmaxArgmaxHelper<Ttype, Dtype, Ptype>*>(this->_helper); \
+    auto& param = impl->_param_dense_softmax_argmax; \
+    if (impl->_use_fused) { \
+        impl->_funcs_dense_softmax_argmax(ins, outs, param, ctx); \
+    } else { \
+        impl->_funcs_dense(ins, impl->_dense_outs, param.fc_param, ctx); \
+        impl->_funcs_softmax(impl->_dense_outs, impl->_softmax_outs, param.softmax_param, ctx); \
+        impl->_funcs_argmax(impl->_softmax_outs, outs, param.argmax_param, ctx); \
+    } \
+}
+
+/// targets which have the fused saber kernel.
+template<typename Ttype>
+inline bool has_fused_kernel() {
+    return false;
+}
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+template<>
+inline bool has_fused_kernel<X86>() {
+    return true;
+}
+#endif
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DenseSoftmaxArgmaxHelper<Ttype, Dtype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing DenseSoftmaxArgmax op parameter.";
+    auto axis = GET_PARAMETER(int, axis);
+    auto out_dim = GET_PARAMETER(int, out_dim);
+    auto bias_term = GET_PARAMETER(bool, bias_term);
+
+    using pblock_type = PBlock<typename DataTypeWarpper<Dtype>::type, Ttype>;
+    auto weights = GET_PARAMETER(pblock_type, weight_1);
+    Tensor4d<Ttype, Dtype>* bias = nullptr;
+    if (bias_term) {
+        auto bias_block = GET_PARAMETER(pblock_type, weight_2);
+        bias = &(bias_block.d_tensor());
+    }
+    saber::FcParam<Tensor4d<Ttype, Dtype>> fc_param(&(weights.d_tensor()), bias, out_dim, axis);
+
+    auto softmax_axis = GET_PARAMETER(int, softmax_0_axis);
+    saber::SoftmaxParam<Tensor4d<Ttype, Dtype>> softmax_param(softmax_axis);
+
+    auto out_max_val = GET_PARAMETER(bool, argmax_0_out_max_val);
+    auto top_k = GET_PARAMETER(int, argmax_0_top_k);
+    auto axis_term = GET_PARAMETER(bool, argmax_0_axis_term);
+    saber::ArgmaxParam<Tensor4d<Ttype, Dtype>> argmax_param(out_max_val, top_k);
+    // the fused kernel takes the softmax and argmax along the dense outputs only
+    bool along_outputs = softmax_axis == 1;
+    if (axis_term) {
+        auto argmax_axis = GET_PARAMETER(int, argmax_0_axis);
+        argmax_param = saber::ArgmaxParam<Tensor4d<Ttype, Dtype>>(out_max_val, top_k, argmax_axis);
+        along_outputs = along_outputs && argmax_axis == 1;
+    }
+
+    saber::FcSoftmaxArgmaxParam<Tensor4d<Ttype, Dtype>> param(fc_param, softmax_param, argmax_param);
+    _param_dense_softmax_argmax = param;
+    _use_fused = has_fused_kernel<Ttype>() && along_outputs;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DenseSoftmaxArgmaxHelper<Ttype, Dtype, Ptype>::Init(OpContext<Ttype>& ctx,
+        const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    if (_use_fused) {
+        SABER_CHECK(_funcs_dense_softmax_argmax.init(ins, outs, _param_dense_softmax_argmax,
+                                                     SPECIFY, SABER_IMPL, ctx));
+        return Status::OK();
+    }
+    SABER_CHECK(_funcs_dense.init(ins, _dense_outs, _param_dense_softmax_argmax.fc_param,
+                                  STATIC, VENDER_IMPL, ctx));
+    SABER_CHECK(_funcs_softmax.init(_dense_outs, _softmax_outs, _param_dense_softmax_argmax.softmax_param,
+                                    STATIC, SABER_IMPL, ctx));
+    SABER_CHECK(_funcs_argmax.init(_softmax_outs, outs, _param_dense_softmax_argmax.argmax_param,
+                                   SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DenseSoftmaxArgmaxHelper<Ttype, Dtype, Ptype>::InferShape(const
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    if (_dense_outs.empty()) {
+        _dense_outs.push_back(&_dense_out);
+        _softmax_outs.push_back(&_softmax_out);
+    }
+    SABER_CHECK(_funcs_dense_softmax_argmax.compute_output_shape(ins, outs, _param_dense_softmax_argmax));
+    if (!_use_fused) {
+        SABER_CHECK(_funcs_dense.compute_output_shape(ins, _dense_outs, _param_dense_softmax_argmax.fc_param));
+        _dense_out.re_alloc(_dense_out.valid_shape());
+        SABER_CHECK(_funcs_softmax.compute_output_shape(_dense_outs, _softmax_outs,
+                                                        _param_dense_softmax_argmax.softmax_param));
+        _softmax_out.re_alloc(_softmax_out.valid_shape());
+    }
+    return Status::OK();
+}
+
+#ifdef USE_CUDA
+INSTANCE_DENSE_SOFTMAX_ARGMAX(NV, AK_FLOAT, Precision::FP32);
+template class DenseSoftmaxArgmaxHelper<NV, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(DenseSoftmaxArgmax, DenseSoftmaxArgmaxHelper, NV, AK_FLOAT, Precision::FP32);
+#endif
+
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+INSTANCE_DENSE_SOFTMAX_ARGMAX(X86, AK_FLOAT, Precision::FP32);
+template class DenseSoftmaxArgmaxHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(DenseSoftmaxArgmax, DenseSoftmaxArgmaxHelper, X86, AK_FLOAT, Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(DenseSoftmaxArgmax)
+.Doc("DenseSoftmaxArgmax fusion operator")
+#ifdef USE_CUDA
+.__alias__<NV, AK_FLOAT, Precision::FP32>("dense_softmax_argmax")
+#endif
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+.__alias__<X86, AK_FLOAT, Precision::FP32>("dense_softmax_argmax")
+#endif
+.num_in(1)
+.num_out(1)
+.Args<int>("axis", " axis to compute ")
+.Args<int>("out_dim", " out dim ")
+.Args<bool>("bias_term", " whether fc weights have bias")
+.Args<int>("softmax_0_axis", " axis of softmax")
+.Args<bool>("argmax_0_out_max_val", " out_max_val for argmax ")
+.Args<unsigned int>("argmax_0_top_k", " top_k for argmax")
+.Args<int>("argmax_0_axis", " axis for argmax");
+
+} /* namespace ops */
+
+} /* namespace anakin */
@@ -0,0 +1,111 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+   
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. 
+*/
+
+#ifndef ANAKIN_OPERATOR_DENSE_SOFTMAX_ARGMAX_H
+#define ANAKIN_OPERATOR_DENSE_SOFTMAX_ARGMAX_H
+
+#include "framework/core/base.h"
+#include "framework/core/data_types.h"
+#include "framework/core/operator/operator.h"
+#include "utils/logger/logger.h"
+#include "saber/funcs/fc.h"
+#include "saber/funcs/softmax.h"
+#include "saber/funcs/argmax.h"
+#include "saber/funcs/fc_softmax_argmax.h"
+
+namespace anakin {
+
+namespace ops {
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class DenseSoftmaxArgmaxHelper;
+
+/// output layer fusion op
+/**
+ * \brief DenseSoftmaxArgmax implementation class
+ * public inherit Operator
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class DenseSoftmaxArgmax : public Operator<Ttype, Dtype, Ptype> {
+public:
+    DenseSoftmaxArgmax() {}
+
+    /// forward impl
+    virtual void operator() (OpContext<Ttype> &ctx, 
+                             const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, 
+                             std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+        LOG(ERROR) << "Not Impl Yet Operator DenseSoftmaxArgmax<TargetType:"<<"unknown"<<","
+                   <<type_id<typename DataTypeWarpper<Dtype>::type>().type_info()<<">";
+    }
+
+    friend class DenseSoftmaxArgmaxHelper<Ttype, Dtype, Ptype>;
+};
+
+/**
+ * \brief DenseSoftmaxArgmax helper class to implement it
+ * public inherit OperatorHelper
+ * including init resource and shape size in DenseSoftmaxArgmax context
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class DenseSoftmaxArgmaxHelper : public OperatorHelper<Ttype, Dtype, Ptype> {
+public:
+    DenseSoftmaxArgmaxHelper()=default;
+
+    ~DenseSoftmaxArgmaxHelper() {}
+
+    Status InitParam() override;
+
+    /**
+    * \brief initial all the resource needed by dense softmax argmax
+    * \param ctx stand for DenseSoftmaxArgmax operation context
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status Init(OpContext<Ttype> &ctx,
+                const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, 
+                std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+    /**
+    * \brief infer the shape of output and input.
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                      std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+public:
+    ///< _param_dense_softmax_argmax stand for DenseSoftmaxArgmax parameter
+    saber::FcSoftmaxArgmaxParam<Tensor4d<Ttype, Dtype>> _param_dense_softmax_argmax;
+    ///< _funcs_dense_softmax_argmax stand for the fused function
+    saber::FcSoftmaxArgmax<Ttype, Dtype> _funcs_dense_softmax_argmax;
+
+    ///< targets without the fused kernel run dense, softmax and argmax one by one
+    bool _use_fused{false};
+    saber::Fc<Ttype, Dtype> _funcs_dense;
+    saber::Softmax<Ttype, Dtype> _funcs_softmax;
+    saber::Argmax<Ttype, Dtype> _funcs_argmax;
+    Tensor4d<Ttype, Dtype> _dense_out;
+    Tensor4d<Ttype, Dtype> _softmax_out;
+    std::vector<Tensor4dPtr<Ttype, Dtype> > _dense_outs;
+    std::vector<Tensor4dPtr<Ttype, Dtype> > _softmax_outs;
+};
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
+#endif
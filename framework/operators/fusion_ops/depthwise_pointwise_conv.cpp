@@ -0,0 +1,168 @@
+#include "framework/operators/fusion_ops/depthwise_pointwise_conv.h"
+
+namespace anakin {
+
+namespace ops {
+
+#define INSTANCE_DEPTHWISEPOINTWISECONV(Ttype, Dtype, Ptype) \
+template<> \
+void DepthwisePointwiseConv<Ttype, Dtype, Ptype>::operator()(\
+    OpContext<Ttype>& ctx,\
+    const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,\
+    std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {\
+    auto* impl = static_cast<DepthwisePointwiseConvHelper<Ttype, Dtype, Ptype>*>\
+                 (this->_helper);\
+    auto& param = static_cast<DepthwisePointwiseConvHelper<Ttype, Dtype, Ptype>*>\
+                  (this->_helper)->_param_depthwise_pointwise_conv;\
+    SABER_CHECK(impl->_funcs_depthwise_pointwise_conv(ins, outs, param, ctx));\
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DepthwisePointwiseConvHelper<Ttype, Dtype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing DepthwisePointwiseConv op parameter.";
+    using pblock_type = PBlock<typename DataTypeWarpper<Dtype>::type, Ttype>;
+
+    // get depthwise conv param, the attrs of the first node keep their names
+    auto group = GET_PARAMETER(int, group);
+    auto bias_term = GET_PARAMETER(bool, bias_term);
+    auto padding = GET_PARAMETER(PTuple<int>, padding);
+    auto strides = GET_PARAMETER(PTuple<int>, strides);
+    auto dilation_rate = GET_PARAMETER(PTuple<int>, dilation_rate);
+    auto weights = GET_PARAMETER(pblock_type, weight_1);
+    Tensor4d<Ttype, Dtype>* bias = nullptr;
+    if (bias_term) {
+        auto bias_block = GET_PARAMETER(pblock_type, weight_2);
+        bias = &(bias_block.d_tensor());
+    } else {
+        bias = new Tensor4d<Ttype, Dtype>();
+    }
+    saber::ConvParam<Tensor4d<Ttype, Dtype>> dw_conv_param(group, padding[0], padding[1],
+                                          strides[0], strides[1],
+                                          dilation_rate[0], dilation_rate[1],
+                                          &(weights.d_tensor()), bias);
+
+    auto epsilon = GET_PARAMETER(float, batchnorm_0_epsilon);
+    auto momentum = GET_PARAMETER(float, batchnorm_0_momentum);
+    auto batch_norm_weight_1 = GET_PARAMETER(pblock_type, batchnorm_0_weight_1);
+    auto batch_norm_weight_2 = GET_PARAMETER(pblock_type, batchnorm_0_weight_2);
+    auto batch_norm_weight_3 = GET_PARAMETER(pblock_type, batchnorm_0_weight_3);
+    BatchnormParam<Tensor4d<Ttype, Dtype>> dw_batchnorm_param(batch_norm_weight_1.vector(),
+                                        batch_norm_weight_2.vector(),
+                                        batch_norm_weight_3.vector()[0],
+                                        momentum, epsilon);
+
+    auto scale_num_axes = GET_PARAMETER(int, scale_0_num_axes);
+    auto scale_bias_term = GET_PARAMETER(bool, scale_0_bias_term);
+    auto scale_axis = GET_PARAMETER(int, scale_0_axis);
+    auto scale_weight_1 = GET_PARAMETER(pblock_type, scale_0_weight_1);
+    auto scale_weight_2 = GET_PARAMETER(pblock_type, scale_0_weight_2);
+    saber::ScaleParam<Tensor4d<Ttype, Dtype>> dw_scale_param(scale_weight_1.vector(),
+                                           scale_weight_2.vector(),
+                                           scale_bias_term, scale_axis, scale_num_axes);
+
+    ActivationParam<Tensor4d<Ttype, Dtype>> active_param(Active_relu);
+    ConvActiveParam<Tensor4d<Ttype, Dtype>> dw_param(dw_conv_param, active_param,
+                                         dw_batchnorm_param, dw_scale_param);
+
+    // get pointwise conv param, merged under the conv_1 prefix
+    auto pw_group = GET_PARAMETER(int, conv_1_group);
+    auto pw_bias_term = GET_PARAMETER(bool, conv_1_bias_term);
+    auto pw_padding = GET_PARAMETER(PTuple<int>, conv_1_padding);
+    auto pw_strides = GET_PARAMETER(PTuple<int>, conv_1_strides);
+    auto pw_dilation_rate = GET_PARAMETER(PTuple<int>, conv_1_dilation_rate);
+    auto pw_weights = GET_PARAMETER(pblock_type, conv_1_weight_1);
+    Tensor4d<Ttype, Dtype>* pw_bias = nullptr;
+    if (pw_bias_term) {
+        auto pw_bias_block = GET_PARAMETER(pblock_type, conv_1_weight_2);
+        pw_bias = &(pw_bias_block.d_tensor());
+    } else {
+        pw_bias = new Tensor4d<Ttype, Dtype>();
+    }
+    saber::ConvParam<Tensor4d<Ttype, Dtype>> pw_conv_param(pw_group, pw_padding[0], pw_padding[1],
+                                          pw_strides[0], pw_strides[1],
+                                          pw_dilation_rate[0], pw_dilation_rate[1],
+                                          &(pw_weights.d_tensor()), pw_bias);
+
+    auto pw_epsilon = GET_PARAMETER(float, batchnorm_1_epsilon);
+    auto pw_momentum = GET_PARAMETER(float, batchnorm_1_momentum);
+    auto pw_batch_norm_weight_1 = GET_PARAMETER(pblock_type, batchnorm_1_weight_1);
+    auto pw_batch_norm_weight_2 = GET_PARAMETER(pblock_type, batchnorm_1_weight_2);
+    auto pw_batch_norm_weight_3 = GET_PARAMETER(pblock_type, batchnorm_1_weight_3);
+    BatchnormParam<Tensor4d<Ttype, Dtype>> pw_batchnorm_param(pw_batch_norm_weight_1.vector(),
+                                        pw_batch_norm_weight_2.vector(),
+                                        pw_batch_norm_weight_3.vector()[0],
+                                        pw_momentum, pw_epsilon);
+
+    auto pw_scale_num_axes = GET_PARAMETER(int, scale_1_num_axes);
+    auto pw_scale_bias_term = GET_PARAMETER(bool, scale_1_bias_term);
+    auto pw_scale_axis = GET_PARAMETER(int, scale_1_axis);
+    auto pw_scale_weight_1 = GET_PARAMETER(pblock_type, scale_1_weight_1);
+    auto pw_scale_weight_2 = GET_PARAMETER(pblock_type, scale_1_weight_2);
+    saber::ScaleParam<Tensor4d<Ttype, Dtype>> pw_scale_param(pw_scale_weight_1.vector(),
+                                           pw_scale_weight_2.vector(),
+                                           pw_scale_bias_term, pw_scale_axis, pw_scale_num_axes);
+
+    // the mobilenet v2 projection has no relu after the 1x1 conv
+    ConvActiveParam<Tensor4d<Ttype, Dtype>> pw_param(pw_conv_param, pw_batchnorm_param,
+                                         pw_scale_param);
+    if (this->check_attr("relu_1_alpha")) {
+        pw_param = ConvActiveParam<Tensor4d<Ttype, Dtype>>(pw_conv_param, active_param,
+                                         pw_batchnorm_param, pw_scale_param);
+    }
+
+    saber::ConvDwPwParam<Tensor4d<Ttype, Dtype>> dw_pw_param(dw_param, pw_param);
+    _param_depthwise_pointwise_conv = dw_pw_param;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DepthwisePointwiseConvHelper<Ttype, Dtype, Ptype>::Init(OpContext<Ttype>& ctx,
+        const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_depthwise_pointwise_conv.init(ins, outs, _param_depthwise_pointwise_conv,
+                                                     SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status DepthwisePointwiseConvHelper<Ttype, Dtype, Ptype>::InferShape(const
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_depthwise_pointwise_conv.compute_output_shape(ins, outs,
+                _param_depthwise_pointwise_conv));
+    return Status::OK();
+}
+
+#ifdef USE_X86_PLACE
+INSTANCE_DEPTHWISEPOINTWISECONV(X86, AK_FLOAT, Precision::FP32);
+template class DepthwisePointwiseConvHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(DepthwisePointwiseConv, DepthwisePointwiseConvHelper, X86, AK_FLOAT,
+                                  Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(DepthwisePointwiseConv)
+.Doc("DepthwisePointwiseConv fusion operator")
+#ifdef USE_X86_PLACE
+.__alias__<X86, AK_FLOAT, Precision::FP32>("depthwise_pointwise_conv")
+#endif
+.num_in(1)
+.num_out(1)
+.Args<int>("group", " group of the depthwise conv ")
+.Args<bool>("bias_term", " whether the depthwise conv has bias")
+.Args<PTuple<int>>("padding", "padding of the depthwise conv (x, y)")
+.Args<PTuple<int>>("strides", "strides of the depthwise conv (x)")
+.Args<PTuple<int>>("dilation_rate", "dilation rate of the depthwise conv (x)")
+.Args<int>("conv_1_group", " group of the 1x1 conv ")
+.Args<bool>("conv_1_bias_term", " whether the 1x1 conv has bias")
+.Args<float>("batchnorm_0_epsilon", "epsilon for the first batchnorm")
+.Args<float>("batchnorm_1_epsilon", "epsilon for the second batchnorm")
+.Args<bool>("scale_0_bias_term", "whether the first scale has bias")
+.Args<bool>("scale_1_bias_term", "whether the second scale has bias")
+.Args<float>("relu_0_alpha", " alpha for the relu after the depthwise conv")
+.Args<float>("relu_1_alpha", " alpha for the relu after the 1x1 conv, if any");
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
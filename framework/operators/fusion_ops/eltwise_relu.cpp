@@ -1,4 +1,5 @@
 #include "framework/operators/fusion_ops/eltwise_relu.h"
+#include "framework/operators/eltwise_op.h"
 
 namespace anakin {
 
@@ -78,6 +79,14 @@ Status EltwiseReluHelper<Ttype, Dtype, Ptype>::InitParam() {
     //
     //    saber::EltwiseParam<Tensor4d<Ttype, Dtype>>    eltwise_param(elt_type, tdcoeff_p);
     saber::EltwiseParam<Tensor4d<Ttype, Dtype>>  eltwise_param(elt_type, coeff.vector());
+    // the fused (a * b) + c -> relu keeps the chain of the eltwise node
+    if (FIND_PARAMETER(chain)) {
+        auto chain = GET_PARAMETER(PTuple<std::string>, chain);
+        Status status = parse_eltwise_chain(chain, eltwise_param.chain_ops);
+        if (!status) {
+            return status;
+        }
+    }
     EltwiseActiveParam<Tensor4d<Ttype, Dtype>> eltwise_relu_param(eltwise_param, activation_param);
     _param_eltwise_relu = eltwise_relu_param;
     return Status::OK();
@@ -17,6 +17,19 @@ void PermutePower<NV, AK_FLOAT, Precision::FP32>::operator()(
 }
 #endif
 
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+template<>
+void PermutePower<X86, AK_FLOAT, Precision::FP32>::operator()(
+    OpContext<X86>& ctx,
+    const std::vector<Tensor4dPtr<X86, AK_FLOAT> >& ins,
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> >& outs) {
+    auto* impl = static_cast<PermutePowerHelper<X86, AK_FLOAT, Precision::FP32>*>(this->_helper);
+    auto& param = static_cast<PermutePowerHelper<X86, AK_FLOAT, Precision::FP32>*>
+                  (this->_helper)->_param_permute_power;
+    impl->_funcs_permute_power(ins, outs, param, ctx);
+}
+#endif
+
 /// TODO ... specialization other type of operator
 
 
@@ -63,6 +76,10 @@ template class PermutePowerHelper<NV, AK_FLOAT, Precision::FP16>;
 template class PermutePowerHelper<NV, AK_FLOAT, Precision::INT8>;
 #endif
 
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+template class PermutePowerHelper<X86, AK_FLOAT, Precision::FP32>;
+#endif
+
 #ifdef USE_ARM_PLACE
 template class PermutePowerHelper<ARM, AK_FLOAT, Precision::FP32>;
 template class PermutePowerHelper<ARM, AK_FLOAT, Precision::FP16>;
@@ -73,6 +90,9 @@ template class PermutePowerHelper<ARM, AK_FLOAT, Precision::INT8>;
 #ifdef USE_CUDA
 ANAKIN_REGISTER_OP_HELPER(PermutePower, PermutePowerHelper, NV, AK_FLOAT, Precision::FP32);
 #endif
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+ANAKIN_REGISTER_OP_HELPER(PermutePower, PermutePowerHelper, X86, AK_FLOAT, Precision::FP32);
+#endif
 #ifdef USE_ARM_PLACE
 ANAKIN_REGISTER_OP_HELPER(PermutePower, PermutePowerHelper, ARM, AK_FLOAT, Precision::FP32);
 #endif
@@ -83,6 +103,9 @@ ANAKIN_REGISTER_OP(PermutePower)
 #ifdef USE_CUDA
 .__alias__<NV, AK_FLOAT, Precision::FP32>("permute_power")
 #endif
+#if defined(USE_X86_PLACE) || defined(BUILD_LITE)
+.__alias__<X86, AK_FLOAT, Precision::FP32>("permute_power")
+#endif
 #ifdef USE_ARM_PLACE
 .__alias__<ARM, AK_FLOAT, Precision::FP32>("permute_power")
 #endif
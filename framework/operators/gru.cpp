@@ -88,6 +88,18 @@ Status GruHelper<Ttype, Dtype, Ptype>::InferShape(const std::vector<Tensor4dPtr<
     return Status::OK();
 }
 
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status GruHelper<Ttype, Dtype, Ptype>::BindState(Tensor4dPtr<Ttype, Dtype> init_hidden,
+                                                   Tensor4dPtr<Ttype, Dtype> init_cell,
+                                                   Tensor4dPtr<Ttype, Dtype> last_hidden,
+                                                   Tensor4dPtr<Ttype, Dtype> last_cell) {
+    if (init_cell != nullptr || last_cell != nullptr) {
+        return Status::FAIL(" Gru doesn't have cell state.");
+    }
+    _param_gru.set_state(init_hidden, last_hidden);
+    return Status::OK();
+}
+
 #ifdef USE_CUDA
 template class GruHelper<NV, AK_FLOAT, Precision::FP32>;
 template class GruHelper<NV, AK_FLOAT, Precision::FP16>;
@@ -17,6 +17,19 @@ void Lrn<NV, AK_FLOAT, Precision::FP32>::operator()(
 }
 #endif
 
+#ifdef USE_X86_PLACE
+template<>
+void Lrn<X86, AK_FLOAT, Precision::FP32>::operator()(
+    OpContext<X86>& ctx,
+    const std::vector<Tensor4dPtr<X86, AK_FLOAT> >& ins,
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> >& outs) {
+    auto* impl =
+        static_cast<LrnHelper<X86, AK_FLOAT, Precision::FP32>*>(this->_helper);
+    auto& param = impl->_param_lrn;
+    impl->_funcs_lrn(ins, outs, param, ctx);
+}
+#endif
+
 /// TODO ... specialization other type of operator
 
 
@@ -70,6 +83,10 @@ template class LrnHelper<NV, AK_FLOAT, Precision::FP16>;
 template class LrnHelper<NV, AK_FLOAT, Precision::INT8>;
 #endif
 
+#ifdef USE_X86_PLACE
+template class LrnHelper<X86, AK_FLOAT, Precision::FP32>;
+#endif
+
 #ifdef USE_ARM_PLACE
 template class LrnHelper<ARM, AK_FLOAT, Precision::FP32>;
 template class LrnHelper<ARM, AK_FLOAT, Precision::FP16>;
@@ -80,6 +97,9 @@ template class LrnHelper<ARM, AK_FLOAT, Precision::INT8>;
 #ifdef USE_CUDA
 ANAKIN_REGISTER_OP_HELPER(Lrn, LrnHelper, NV, AK_FLOAT, Precision::FP32);
 #endif
+#ifdef USE_X86_PLACE
+ANAKIN_REGISTER_OP_HELPER(Lrn, LrnHelper, X86, AK_FLOAT, Precision::FP32);
+#endif
 #ifdef USE_ARM_PLACE
 ANAKIN_REGISTER_OP_HELPER(Lrn, LrnHelper, ARM, AK_FLOAT, Precision::FP32);
 #endif
@@ -90,11 +110,19 @@ ANAKIN_REGISTER_OP(Lrn)
 #ifdef USE_CUDA
 .__alias__<NV, AK_FLOAT, Precision::FP32>("LRN")
 #endif
+#ifdef USE_X86_PLACE
+.__alias__<X86, AK_FLOAT, Precision::FP32>("LRN")
+#endif
 #ifdef USE_ARM_PLACE
 .__alias__<ARM, AK_FLOAT, Precision::FP32>("LRN")
 #endif
 .num_in(3)
-.num_out(1);
+.num_out(1)
+.Args<int>("local_size", " size of the normalization window")
+.Args<float>("alpha", " scale of the window sum of squares")
+.Args<float>("beta", " exponent of the normalization")
+.Args<float>("k", " offset added before the power")
+.Args<std::string>("norm_region", " ACROSS_CHANNELS or WITHIN_CHANNEL");
 
 } /* namespace ops */
 
@@ -95,6 +95,15 @@ Status LstmHelper<Ttype, Dtype, Ptype>::InferShape(const std::vector<Tensor4dPtr
     return Status::OK();
 }
 
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status LstmHelper<Ttype, Dtype, Ptype>::BindState(Tensor4dPtr<Ttype, Dtype> init_hidden,
+                                                   Tensor4dPtr<Ttype, Dtype> init_cell,
+                                                   Tensor4dPtr<Ttype, Dtype> last_hidden,
+                                                   Tensor4dPtr<Ttype, Dtype> last_cell) {
+    _param_lstm.set_state(init_hidden, init_cell, last_hidden, last_cell);
+    return Status::OK();
+}
+
 #ifdef USE_CUDA
 template class LstmHelper<NV, AK_FLOAT, Precision::FP32>;
 template class LstmHelper<NV, AK_FLOAT, Precision::FP16>;
@@ -87,6 +87,13 @@ public:
     Status InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
                       std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
 
+    /**
+    * \brief bind the recurrent state used by streaming inference
+    * \return status
+    */
+    Status BindState(Tensor4dPtr<Ttype, Dtype> init_hidden, Tensor4dPtr<Ttype, Dtype> init_cell,
+                     Tensor4dPtr<Ttype, Dtype> last_hidden, Tensor4dPtr<Ttype, Dtype> last_cell) override;
+
 public:
     ///< _param_lstm stand for Lstm parameter
     saber::LstmParam<Tensor4d<Ttype, Dtype>> _param_lstm;
@@ -0,0 +1,72 @@
+#include "framework/operators/mat_mul.h"
+
+namespace anakin{
+
+namespace ops{
+
+#define INSTANCE_MAT_MUL(Ttype, Dtype, Ptype) \
+template<> \
+void MatMul<Ttype, Dtype, Ptype>::operator()(OpContext<Ttype>& ctx, \
+    const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+    std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) { \
+    auto* impl = static_cast<MatMulHelper<Ttype, Dtype, Ptype>*>(this->_helper); \
+    auto& param = static_cast<MatMulHelper<Ttype, Dtype, Ptype>*> \
+                  (this->_helper)->_param_mat_mul; \
+    impl->_funcs_mat_mul(ins, outs, param, ctx); \
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MatMulHelper<Ttype, Dtype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing MatMul op parameter.";
+    auto transpose_x = GET_PARAMETER(bool, transpose_x);
+    auto transpose_y = GET_PARAMETER(bool, transpose_y);
+
+    saber::MatMulParam<Tensor4d<Ttype, Dtype>> param(transpose_x, transpose_y);
+    _param_mat_mul = param;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MatMulHelper<Ttype, Dtype, Ptype>::Init(OpContext<Ttype> &ctx,
+const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_mat_mul.init(ins, outs, _param_mat_mul, SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MatMulHelper<Ttype, Dtype, Ptype>::InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+    std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_mat_mul.compute_output_shape(ins, outs, _param_mat_mul));
+    return Status::OK();
+}
+
+#ifdef USE_CUDA
+INSTANCE_MAT_MUL(NV, AK_FLOAT, Precision::FP32);
+template class MatMulHelper<NV, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(MatMul, MatMulHelper, NV, AK_FLOAT, Precision::FP32);
+#endif
+
+#ifdef USE_X86_PLACE
+INSTANCE_MAT_MUL(X86, AK_FLOAT, Precision::FP32);
+template class MatMulHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(MatMul, MatMulHelper, X86, AK_FLOAT, Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(MatMul)
+.Doc("MatMul operator")
+#ifdef USE_CUDA
+.__alias__<NV, AK_FLOAT, Precision::FP32>("matmul")
+#endif
+#ifdef USE_X86_PLACE
+.__alias__<X86, AK_FLOAT, Precision::FP32>("matmul")
+#endif
+.num_in(2)
+.num_out(1)
+.Args<bool>("transpose_x", " whether to transpose the matrices of x")
+.Args<bool>("transpose_y", " whether to transpose the matrices of y");
+
+} //ops
+
+} //anakin
@@ -0,0 +1,98 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+   
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. 
+*/
+
+#ifndef ANAKIN_OPERATOR_MAT_MUL_H
+#define ANAKIN_OPERATOR_MAT_MUL_H
+
+#include "framework/core/base.h"
+#include "framework/core/data_types.h"
+#include "framework/core/operator/operator.h"
+#include "utils/logger/logger.h"
+#include "saber/funcs/mat_mul.h"
+
+namespace anakin {
+
+namespace ops {
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class MatMulHelper;
+
+/// batched matrix multiply op
+/**
+ * \brief MatMul operation class
+ * public inheritance Operator
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class MatMul : public Operator<Ttype, Dtype, Ptype> {
+public:
+    MatMul() {}
+
+    /// forward impl
+    virtual void operator() (OpContext<Ttype> &ctx, 
+                             const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, 
+                             std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+        LOG(ERROR) << "Not Impl Yet Operator MatMul<TargetType:"<<"unknown"<<","
+                   <<type_id<typename DataTypeWarpper<Dtype>::type>().type_info()<<">";
+    }
+
+    friend class MatMulHelper<Ttype, Dtype, Ptype>;
+};
+
+/**
+ * \brief MatMul helper class
+ * public inherit OperatorHelper
+ * including init resource and shape size in MatMul context
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class MatMulHelper : public OperatorHelper<Ttype, Dtype, Ptype> {
+public:
+    MatMulHelper()=default;
+
+    ~MatMulHelper() {}
+
+    Status InitParam() override;
+
+    /**
+    * \brief initial all the resource needed by MatMul
+    * \param ctx stand for MatMul operation context
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status Init(OpContext<Ttype> &ctx,
+                const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, 
+                std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+    /**
+    * \brief infer the shape of output and input.
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                      std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+public:
+    ///< _param_mat_mul stand for MatMul parameter
+    saber::MatMulParam<Tensor4d<Ttype, Dtype>> _param_mat_mul;
+    ///< _funcs_mat_mul stand for MatMul function
+    saber::MatMul<Ttype, Dtype> _funcs_mat_mul;
+};
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
+#endif //ANAKIN_OPERATOR_MAT_MUL_H
@@ -0,0 +1,65 @@
+#include "framework/operators/multi_head_attention.h"
+
+namespace anakin{
+
+namespace ops{
+
+#define INSTANCE_MULTI_HEAD_ATTENTION(Ttype, Dtype, Ptype) \
+template<> \
+void MultiHeadAttention<Ttype, Dtype, Ptype>::operator()(OpContext<Ttype>& ctx, \
+    const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+    std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) { \
+    auto* impl = static_cast<MultiHeadAttentionHelper<Ttype, Dtype, Ptype>*>(this->_helper); \
+    auto& param = static_cast<MultiHeadAttentionHelper<Ttype, Dtype, Ptype>*> \
+                  (this->_helper)->_param_multi_head_attention; \
+    impl->_funcs_multi_head_attention(ins, outs, param, ctx); \
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MultiHeadAttentionHelper<Ttype, Dtype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing MultiHeadAttention op parameter.";
+    auto head_num = GET_PARAMETER(int, head_num);
+    auto scale = GET_PARAMETER(float, scale);
+
+    // the input holds q, k and v of every word side by side
+    saber::MultiHeadAttentionParam<Tensor4d<Ttype, Dtype>> param(head_num, scale);
+    _param_multi_head_attention = param;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MultiHeadAttentionHelper<Ttype, Dtype, Ptype>::Init(OpContext<Ttype> &ctx,
+const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_multi_head_attention.init(ins, outs, _param_multi_head_attention,
+                                                 SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MultiHeadAttentionHelper<Ttype, Dtype, Ptype>::InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+    std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_multi_head_attention.compute_output_shape(ins, outs, _param_multi_head_attention));
+    return Status::OK();
+}
+
+#ifdef USE_X86_PLACE
+INSTANCE_MULTI_HEAD_ATTENTION(X86, AK_FLOAT, Precision::FP32);
+template class MultiHeadAttentionHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(MultiHeadAttention, MultiHeadAttentionHelper, X86, AK_FLOAT, Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(MultiHeadAttention)
+.Doc("MultiHeadAttention operator")
+#ifdef USE_X86_PLACE
+.__alias__<X86, AK_FLOAT, Precision::FP32>("multi_head_attention")
+#endif
+.num_in(1)
+.num_out(1)
+.Args<int>("head_num", " number of attention heads")
+.Args<float>("scale", " scale of the scores, 1 / sqrt(head size) when not positive");
+
+} //ops
+
+} //anakin
@@ -0,0 +1,73 @@
+#include "framework/operators/mvn.h"
+
+namespace anakin {
+
+namespace ops {
+
+#define INSTANCE_MVN(Ttype, Dtype, Ptype) \
+template<> \
+void Mvn<Ttype, Dtype, Ptype>::operator()(OpContext<Ttype>& ctx, \
+    const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+    std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) { \
+    auto* impl = static_cast<MvnHelper<Ttype, Dtype, Ptype>*>(this->_helper); \
+    auto& param = impl->_param_mvn; \
+    impl->_funcs_mvn(ins, outs, param, ctx); \
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MvnHelper<Ttype, Dtype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing Mvn op parameter.";
+    auto normalize_variance = GET_PARAMETER(bool, normalize_variance);
+    auto across_channels = GET_PARAMETER(bool, across_channels);
+    auto epsilon = GET_PARAMETER(float, epsilon);
+
+    saber::MvnParam<Tensor4d<Ttype, Dtype>> param(normalize_variance, across_channels, epsilon);
+    _param_mvn = param;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MvnHelper<Ttype, Dtype, Ptype>::Init(OpContext<Ttype> &ctx,
+        const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_mvn.init(ins, outs, _param_mvn, SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status MvnHelper<Ttype, Dtype, Ptype>::InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_mvn.compute_output_shape(ins, outs, _param_mvn));
+    return Status::OK();
+}
+
+#ifdef USE_CUDA
+INSTANCE_MVN(NV, AK_FLOAT, Precision::FP32);
+template class MvnHelper<NV, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(Mvn, MvnHelper, NV, AK_FLOAT, Precision::FP32);
+#endif
+
+#ifdef USE_X86_PLACE
+INSTANCE_MVN(X86, AK_FLOAT, Precision::FP32);
+template class MvnHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(Mvn, MvnHelper, X86, AK_FLOAT, Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(Mvn)
+.Doc("Mvn operator")
+#ifdef USE_CUDA
+.__alias__<NV, AK_FLOAT, Precision::FP32>("MVN")
+#endif
+#ifdef USE_X86_PLACE
+.__alias__<X86, AK_FLOAT, Precision::FP32>("MVN")
+#endif
+.num_in(1)
+.num_out(1)
+.Args<bool>("normalize_variance", " divide by the standard deviation as well")
+.Args<bool>("across_channels", " normalize over c, h and w instead of per channel")
+.Args<float>("epsilon", " added to the standard deviation");
+
+} /* namespace ops */
+
+} /* namespace anakin */
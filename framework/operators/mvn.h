@@ -0,0 +1,98 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+   
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. 
+*/
+
+#ifndef ANAKIN_OPERATOR_MVN_H
+#define ANAKIN_OPERATOR_MVN_H
+
+#include "framework/core/base.h"
+#include "framework/core/data_types.h"
+#include "framework/core/operator/operator.h"
+#include "utils/logger/logger.h"
+#include "saber/funcs/mvn.h"
+
+namespace anakin {
+
+namespace ops {
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class MvnHelper;
+
+/// mvn op
+/**
+ * \brief Mvn operation class
+ * public inheritance Operator
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class Mvn : public Operator<Ttype, Dtype, Ptype> {
+public:
+    Mvn() {}
+
+    /// forward impl
+    virtual void operator() (OpContext<Ttype> &ctx,
+                             const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                             std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+        LOG(ERROR) << "Not Impl Yet Operator Mvn<TargetType:"<<"unknown"<<","
+                   <<type_id<typename DataTypeWarpper<Dtype>::type>().type_info()<<">";
+    }
+
+    friend class MvnHelper<Ttype, Dtype, Ptype>;
+};
+
+/**
+ * \brief Mvn helper class
+ * public inherit OperatorHelper
+ * including init resource and shape size in mvn context
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class MvnHelper : public OperatorHelper<Ttype, Dtype, Ptype> {
+public:
+    MvnHelper()=default;
+
+    ~MvnHelper() {}
+
+    Status InitParam() override;
+
+    /**
+    * \brief initial all the resource needed by mvn
+    * \param ctx stand for Mvn operation context
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status Init(OpContext<Ttype> &ctx,
+                const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+    /**
+    * \brief infer the shape of output and input.
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                      std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+public:
+    ///< _param_mvn stand for Mvn parameter
+    saber::MvnParam<Tensor4d<Ttype, Dtype>>  _param_mvn;
+    ///< _funcs_mvn stand for Mvn function
+    saber::Mvn<Ttype, Dtype> _funcs_mvn;
+};
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
+#endif //ANAKIN_OPERATOR_MVN_H
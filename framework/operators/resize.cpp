@@ -23,8 +23,17 @@ Status ResizeHelper<Ttype, Dtype, Ptype>::InitParam() {
     // get resize param
     auto width_scale = GET_PARAMETER(float, width_scale);
     auto height_scale = GET_PARAMETER(float, height_scale);
-    
-    ResizeParam<Tensor4d<Ttype, Dtype>> resize_param(height_scale, width_scale);
+    ResizeType resize_type = Resize_bilinear;
+    if (FIND_PARAMETER(method)) {
+        auto method = GET_PARAMETER(std::string, method);
+        if (method == "NEAREST") {
+            resize_type = Resize_nearest;
+        } else if (method != "BILINEAR") {
+            LOG(FATAL) << " Resize op doesn't support : " << method << " method.";
+        }
+    }
+
+    ResizeParam<Tensor4d<Ttype, Dtype>> resize_param(width_scale, height_scale, resize_type);
     _param_resize = resize_param;
     return Status::OK();
 }
@@ -82,7 +91,8 @@ ANAKIN_REGISTER_OP(Resize)
 .num_in(1)
 .num_out(1)
 .Args<float>("height_scale", " height scale for resize")
-.Args<float>("width_scale", " width scale for resize");
+.Args<float>("width_scale", " width scale for resize")
+.Args<std::string>("method", " BILINEAR (default) or NEAREST");
 
 } /* namespace ops */
 
@@ -0,0 +1,71 @@
+#include "framework/operators/spatial_pyramid_pooling.h"
+
+namespace anakin {
+
+namespace ops {
+
+#define INSTANCE_SPP(Ttype, Dtype, Ptype) \
+template<> \
+void Spp<Ttype, Dtype, Ptype>::operator()(OpContext<Ttype>& ctx, \
+    const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins, \
+    std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) { \
+    auto* impl = static_cast<SppHelper<Ttype, Dtype, Ptype>*>(this->_helper); \
+    auto& param = impl->_param_spp; \
+    impl->_funcs_spp(ins, outs, param, ctx); \
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status SppHelper<Ttype, Dtype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing Spp op parameter.";
+    auto pyramid_height = GET_PARAMETER(int, pyramid_height);
+    auto pool_method = GET_PARAMETER(std::string, method);
+
+    PoolingType pool_type = Pooling_max;
+    if (pool_method == "MAX") {
+        pool_type = Pooling_max;
+    } else if (pool_method == "AVG") {
+        pool_type = Pooling_average_include_padding;
+    } else {
+        LOG(FATAL) << " Spp op doesn't support : " << pool_method << " pooling.";
+    }
+
+    saber::SPPParam<Tensor4d<Ttype, Dtype>> param(pyramid_height, pool_type);
+    _param_spp = param;
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status SppHelper<Ttype, Dtype, Ptype>::Init(OpContext<Ttype> &ctx,
+        const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_spp.init(ins, outs, _param_spp, SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+Status SppHelper<Ttype, Dtype, Ptype>::InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+        std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+    SABER_CHECK(_funcs_spp.compute_output_shape(ins, outs, _param_spp));
+    return Status::OK();
+}
+
+#ifdef USE_X86_PLACE
+INSTANCE_SPP(X86, AK_FLOAT, Precision::FP32);
+template class SppHelper<X86, AK_FLOAT, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(Spp, SppHelper, X86, AK_FLOAT, Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(Spp)
+.Doc("Spp operator")
+#ifdef USE_X86_PLACE
+.__alias__<X86, AK_FLOAT, Precision::FP32>("SPP")
+#endif
+.num_in(1)
+.num_out(1)
+.Args<int>("pyramid_height", " levels of the pyramid, level i pools to 2^i x 2^i bins")
+.Args<std::string>("method", " pooling type of the bins (MAX, AVG)");
+
+} /* namespace ops */
+
+} /* namespace anakin */
@@ -0,0 +1,98 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+   
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. 
+*/
+
+#ifndef ANAKIN_OPERATOR_SPATIAL_PYRAMID_POOLING_H
+#define ANAKIN_OPERATOR_SPATIAL_PYRAMID_POOLING_H
+
+#include "framework/core/base.h"
+#include "framework/core/data_types.h"
+#include "framework/core/operator/operator.h"
+#include "utils/logger/logger.h"
+#include "saber/funcs/spp.h"
+
+namespace anakin {
+
+namespace ops {
+
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class SppHelper;
+
+/// spatial pyramid pooling op
+/**
+ * \brief Spp operation class
+ * public inheritance Operator
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class Spp : public Operator<Ttype, Dtype, Ptype> {
+public:
+    Spp() {}
+
+    /// forward impl
+    virtual void operator() (OpContext<Ttype> &ctx,
+                             const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                             std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) {
+        LOG(ERROR) << "Not Impl Yet Operator Spp<TargetType:"<<"unknown"<<","
+                   <<type_id<typename DataTypeWarpper<Dtype>::type>().type_info()<<">";
+    }
+
+    friend class SppHelper<Ttype, Dtype, Ptype>;
+};
+
+/**
+ * \brief Spp helper class
+ * public inherit OperatorHelper
+ * including init resource and shape size in spatial pyramid pooling context
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+class SppHelper : public OperatorHelper<Ttype, Dtype, Ptype> {
+public:
+    SppHelper()=default;
+
+    ~SppHelper() {}
+
+    Status InitParam() override;
+
+    /**
+    * \brief initial all the resource needed by spatial pyramid pooling
+    * \param ctx stand for Spp operation context
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status Init(OpContext<Ttype> &ctx,
+                const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+    /**
+    * \brief infer the shape of output and input.
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status InferShape(const std::vector<Tensor4dPtr<Ttype, Dtype> >& ins,
+                      std::vector<Tensor4dPtr<Ttype, Dtype> >& outs) override;
+
+public:
+    ///< _param_spp stand for Spp parameter
+    saber::SPPParam<Tensor4d<Ttype, Dtype>>  _param_spp;
+    ///< _funcs_spp stand for Spp function
+    saber::Spp<Ttype, Dtype> _funcs_spp;
+};
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
+#endif //ANAKIN_OPERATOR_SPATIAL_PYRAMID_POOLING_H
@@ -66,6 +66,9 @@ public:
 #ifdef USE_ARM_PLACE
         _act_ids = ctx._act_ids;
         _mode = ctx._mode;
+#endif
+#ifdef USE_X86_PLACE
+        _thread_num = ctx._thread_num;
 #endif
     }
 
@@ -78,6 +81,9 @@ public:
 #ifdef USE_ARM_PLACE
         this->_act_ids = ctx._act_ids;
         this->_mode = ctx._mode;
+#endif
+#ifdef USE_X86_PLACE
+        this->_thread_num = ctx._thread_num;
 #endif
         return *this;
     }
@@ -125,6 +131,20 @@ public:
     //std::vector<int> get_act_ids();
 #endif
 
+#ifdef USE_X86_PLACE
+    /**
+     * \brief set omp and mkl threads the kernels of this context run with,
+     *  0 takes the intra-op threads of the process budget, see x86_thread.h
+     */
+    void set_thread_num(int threads);
+    int get_thread_num();
+    /**
+     * \brief apply the thread num to the calling thread, before init and run of kernels.
+     *  A budget thread num is fixed at the first bind, buffers sized at init stay valid.
+     */
+    void bind_dev();
+#endif
+
 
 private:
     //! current stream to process
@@ -138,6 +158,9 @@ private:
     PowerMode _mode{SABER_POWER_HIGH};
     std::vector<int> _act_ids{0};
 #endif
+#ifdef USE_X86_PLACE
+    int _thread_num{0};
+#endif
 };
 
 } //namespace saber
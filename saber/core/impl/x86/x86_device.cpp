@@ -1,4 +1,8 @@
 #include "saber/core/device.h"
+#include "saber/core/context.h"
+#include "saber/core/impl/x86/x86_isa.h"
+#include "saber/core/impl/x86/x86_thread.h"
+#include <thread>
 namespace anakin{
 
 namespace saber{
@@ -23,13 +27,39 @@ void Device<X86>::create_stream() {
 
 template <>
 void Device<X86>::get_info() {
-    // todo
-    LOG(WARNING) << "X86 get_info is not implemented";
+    // x86 kernels pick their code path by this level, see saber/funcs/impl/x86/x86_kernels.h
+    X86Isa isa = x86_isa();
+    _info._idx = 0;
+    _info._device_name = std::string("x86 ") + x86_isa_name(isa);
+    _info._generate_arch = isa;
+    _info._compute_core_num = std::thread::hardware_concurrency();
+    LOG(INFO) << "x86 kernels run at " << x86_isa_name(isa) << ", host supports "
+              << x86_isa_name(x86_detect_isa());
 }
 
 template void Device<X86>::get_info();
 template void Device<X86>::create_stream();
 
+#ifdef USE_X86_PLACE
+template <>
+void Context<X86>::set_thread_num(int threads) {
+    _thread_num = threads;
+}
+
+template <>
+int Context<X86>::get_thread_num() {
+    return _thread_num > 0 ? _thread_num : x86_thread_budget().intra_op_num;
+}
+
+template <>
+void Context<X86>::bind_dev() {
+    if (_thread_num <= 0) {
+        _thread_num = x86_thread_budget().intra_op_num;
+    }
+    x86_set_thread_num(_thread_num);
+}
+#endif
+
 } //namespace saber
 
 } //namespace anakin
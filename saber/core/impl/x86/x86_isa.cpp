@@ -0,0 +1,85 @@
+#include "saber/core/impl/x86/x86_isa.h"
+#include <cpuid.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace anakin {
+namespace saber {
+
+/// XCR0, the register states the os saves on context switch
+static inline unsigned long long xgetbv0() {
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+}
+
+X86Isa x86_detect_isa() {
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return X86_ISA_SCALAR;
+    }
+    const bool sse42 = ecx & bit_SSE4_2;
+    const bool fma = ecx & bit_FMA;
+    const bool osxsave = ecx & bit_OSXSAVE;
+    const bool avx = ecx & bit_AVX;
+    if (!sse42) {
+        return X86_ISA_SCALAR;
+    }
+    if (!osxsave || !avx) {
+        return X86_ISA_SSE42;
+    }
+    const unsigned long long xcr0 = xgetbv0();
+    // xmm and ymm states
+    if ((xcr0 & 0x6) != 0x6 || !fma) {
+        return X86_ISA_SSE42;
+    }
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return X86_ISA_SSE42;
+    }
+    const bool avx2 = ebx & bit_AVX2;
+    const bool avx512f = ebx & bit_AVX512F;
+    if (!avx2) {
+        return X86_ISA_SSE42;
+    }
+    // opmask and zmm states
+    if (avx512f && (xcr0 & 0xe6) == 0xe6) {
+        return X86_ISA_AVX512;
+    }
+    return X86_ISA_AVX2;
+}
+
+X86Isa x86_isa() {
+    static const X86Isa isa = [] {
+        X86Isa detected = x86_detect_isa();
+        const char* cap = getenv("ANAKIN_X86_ISA");
+        if (cap != nullptr) {
+            for (int i = X86_ISA_SCALAR; i <= X86_ISA_AVX512; ++i) {
+                if (strcmp(cap, x86_isa_name((X86Isa)i)) == 0 && i < detected) {
+                    detected = (X86Isa)i;
+                }
+            }
+        }
+        return detected;
+    }();
+    return isa;
+}
+
+const char* x86_isa_name(X86Isa isa) {
+    switch (isa) {
+        case X86_ISA_SSE42:
+            return "sse42";
+        case X86_ISA_AVX2:
+            return "avx2";
+        case X86_ISA_AVX512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+} // namespace saber
+} // namespace anakin
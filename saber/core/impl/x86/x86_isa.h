@@ -0,0 +1,44 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_CORE_IMPL_X86_X86_ISA_H
+#define ANAKIN_SABER_CORE_IMPL_X86_X86_ISA_H
+
+namespace anakin {
+namespace saber {
+
+/// x86 instruction set levels which kernels are built for, ordered from the oldest
+enum X86Isa {
+    X86_ISA_SCALAR = 0,
+    X86_ISA_SSE42 = 1,
+    X86_ISA_AVX2 = 2,    ///< avx2 with fma
+    X86_ISA_AVX512 = 3   ///< avx512f
+};
+
+/// the best level the host cpu and os support, from cpuid and xgetbv
+X86Isa x86_detect_isa();
+
+/**
+ * \brief the level x86 kernels run at, detected once.
+ *  It can be lowered with env ANAKIN_X86_ISA=scalar|sse42|avx2|avx512, e.g. to test old paths.
+ */
+X86Isa x86_isa();
+
+const char* x86_isa_name(X86Isa isa);
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_CORE_IMPL_X86_X86_ISA_H
@@ -0,0 +1,146 @@
+#include "saber/core/impl/x86/x86_thread.h"
+#include "anakin_config.h"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <mkl_service.h>
+#include "utils/logger/logger.h"
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace anakin {
+namespace saber {
+
+///< inter-op slots of the process, true where a Worker reserved it
+static std::vector<bool> g_inter_op_slots;
+static std::mutex g_inter_op_mut;
+
+static int env_positive_int(const char* name) {
+    const char* value = getenv(name);
+    if (value == nullptr) {
+        return 0;
+    }
+    return std::max(0, atoi(value));
+}
+
+const std::vector<int>& x86_process_cpus() {
+    static const std::vector<int> cpus = [] {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &cpu_set)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        if (cpus.empty()) {
+            int cpu_num = std::max(1u, std::thread::hardware_concurrency());
+            for (int cpu = 0; cpu < cpu_num; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        int cap = env_positive_int("ANAKIN_X86_CORES");
+        if (cap > 0 && cap < cpus.size()) {
+            cpus.resize(cap);
+        }
+        return cpus;
+    }();
+    return cpus;
+}
+
+int x86_reserve_inter_op_threads(int inter_op_num) {
+    inter_op_num = std::max(1, inter_op_num);
+    int first = 0;
+    {
+        std::lock_guard<std::mutex> guard(g_inter_op_mut);
+        // first fit, a range may run past the end of the slots
+        int end = g_inter_op_slots.size();
+        for (int i = 0; i < end && i < first + inter_op_num; ++i) {
+            if (g_inter_op_slots[i]) {
+                first = i + 1;
+            }
+        }
+        if (first + inter_op_num > end) {
+            g_inter_op_slots.resize(first + inter_op_num, false);
+        }
+        std::fill(g_inter_op_slots.begin() + first, g_inter_op_slots.begin() + first + inter_op_num, true);
+    }
+    X86ThreadBudget budget = x86_thread_budget();
+    LOG(INFO) << "x86 thread budget: " << budget.core_num << " cores, " << budget.inter_op_num
+              << " inter-op threads x " << budget.intra_op_num << " intra-op threads";
+    return first;
+}
+
+void x86_release_inter_op_threads(int first, int inter_op_num) {
+    std::lock_guard<std::mutex> guard(g_inter_op_mut);
+    int end = std::min<int>(first + inter_op_num, g_inter_op_slots.size());
+    for (int i = std::max(0, first); i < end; ++i) {
+        g_inter_op_slots[i] = false;
+    }
+    while (!g_inter_op_slots.empty() && !g_inter_op_slots.back()) {
+        g_inter_op_slots.pop_back();
+    }
+}
+
+X86ThreadBudget x86_thread_budget() {
+    X86ThreadBudget budget;
+    budget.core_num = x86_process_cpus().size();
+    {
+        std::lock_guard<std::mutex> guard(g_inter_op_mut);
+        budget.inter_op_num = std::max<int>(1, g_inter_op_slots.size());
+    }
+    budget.intra_op_num = std::max(1, budget.core_num / budget.inter_op_num);
+    static const int forced_intra_op_num = env_positive_int("ANAKIN_X86_INTRA_OP_THREADS");
+    if (forced_intra_op_num > 0) {
+        budget.intra_op_num = forced_intra_op_num;
+    }
+    return budget;
+}
+
+void x86_set_thread_num(int thread_num) {
+    static thread_local int current_thread_num = 0;
+    thread_num = std::max(1, thread_num);
+    if (thread_num == current_thread_num) {
+        return;
+    }
+    current_thread_num = thread_num;
+#ifdef USE_OPENMP
+    // the omp icv is per thread, it sizes the teams of the bare parallel regions of kernels
+    omp_set_dynamic(0);
+    omp_set_num_threads(thread_num);
+#endif
+    mkl_set_num_threads_local(thread_num);
+}
+
+bool x86_bind_current_thread(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &cpu_set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+        LOG(WARNING) << " bind thread to cpus " << cpus.front() << "-" << cpus.back() << " failed";
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace saber
+} // namespace anakin
@@ -0,0 +1,73 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#ifndef ANAKIN_SABER_CORE_IMPL_X86_X86_THREAD_H
+#define ANAKIN_SABER_CORE_IMPL_X86_X86_THREAD_H
+
+#include <vector>
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief process-wide split of the cores between inter-op threads, which run nets at
+ *  the same time (e.g. the threads of a Worker), and the intra-op omp and mkl threads
+ *  each of them runs kernels with. Without it every net thread starts a team as large
+ *  as the machine and N of them oversubscribe the cores N times.
+ */
+struct X86ThreadBudget {
+    int core_num;       ///< cpus the process may run on
+    int inter_op_num;   ///< threads running nets concurrently
+    int intra_op_num;   ///< omp and mkl threads of each of them
+};
+
+/**
+ * \brief cpus of the process affinity mask in ascending order.
+ *  They can be capped to the first n with env ANAKIN_X86_CORES=n.
+ */
+const std::vector<int>& x86_process_cpus();
+
+/**
+ * \brief reserve inter_op_num more threads running nets concurrently, e.g. the threads of
+ *  a Worker, on top of the ones reserved already. The budget counts 1 when none is.
+ * \return the first slot of the reservation, slot i runs on the i-th share of the cores.
+ *  The shares are sized when a thread binds, so reserve before launching the threads.
+ */
+int x86_reserve_inter_op_threads(int inter_op_num);
+
+/// give back a reservation, its slots are reused by later ones.
+void x86_release_inter_op_threads(int first, int inter_op_num);
+
+/**
+ * \brief the current budget, intra_op_num is core_num / inter_op_num and at least 1.
+ *  Env ANAKIN_X86_INTRA_OP_THREADS=n forces intra_op_num.
+ */
+X86ThreadBudget x86_thread_budget();
+
+/**
+ * \brief set the omp and mkl threads of the parallel regions the calling thread starts,
+ *  other threads keep their own. Cheap when it's unchanged, so it can be called per op.
+ */
+void x86_set_thread_num(int thread_num);
+
+/**
+ * \brief pin the calling thread to cpus, the omp team it starts afterwards inherits them.
+ * \return false if pinning is not supported or failed.
+ */
+bool x86_bind_current_thread(const std::vector<int>& cpus);
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_CORE_IMPL_X86_X86_THREAD_H
@@ -571,6 +571,21 @@ public:
         return SaberSuccess;
     }
 
+    /**
+     *  \brief Swap memory (buffer, shapes, share flags and seq offset) with another tensor,
+     *  events of both tensors are kept. Swapping twice gives the memory back exactly,
+     *  including whether the tensor owned its buffer.
+     */
+    void swap_buffer(Tensor<TargetType, datatype, LayOutType>& tensor) {
+        std::swap(_shape, tensor._shape);
+        std::swap(_valid_shape, tensor._valid_shape);
+        std::swap(_offset, tensor._offset);
+        std::swap(_buf, tensor._buf);
+        std::swap(_is_subbuf, tensor._is_subbuf);
+        std::swap(_is_shared, tensor._is_shared);
+        std::swap(_seq_offset, tensor._seq_offset);
+    }
+
     /**
      *  \brief Deep copy data within region of interest from input tensor.
      */
@@ -0,0 +1,138 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_CONV_DW_PW_H
+#define ANAKIN_SABER_FUNCS_CONV_DW_PW_H
+
+#include "saber/funcs/funcs_utils.h"
+#include "saber/funcs/base.h"
+#include "saber/funcs/impl/impl_base.h"
+#include "saber/funcs/impl/impl_conv_dw_pw.h"
+
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_conv_dw_pw.h"
+#endif
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief depthwise conv -> 1x1 conv of mobilenet style blocks as one function,
+ * the depthwise output is never written out as a whole tensor.
+ * Batchnorm and scale of both convs are folded into their weights at init.
+ */
+template<typename TargetType,
+        DataType OpDtype,
+        DataType inDtype = AK_FLOAT,
+        DataType outDtype = AK_FLOAT,
+        typename LayOutType_op = NCHW,
+        typename LayOutType_in = NCHW,
+        typename LayOutType_out = NCHW
+>
+class ConvDwPw : public BaseFunc<
+        Tensor<TargetType, inDtype, LayOutType_in>,
+        Tensor<TargetType, outDtype, LayOutType_out>,
+        Tensor<TargetType, OpDtype, LayOutType_op>,
+        ImplBase,
+        ConvDwPwParam
+> {
+public:
+    using BaseFunc<
+            Tensor<TargetType, inDtype, LayOutType_in>,
+            Tensor<TargetType, outDtype, LayOutType_out>,
+            Tensor<TargetType, OpDtype, LayOutType_op>,
+            ImplBase,
+            ConvDwPwParam>::BaseFunc;
+
+    ConvDwPw() = default;
+
+    typedef Tensor<TargetType, inDtype, LayOutType_in> InDataTensor;
+    typedef Tensor<TargetType, outDtype, LayOutType_out> OutDataTensor;
+    typedef Tensor<TargetType, OpDtype, LayOutType_op> OpTensor;
+    typedef ConvDwPwParam<OpTensor> Param_t;
+    typedef std::vector<InDataTensor *> Input_v;
+    typedef std::vector<OutDataTensor *> Output_v;
+    typedef std::vector<Shape> Shape_v;
+
+    virtual SaberStatus compute_output_shape(const Input_v& input, Output_v& output, \
+        Param_t& param) override {
+
+        ConvParam<OpTensor>& dw_param = param.dw_param.conv_param;
+        ConvParam<OpTensor>& pw_param = param.pw_param.conv_param;
+        Shape output_shape = input[0]->valid_shape();
+
+        // the 1x1 conv keeps the spatial size of the depthwise output
+        int kernel_exten = dw_param.dilation_h * (dw_param.weight()->height() - 1) + 1;
+        int out_h = (input[0]->height() + 2 * dw_param.pad_h - kernel_exten) / dw_param.stride_h + 1;
+        out_h = (out_h + 2 * pw_param.pad_h - pw_param.weight()->height()) / pw_param.stride_h + 1;
+        kernel_exten = dw_param.dilation_w * (dw_param.weight()->width() - 1) + 1;
+        int out_w = (input[0]->width() + 2 * dw_param.pad_w - kernel_exten) / dw_param.stride_w + 1;
+        out_w = (out_w + 2 * pw_param.pad_w - pw_param.weight()->width()) / pw_param.stride_w + 1;
+
+        output_shape[input[0]->num_index()] = input[0]->num();
+        output_shape[input[0]->channel_index()] = pw_param.weight()->num();
+        output_shape[input[0]->height_index()] = out_h;
+        output_shape[input[0]->width_index()] = out_w;
+        return output[0]->set_shape(output_shape);
+    }
+
+    virtual SaberStatus init_impl(ImplEnum implenum) override {
+        switch (implenum) {
+            case VENDER_IMPL:
+                this->_impl.push_back(new VenderConvDwPw <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            case SABER_IMPL:
+                this->_impl.push_back(new SaberConvDwPw <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            default:
+                return SaberUnImplError;
+        }
+    }
+
+    virtual SaberStatus init(const Input_v& input, Output_v& output, Param_t& param,
+                      SaberImplStrategy strategy, ImplEnum implenum,
+                      Context<TargetType> &ctx) override {
+
+        update_conv_weights<OpTensor, ConvActiveParam>(param.dw_param);
+        update_conv_weights<OpTensor, ConvActiveParam>(param.pw_param);
+
+        return BaseFunc<Tensor<TargetType, inDtype, LayOutType_in>,
+                Tensor<TargetType, outDtype, LayOutType_out>,
+                Tensor<TargetType, OpDtype, LayOutType_op>,
+                ImplBase,
+                ConvDwPwParam>::init(input, output, param, strategy, implenum, ctx);
+    }
+
+private:
+
+    virtual void pick_best_static() override {
+        if (true) // some condition?
+            this->_best_impl = this->_impl[0];
+    }
+
+    virtual void pick_best_specify(ImplEnum implenum) override {
+        this->_best_impl = this->_impl[0];
+    }
+
+};
+
+}
+}
+
+#endif //ANAKIN_SABER_FUNCS_CONV_DW_PW_H
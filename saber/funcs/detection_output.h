@@ -23,7 +23,7 @@
 #endif
 
 #ifdef USE_X86_PLACE
-#include "saber/funcs/impl/impl_detection_output.h"
+#include "saber/funcs/impl/x86/saber_detection_output.h"
 #endif
 
 #ifdef USE_ARM_PLACE
@@ -68,11 +68,17 @@ public:
 
     virtual SaberStatus compute_output_shape(const Input_v &input, \
         Output_v &output, Param_t &param) override {
+        //! rows of (image, label, score, xmin, ymin, xmax, ymax), at most keep_top_k per image
+        //! or every score when keep_top_k is -1, and one row of -1 when nothing is detected
         Shape shape_out = output[0]->valid_shape();
         CHECK_EQ(shape_out.dims(), 4) << "only support 4d layout";
+        int max_rows = input[1]->valid_size();
+        if (param.keep_top_k > -1) {
+            max_rows = input[0]->num() * param.keep_top_k;
+        }
         shape_out[0] = 1;
         shape_out[1] = 1;
-        shape_out[2] = param.keep_top_k;
+        shape_out[2] = max_rows > 1 ? max_rows : 1;
         shape_out[3] = 7;
 
         return output[0]->set_shape(shape_out);
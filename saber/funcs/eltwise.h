@@ -32,6 +32,33 @@
 namespace anakin {
 namespace saber {
 
+/**
+ * \brief numpy style broadcast of eltwise inputs: every dim of an input equals the one
+ *  of the output or is 1, e.g. bias like [1, c, 1, 1] and gate like [n, c, 1, 1] inputs.
+ *  Targets without broadcast kernels reject inputs of different shapes in create.
+ */
+inline SaberStatus eltwise_broadcast_shape(const std::vector<Shape>& shapes, Shape& out_shape) {
+    out_shape = shapes[0];
+    for (int i = 1; i < shapes.size(); ++i) {
+        if (shapes[i].dims() != out_shape.dims()) {
+            LOG(ERROR) << "eltwise inputs must have the same rank";
+            return SaberInvalidValue;
+        }
+        for (int d = 0; d < out_shape.dims(); ++d) {
+            if (shapes[i][d] == out_shape[d] || shapes[i][d] == 1) {
+                continue;
+            }
+            if (out_shape[d] != 1) {
+                LOG(ERROR) << "eltwise input " << i << " can't broadcast at dim " << d
+                           << ": " << shapes[i][d] << " vs " << out_shape[d];
+                return SaberInvalidValue;
+            }
+            out_shape[d] = shapes[i][d];
+        }
+    }
+    return SaberSuccess;
+}
+
 template<typename TargetType,
         DataType OpDtype,
         DataType inDtype = AK_FLOAT,
@@ -67,14 +94,15 @@ public:
 
     virtual SaberStatus compute_output_shape(const Input_v& input, Output_v& output, \
         Param_t& param) override {
-        for (int i = 1; i < input.size(); ++i) {
-            CHECK_EQ(input[0]->num(), input[i]->num());
-            CHECK_EQ(input[0]->channel(), input[i]->channel());
-            CHECK_EQ(input[0]->height(), input[i]->height());
-            CHECK_EQ(input[0]->width(), input[i]->width());
+        std::vector<Shape> input_shapes;
+        for (int i = 0; i < input.size(); ++i) {
+            input_shapes.push_back(input[i]->valid_shape());
+        }
+        Shape output_shape;
+        SaberStatus status = eltwise_broadcast_shape(input_shapes, output_shape);
+        if (status != SaberSuccess) {
+            return status;
         }
-
-        Shape output_shape = input[0]->valid_shape();
         output[0]->set_shape(output_shape);
 
         return SaberSuccess;
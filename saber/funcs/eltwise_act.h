@@ -19,6 +19,7 @@
 #include "saber/funcs/base.h"
 #include "saber/funcs/impl/impl_base.h"
 #include "saber/funcs/impl/impl_eltwise_act.h"
+#include "saber/funcs/eltwise.h"
 #ifdef NVIDIA_GPU
 #include "saber/funcs/impl/cuda/saber_eltwise_act.h"
 #endif
@@ -69,14 +70,15 @@ public:
 
     virtual SaberStatus compute_output_shape(const Input_v& input, Output_v& output, \
         Param_t& param) override {
-        for (int i = 1; i < input.size(); ++i) {
-                    CHECK_EQ(input[0]->num(), input[i]->num());
-                    CHECK_EQ(input[0]->channel(), input[i]->channel());
-                    CHECK_EQ(input[0]->height(), input[i]->height());
-                    CHECK_EQ(input[0]->width(), input[i]->width());
+        std::vector<Shape> input_shapes;
+        for (int i = 0; i < input.size(); ++i) {
+            input_shapes.push_back(input[i]->valid_shape());
+        }
+        Shape output_shape;
+        SaberStatus status = eltwise_broadcast_shape(input_shapes, output_shape);
+        if (status != SaberSuccess) {
+            return status;
         }
-
-        Shape output_shape = input[0]->valid_shape();
         output[0]->set_shape(output_shape);
 
         return SaberSuccess;
@@ -0,0 +1,135 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+   
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. 
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_FC_SOFTMAX_ARGMAX_H
+#define ANAKIN_SABER_FUNCS_FC_SOFTMAX_ARGMAX_H
+
+#include "saber/funcs/base.h"
+#include "saber/funcs/impl/impl_base.h"
+#include "saber/funcs/impl/impl_fc_softmax_argmax.h"
+
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_fc_softmax_argmax.h"
+#endif
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief output layer of large vocabulary model: fc -> softmax -> top k argmax,
+ * only the top k ids (and probabilities when out_max_val is set) of every row are
+ * written, the output layout is the same as Argmax.
+ */
+template<typename TargetType,
+        DataType OpDtype,
+        DataType inDtype = AK_FLOAT,
+        DataType outDtype = AK_FLOAT,
+        typename LayOutType_op = NCHW,
+        typename LayOutType_in = NCHW,
+        typename LayOutType_out = NCHW
+>
+class FcSoftmaxArgmax : public BaseFunc<
+        Tensor<TargetType, inDtype, LayOutType_in>,
+        Tensor<TargetType, outDtype, LayOutType_out>,
+        Tensor<TargetType, OpDtype, LayOutType_op>,
+        ImplBase,
+        FcSoftmaxArgmaxParam
+> {
+public:
+    using BaseFunc<
+            Tensor<TargetType, inDtype, LayOutType_in>,
+            Tensor<TargetType, outDtype, LayOutType_out>,
+            Tensor<TargetType, OpDtype, LayOutType_op>,
+            ImplBase,
+            FcSoftmaxArgmaxParam>::BaseFunc;
+
+    FcSoftmaxArgmax() = default;
+
+    typedef Tensor<TargetType, inDtype, LayOutType_in> InDataTensor;
+    typedef Tensor<TargetType, outDtype, LayOutType_out> OutDataTensor;
+    typedef Tensor<TargetType, OpDtype, LayOutType_op> OpTensor;
+    typedef FcSoftmaxArgmaxParam<OpTensor> Param_t;
+    typedef std::vector<InDataTensor *> Input_v;
+    typedef std::vector<OutDataTensor *> Output_v;
+    typedef std::vector<Shape> Shape_v;
+
+    virtual SaberStatus compute_output_shape(const Input_v& input, Output_v& output, \
+        Param_t& param) override {
+
+        FcParam<OpTensor>& fc_param = param.fc_param;
+        ArgmaxParam<OpTensor>& argmax_param = param.argmax_param;
+        int m = input[0]->count_valid(0, fc_param.axis);
+        int k = input[0]->count_valid(fc_param.axis, input[0]->dims());
+        int n = fc_param.num_output;
+        int weights_size = fc_param.weights->valid_size();
+        if (n <= 0) {
+            n = weights_size / k;
+        }
+        CHECK_EQ(weights_size / n, k) << "weights size does not meet the input size";
+        CHECK_LE(argmax_param.top_k, n) << "top k should not be larger than fc output";
+
+        // fc output is (m, n, 1, 1), argmax runs along n.
+        Shape output_shape = input[0]->valid_shape();
+        for (int i = 0; i < output_shape.dims(); ++i) {
+            output_shape[i] = 1;
+        }
+        output_shape[0] = m;
+        if (argmax_param.has_axis) {
+            CHECK_EQ(argmax_param.axis, 1) << "argmax should run along fc output channel";
+            output_shape[1] = argmax_param.top_k;
+        } else {
+            output_shape[2] = argmax_param.top_k;
+            if (argmax_param.out_max_val) {
+                output_shape[1] = 2;
+            }
+        }
+        output[0]->set_seq_offset(input[0]->get_seq_offset());
+        return output[0]->set_shape(output_shape);
+    }
+
+    virtual SaberStatus init_impl(ImplEnum implenum) override {
+        switch (implenum) {
+            case VENDER_IMPL:
+                this->_impl.push_back(new VenderFcSoftmaxArgmax <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            case SABER_IMPL:
+                this->_impl.push_back(new SaberFcSoftmaxArgmax <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            default:
+                return SaberUnImplError;
+        }
+    }
+
+private:
+
+    virtual void pick_best_static() override {
+        if (true) // some condition?
+            this->_best_impl = this->_impl[0];
+    }
+
+    virtual void pick_best_specify(ImplEnum implenum) override {
+        this->_best_impl = this->_impl[0];
+    }
+
+};
+
+}
+}
+
+#endif //ANAKIN_SABER_FUNCS_FC_SOFTMAX_ARGMAX_H
@@ -275,6 +275,10 @@ LayOutType_op, LayOutType_in, LayOutType_out>::create(\
         Context<ARM> &ctx) {
     this->_ctx = &ctx;
     this->_coeff = param.coeff;
+    if (!param.chain_ops.empty()) {
+        LOG(ERROR) << "eltwise chain is not supported on ARM";
+        return SaberUnImplError;
+    }
     Shape sh_out_saber = outputs[0]->valid_shape();
     for (int i = 0; i < inputs.size(); i ++){
         Shape sh_in_saber = inputs[i]->valid_shape();
@@ -100,6 +100,10 @@ SaberStatus SaberResize<NV, OpDtype, inDtype, outDtype,\
     const std::vector<DataTensor_in *>& inputs, \
     std::vector<DataTensor_out *>& outputs, \
     ResizeParam<OpTensor>& param) {
+    if (param.resize_type != Resize_bilinear) {
+        LOG(ERROR) << "cuda resize only supports bilinear interpolation";
+        return SaberUnImplError;
+    }
     cudaStream_t stream = this->_ctx->get_compute_stream();
 
     int w_out = outputs[0]->width();
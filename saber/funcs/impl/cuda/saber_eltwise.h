@@ -61,6 +61,16 @@ public:
                            EltwiseParam<OpTensor> &param,
                            Context<NV> &ctx) {
         this->_ctx = &ctx;
+        if (!param.chain_ops.empty()) {
+            LOG(ERROR) << "eltwise chain is not supported on NV";
+            return SaberUnImplError;
+        }
+        for (int i = 0; i < inputs.size(); ++i) {
+            if (inputs[i]->valid_shape() != outputs[0]->valid_shape()) {
+                LOG(ERROR) << "eltwise broadcast is not supported on NV";
+                return SaberUnImplError;
+            }
+        }
         if ((param.operation == Eltwise_max) && (outputs.size() == 1)) {
             _max_idx.reshape(inputs[0]->shape());
         }
@@ -64,6 +64,16 @@ public:
 
         this->_ctx = &ctx;
         EltwiseParam<OpTensor> &elt_param = param.eltwise_param;
+        if (!elt_param.chain_ops.empty()) {
+            LOG(ERROR) << "eltwise chain is not supported on NV";
+            return SaberUnImplError;
+        }
+        for (int i = 0; i < inputs.size(); ++i) {
+            if (inputs[i]->valid_shape() != outputs[0]->valid_shape()) {
+                LOG(ERROR) << "eltwise broadcast is not supported on NV";
+                return SaberUnImplError;
+            }
+        }
         if ((elt_param.operation == Eltwise_max) && (outputs.size() == 1)) {
             _max_idx.reshape(inputs[0]->shape());
         }
@@ -22,6 +22,7 @@ SaberStatus SaberConv2D<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::di
                     param.group,param.weight()->width(),param.weight()->height(),
                     param.stride_w,param.stride_h,param.dilation_w,param.dilation_h,
                     param.pad_w,param.pad_h,with_bias,false);
+    return SaberSuccess;
 };
 template class SaberConv2D<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
 
@@ -8,6 +8,7 @@
 #include "saber/funcs/impl/x86/jit_avx512_conv_act.h"
 #include "saber/funcs/impl/x86/jit_avx2_conv_act.h"
 #include "saber/funcs/impl/x86/x86_utils.h"
+#include "saber/funcs/impl/x86/x86_activation.h"
 
 namespace anakin {
 namespace saber {
@@ -34,8 +35,16 @@ SaberStatus SaberConv2DAct<X86, OpDtype, inDtype, outDtype,
     const OpTensor *weight = conv_param->weight();
     Shape weight_shape(weight->shape());
 
+    bool nchw = std::is_same<LayOutType_out, NCHW>::value && std::is_same<LayOutType_in, NCHW>::value
+                && std::is_same<LayOutType_op, NCHW>::value;
+    if (conv_act_with_sum(param) && !(nchw && conv_act_sum_supported(param))) {
+        // the jit kernels of the blocked layouts don't accumulate a residual
+        LOG(ERROR) << "only a residual sum with unit coefficients can be fused into x86 NCHW conv";
+        return SaberUnImplError;
+    }
+
     // go to different engines per different input parameters
-    if(std::is_same<LayOutType_out, NCHW>::value&&std::is_same<LayOutType_in, NCHW>::value&&std::is_same<LayOutType_op, NCHW>::value){
+    if(nchw){
         return SaberSuccess;
     }
     else if (conv_param->group == weight_shape[0] && conv_param->group == weight_shape[1]) {
@@ -138,9 +147,13 @@ SaberStatus SaberConv2DAct<X86, OpDtype, inDtype, outDtype,
             bias_ptr=param.conv_param.bias()->data();
             with_bias=true;
         }
+        const ActivationParam<OpTensor>* act=conv_act_activation(param);
         bool with_relu=false;
-        if(param.has_active&&param.activation_param.active==Active_relu){
+        bool with_act_epilogue=false;
+        if(act!=nullptr&&act->active==Active_relu&&act->negative_slope==0.f){
             with_relu=true;
+        }else if(act!=nullptr){
+            with_act_epilogue=true;
         }
         CHECK_NOTNULL(outputs[0])<<"outputs can not be null";
 //        conv_basic_x86(*outputs[0],*inputs[0],param.conv_param.weight()->data(),bias_ptr,
@@ -150,7 +163,14 @@ SaberStatus SaberConv2DAct<X86, OpDtype, inDtype, outDtype,
         im2col_conv_cpu(*outputs[0],*inputs[0],_im2col_workspace,param.conv_param.weight()->data(),bias_ptr,
                    param.conv_param.group,param.conv_param.weight()->width(),param.conv_param.weight()->height(),
                    param.conv_param.stride_w,param.conv_param.stride_h,param.conv_param.dilation_w,param.conv_param.dilation_h,
-                   param.conv_param.pad_w,param.conv_param.pad_h,with_bias,with_relu);
+                   param.conv_param.pad_w,param.conv_param.pad_h,with_bias,with_relu,conv_act_with_sum(param));
+        if(with_act_epilogue){
+            X86ActParam act_param=make_x86_act_param(*act);
+            float* out_data=outputs[0]->mutable_data();
+            int num=outputs[0]->num();
+            int channel=outputs[0]->channel();
+            x86_act_forward(out_data,out_data,num,channel,outputs[0]->valid_size()/(num*channel),act_param);
+        }
         return SaberSuccess;
     }
 
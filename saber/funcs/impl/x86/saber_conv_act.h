@@ -20,6 +20,44 @@
 
 namespace anakin {
 namespace saber {
+
+/**
+ * A conv act param may carry the residual eltwise the conv was fused with
+ * (see ConvElsFusionScheduler). The output tensor then already holds the residual,
+ * so the NCHW kernel accumulates into it and applies the activation after the sum.
+ * The jit kernels of the blocked layouts refuse such a param.
+ */
+template <typename opTensor>
+inline bool conv_act_with_sum(const ConvActiveParam<opTensor>& param) {
+    return param.has_eltwise || param.has_eltwise_act;
+}
+
+/// only a plain sum with unit coefficients folds into the accumulators
+template <typename opTensor>
+inline bool conv_act_sum_supported(const ConvActiveParam<opTensor>& param) {
+    const EltwiseParam<opTensor>& elt = param.has_eltwise_act ?
+            param.eltwise_act_param.eltwise_param : param.eltwise_param;
+    if (elt.operation != Eltwise_sum) {
+        return false;
+    }
+    for (auto coeff : elt.coeff) {
+        if (coeff != 1.f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// the activation applied last, after the residual sum if any, or nullptr
+template <typename opTensor>
+inline const ActivationParam<opTensor>* conv_act_activation(const ConvActiveParam<opTensor>& param) {
+    if (param.has_eltwise_act) {
+        return param.eltwise_act_param.has_activation ? &param.eltwise_act_param.activation_param
+                                                      : nullptr;
+    }
+    return param.has_active ? &param.activation_param : nullptr;
+}
+
 template <DataType OpDtype,
           DataType inDtype,
           DataType outDtype,
@@ -0,0 +1,228 @@
+#include "saber/funcs/impl/x86/saber_conv_dw_pw.h"
+#include "saber/funcs/impl/x86/saber_conv_act.h"
+#include "saber/funcs/impl/x86/x86_activation.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+#include "mkl_cblas.h"
+#include <algorithm>
+
+namespace anakin{
+namespace saber {
+
+///< floats of the depthwise output tile of one thread, half of a typical L2 cache
+static const int kDwTileSize = 32 * 1024;
+
+/// first output index whose input index out * stride + offset is not negative
+static inline int dw_first_valid(int offset, int stride) {
+    return offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+}
+
+/// one past the last output index whose input index out * stride + offset is below size
+static inline int dw_last_valid(int offset, int stride, int size, int out_size) {
+    if (size - 1 - offset < 0) {
+        return 0;
+    }
+    return std::min(out_size, (size - 1 - offset) / stride + 1);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberConvDwPw<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvDwPwParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberConvDwPw<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvDwPwParam<OpTensor> &param, Context<X86> &ctx) {
+    if (inDtype != AK_FLOAT) {
+        LOG(ERROR) << "conv dw pw only supports FP32 currently";
+        return SaberUnImplError;
+    }
+    this->_ctx = &ctx;
+    this->_param = &param;
+
+    ConvParam<OpTensor>& dw_param = param.dw_param.conv_param;
+    ConvParam<OpTensor>& pw_param = param.pw_param.conv_param;
+    const int channel = inputs[0]->channel();
+    Shape dw_shape = dw_param.weight()->valid_shape();
+    Shape pw_shape = pw_param.weight()->valid_shape();
+    if (dw_param.group != channel || dw_shape[0] != channel || dw_shape[1] != 1) {
+        LOG(ERROR) << "the first conv of conv dw pw must be depthwise";
+        return SaberUnImplError;
+    }
+    if (pw_param.group != 1 || pw_shape[1] != channel || pw_shape[2] != 1 || pw_shape[3] != 1
+            || pw_param.stride_h != 1 || pw_param.stride_w != 1
+            || pw_param.pad_h != 0 || pw_param.pad_w != 0) {
+        LOG(ERROR) << "the second conv of conv dw pw must be a 1x1 conv of stride 1 without padding";
+        return SaberUnImplError;
+    }
+    if (conv_act_with_sum(param.dw_param) || conv_act_with_sum(param.pw_param)) {
+        LOG(ERROR) << "conv dw pw does not fuse eltwise";
+        return SaberUnImplError;
+    }
+
+    const ActivationParam<OpTensor>* dw_act = conv_act_activation(param.dw_param);
+    const ActivationParam<OpTensor>* pw_act = conv_act_activation(param.pw_param);
+    if ((dw_act && !x86_act_supported(dw_act->active))
+            || (pw_act && !x86_act_supported(pw_act->active))) {
+        LOG(ERROR) << "unsupported activation of conv dw pw";
+        return SaberUnImplError;
+    }
+    _with_dw_act = dw_act != nullptr;
+    _with_pw_act = pw_act != nullptr;
+    if (_with_dw_act) {
+        _dw_act = make_x86_act_param(*dw_act);
+    }
+    if (_with_pw_act) {
+        _pw_act = make_x86_act_param(*pw_act);
+    }
+
+    // tiles as large as the cache budget, but enough of them to keep every thread busy
+    const int num = outputs[0]->num();
+    const int out_h = outputs[0]->height();
+    const int out_w = outputs[0]->width();
+    _thread_num = omp_get_max_threads();
+    _tile_rows = std::max(1, kDwTileSize / std::max(channel * out_w, 1));
+    int tiles_wanted = utils::div_up(_thread_num, std::max(num, 1));
+    _tile_rows = std::min(_tile_rows, utils::div_up(out_h, tiles_wanted));
+    _tile_rows = std::max(1, std::min(_tile_rows, out_h));
+    _tiles_per_image = utils::div_up(out_h, _tile_rows);
+
+    _dw_tile.re_alloc(Shape(_thread_num, channel, _tile_rows, out_w));
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberConvDwPw<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvDwPwParam<OpTensor> &param) {
+    ConvParam<OpTensor>& dw_param = param.dw_param.conv_param;
+    ConvParam<OpTensor>& pw_param = param.pw_param.conv_param;
+    const float* src = inputs[0]->data();
+    const float* dw_weight = dw_param.weight()->data();
+    const float* pw_weight = pw_param.weight()->data();
+    const float* dw_bias = dw_param.bias() && dw_param.bias()->valid_size() > 0 ?
+                           dw_param.bias()->data() : nullptr;
+    const float* pw_bias = pw_param.bias() && pw_param.bias()->valid_size() > 0 ?
+                           pw_param.bias()->data() : nullptr;
+    float* dst = outputs[0]->mutable_data();
+
+    const int num = inputs[0]->num();
+    const int channel = inputs[0]->channel();
+    const int in_h = inputs[0]->height();
+    const int in_w = inputs[0]->width();
+    const int out_c = outputs[0]->channel();
+    const int out_h = outputs[0]->height();
+    const int out_w = outputs[0]->width();
+    const int kernel_h = dw_param.weight()->height();
+    const int kernel_w = dw_param.weight()->width();
+    const int stride_h = dw_param.stride_h;
+    const int stride_w = dw_param.stride_w;
+    const int pad_h = dw_param.pad_h;
+    const int pad_w = dw_param.pad_w;
+    const int dilation_h = dw_param.dilation_h;
+    const int dilation_w = dw_param.dilation_w;
+    const int tile_rows = _tile_rows;
+    const int tiles_per_image = _tiles_per_image;
+    const int tile_size = channel * tile_rows * out_w;
+    float* tile_all = _dw_tile.mutable_data();
+
+    #pragma omp parallel for schedule(static) num_threads(_thread_num)
+    for (int task = 0; task < num * tiles_per_image; ++task) {
+        const int n = task / tiles_per_image;
+        const int row_start = (task % tiles_per_image) * tile_rows;
+        const int rows = std::min(tile_rows, out_h - row_start);
+        const int len = rows * out_w;
+        float* tile = tile_all + omp_get_thread_num() * tile_size;
+
+        // depthwise rows of every channel, one kernel tap at a time over the valid columns
+        for (int c = 0; c < channel; ++c) {
+            const float* in_c = src + (n * channel + c) * in_h * in_w;
+            const float* w_c = dw_weight + c * kernel_h * kernel_w;
+            float* tile_c = tile + c * len;
+            const float b = dw_bias ? dw_bias[c] : 0.f;
+            for (int i = 0; i < len; ++i) {
+                tile_c[i] = b;
+            }
+            for (int r = 0; r < rows; ++r) {
+                float* out_row = tile_c + r * out_w;
+                const int ih_start = (row_start + r) * stride_h - pad_h;
+                for (int kh = 0; kh < kernel_h; ++kh) {
+                    const int ih = ih_start + kh * dilation_h;
+                    if (ih < 0 || ih >= in_h) {
+                        continue;
+                    }
+                    const float* in_row = in_c + ih * in_w;
+                    for (int kw = 0; kw < kernel_w; ++kw) {
+                        const int offset = kw * dilation_w - pad_w;
+                        const int ow_start = dw_first_valid(offset, stride_w);
+                        const int ow_end = dw_last_valid(offset, stride_w, in_w, out_w);
+                        const float w = w_c[kh * kernel_w + kw];
+                        if (stride_w == 1) {
+                            const float* in_ptr = in_row + ow_start + offset;
+                            float* out_ptr = out_row + ow_start;
+                            for (int i = 0; i < ow_end - ow_start; ++i) {
+                                out_ptr[i] += w * in_ptr[i];
+                            }
+                        } else {
+                            for (int ow = ow_start; ow < ow_end; ++ow) {
+                                out_row[ow] += w * in_row[ow * stride_w + offset];
+                            }
+                        }
+                    }
+                }
+            }
+            if (_with_dw_act) {
+                x86_act_range(tile_c, tile_c, len, _dw_act, c);
+            }
+        }
+
+        // 1x1 conv of the tile straight into the output rows
+        float* out_tile = dst + n * out_c * out_h * out_w + row_start * out_w;
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, out_c, len, channel,
+                    1.f, pw_weight, channel, tile, len, 0.f, out_tile, out_h * out_w);
+        if (pw_bias || _with_pw_act) {
+            for (int oc = 0; oc < out_c; ++oc) {
+                float* out_ptr = out_tile + oc * out_h * out_w;
+                if (pw_bias) {
+                    const float b = pw_bias[oc];
+                    for (int i = 0; i < len; ++i) {
+                        out_ptr[i] += b;
+                    }
+                }
+                if (_with_pw_act) {
+                    x86_act_range(out_ptr, out_ptr, len, _pw_act, oc);
+                }
+            }
+        }
+    }
+    return SaberSuccess;
+}
+
+template class SaberConvDwPw<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+}
+} // namespace anakin
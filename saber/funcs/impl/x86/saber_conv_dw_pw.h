@@ -0,0 +1,85 @@
+/* Copyright (c) 2016 Anakin Authors All Rights Reserve.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_CONV_DW_PW_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_CONV_DW_PW_H
+
+#include "saber/funcs/impl/impl_conv_dw_pw.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#include "saber/saber_funcs_param.h"
+
+namespace anakin{
+namespace saber {
+
+/**
+ * the output rows of every image are split in tiles, a thread computes the depthwise
+ * output of all the channels of a tile into its own buffer, sized to stay in cache,
+ * and the 1x1 conv of the tile is one gemm from that buffer into the output rows.
+ */
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+class SaberConvDwPw<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out> : public ImplBase<
+        Tensor<X86, inDtype, LayOutType_in>,
+        Tensor<X86, outDtype, LayOutType_out>,
+        Tensor<X86, OpDtype, LayOutType_op>,
+        ConvDwPwParam<Tensor<X86, OpDtype, LayOutType_op> > > {
+public:
+    typedef Tensor<X86, inDtype, LayOutType_in> DataTensor_in;
+    typedef Tensor<X86, outDtype, LayOutType_out> DataTensor_out;
+    typedef Tensor<X86, OpDtype, LayOutType_op> OpTensor;
+    typedef typename DataTensor_in::Dtype DataType_in;
+    typedef typename DataTensor_out::Dtype DataType_out;
+    typedef typename OpTensor::Dtype DataType_op;
+
+    SaberConvDwPw() = default;
+
+    ~SaberConvDwPw() {}
+
+    virtual SaberStatus init(const std::vector<DataTensor_in*>& inputs,
+                             std::vector<DataTensor_out*>& outputs,
+                             ConvDwPwParam<OpTensor> &param,
+                             Context<X86> &ctx) override;
+
+    virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
+                               std::vector<DataTensor_out*>& outputs,
+                               ConvDwPwParam<OpTensor> &param,
+                               Context<X86> &ctx) override;
+
+    virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
+                                 std::vector<DataTensor_out*>& outputs,
+                                 ConvDwPwParam<OpTensor> &param) override;
+
+private:
+    ///< output rows of one tile
+    int _tile_rows{1};
+    int _tiles_per_image{1};
+    int _thread_num{1};
+    bool _with_dw_act{false};
+    bool _with_pw_act{false};
+    X86ActParam _dw_act;
+    X86ActParam _pw_act;
+    ///< per thread depthwise output tile, channel * _tile_rows * out_w
+    DataTensor_in _dw_tile;
+};
+
+}
+}
+
+#endif
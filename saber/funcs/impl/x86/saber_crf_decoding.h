@@ -17,6 +17,7 @@
 
 #include "saber/funcs/impl/impl_crf_decoding.h"
 #include "saber/saber_funcs_param.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
 
 namespace anakin{
 namespace saber {
@@ -68,6 +69,7 @@ private:
     DataTensor_in _trans;
     DataTensor_in _emis;
     int _aligned_tag_num;
+    const X86Kernels* _kernels{nullptr};
 };
 }
 }
@@ -0,0 +1,252 @@
+#include "saber/funcs/impl/x86/saber_deconv.h"
+#include "saber/funcs/impl/x86/x86_activation.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+#include "mkl_cblas.h"
+#include <algorithm>
+#include <vector>
+
+namespace anakin{
+namespace saber {
+
+template class SaberDeconv2D<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+namespace {
+
+struct DeconvShape {
+    int ih, iw, oh, ow;
+    int kh, kw;
+    int stride_h, stride_w;
+    int pad_h, pad_w;
+    int dila_h, dila_w;
+};
+
+/// [first, last) of the input columns whose tap at out0 + i * stride lands in [0, out_size)
+inline void valid_range(int out0, int stride, int in_size, int out_size, int& first, int& last) {
+    first = out0 < 0 ? (-out0 + stride - 1) / stride : 0;
+    last = out0 < out_size ? std::min(in_size, (out_size - 1 - out0) / stride + 1) : 0;
+}
+
+/// adds the kh * kw rows of one output channel, each [ih, iw], to its plane
+void col2im_plane(const X86Kernels& kernels, const float* col, float* plane, const DeconvShape& s) {
+    const int in_size = s.ih * s.iw;
+    for (int ky = 0; ky < s.kh; ++ky) {
+        int iy_first = 0;
+        int iy_last = 0;
+        const int oy0 = ky * s.dila_h - s.pad_h;
+        valid_range(oy0, s.stride_h, s.ih, s.oh, iy_first, iy_last);
+        for (int kx = 0; kx < s.kw; ++kx) {
+            int ix_first = 0;
+            int ix_last = 0;
+            const int ox0 = kx * s.dila_w - s.pad_w;
+            valid_range(ox0, s.stride_w, s.iw, s.ow, ix_first, ix_last);
+            const float* col_k = col + (size_t)(ky * s.kw + kx) * in_size;
+            for (int iy = iy_first; iy < iy_last; ++iy) {
+                const float* col_row = col_k + iy * s.iw;
+                float* out_row = plane + (size_t)(oy0 + iy * s.stride_h) * s.ow + ox0;
+                if (s.stride_w == 1) {
+                    kernels.elt_apply(Eltwise_sum, out_row + ix_first, col_row + ix_first, false, 1.f,
+                                      ix_last - ix_first);
+                } else {
+                    for (int ix = ix_first; ix < ix_last; ++ix) {
+                        out_row[ix * s.stride_w] += col_row[ix];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief depthwise deconv of one plane, dilation 1.
+ *  The outputs of a row at phase px of the stride take the same kernel columns, each of them
+ *  over contiguous inputs, so a phase is summed in buf as axpys and then scattered to the row.
+ */
+void deconv_dw_plane(const X86Kernels& kernels, const float* in, const float* weight, float bias,
+                     float* plane, const DeconvShape& s, float* buf) {
+    for (int oy = 0; oy < s.oh; ++oy) {
+        float* out_row = plane + (size_t)oy * s.ow;
+        const int uy = oy + s.pad_h;
+        for (int px = 0; px < s.stride_w; ++px) {
+            const int ox0 = ((px - s.pad_w) % s.stride_w + s.stride_w) % s.stride_w;
+            if (ox0 >= s.ow) {
+                continue;
+            }
+            const int n = (s.ow - 1 - ox0) / s.stride_w + 1;
+            std::fill(buf, buf + n, bias);
+            for (int ky = uy % s.stride_h; ky < s.kh; ky += s.stride_h) {
+                if (uy < ky) {
+                    break;
+                }
+                const int iy = (uy - ky) / s.stride_h;
+                if (iy >= s.ih) {
+                    continue;
+                }
+                const float* in_row = in + (size_t)iy * s.iw;
+                for (int kx = (ox0 + s.pad_w) % s.stride_w; kx < s.kw; kx += s.stride_w) {
+                    // kx and ox0 + pad_w are alike modulo the stride, so the division is exact
+                    const int base = (ox0 + s.pad_w - kx) / s.stride_w;
+                    const int first = std::max(0, -base);
+                    const int last = std::min(n, s.iw - base);
+                    if (last > first) {
+                        kernels.elt_apply(Eltwise_sum, buf + first, in_row + base + first, false,
+                                          weight[ky * s.kw + kx], last - first);
+                    }
+                }
+            }
+            for (int j = 0; j < n; ++j) {
+                out_row[ox0 + j * s.stride_w] = buf[j];
+            }
+        }
+    }
+}
+
+} // namespace
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDeconv2D<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDeconv2D<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    const int ic = inputs[0]->channel();
+    const int oc = outputs[0]->channel();
+    const int group = param.group;
+    if (group <= 0 || ic % group != 0 || oc % group != 0) {
+        LOG(ERROR) << "deconv group " << group << " doesn't divide " << ic << " input and "
+                   << oc << " output channels";
+        return SaberInvalidValue;
+    }
+    if (_with_act && !x86_act_supported(_act.type)) {
+        LOG(ERROR) << "x86 deconv doesn't support activation " << _act.type;
+        return SaberUnImplError;
+    }
+    const int kh = param.weight()->height();
+    const int kw = param.weight()->width();
+    _direct = group == ic && group == oc && param.dilation_h == 1 && param.dilation_w == 1;
+    _gemm_to_output = kh == 1 && kw == 1 && param.stride_h == 1 && param.stride_w == 1
+                      && param.pad_h == 0 && param.pad_w == 0;
+    if (!_direct && !_gemm_to_output) {
+        const int col_rows = oc / group * kh * kw;
+        _col_workspace.re_alloc(Shape(1, 1, col_rows, inputs[0]->height() * inputs[0]->width()));
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDeconv2D<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvParam<OpTensor>& param) {
+    const X86Kernels& kernels = *_kernels;
+    const int num = inputs[0]->num();
+    const int ic = inputs[0]->channel();
+    const int oc = outputs[0]->channel();
+    const int group = param.group;
+    const int ic_g = ic / group;
+    const int oc_g = oc / group;
+    DeconvShape s;
+    s.ih = inputs[0]->height();
+    s.iw = inputs[0]->width();
+    s.oh = outputs[0]->height();
+    s.ow = outputs[0]->width();
+    s.kh = param.weight()->height();
+    s.kw = param.weight()->width();
+    s.stride_h = param.stride_h;
+    s.stride_w = param.stride_w;
+    s.pad_h = param.pad_h;
+    s.pad_w = param.pad_w;
+    s.dila_h = param.dilation_h;
+    s.dila_w = param.dilation_w;
+    const int in_size = s.ih * s.iw;
+    const int out_size = s.oh * s.ow;
+    const int kernel_size = s.kh * s.kw;
+
+    const float* src = inputs[0]->data();
+    float* dst = outputs[0]->mutable_data();
+    const float* weight = param.weight()->data();
+    const float* bias = param.bias()->valid_size() > 0 ? param.bias()->data() : nullptr;
+    const X86ActParam* act = _with_act ? &_act : nullptr;
+
+    if (_direct) {
+        const int planes = num * oc;
+        #pragma omp parallel
+        {
+            std::vector<float> buf(s.ow / s.stride_w + 1);
+            #pragma omp for schedule(static)
+            for (int p = 0; p < planes; ++p) {
+                const int c = p % oc;
+                float* plane = dst + (size_t)p * out_size;
+                deconv_dw_plane(kernels, src + (size_t)p * in_size, weight + (size_t)c * kernel_size,
+                                bias ? bias[c] : 0.f, plane, s, buf.data());
+                if (act) {
+                    x86_act_range(plane, plane, out_size, *act, c);
+                }
+            }
+        }
+        return SaberSuccess;
+    }
+
+    const int col_rows = oc_g * kernel_size;
+    for (int n = 0; n < num; ++n) {
+        for (int g = 0; g < group; ++g) {
+            const float* src_g = src + ((size_t)n * ic + g * ic_g) * in_size;
+            const float* weight_g = weight + (size_t)g * ic_g * col_rows;
+            float* dst_g = dst + ((size_t)n * oc + g * oc_g) * out_size;
+            float* col = _gemm_to_output ? dst_g : _col_workspace.mutable_data();
+            // col [oc_g * kh * kw, ih * iw] = weight_g^T * src_g
+            cblas_sgemm(CblasRowMajor, CblasTrans, CblasNoTrans, col_rows, in_size, ic_g,
+                        1.f, weight_g, col_rows, src_g, in_size, 0.f, col, in_size);
+            #pragma omp parallel for schedule(static) if (oc_g > 1)
+            for (int c = 0; c < oc_g; ++c) {
+                float* plane = dst_g + (size_t)c * out_size;
+                const float b = bias ? bias[g * oc_g + c] : 0.f;
+                if (_gemm_to_output) {
+                    if (b != 0.f) {
+                        kernels.elt_apply(Eltwise_sum, plane, &b, true, 1.f, out_size);
+                    }
+                } else {
+                    std::fill(plane, plane + out_size, b);
+                    col2im_plane(kernels, col + (size_t)c * kernel_size * in_size, plane, s);
+                }
+                if (act) {
+                    x86_act_range(plane, plane, out_size, *act, g * oc_g + c);
+                }
+            }
+        }
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -0,0 +1,87 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_DECONV_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_DECONV_H
+
+#include "saber/funcs/impl/impl_deconv.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+
+namespace anakin{
+namespace saber {
+
+/**
+ * deconvolution of NCHW tensors, weights are [group, ic / group, oc / group, kh, kw].
+ * Depthwise deconvs (the bilinear upsampling of segmentation nets) of dilation 1 run a direct
+ * kernel which splits every output row into its stride phases; the others are a gemm per
+ * group followed by col2im, where a 1x1 stride 1 deconv writes the gemm straight to the output.
+ * Bias and the activation given by set_activation are applied to every plane while it's in cache.
+ */
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+class SaberDeconv2D<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out> : public ImplBase<
+        Tensor<X86, inDtype, LayOutType_in>,
+        Tensor<X86, outDtype, LayOutType_out>,
+        Tensor<X86, OpDtype, LayOutType_op>,
+        ConvParam<Tensor<X86, OpDtype, LayOutType_op> > > {
+public:
+    typedef Tensor<X86, inDtype, LayOutType_in> DataTensor_in;
+    typedef Tensor<X86, outDtype, LayOutType_out> DataTensor_out;
+    typedef Tensor<X86, OpDtype, LayOutType_op> OpTensor;
+
+    SaberDeconv2D()
+    {}
+
+    ~SaberDeconv2D() {
+    }
+
+    virtual SaberStatus init(const std::vector<DataTensor_in*>& inputs,
+                             std::vector<DataTensor_out*>& outputs,
+                             ConvParam<OpTensor>& param,
+                             Context<X86> &ctx) override;
+
+    virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
+                               std::vector<DataTensor_out*>& outputs,
+                               ConvParam<OpTensor>& param,
+                               Context<X86> &ctx) override;
+
+    virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
+                                 std::vector<DataTensor_out*>& outputs,
+                                 ConvParam<OpTensor> &param) override;
+
+    /// activation epilogue, set before init
+    void set_activation(const X86ActParam& act) {
+        _act = act;
+        _with_act = act.type != Active_unknow;
+    }
+
+private:
+    const X86Kernels* _kernels{nullptr};
+    X86ActParam _act;
+    bool _with_act{false};
+    bool _direct{false};
+    bool _gemm_to_output{false};    ///< a 1x1 stride 1 deconv, its col is the output
+    OpTensor _col_workspace;
+};
+
+}
+}
+
+#endif
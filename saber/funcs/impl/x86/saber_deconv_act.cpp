@@ -0,0 +1,60 @@
+#include "saber/funcs/impl/x86/saber_deconv_act.h"
+#include "saber/funcs/impl/x86/x86_activation.h"
+
+namespace anakin{
+namespace saber {
+
+template class SaberDeconv2DAct<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDeconv2DAct<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvActiveParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    if (param.has_active) {
+        _deconv.set_activation(make_x86_act_param(param.activation_param));
+    }
+    return _deconv.init(inputs, outputs, param.conv_param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDeconv2DAct<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvActiveParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    return _deconv.create(inputs, outputs, param.conv_param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDeconv2DAct<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ConvActiveParam<OpTensor>& param) {
+    return _deconv.dispatch(inputs, outputs, param.conv_param);
+}
+
+}
+} // namespace anakin
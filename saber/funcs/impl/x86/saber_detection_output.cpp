@@ -0,0 +1,117 @@
+#include "saber/funcs/impl/x86/saber_detection_output.h"
+#include "saber/funcs/impl/x86/x86_detection.h"
+#include "saber/funcs/impl/x86/x86_permute.h"
+#include <cstring>
+
+namespace anakin{
+namespace saber {
+
+template class SaberDetectionOutput<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDetectionOutput<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        DetectionOutputParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDetectionOutput<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        DetectionOutputParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    //! inputs[0]: location map, dims = 4 {N, boxes * 4, 1, 1}
+    //! inputs[1]: confidence map, dims = 4 {N, boxes * classes, 1, 1}
+    //! inputs[2]: prior boxes, dims = 4 {1, 1, 2, boxes * 4(xmin, ymin, xmax, ymax)}
+    const int num = inputs[0]->num();
+    _num_priors = inputs[2]->valid_shape()[3] / 4;
+    if (param.class_num == 0) {
+        _num_classes = inputs[1]->valid_size() / (num * _num_priors);
+    } else {
+        _num_classes = param.class_num;
+    }
+    _num_loc_classes = param.share_location ? 1 : _num_classes;
+    if (inputs[0]->valid_size() != num * _num_priors * _num_loc_classes * 4) {
+        LOG(ERROR) << "Number of priors must match number of location predictions.";
+        return SaberInvalidValue;
+    }
+    if (inputs[1]->valid_size() != num * _num_priors * _num_classes) {
+        LOG(ERROR) << "Number of priors must match number of confidence predictions.";
+        return SaberInvalidValue;
+    }
+
+    SABER_CHECK(_prior_table.reshape(Shape(1, 1, 1, x86_prior_table_size(_num_priors))));
+    SABER_CHECK(_bbox_preds.reshape(inputs[0]->valid_shape()));
+    SABER_CHECK(_conf_permute.reshape(inputs[1]->valid_shape()));
+    if (!param.share_location) {
+        SABER_CHECK(_loc_permute.reshape(inputs[0]->valid_shape()));
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberDetectionOutput<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        DetectionOutputParam<OpTensor>& param) {
+    const int num = inputs[0]->num();
+    float* table = _prior_table.mutable_data();
+    x86_prior_table(inputs[2]->data(), _num_priors, param.type, param.variance_encode_in_target, table);
+
+    //! boxes of every location class are decoded as [num, loc classes, priors, 4]
+    const float* loc = inputs[0]->data();
+    if (!param.share_location) {
+        x86_permute_forward(loc, {num, _num_priors, _num_loc_classes, 4},
+                            _loc_permute.mutable_data(), {0, 2, 1, 3});
+        loc = _loc_permute.data();
+    }
+    float* bbox = _bbox_preds.mutable_data();
+    const int box_sets = num * _num_loc_classes;
+    #pragma omp parallel for schedule(static) if (box_sets > 1)
+    for (int i = 0; i < box_sets; ++i) {
+        const size_t offset = (size_t)i * _num_priors * 4;
+        x86_decode_bboxes(loc + offset, table, _num_priors, param.type, bbox + offset);
+    }
+
+    //! confidences to [num, classes, priors]
+    float* conf = _conf_permute.mutable_data();
+    x86_permute_forward(inputs[1]->data(), {num, _num_priors, _num_classes}, conf, {0, 2, 1});
+
+    x86_multiclass_nms(bbox, conf, num, _num_classes, _num_priors, param.share_location,
+                       make_x86_nms_param(param), _result);
+
+    if (_result.empty()) {
+        _result.assign(7, -1.f);
+    }
+    const int rows = _result.size() / 7;
+    outputs[0]->reshape(Shape(1, 1, rows, 7));
+    memcpy(outputs[0]->mutable_data(), _result.data(), sizeof(float) * _result.size());
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
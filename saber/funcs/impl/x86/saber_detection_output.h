@@ -0,0 +1,79 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_DETECTION_OUTPUT_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_DETECTION_OUTPUT_H
+
+#include "saber/funcs/impl/impl_detection_output.h"
+#include <vector>
+
+namespace anakin{
+namespace saber {
+
+/**
+ * ssd detection output: decodes the loc offsets against the priors, transposes the
+ * confidences to [num, classes, priors] and runs the multiclass nms of x86_detection.h,
+ * in parallel over images and classes.
+ */
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+class SaberDetectionOutput<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out> : public ImplBase<
+        Tensor<X86, inDtype, LayOutType_in>,
+        Tensor<X86, outDtype, LayOutType_out>,
+        Tensor<X86, OpDtype, LayOutType_op>,
+        DetectionOutputParam<Tensor<X86, OpDtype, LayOutType_op> > > {
+public:
+    typedef Tensor<X86, inDtype, LayOutType_in> DataTensor_in;
+    typedef Tensor<X86, outDtype, LayOutType_out> DataTensor_out;
+    typedef Tensor<X86, OpDtype, LayOutType_op> OpTensor;
+
+    SaberDetectionOutput() {}
+
+    ~SaberDetectionOutput() {}
+
+    virtual SaberStatus init(const std::vector<DataTensor_in*>& inputs,
+                             std::vector<DataTensor_out*>& outputs,
+                             DetectionOutputParam<OpTensor>& param,
+                             Context<X86> &ctx) override;
+
+    virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
+                               std::vector<DataTensor_out*>& outputs,
+                               DetectionOutputParam<OpTensor>& param,
+                               Context<X86> &ctx) override;
+
+    virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
+                                 std::vector<DataTensor_out*>& outputs,
+                                 DetectionOutputParam<OpTensor> &param) override;
+
+private:
+    int _num_classes{0};
+    int _num_loc_classes{1};
+    int _num_priors{0};
+    OpTensor _prior_table;
+    OpTensor _loc_permute;      ///< loc as [num, loc classes, priors, 4] when it isn't shared
+    OpTensor _bbox_preds;
+    OpTensor _conf_permute;
+    std::vector<float> _result;
+};
+
+}
+}
+
+#endif
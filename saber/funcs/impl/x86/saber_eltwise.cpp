@@ -40,96 +40,15 @@ SaberStatus SaberEltwise<X86, OpDtype, inDtype, outDtype,
         Context<X86> &ctx)
 {
     this->_param = &param;
-    if (this->_param->operation != Eltwise_sum) {
-                LOG(INFO) << "eltwise type "
-                          << this->_param->operation << " is not supported now";
+    this->_ctx = &ctx;
+    _elt_param = make_x86_eltwise_param(param, inputs.size());
+    if (!x86_eltwise_supported(_elt_param, inputs.size())) {
+        LOG(ERROR) << "eltwise type " << param.operation << " with "
+                   << param.chain_ops.size() << " chain ops is not supported now";
         return SaberUnImplError;
     }
-    typedef typename DataTensor_in::Dtype DataType_in;
-    typedef typename DataTensor_out::Dtype DataType_out;
-    typedef typename OpTensor::Dtype DataType_op;
-    this->_ctx = &ctx;
-
     return SaberSuccess;
 }
-template <typename HTensor>
-static void very_simple_eltwise(const std::vector<HTensor*>& inputs,
-                                    std::vector<HTensor*>& outputs,
-                                    EltwiseParam<HTensor>& param){
-    typedef typename HTensor::Dtype Dtype;
-    const int input_num = inputs.size();
-    volatile const size_t inner_size = inputs[0]->valid_size();
-    Dtype* target=outputs[0]->mutable_data();
-    std::vector<const Dtype*> in_ptrs(input_num);
-    for(int i=0;i<input_num;++i){
-        in_ptrs[i]=inputs[i]->data();
-    }
-//TODO:can be SIMD to improve cache efficient
-//TODO:can be opt by check coeff == 1
-    for(int inner_id=0;inner_id<inner_size;++inner_id){
-        Dtype temp=0;
-        for(int input_id=0;input_id<input_num;++input_id) {
-            temp+=in_ptrs[input_id][inner_id]*param.coeff[input_id];
-        }
-        target[inner_id]=temp;
-    }
-}
-
-template <DataType OpDtype ,
-        DataType inDtype,
-        DataType outDtype,
-        typename LayOutType_op,
-        typename LayOutType_in,
-        typename LayOutType_out>
-void SaberEltwise<X86, OpDtype, inDtype, outDtype,
-        LayOutType_op, LayOutType_in, LayOutType_out>::simple_sum(
-        const std::vector<DataTensor_in*>& inputs,
-        std::vector<DataTensor_out*>& outputs,
-        EltwiseParam<OpTensor>& param){
-
-    const int num_arrs = inputs.size();
-    const size_t nelems = inputs[0]->size();
-    const size_t block_size = 16 * 1024 / sizeof(float);
-    const size_t blocks_number = nelems / block_size;
-    const size_t tail = nelems % block_size;
-#pragma omp parallel
-    {
-        const int ithr = omp_get_thread_num();
-        const int nthr = omp_get_num_threads();
-        size_t start{0}, end{0};
-        utils::balance211(blocks_number, nthr, ithr, start, end);
-
-        for (size_t nb = start; nb < end; ++nb) {
-            size_t start_e = nb * block_size;
-            size_t end_e = start_e + block_size;
-            // #pragma omp simd
-            for (size_t e = start_e; e < end_e; e++) {
-                outputs[0]->mutable_data()[e] = param.coeff[0] * inputs[0]->mutable_data()[e];
-            }
-            for (int a = 1; a < num_arrs; a++) {
-                // #pragma omp simd
-                for (size_t e = start_e; e < end_e; e++) {
-                    outputs[0]->mutable_data()[e] += param.coeff[a] * inputs[a]->mutable_data()[e];
-                }
-            }
-        }
-
-        if (tail != 0 && ithr == nthr - 1) {
-            size_t start_e = nelems - tail;
-            size_t end_e = nelems;
-            // #pragma omp simd
-            for (size_t e = start_e; e < end_e; e++) {
-                outputs[0]->mutable_data()[e] = param.coeff[0] * inputs[0]->mutable_data()[e];
-            }
-            for (int a = 1; a < num_arrs; a++) {
-                // #pragma omp simd
-                for (size_t e = start_e; e < end_e; e++) {
-                    outputs[0]->mutable_data()[e] += param.coeff[a] * inputs[a]->mutable_data()[e];
-                }
-            }
-        }
-    }
-}
 
 template <DataType OpDtype ,
     DataType inDtype,
@@ -144,14 +63,15 @@ SaberStatus SaberEltwise<X86, OpDtype, inDtype, outDtype,
         EltwiseParam<OpTensor> &param)
 {
     CHECK_EQ(outputs.size(), (size_t)1);
-    switch (param.operation) {
-        case Eltwise_sum:
-            very_simple_eltwise(inputs, outputs, param);
-            return SaberSuccess;
-        default:
-            return SaberUnImplError;
+    std::vector<const float*> srcs;
+    std::vector<Shape> src_shapes;
+    for (int i = 0; i < inputs.size(); ++i) {
+        srcs.push_back(inputs[i]->data());
+        src_shapes.push_back(inputs[i]->valid_shape());
     }
-      
+    x86_eltwise_forward(srcs, src_shapes, outputs[0]->mutable_data(),
+                        outputs[0]->valid_shape(), _elt_param);
+    return SaberSuccess;
 }
 
 }
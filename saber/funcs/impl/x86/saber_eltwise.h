@@ -17,6 +17,7 @@
 
 #include "saber/funcs/impl/impl_eltwise.h"
 #include "saber/funcs/impl/x86/x86_utils.h"
+#include "saber/funcs/impl/x86/x86_eltwise.h"
 namespace anakin{
 namespace saber {
 
@@ -58,9 +59,7 @@ public:
                                  std::vector<DataTensor_out*>& outputs,
                                  EltwiseParam<OpTensor> &param) override;
 private:
-    void simple_sum(const std::vector<DataTensor_in*>& inputs,
-                    std::vector<DataTensor_out*>& outputs,
-                    EltwiseParam<OpTensor> &param);
+    X86EltwiseParam _elt_param;
 };
 
 }
@@ -17,6 +17,7 @@
 
 #include "saber/funcs/impl/impl_eltwise_act.h"
 #include "saber/funcs/impl/x86/x86_utils.h"
+#include "saber/funcs/impl/x86/x86_eltwise.h"
 
 namespace anakin{
 namespace saber {
@@ -59,11 +60,8 @@ public:
                                  EltwiseActiveParam<OpTensor> &param) override;
 
 private:
-    void simple_sum(const std::vector<DataTensor_in*>& inputs,
-                    std::vector<DataTensor_out*>& outputs,
-                    EltwiseActiveParam<OpTensor>& param);
-
-    void simple_relu(std::vector<DataTensor_out*>& outputs);
+    X86EltwiseParam _elt_param;
+    X86ActParam _act_param;
 };
 
 }
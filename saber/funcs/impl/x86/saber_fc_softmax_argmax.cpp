@@ -0,0 +1,244 @@
+#include "saber/funcs/impl/x86/saber_fc_softmax_argmax.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+#include "mkl_cblas.h"
+#include "mkl_vml_functions.h"
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+
+namespace anakin{
+namespace saber {
+
+template class SaberFcSoftmaxArgmax<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+///< floats of one logits tile per thread, half of a typical L2 cache
+static const int kLogitsTileSize = 32 * 1024;
+
+/// sift down of a min heap, the root is the smallest of the current top k.
+static inline void adjust_small_heap_with_index(float* val, int* idx, int node, int size) {
+    while (true) {
+        int left = 2 * node + 1;
+        int right = left + 1;
+        int smallest = node;
+        if (left < size && val[left] < val[smallest]) {
+            smallest = left;
+        }
+        if (right < size && val[right] < val[smallest]) {
+            smallest = right;
+        }
+        if (smallest == node) {
+            break;
+        }
+        std::swap(val[node], val[smallest]);
+        std::swap(idx[node], idx[smallest]);
+        node = smallest;
+    }
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberFcSoftmaxArgmax<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        FcSoftmaxArgmaxParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberFcSoftmaxArgmax<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        FcSoftmaxArgmaxParam<OpTensor> &param, Context<X86> &ctx) {
+    if (inDtype != AK_FLOAT) {
+        LOG(ERROR) << "fc softmax argmax only supports FP32 currently";
+        return SaberUnImplError;
+    }
+    if (inputs.size() != 1) {
+        LOG(ERROR) << "fc softmax argmax only supports one input";
+        return SaberUnImplError;
+    }
+    if (param.softmax_param.axis != 1) {
+        LOG(ERROR) << "fc softmax argmax only supports softmax along fc output channel";
+        return SaberUnImplError;
+    }
+    this->_ctx = &ctx;
+    this->_param = &param;
+
+    FcParam<OpTensor>& fc_param = param.fc_param;
+    _m = inputs[0]->count_valid(0, fc_param.axis);
+    _k = inputs[0]->count_valid(fc_param.axis, inputs[0]->dims());
+    _n = fc_param.num_output > 0 ? fc_param.num_output : fc_param.weights->valid_size() / _k;
+    _top_k = param.argmax_param.top_k;
+
+    _thread_num = omp_get_max_threads();
+    _tile_n = utils::round_up(kLogitsTileSize / std::max(_m, 1), 16);
+    _tile_n = std::max(16, std::min(_n, _tile_n));
+
+    _logits.re_alloc(Shape(_thread_num, _m, _tile_n, 1));
+    _row_max.re_alloc(Shape(_thread_num, _m, 1, 1));
+    _row_sum.re_alloc(Shape(_thread_num, _m, 1, 1));
+    _heap_val.re_alloc(Shape(_thread_num, _m, _top_k, 1));
+    _heap_idx.re_alloc(Shape(_thread_num, _m, _top_k, 1));
+
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberFcSoftmaxArgmax<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        FcSoftmaxArgmaxParam<OpTensor> &param) {
+    FcParam<OpTensor>& fc_param = param.fc_param;
+    ArgmaxParam<OpTensor>& argmax_param = param.argmax_param;
+    const float* src = inputs[0]->data();
+    const float* weights = fc_param.weights->data();
+    const float* bias = fc_param.bias ? fc_param.bias->data() : nullptr;
+    float* dst = outputs[0]->mutable_data();
+    outputs[0]->set_seq_offset(inputs[0]->get_seq_offset());
+
+    const int m = _m;
+    const int k = _k;
+    const int n = _n;
+    const int top_k = _top_k;
+    const int tile_n = _tile_n;
+    const int tile_num = utils::div_up(n, tile_n);
+    float* logits_all = _logits.mutable_data();
+    float* row_max_all = _row_max.mutable_data();
+    float* row_sum_all = _row_sum.mutable_data();
+    float* heap_val_all = _heap_val.mutable_data();
+    int* heap_idx_all = _heap_idx.mutable_data();
+
+    #pragma omp parallel num_threads(_thread_num)
+    {
+        const int ithr = omp_get_thread_num();
+        const int nthr = omp_get_num_threads();
+        // reset state of every slot, the team may be smaller than _thread_num
+        for (int slot = ithr; slot < _thread_num; slot += nthr) {
+            for (int i = 0; i < m; ++i) {
+                row_max_all[slot * m + i] = -FLT_MAX;
+                row_sum_all[slot * m + i] = 0.f;
+            }
+            for (int i = 0; i < m * top_k; ++i) {
+                heap_val_all[slot * m * top_k + i] = -FLT_MAX;
+                heap_idx_all[slot * m * top_k + i] = -1;
+            }
+        }
+
+        float* logits = logits_all + ithr * m * tile_n;
+        float* row_max = row_max_all + ithr * m;
+        float* row_sum = row_sum_all + ithr * m;
+        float* heap_val = heap_val_all + ithr * m * top_k;
+        int* heap_idx = heap_idx_all + ithr * m * top_k;
+
+        for (int tile = ithr; tile < tile_num; tile += nthr) {
+            const int n_start = tile * tile_n;
+            const int nn = std::min(tile_n, n - n_start);
+            if (fc_param.is_transpose_weights) {
+                // weights is k * n
+                cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, nn, k,
+                            1.f, src, k, weights + n_start, n, 0.f, logits, nn);
+            } else {
+                // weights is n * k
+                cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, m, nn, k,
+                            1.f, src, k, weights + n_start * k, k, 0.f, logits, nn);
+            }
+
+            for (int i = 0; i < m; ++i) {
+                float* row = logits + i * nn;
+                float* val = heap_val + i * top_k;
+                int* idx = heap_idx + i * top_k;
+                float tile_max = -FLT_MAX;
+                for (int j = 0; j < nn; ++j) {
+                    if (bias) {
+                        row[j] += bias[n_start + j];
+                    }
+                    tile_max = std::max(tile_max, row[j]);
+                    // logits rank the same as probabilities
+                    if (row[j] > val[0]) {
+                        val[0] = row[j];
+                        idx[0] = n_start + j;
+                        adjust_small_heap_with_index(val, idx, 0, top_k);
+                    }
+                }
+                // online softmax: rescale the running sum to the new max
+                float new_max = std::max(row_max[i], tile_max);
+                for (int j = 0; j < nn; ++j) {
+                    row[j] -= new_max;
+                }
+                vsExp(nn, row, row);
+                float tile_sum = 0.f;
+                for (int j = 0; j < nn; ++j) {
+                    tile_sum += row[j];
+                }
+                row_sum[i] = row_sum[i] * expf(row_max[i] - new_max) + tile_sum;
+                row_max[i] = new_max;
+            }
+        }
+    }
+
+    // merge states of all threads into the first slot and write the top k
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < m; ++i) {
+        float global_max = -FLT_MAX;
+        for (int t = 0; t < _thread_num; ++t) {
+            global_max = std::max(global_max, row_max_all[t * m + i]);
+        }
+        float global_sum = 0.f;
+        for (int t = 0; t < _thread_num; ++t) {
+            if (row_sum_all[t * m + i] > 0.f) {
+                global_sum += row_sum_all[t * m + i] * expf(row_max_all[t * m + i] - global_max);
+            }
+        }
+        float* val = heap_val_all + i * top_k;
+        int* idx = heap_idx_all + i * top_k;
+        for (int t = 1; t < _thread_num; ++t) {
+            const float* t_val = heap_val_all + (t * m + i) * top_k;
+            const int* t_idx = heap_idx_all + (t * m + i) * top_k;
+            for (int j = 0; j < top_k; ++j) {
+                if (t_idx[j] >= 0 && t_val[j] > val[0]) {
+                    val[0] = t_val[j];
+                    idx[0] = t_idx[j];
+                    adjust_small_heap_with_index(val, idx, 0, top_k);
+                }
+            }
+        }
+        // pop the heap from the smallest, the largest lands at position 0
+        float* out = dst + i * top_k * ((!argmax_param.has_axis && argmax_param.out_max_val) ? 2 : 1);
+        for (int j = top_k - 1; j >= 0; --j) {
+            float prob = expf(val[0] - global_max) / global_sum;
+            if (argmax_param.has_axis) {
+                out[j] = argmax_param.out_max_val ? prob : idx[0];
+            } else if (argmax_param.out_max_val) {
+                out[j] = idx[0];
+                out[j + top_k] = prob;
+            } else {
+                out[j] = idx[0];
+            }
+            val[0] = FLT_MAX;
+            idx[0] = -1;
+            adjust_small_heap_with_index(val, idx, 0, top_k);
+        }
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
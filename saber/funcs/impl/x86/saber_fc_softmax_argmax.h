@@ -0,0 +1,89 @@
+/* Copyright (c) 2016 Anakin Authors All Rights Reserve.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_FC_SOFTMAX_ARGMAX_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_FC_SOFTMAX_ARGMAX_H
+
+#include "saber/funcs/impl/impl_fc_softmax_argmax.h"
+#include "saber/saber_funcs_param.h"
+
+namespace anakin{
+namespace saber {
+
+/**
+ * logits are computed tile by tile along the vocabulary, every thread keeps running
+ * max / sum (online softmax) and a small top k heap per row, the full num * vocab
+ * probability tensor is never materialized.
+ */
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+class SaberFcSoftmaxArgmax<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out> : public ImplBase<
+        Tensor<X86, inDtype, LayOutType_in>,
+        Tensor<X86, outDtype, LayOutType_out>,
+        Tensor<X86, OpDtype, LayOutType_op>,
+        FcSoftmaxArgmaxParam<Tensor<X86, OpDtype, LayOutType_op> > > {
+public:
+    typedef Tensor<X86, inDtype, LayOutType_in> DataTensor_in;
+    typedef Tensor<X86, outDtype, LayOutType_out> DataTensor_out;
+    typedef Tensor<X86, OpDtype, LayOutType_op> OpTensor;
+    typedef typename DataTensor_in::Dtype DataType_in;
+    typedef typename DataTensor_out::Dtype DataType_out;
+    typedef typename OpTensor::Dtype DataType_op;
+
+    SaberFcSoftmaxArgmax() = default;
+
+    ~SaberFcSoftmaxArgmax() {}
+
+    virtual SaberStatus init(const std::vector<DataTensor_in*>& inputs,
+                             std::vector<DataTensor_out*>& outputs,
+                             FcSoftmaxArgmaxParam<OpTensor> &param,
+                             Context<X86> &ctx) override;
+
+    virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
+                               std::vector<DataTensor_out*>& outputs,
+                               FcSoftmaxArgmaxParam<OpTensor> &param,
+                               Context<X86> &ctx) override;
+
+    virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
+                                 std::vector<DataTensor_out*>& outputs,
+                                 FcSoftmaxArgmaxParam<OpTensor> &param) override;
+
+private:
+    int _m{0};
+    int _k{0};
+    int _n{0};
+    int _top_k{0};
+    ///< vocabulary columns computed per tile
+    int _tile_n{0};
+    int _thread_num{1};
+    ///< per thread logits tile, _m * _tile_n
+    DataTensor_in _logits;
+    ///< per thread running max and sum of every row
+    DataTensor_in _row_max;
+    DataTensor_in _row_sum;
+    ///< per thread top k heap of every row
+    DataTensor_in _heap_val;
+    Tensor<X86, AK_INT32, NCHW> _heap_idx;
+};
+
+}
+}
+
+#endif
@@ -2,30 +2,141 @@
 #include "saber/funcs/impl/x86/saber_gru.h"
 #include "saber/core/tensor_op.h"
 
-#include <immintrin.h>
 #include "sys/time.h"
 #include "x86_utils.h"
-#include "saber_normal_activation.h"
 
 namespace anakin {
 
 namespace saber {
 
+///< floats of hidden units a thread owns at least in the batch 1 recurrence
+static const int kStepSliceMin = 64;
+
+template<>
+void SaberGru<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::init_step_weights() {
+    _step_slices = utils::split_aligned(_aligned_hidden_size, _kernels->width,
+                                        omp_get_max_threads(), kStepSliceMin);
+    _step_threads = _step_slices.size() - 1;
+    if (_step_threads < 2) {
+        return;
+    }
+    const int hidden = _hidden_size;
+    const int aligned = _aligned_hidden_size;
+    const OpDataType* weight_o = (const OpDataType*)_aligned_weights_h2h.data();
+    const OpDataType* weight_rz = weight_o + hidden * aligned;
+    const OpDataType* bias = (const OpDataType*)_aligned_weights_bias.data();
+    _step_weights_o.resize(_step_threads);
+    _step_weights_rz.resize(_step_threads);
+    _step_bias.resize(_step_threads);
+    _step_gates.resize(_step_threads);
+    _step_reset.re_alloc(Shape(1, 1, 1, aligned));
+
+    #pragma omp parallel for schedule(static, 1) num_threads(_step_threads)
+    for (int t = 0; t < _step_threads; ++t) {
+        const int start = _step_slices[t];
+        const int units = _step_slices[t + 1] - start;
+        _step_weights_o[t].re_alloc(Shape(1, 1, hidden, units));
+        _step_weights_rz[t].re_alloc(Shape(1, hidden, 2, units));
+        _step_bias[t].re_alloc(Shape(1, 1, 3, units));
+        _step_gates[t].re_alloc(Shape(1, 1, 6, units));
+        OpDataType* w_o = (OpDataType*)_step_weights_o[t].mutable_data();
+        OpDataType* w_rz = (OpDataType*)_step_weights_rz[t].mutable_data();
+        OpDataType* b = (OpDataType*)_step_bias[t].mutable_data();
+        for (int row = 0; row < hidden; ++row) {
+            memcpy(w_o + row * units, weight_o + row * aligned + start, units * sizeof(OpDataType));
+        }
+        for (int row = 0; row < hidden * 2; ++row) {
+            memcpy(w_rz + row * units, weight_rz + row * aligned + start, units * sizeof(OpDataType));
+        }
+        for (int gate = 0; gate < 3; ++gate) {
+            memcpy(b + gate * units, bias + gate * aligned + start, units * sizeof(OpDataType));
+        }
+    }
+}
+
+template<>
+void SaberGru<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
+        step_dispatch(const OpDataType* wx, const OpDataType* h_init, OpDataType* h_out,
+                      const std::vector<int>& emit_offset_vec, int emit_length,
+                      GruParam<OpTensor>& param) {
+    const int hidden = _hidden_size;
+    const int aligned = _aligned_hidden_size;
+    OpDataType* reset = (OpDataType*)_step_reset.mutable_data();
+
+    #pragma omp parallel num_threads(_step_threads)
+    {
+        #pragma omp single
+        _step_barrier.reset(omp_get_num_threads());
+
+        // a smaller team than asked for takes several slices per thread
+        const int team = omp_get_num_threads();
+        X86GruCellArgs cell_args;
+        cell_args.row_start = 0;
+        cell_args.row_end = 1;
+        cell_args.gate_act = param.gate_activity;
+        cell_args.hid_act = param.h_activity;
+
+        for (int word_id = 0; word_id < emit_length; word_id++) {
+            int real_word_id = param.is_reverse ? emit_length - word_id - 1 : word_id;
+            int last_word_id = param.is_reverse ? real_word_id + 1 : word_id - 1;
+            const OpDataType* wx_row = wx + emit_offset_vec[real_word_id] * 3 * aligned;
+            const OpDataType* hin = word_id == 0 ? h_init :
+                                    h_out + emit_offset_vec[last_word_id] * aligned;
+            OpDataType* hout = h_out + emit_offset_vec[real_word_id] * aligned;
+
+            for (int t = omp_get_thread_num(); t < _step_threads; t += team) {
+                const int start = _step_slices[t];
+                const int units = _step_slices[t + 1] - start;
+                OpDataType* gates = (OpDataType*)_step_gates[t].mutable_data();
+                for (int gate = 0; gate < 3; ++gate) {
+                    memcpy(gates + gate * units, wx_row + gate * aligned + start, units * sizeof(OpDataType));
+                }
+                cblas_sgemv(CblasRowMajor, CblasTrans, hidden, 2 * units, 1.f,
+                            (const OpDataType*)_step_weights_rz[t].data(), 2 * units,
+                            hin, 1, 0.f, gates + 3 * units, 1);
+                cell_args.wx = gates;
+                cell_args.wh = gates + 3 * units;
+                cell_args.bias = (const OpDataType*)_step_bias[t].data();
+                cell_args.hidden = units;
+                cell_args.hin = hin + start;
+                cell_args.hout = reset + start;
+                _kernels->gru_reset(cell_args);
+            }
+            // the o gates of every unit read the reset hidden of all of them
+            _step_barrier.wait();
+
+            for (int t = omp_get_thread_num(); t < _step_threads; t += team) {
+                const int start = _step_slices[t];
+                const int units = _step_slices[t + 1] - start;
+                OpDataType* gates = (OpDataType*)_step_gates[t].mutable_data();
+                cblas_sgemv(CblasRowMajor, CblasTrans, hidden, units, 1.f,
+                            (const OpDataType*)_step_weights_o[t].data(), units,
+                            reset, 1, 0.f, gates + 5 * units, 1);
+                cell_args.wx = gates;
+                cell_args.wh = gates + 3 * units;
+                cell_args.whr = gates + 5 * units;
+                cell_args.bias = (const OpDataType*)_step_bias[t].data();
+                cell_args.hidden = units;
+                cell_args.hin = hin + start;
+                cell_args.hout = hout + start;
+                _kernels->gru_update(cell_args);
+            }
+            // and the next word the whole hidden of this one, also reset is written again
+            _step_barrier.wait();
+        }
+    }
+}
+
 template <>
-template<typename BIT>
 SaberStatus SaberGru<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
 batch_s_aligned(const std::vector<OpTensor*>& inputs,
                 std::vector<OpTensor*>& outputs,
                 GruParam<OpTensor>& param) {
     CHECK_NE(param.formula, GRU_CUDNN) << "X86 gru not support cudnn formula now";
-    int loop_div = sizeof(BIT) / sizeof(float);
-    //    LOG(INFO)<<"loop_div "<<loop_div;
     const OpDataType* weight_h = (const OpDataType*)_aligned_weights_h2h.data();
     const OpDataType* weight_w = (const OpDataType*)_aligned_weights_i2h.data();
     const OpDataType* bias = (const OpDataType*)_aligned_weights_bias.data();
 
-    BIT(*gate_act)(const BIT) = Activate_inner<BIT>(param.gate_activity);
-    BIT(*hid_act)(const BIT) = Activate_inner<BIT>(param.h_activity);
     std::vector<int>offset_vec = inputs[0]->get_seq_offset();
     std::vector<int> length_vec(offset_vec.size() - 1);
     int batch_size = offset_vec.size() - 1;
@@ -48,10 +159,17 @@ batch_s_aligned(const std::vector<OpTensor*>& inputs,
                                        batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
         h_init = (const OpDataType*)_aligned_init_hidden.data();
     } else if (param.init_hidden() != nullptr) {
-        h_init = (const OpDataType*)param.init_hidden()->data();
-        //FIXME:is it correct?
+        // state carried over from the previous chunk, batch_size * _hidden_size
+        CHECK_GE(param.init_hidden()->valid_size(), batch_size * _hidden_size) << "init hidden is too small";
+        _aligned_init_hidden.try_expand_size(batch_size * _aligned_hidden_size);
+        memset(_aligned_init_hidden.mutable_data(), 0, batch_size * _aligned_hidden_size * sizeof(OpDataType));
+        aligned_utils.aligned_last_dim((const OpDataType*)param.init_hidden()->data(),
+                                       (OpDataType*)_aligned_init_hidden.mutable_data(),
+                                       batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
+        h_init = (const OpDataType*)_aligned_init_hidden.data();
     } else {
         _aligned_init_hidden.try_expand_size(batch_size * _aligned_hidden_size);
+        memset(_aligned_init_hidden.mutable_data(), 0, batch_size * _aligned_hidden_size * sizeof(OpDataType));
         h_init = (const OpDataType*)_aligned_init_hidden.data();
     }
 
@@ -102,97 +220,59 @@ batch_s_aligned(const std::vector<OpTensor*>& inputs,
     mkl_gemm(false, false, seqsum, 3 * _aligned_hidden_size, _word_size, 1.f, inner_x, weight_w, 0.f,
              temp_wx);
 
-    int o_offset = 0;
-    int r_offset = 1;
-    int z_offset = 2;
-    const BIT* b_r = (BIT*)(bias + r_offset * _aligned_hidden_size);
-    const BIT* b_z = (BIT*)(bias + z_offset * _aligned_hidden_size);
-    const BIT* b_o = (BIT*)(bias + o_offset * _aligned_hidden_size);
-
+    X86GruCellArgs cell_args;
+    cell_args.wx = temp_wx;
+    cell_args.wh = temp_wh;
+    cell_args.whr = temp_whr;
+    cell_args.bias = bias;
+    cell_args.gate_act = param.gate_activity;
+    cell_args.hid_act = param.h_activity;
+    cell_args.hidden = _aligned_hidden_size;
 
     int reverse_out_offset = seqsum;
 
+    if (batch_size == 1 && _step_threads > 1) {
+        step_dispatch(temp_wx, inner_h_init, inner_h_out, emit_offset_vec, emit_length, param);
+    } else {
+        for (int word_id = 0; word_id < emit_length; word_id++) {
+            int real_word_id = word_id;
+            int last_word_id = word_id - 1;
 
-    for (int word_id = 0; word_id < emit_length; word_id++) {
-        int real_word_id = word_id;
-        int last_word_id = word_id - 1;
-
-        if (param.is_reverse && batch_size == 1) {
-            real_word_id = emit_length - word_id - 1;
-            last_word_id = real_word_id + 1;
-        }
-
-        int emit_word_id_start = emit_offset_vec[real_word_id];
-        int emit_word_id_end = emit_offset_vec[real_word_id + 1];
-        int emit_word_length = emit_word_id_end - emit_word_id_start;
-        const float* hin;
-
-        if (word_id == 0) {
-            hin = inner_h_init;
-        } else {
-            hin = inner_h_out + emit_offset_vec[last_word_id] * _aligned_hidden_size;
-        }
-
-        float* hout = nullptr;
-        hout = emit_offset_vec[real_word_id] * _aligned_hidden_size + inner_h_out;
-
-        //wh
-        mkl_gemm(false, false, emit_word_length, 2 * _aligned_hidden_size, _aligned_hidden_size, 1.0, hin,
-                 weight_h + _hidden_size * _aligned_hidden_size,
-                 0.f, temp_wh);
-
-        BIT r;
-        BIT z;
-        BIT _h;
-        BIT* hout_256 = (BIT*) hout;
-        const BIT* hin_256 = (BIT*) hin;
-        //#pragma omp parallel for
-
-        for (int emit_word_id = emit_word_id_start; emit_word_id < emit_word_id_end; emit_word_id++) {
-            int emit_id_offset = emit_word_id - emit_word_id_start;
-            BIT* w_x_r = (BIT*)(temp_wx + r_offset * _aligned_hidden_size
-                                + emit_word_id * _aligned_hidden_size * 3);
-            BIT* w_h_r = (BIT*)(temp_wh + 0 * _aligned_hidden_size
-                                + emit_id_offset * _aligned_hidden_size * 2);
-            BIT* emit_hout = (BIT*)(hout + emit_id_offset * _aligned_hidden_size);
-            const BIT* emit_hin = (BIT*)(hin + emit_id_offset * _aligned_hidden_size);
-
-            for (int frame_id = 0; frame_id < _aligned_hidden_size / (sizeof(BIT) / 4); ++frame_id) {
-                r = w_x_r[frame_id] + w_h_r[frame_id] + b_r[frame_id]; //h_out=gate_r
-                r = gate_act(r);
-
-                emit_hout[frame_id] = r * emit_hin[frame_id];
+            if (param.is_reverse && batch_size == 1) {
+                real_word_id = emit_length - word_id - 1;
+                last_word_id = real_word_id + 1;
             }
 
-        }
+            int emit_word_id_start = emit_offset_vec[real_word_id];
+            int emit_word_id_end = emit_offset_vec[real_word_id + 1];
+            int emit_word_length = emit_word_id_end - emit_word_id_start;
+            const float* hin;
 
-        mkl_gemm(false, false, emit_word_length, _aligned_hidden_size, _aligned_hidden_size, 1.0, hout,
-                 weight_h, 0.f, temp_whr);
+            if (word_id == 0) {
+                hin = inner_h_init;
+            } else {
+                hin = inner_h_out + emit_offset_vec[last_word_id] * _aligned_hidden_size;
+            }
 
-        //#pragma omp parallel for
-        for (int emit_word_id = emit_word_id_start; emit_word_id < emit_word_id_end; emit_word_id++) {
-            int emit_offset = emit_word_id - emit_word_id_start;
-            BIT* w_x_z = (BIT*)(temp_wx + z_offset * _aligned_hidden_size
-                                + emit_word_id * _aligned_hidden_size * 3);
-            BIT* w_x_o = (BIT*)(temp_wx + o_offset * _aligned_hidden_size
-                                + emit_word_id * _aligned_hidden_size * 3);
+            float* hout = nullptr;
+            hout = emit_offset_vec[real_word_id] * _aligned_hidden_size + inner_h_out;
 
-            BIT* w_h_z = (BIT*)(temp_wh + 1 * _aligned_hidden_size
-                                + emit_offset * _aligned_hidden_size * 2);
+            //wh
+            mkl_gemm(false, false, emit_word_length, 2 * _aligned_hidden_size, _aligned_hidden_size, 1.0, hin,
+                     weight_h + _hidden_size * _aligned_hidden_size,
+                     0.f, temp_wh);
 
-            BIT* w_h_o = (BIT*)(temp_whr + emit_offset * _aligned_hidden_size);
-            BIT* emit_hout = (BIT*)(hout + emit_offset * _aligned_hidden_size) ;
-            const BIT* emit_hin = (BIT*)(hin + emit_offset * _aligned_hidden_size) ;
+            cell_args.row_start = emit_word_id_start;
+            cell_args.row_end = emit_word_id_end;
+            cell_args.hin = hin;
+            cell_args.hout = hout;
+            _kernels->gru_reset(cell_args);
 
-            for (int frame_id = 0; frame_id < _aligned_hidden_size / (sizeof(BIT) / 4); ++frame_id) {
+            mkl_gemm(false, false, emit_word_length, _aligned_hidden_size, _aligned_hidden_size, 1.0, hout,
+                     weight_h, 0.f, temp_whr);
 
-                z = gate_act(w_x_z[frame_id] + w_h_z[frame_id] + b_z[frame_id]);
-                _h = w_x_o[frame_id] + w_h_o[frame_id] + b_o[frame_id];
-                _h = hid_act(_h);
-                emit_hout[frame_id] = (1 - z) * emit_hin[frame_id] + z * _h;
-            }
+            _kernels->gru_update(cell_args);
         }
-
     }
 
     if (transform) {
@@ -203,6 +283,18 @@ batch_s_aligned(const std::vector<OpTensor*>& inputs,
                                          _aligned_hidden_size);
     }
 
+    // export the final hidden of every sequence, so the next chunk can continue from it
+    if (param.last_hidden() != nullptr) {
+        param.last_hidden()->reshape(Shape(batch_size, _hidden_size, 1, 1));
+        OpDataType* last_hidden = (OpDataType*)param.last_hidden()->mutable_data();
+
+        for (int i = 0; i < batch_size; ++i) {
+            int last_word_id = is_reverse ? offset_vec[i] : offset_vec[i + 1] - 1;
+            memcpy(last_hidden + i * _hidden_size, out + last_word_id * _hidden_size,
+                   _hidden_size * sizeof(OpDataType));
+        }
+    }
+
     return SaberSuccess;
 };
 template<>
@@ -216,7 +308,7 @@ SaberStatus SaberGru<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::dispa
 
     outputs[0]->set_seq_offset(inputs[0]->get_seq_offset());
 
-    batch_s_aligned<SABER_X86_TYPE >(inputs, outputs, param);
+    batch_s_aligned(inputs, outputs, param);
 
     return SaberSuccess;
 
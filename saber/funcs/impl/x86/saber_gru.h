@@ -4,15 +4,7 @@
 #define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_GRU_H
 #include "saber/funcs/impl/impl_gru.h"
 #include "saber/funcs/impl/x86/x86_utils.h"
-#if defined(__AVX512F__)
-#define SABER_X86_TYPE __m512
-#elif defined(__AVX2__) and defined(__FMA__)
-#define SABER_X86_TYPE __m256
-#elif defined(__SSE4_2__) and defined(__FMA__)
-#define SABER_X86_TYPE __m128
-#else
-#define SABER_X86_TYPE float
-#endif
+#include "saber/funcs/impl/x86/x86_kernels.h"
 
 
 
@@ -52,11 +44,14 @@ public:
                              GruParam<OpTensor>& gru_param, Context<X86>& ctx) {
         this->_ctx = &ctx;
         CHECK_EQ(gru_param.formula ,GRU_ORIGIN)<<"only support gru_origin now";
+        CHECK(x86_rnn_act_supported(gru_param.gate_activity) && x86_rnn_act_supported(gru_param.h_activity))
+                << "x86 gru doesn't support the activations";
         _hidden_size = gru_param.bias()->valid_size() / 3;
         if (gru_param.formula == GRU_ORIGIN&&_aligned_way) {
             //FIXME:aligned should be determine by framework
-            int aligned_byte= sizeof(SABER_X86_TYPE);
-            int c_size=aligned_byte/sizeof(OpDataType);
+            // rows are padded to the vector width of the kernels the host runs
+            _kernels = &x86_kernels();
+            int c_size = _kernels->width;
 
             _hidden_size = gru_param.bias()->valid_size() / 3;
             int weights_bias_size = _hidden_size * 3;
@@ -97,6 +92,7 @@ public:
                    sizeof(InDataType) * weights_h2h_size);
             memcpy(_weights_bias.mutable_data(), gru_param.bias()->data(),
                    sizeof(InDataType) * weights_bias_size);
+            init_step_weights();
 
 //            Shape wh_shape(1,1,2,_aligned_hidden_size/c_size,c_size);
 //            Shape whr_shape(1,1,1,_aligned_hidden_size/c_size,c_size);
@@ -149,6 +145,7 @@ private:
     int _aligned_size;
     int _aligned_word_size_iter_num;
     int _aligned_hidden_size_iter_num;
+    const X86Kernels* _kernels{nullptr};
 
     OpTensor _weights_i2h;
     OpTensor _weights_h2h;
@@ -168,12 +165,40 @@ private:
     OpTensor _temp_out;
     OpTensor _temp_h_init;
 
-    template <typename BIT>
     SaberStatus batch_s_aligned(\
                                 const std::vector<OpTensor*>& inputs,
                                 std::vector<OpTensor*>& outputs,
                                 GruParam<OpTensor>& param);
 
+    ///< threads of the batch 1 recurrence, it runs on the batch path with 1
+    int _step_threads{1};
+    ///< hidden units [_step_slices[t], _step_slices[t + 1]) belong to thread t
+    std::vector<int> _step_slices;
+    ///< per thread h2h weights of its units, o [hidden, units] and r z [hidden, 2, units]
+    std::vector<OpTensor> _step_weights_o;
+    std::vector<OpTensor> _step_weights_rz;
+    ///< per thread bias [3, units] and gates of one word, wx [3, units], wh [2, units], whr [units]
+    std::vector<OpTensor> _step_bias;
+    std::vector<OpTensor> _step_gates;
+    ///< r * hin of the whole hidden, every thread reads it for its o gates
+    OpTensor _step_reset;
+    utils::SpinBarrier _step_barrier;
+
+    /**
+     * \brief split the hidden units over the threads of the context, every thread packs
+     *  its slice of weights, so they are first touched by the thread which reads them.
+     */
+    void init_step_weights();
+
+    /**
+     * \brief the recurrence of a batch of one sequence on _step_threads threads, each computes
+     *  the gates of its hidden units from its slice of h2h weights. The o gates need the reset
+     *  hidden of all the units, so the threads meet at a spin barrier twice a word.
+     */
+    void step_dispatch(const OpDataType* wx, const OpDataType* h_init, OpDataType* h_out,
+                       const std::vector<int>& emit_offset_vec, int emit_length,
+                       GruParam<OpTensor>& param);
+
 };
 
 }
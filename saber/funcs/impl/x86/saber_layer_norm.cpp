@@ -0,0 +1,84 @@
+#include "saber/funcs/impl/x86/saber_layer_norm.h"
+
+namespace anakin{
+namespace saber {
+
+template class SaberLayerNorm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberLayerNorm<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        LayerNormParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberLayerNorm<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        LayerNormParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    this->_param = &param;
+    _inner_size = inputs[0]->count_valid(param.axis, inputs[0]->dims());
+    _outer_size = inputs[0]->count_valid(0, param.axis);
+    const OpTensor* scale = param.scale_weights();
+    const OpTensor* bias = param.bias_weights();
+    if (scale && scale->valid_size() > 0 && scale->valid_size() != _inner_size) {
+        LOG(ERROR) << "layer norm scale size " << scale->valid_size()
+                   << " doesn't match the normalized size " << _inner_size;
+        return SaberInvalidValue;
+    }
+    if (bias && bias->valid_size() > 0 && bias->valid_size() != _inner_size) {
+        LOG(ERROR) << "layer norm bias size " << bias->valid_size()
+                   << " doesn't match the normalized size " << _inner_size;
+        return SaberInvalidValue;
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberLayerNorm<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        LayerNormParam<OpTensor> &param) {
+    const float* src = inputs[0]->data();
+    float* dst = outputs[0]->mutable_data();
+    const OpTensor* scale_weights = param.scale_weights();
+    const OpTensor* bias_weights = param.bias_weights();
+    const float* scale = (scale_weights && scale_weights->valid_size() > 0) ? scale_weights->data() : nullptr;
+    const float* bias = (bias_weights && bias_weights->valid_size() > 0) ? bias_weights->data() : nullptr;
+    const int inner_size = _inner_size;
+    const X86Kernels& kernels = *_kernels;
+    outputs[0]->set_seq_offset(inputs[0]->get_seq_offset());
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < _outer_size; ++i) {
+        kernels.layer_norm(src + (size_t)i * inner_size, dst + (size_t)i * inner_size, inner_size,
+                           scale, bias, param.eps);
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
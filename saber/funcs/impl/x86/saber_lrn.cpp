@@ -0,0 +1,89 @@
+#include "saber/funcs/impl/x86/saber_lrn.h"
+#include <omp.h>
+#include <algorithm>
+
+namespace anakin{
+namespace saber {
+
+template class SaberLrn<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+///< pixels of one task, the running sums and a channel window of them stay in cache
+static const int kLrnBlock = 512;
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberLrn<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        LrnParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberLrn<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        LrnParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    this->_param = &param;
+    if (param.norm_region != ACROSS_CHANNELS) {
+        LOG(ERROR) << "lrn only supports ACROSS_CHANNELS currently";
+        return SaberUnImplError;
+    }
+    if (param.local_size <= 0) {
+        LOG(ERROR) << "lrn local size " << param.local_size << " should be positive";
+        return SaberInvalidValue;
+    }
+    _thread_num = omp_get_max_threads();
+    _accum.reshape(Shape(_thread_num, 1, 1, kLrnBlock));
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberLrn<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        LrnParam<OpTensor> &param) {
+    const float* src = inputs[0]->data();
+    float* dst = outputs[0]->mutable_data();
+    const int num = inputs[0]->num();
+    const int channel = inputs[0]->channel();
+    const int plane = inputs[0]->height() * inputs[0]->width();
+    const int blocks = (plane + kLrnBlock - 1) / kLrnBlock;
+    float* accum_all = _accum.mutable_data();
+    const X86Kernels& kernels = *_kernels;
+
+    #pragma omp parallel for schedule(static) num_threads(_thread_num)
+    for (int task = 0; task < num * blocks; ++task) {
+        const int n = task / blocks;
+        const int start = task % blocks * kLrnBlock;
+        const int len = std::min(kLrnBlock, plane - start);
+        const size_t offset = (size_t)n * channel * plane + start;
+        kernels.lrn_across(src + offset, dst + offset, len, channel, plane, param.local_size,
+                           param.alpha, param.beta, param.k,
+                           accum_all + (size_t)omp_get_thread_num() * kLrnBlock);
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -2,130 +2,129 @@
 #include "saber_types.h"
 #include "saber_lstm.h"
 #include "saber/core/tensor_op.h"
-#include <immintrin.h>
 #include "sys/time.h"
 #include "mkl_cblas.h"
-#include "saber_normal_activation.h"
 namespace anakin {
 
 namespace saber {
 
+///< floats of hidden units a thread owns at least in the batch 1 recurrence,
+///< below it the barrier of every word costs more than the slice saves
+static const int kStepSliceMin = 64;
 
-template <typename BIT,typename OpDataType,bool with_peephole>
-static inline void cal_first_lstm_nullhidden(int emit_word_id_start,int emit_word_id_end,OpDataType* temp_wx,const OpDataType* weight_peephole,
-                                      OpDataType* hout,OpDataType* inner_cell,const BIT* b_i, const BIT* b_f, const BIT* b_c, const BIT* b_o,
-                                      ActiveType gate_activity, ActiveType cell_activity, ActiveType candi_activity,int hidden_size){
-    const int i_offset = 0;
-    const int c_offset = 2;
-    const int o_offset = 3;
-    BIT(*gate_act)(const BIT) = Activate_inner<BIT>(gate_activity);
-    BIT(*cell_act)(const BIT) = Activate_inner<BIT>(cell_activity);
-    BIT(*candi_act)(const BIT) = Activate_inner<BIT>(candi_activity);
-    for (int emit_word_id = emit_word_id_start; emit_word_id < emit_word_id_end; emit_word_id++) {
-        int emit_wx_offset = emit_word_id * hidden_size * 4;
-        const BIT* w_x_i = (BIT*)(temp_wx + i_offset * hidden_size + emit_wx_offset);
-        const BIT* w_x_c = (BIT*)(temp_wx + c_offset * hidden_size + emit_wx_offset);
-        const BIT* w_x_o = (BIT*)(temp_wx + o_offset * hidden_size + emit_wx_offset);
-
-        const BIT* w_co = (BIT*)(weight_peephole + 2 * hidden_size);
-        int emit_id_offset = emit_word_id - emit_word_id_start;
-        BIT* gate_h_p = (BIT*)(hout + emit_id_offset * hidden_size);
-        BIT* gate_c_p = (BIT*)(inner_cell + emit_id_offset * hidden_size);
-
-        if(with_peephole) {
-            for (int frame_id = 0; frame_id < hidden_size / (sizeof(BIT) / sizeof(OpDataType));
-                 ++frame_id) {
-                BIT gate_i = gate_act(w_x_i[frame_id] + b_i[frame_id]);
-                BIT gate_c_s = cell_act(w_x_c[frame_id] + b_c[frame_id]);
-                BIT gate_c = gate_i * gate_c_s;
-                BIT gate_o = gate_act(w_x_o[frame_id] + b_o[frame_id] + gate_c * w_co[frame_id]);
-                gate_c_p[frame_id] = gate_c;
-                gate_h_p[frame_id] = gate_o * candi_act(gate_c);
-            }
-        } else{
-            for (int frame_id = 0; frame_id < hidden_size / (sizeof(BIT) / sizeof(OpDataType));
-                 ++frame_id) {
-                BIT gate_i = gate_act(w_x_i[frame_id] + b_i[frame_id]);
-                BIT gate_c_s = cell_act(w_x_c[frame_id] + b_c[frame_id]);
-                BIT gate_c = gate_i * gate_c_s;
-                BIT gate_o = gate_act(w_x_o[frame_id] + b_o[frame_id]);
-                gate_c_p[frame_id] = gate_c;
-                gate_h_p[frame_id] = gate_o * candi_act(gate_c);
+template<>
+void SaberLstm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
+        init_step_weights(LstmParam<OpTensor>& param) {
+    _step_slices = utils::split_aligned(_aligned_hidden_size, _kernels->width,
+                                        omp_get_max_threads(), kStepSliceMin);
+    _step_threads = _step_slices.size() - 1;
+    if (_step_threads < 2) {
+        return;
+    }
+    const int hidden = _hidden_size;
+    const int aligned = _aligned_hidden_size;
+    const OpDataType* weight_h = (const OpDataType*)_aligned_weights_h2h.data();
+    const OpDataType* bias = (const OpDataType*)_aligned_weights_bias.data();
+    const OpDataType* peephole = param.with_peephole ?
+                                 (const OpDataType*)_aligned_weights_peephole.data() : nullptr;
+    _step_weights_h2h.resize(_step_threads);
+    _step_bias.resize(_step_threads);
+    _step_peephole.resize(_step_threads);
+    _step_gates.resize(_step_threads);
+
+    #pragma omp parallel for schedule(static, 1) num_threads(_step_threads)
+    for (int t = 0; t < _step_threads; ++t) {
+        const int start = _step_slices[t];
+        const int units = _step_slices[t + 1] - start;
+        _step_weights_h2h[t].re_alloc(Shape(1, hidden, 4, units));
+        _step_bias[t].re_alloc(Shape(1, 1, 4, units));
+        _step_gates[t].re_alloc(Shape(1, 1, 4, units));
+        OpDataType* w = (OpDataType*)_step_weights_h2h[t].mutable_data();
+        OpDataType* b = (OpDataType*)_step_bias[t].mutable_data();
+        for (int row = 0; row < hidden * 4; ++row) {
+            memcpy(w + row * units, weight_h + row * aligned + start, units * sizeof(OpDataType));
+        }
+        for (int gate = 0; gate < 4; ++gate) {
+            memcpy(b + gate * units, bias + gate * aligned + start, units * sizeof(OpDataType));
+        }
+        if (peephole != nullptr) {
+            _step_peephole[t].re_alloc(Shape(1, 1, 3, units));
+            OpDataType* p = (OpDataType*)_step_peephole[t].mutable_data();
+            for (int gate = 0; gate < 3; ++gate) {
+                memcpy(p + gate * units, peephole + gate * aligned + start, units * sizeof(OpDataType));
             }
         }
     }
 }
 
-template <typename BIT,typename OpDataType,bool with_peephole>
-static inline void cal_lstm_batch(int emit_word_id_start,int emit_word_id_end,OpDataType* temp_wx,const OpDataType* weight_peephole,
-                                  OpDataType* hout,OpDataType* inner_cell,const BIT* b_i, const BIT* b_f, const BIT* b_c, const BIT* b_o,
-                                  ActiveType gate_activity, ActiveType cell_activity, ActiveType candi_activity,int hidden_size){
-    const int i_offset = 0;
-    const int f_offset = 1;
-    const int c_offset = 2;
-    const int o_offset = 3;
-    BIT(*gate_act)(const BIT) = Activate_inner<BIT>(gate_activity);
-    BIT(*cell_act)(const BIT) = Activate_inner<BIT>(cell_activity);
-    BIT(*candi_act)(const BIT) = Activate_inner<BIT>(candi_activity);
-    for (int emit_word_id = emit_word_id_start; emit_word_id < emit_word_id_end; emit_word_id++) {
-        int emit_wx_offset = emit_word_id * hidden_size * 4;
-        const BIT* w_x_i = (BIT*)(temp_wx + i_offset * hidden_size + emit_wx_offset);
-        const BIT* w_x_f = (BIT*)(temp_wx + f_offset * hidden_size + emit_wx_offset);
-        const BIT* w_x_c = (BIT*)(temp_wx + c_offset * hidden_size + emit_wx_offset);
-        const BIT* w_x_o = (BIT*)(temp_wx + o_offset * hidden_size + emit_wx_offset);
-
-        int emit_id_offset = emit_word_id - emit_word_id_start;
-
-        const BIT* w_ci = (BIT*)(weight_peephole + 0 * hidden_size);
-        const BIT* w_cf = (BIT*)(weight_peephole + 1 * hidden_size);
-        const BIT* w_co = (BIT*)(weight_peephole + 2 * hidden_size);
-
-        BIT* gate_h_p = (BIT*)(hout + emit_id_offset * hidden_size);
-        BIT* gate_c_p = (BIT*)(inner_cell + emit_id_offset * hidden_size);
-
-        if(with_peephole) {
-            for (int frame_id = 0; frame_id < hidden_size / (sizeof(BIT) / sizeof(OpDataType));
-                 ++frame_id) {
-                BIT c_1 = gate_c_p[frame_id];
-                BIT gate_i = gate_act(w_x_i[frame_id] + b_i[frame_id] + w_ci[frame_id] * c_1);
-                BIT gate_f = gate_act(w_x_f[frame_id] + b_f[frame_id] + w_cf[frame_id] * c_1);
-                BIT gate_c_s = cell_act(w_x_c[frame_id] + b_c[frame_id]);
-                BIT gate_c = gate_f * c_1 + gate_i * gate_c_s;
-                BIT gate_o = gate_act(w_x_o[frame_id] + b_o[frame_id] + gate_c * w_co[frame_id]);
-                gate_c_p[frame_id] = gate_c;
-                gate_h_p[frame_id] = gate_o * candi_act(gate_c);
-
-            }
-        }else{
-            for (int frame_id = 0; frame_id < hidden_size / (sizeof(BIT) / sizeof(OpDataType));
-                 ++frame_id) {
-                BIT c_1 = gate_c_p[frame_id];
-                BIT gate_i = gate_act(w_x_i[frame_id]  + b_i[frame_id]);
-                BIT gate_f = gate_act(w_x_f[frame_id]  + b_f[frame_id]);
-                BIT gate_c_s = cell_act(w_x_c[frame_id]  + b_c[frame_id]);
-                BIT gate_c = gate_f * c_1 + gate_i * gate_c_s;
-                BIT gate_o = gate_act(w_x_o[frame_id]  + b_o[frame_id]);
-                gate_c_p[frame_id] = gate_c;
-                gate_h_p[frame_id] = gate_o * candi_act(gate_c);
+template<>
+void SaberLstm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
+        step_dispatch(const OpDataType* wx, const OpDataType* h_init, OpDataType* h_out,
+                      OpDataType* cell, const std::vector<int>& emit_offset_vec, int emit_length,
+                      LstmParam<OpTensor>& param) {
+    const int hidden = _hidden_size;
+    const int aligned = _aligned_hidden_size;
+
+    #pragma omp parallel num_threads(_step_threads)
+    {
+        #pragma omp single
+        _step_barrier.reset(omp_get_num_threads());
+
+        // a smaller team than asked for takes several slices per thread
+        const int team = omp_get_num_threads();
+        X86LstmCellArgs cell_args;
+        cell_args.row_start = 0;
+        cell_args.row_end = 1;
+        cell_args.gate_act = param.gate_activity;
+        cell_args.cell_act = param.cell_activity;
+        cell_args.candi_act = param.candidate_activity;
+
+        for (int word_id = 0; word_id < emit_length; word_id++) {
+            int real_word_id = param.is_reverse ? emit_length - word_id - 1 : word_id;
+            int last_word_id = param.is_reverse ? real_word_id + 1 : word_id - 1;
+            const OpDataType* wx_row = wx + emit_offset_vec[real_word_id] * 4 * aligned;
+            const OpDataType* hin = word_id == 0 ? h_init :
+                                    h_out + emit_offset_vec[last_word_id] * aligned;
+            OpDataType* hout = h_out + emit_offset_vec[real_word_id] * aligned;
+
+            for (int t = omp_get_thread_num(); t < _step_threads; t += team) {
+                const int start = _step_slices[t];
+                const int units = _step_slices[t + 1] - start;
+                OpDataType* gates = (OpDataType*)_step_gates[t].mutable_data();
+                for (int gate = 0; gate < 4; ++gate) {
+                    memcpy(gates + gate * units, wx_row + gate * aligned + start, units * sizeof(OpDataType));
+                }
+                if (hin != nullptr) {
+                    cblas_sgemv(CblasRowMajor, CblasTrans, hidden, 4 * units, 1.f,
+                                (const OpDataType*)_step_weights_h2h[t].data(), 4 * units,
+                                hin, 1, 1.f, gates, 1);
+                }
+                cell_args.wx = gates;
+                cell_args.bias = (const OpDataType*)_step_bias[t].data();
+                cell_args.peephole = param.with_peephole ?
+                                     (const OpDataType*)_step_peephole[t].data() : nullptr;
+                cell_args.hout = hout + start;
+                cell_args.cell = cell + start;
+                cell_args.hidden = units;
+                cell_args.first = hin == nullptr;
+                _kernels->lstm_cell(cell_args);
             }
+            // the next word reads the whole hidden of this one
+            _step_barrier.wait();
         }
     }
 }
 
 template<>
-template <typename BIT,bool with_peephole>
 SaberStatus SaberLstm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
-        avx_dispatch(const std::vector<DataTensor_in*>& inputs,
+        vec_dispatch(const std::vector<DataTensor_in*>& inputs,
                      std::vector<DataTensor_out*>& outputs,
                      LstmParam<OpTensor>& param) {
-    int loop_div = sizeof(BIT) / sizeof(OpDataType);
     const OpDataType* weight_h = (const OpDataType*)_aligned_weights_h2h.data();
     const OpDataType* weight_w = (const OpDataType*)_aligned_weights_i2h.data();
     const OpDataType* bias = (const OpDataType*)_aligned_weights_bias.data();
-    const OpDataType* weight_peephole = (const OpDataType*)_aligned_weights_peephole.data();
-    BIT(*gate_act)(const BIT) = Activate_inner<BIT>(param.gate_activity);
-    BIT(*cell_act)(const BIT) = Activate_inner<BIT>(param.cell_activity);
-    BIT(*candi_act)(const BIT) = Activate_inner<BIT>(param.candidate_activity);
+    const OpDataType* weight_peephole = param.with_peephole ?
+                                        (const OpDataType*)_aligned_weights_peephole.data() : nullptr;
 
     std::vector<int> offset_vec = inputs[0]->get_seq_offset();
     std::vector<int> length_vec(offset_vec.size() - 1);
@@ -149,13 +148,31 @@ SaberStatus SaberLstm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
                                        batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
         h_init = (const OpDataType*)_aligned_init_hidden.data();
     } else if (param.init_hidden() != nullptr) {
-        h_init =(const OpDataType*) param.init_hidden()->data();
-        //FIXME:is it correct?
-    } else {
-        //        _aligned_init_hidden.try_expand_size(batch_size * _aligned_hidden_size);
-        //        _aligned_init_celll.try_expand_size(batch_size * _aligned_hidden_size);
-        //        h_init = _aligned_init_hidden.data();
-        //        cell_init=_aligned_init_celll.data();
+        // state carried over from the previous chunk, batch_size * _hidden_size
+        CHECK_GE(param.init_hidden()->valid_size(), batch_size * _hidden_size) << "init hidden is too small";
+        _aligned_init_hidden.try_expand_size(batch_size * _aligned_hidden_size);
+        memset(_aligned_init_hidden.mutable_data(), 0, batch_size * _aligned_hidden_size * sizeof(OpDataType));
+        aligned_utils.aligned_last_dim((const OpDataType*)param.init_hidden()->data(),
+                                       (OpDataType*)_aligned_init_hidden.mutable_data(),
+                                       batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
+        h_init = (const OpDataType*)_aligned_init_hidden.data();
+    }
+
+    if (param.init_cell() != nullptr) {
+        CHECK_GE(param.init_cell()->valid_size(), batch_size * _hidden_size) << "init cell is too small";
+        _aligned_init_cell.try_expand_size(batch_size * _aligned_hidden_size);
+        memset(_aligned_init_cell.mutable_data(), 0, batch_size * _aligned_hidden_size * sizeof(OpDataType));
+        aligned_utils.aligned_last_dim((const OpDataType*)param.init_cell()->data(),
+                                       (OpDataType*)_aligned_init_cell.mutable_data(),
+                                       batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
+        cell_init = (const OpDataType*)_aligned_init_cell.data();
+
+        if (h_init == nullptr) {
+            // the null hidden fast path of the first word assumes a zero cell, so feed zero hidden instead
+            _aligned_init_hidden.try_expand_size(batch_size * _aligned_hidden_size);
+            memset(_aligned_init_hidden.mutable_data(), 0, batch_size * _aligned_hidden_size * sizeof(OpDataType));
+            h_init = (const OpDataType*)_aligned_init_hidden.data();
+        }
     }
 
     std::vector<int> emit_offset_vec;
@@ -198,62 +215,80 @@ SaberStatus SaberLstm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
     inner_cell = (OpDataType*)_temp_cell.mutable_data();
     memset(inner_cell, 0, _temp_cell.valid_size()* sizeof(OpDataType));
 
+    if (cell_init != nullptr) {
+        if (transform) {
+            transe_util.hidden_2_sorted_hidden(cell_init, inner_cell, _aligned_hidden_size);
+        } else {
+            memcpy(inner_cell, cell_init, batch_size * _aligned_hidden_size * sizeof(OpDataType));
+        }
+    }
+
     OpDataType* temp_wh = (OpDataType*)_temp_wh.mutable_data();
     OpDataType* temp_wx = (OpDataType*)_temp_wx.mutable_data();
 
     mkl_gemm(false, false, seqsum, 4 * _aligned_hidden_size, _word_size, 1.f, inner_x, weight_w, 0.f,
          temp_wx);
 
-    const int i_offset = 0;
-    const int f_offset = 1;
-    const int c_offset = 2;
-    const int o_offset = 3;
-    const BIT* b_i = (BIT*)(bias + i_offset * _aligned_hidden_size);
-    const BIT* b_f = (BIT*)(bias + f_offset * _aligned_hidden_size);
-    const BIT* b_c = (BIT*)(bias + c_offset * _aligned_hidden_size);
-    const BIT* b_o = (BIT*)(bias + o_offset * _aligned_hidden_size);
-
-    for (int word_id = 0; word_id < emit_length; word_id++) {
-        int real_word_id = word_id;
-        int last_word_id = word_id - 1;
-
-        if (param.is_reverse && batch_size == 1) {
-            real_word_id = emit_length - word_id - 1;
-            last_word_id = real_word_id + 1;
-        }
+    X86LstmCellArgs cell_args;
+    cell_args.wx = temp_wx;
+    cell_args.bias = bias;
+    cell_args.peephole = weight_peephole;
+    cell_args.gate_act = param.gate_activity;
+    cell_args.cell_act = param.cell_activity;
+    cell_args.candi_act = param.candidate_activity;
+    cell_args.hidden = _aligned_hidden_size;
+
+    if (batch_size == 1 && _step_threads > 1) {
+        step_dispatch(temp_wx, inner_h_init, inner_h_out, inner_cell, emit_offset_vec, emit_length, param);
+    } else {
+        for (int word_id = 0; word_id < emit_length; word_id++) {
+            int real_word_id = word_id;
+            int last_word_id = word_id - 1;
 
-        int emit_word_id_start = emit_offset_vec[real_word_id];
-        int emit_word_id_end = emit_offset_vec[real_word_id + 1];
-        int emit_word_length = emit_word_id_end - emit_word_id_start;
-        const float* hin;
+            if (param.is_reverse && batch_size == 1) {
+                real_word_id = emit_length - word_id - 1;
+                last_word_id = real_word_id + 1;
+            }
 
-        if (word_id == 0 && inner_h_init == nullptr) {
-            float* hout = nullptr;
-            hout = emit_offset_vec[real_word_id] * _aligned_hidden_size + inner_h_out;
+            int emit_word_id_start = emit_offset_vec[real_word_id];
+            int emit_word_id_end = emit_offset_vec[real_word_id + 1];
+            int emit_word_length = emit_word_id_end - emit_word_id_start;
+            const float* hin;
 
-            cal_first_lstm_nullhidden<BIT,OpDataType,with_peephole>(emit_word_id_start,emit_word_id_end,temp_wx,weight_peephole,
-                                                                    hout,inner_cell,b_i,b_f,b_c,b_o,
-                                                                    param.gate_activity,  param.cell_activity,  param.candidate_activity, _aligned_hidden_size);
+            if (word_id == 0 && inner_h_init == nullptr) {
+                float* hout = nullptr;
+                hout = emit_offset_vec[real_word_id] * _aligned_hidden_size + inner_h_out;
 
-            continue;
+                cell_args.row_start = emit_word_id_start;
+                cell_args.row_end = emit_word_id_end;
+                cell_args.hout = hout;
+                cell_args.cell = inner_cell;
+                cell_args.first = true;
+                _kernels->lstm_cell(cell_args);
 
-        } else if (word_id == 0) {
-            hin = inner_h_init;
-        } else {
-            hin = inner_h_out + emit_offset_vec[last_word_id] * _aligned_hidden_size;
-        }
+                continue;
 
-        float* hout = nullptr;
-        hout = emit_offset_vec[real_word_id] * _aligned_hidden_size + inner_h_out;
+            } else if (word_id == 0) {
+                hin = inner_h_init;
+            } else {
+                hin = inner_h_out + emit_offset_vec[last_word_id] * _aligned_hidden_size;
+            }
 
-        //wh
-        mkl_gemm(false, false, emit_word_length, 4 * _aligned_hidden_size, _aligned_hidden_size, 1.0, hin,
-             weight_h,
-             1.f, temp_wx+emit_word_id_start*4*_aligned_hidden_size);
+            float* hout = nullptr;
+            hout = emit_offset_vec[real_word_id] * _aligned_hidden_size + inner_h_out;
 
-        cal_lstm_batch<BIT,OpDataType,with_peephole>(emit_word_id_start,emit_word_id_end,temp_wx,weight_peephole,
-                                                     hout,inner_cell,b_i,b_f,b_c,b_o,
-                                                     param.gate_activity,  param.cell_activity,  param.candidate_activity, _aligned_hidden_size);
+            //wh
+            mkl_gemm(false, false, emit_word_length, 4 * _aligned_hidden_size, _aligned_hidden_size, 1.0, hin,
+                 weight_h,
+                 1.f, temp_wx+emit_word_id_start*4*_aligned_hidden_size);
+
+            cell_args.row_start = emit_word_id_start;
+            cell_args.row_end = emit_word_id_end;
+            cell_args.hout = hout;
+            cell_args.cell = inner_cell;
+            cell_args.first = false;
+            _kernels->lstm_cell(cell_args);
+        }
     }
 
     if (transform) {
@@ -262,6 +297,24 @@ SaberStatus SaberLstm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
         aligned_utils.unaligned_last_dim((OpDataType*)_temp_out.data(), out, seqsum * _hidden_size, _hidden_size,
                                          _aligned_hidden_size);
     }
+
+    // export the final state of every sequence, so the next chunk can continue from it
+    if (param.last_hidden() != nullptr) {
+        param.last_hidden()->reshape(Shape(batch_size, _hidden_size, 1, 1));
+        OpDataType* last_hidden = (OpDataType*)param.last_hidden()->mutable_data();
+
+        for (int i = 0; i < batch_size; ++i) {
+            int last_word_id = is_reverse ? offset_vec[i] : offset_vec[i + 1] - 1;
+            memcpy(last_hidden + i * _hidden_size, out + last_word_id * _hidden_size,
+                   _hidden_size * sizeof(OpDataType));
+        }
+    }
+
+    if (param.last_cell() != nullptr) {
+        param.last_cell()->reshape(Shape(batch_size, _hidden_size, 1, 1));
+        transe_util.sorted_hidden_2_hidden(inner_cell, (OpDataType*)param.last_cell()->mutable_data(),
+                                           _hidden_size, _aligned_hidden_size);
+    }
     return SaberSuccess;
 
 };
@@ -275,13 +328,8 @@ SaberStatus SaberLstm<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>::
                      LstmParam<OpTensor>& param) {
     CHECK_EQ(inputs.size(),1)<<"only support input size = 1";
     CHECK_EQ(outputs.size(),1)<<"only support outputs size = 1";
-    CHECK_EQ(param.init_hidden()==nullptr, true )<<"only support param.init_hidden() == nullptr";
     CHECK_EQ(param.num_layers,1)<<"only support param.num_layers==1";
-    if(param.with_peephole){
-        avx_dispatch<SABER_X86_TYPE,true>(inputs,outputs,param);
-    }else{
-        avx_dispatch<SABER_X86_TYPE,false>(inputs,outputs,param);
-    }
+    vec_dispatch(inputs,outputs,param);
 
     return SaberSuccess;
 }
@@ -18,17 +18,7 @@
 
 #include "saber/funcs/impl/impl_lstm.h"
 #include "saber/funcs/impl/x86/x86_utils.h"
-
-
-#if defined(__AVX512F__)
-#define SABER_X86_TYPE __m512
-#elif defined(__AVX2__) and defined(__FMA__)
-#define SABER_X86_TYPE __m256
-#elif defined(__SSE4_2__) and defined(__FMA__)
-#define SABER_X86_TYPE __m128
-#else
-#define SABER_X86_TYPE float
-#endif
+#include "saber/funcs/impl/x86/x86_kernels.h"
 
 namespace anakin {
 namespace saber {
@@ -54,7 +44,7 @@ public:
     typedef typename OpTensor::Dtype DataType_op;
     typedef DataType_op OpDataType;
 
-    SaberLstm():_hidden_size(0){};
+    SaberLstm():_hidden_size(0), _kernels(nullptr){};
 
     ~SaberLstm() {};
 
@@ -75,8 +65,11 @@ public:
         int weights_bias_size=4*_hidden_size;
         int weights_peephole_size=3*_hidden_size;
 
-        int aligned_byte= sizeof(SABER_X86_TYPE);
-        int c_size=aligned_byte/sizeof(DataType_op);
+        CHECK(x86_rnn_act_supported(param.gate_activity) && x86_rnn_act_supported(param.cell_activity)
+              && x86_rnn_act_supported(param.candidate_activity)) << "x86 lstm doesn't support the activations";
+        // rows are padded to the vector width of the kernels the host runs
+        _kernels = &x86_kernels();
+        int c_size = _kernels->width;
 
         _aligned_word_size=utils::round_up(_word_size,c_size);
         _aligned_hidden_size=utils::round_up(_hidden_size,c_size);
@@ -105,6 +98,7 @@ public:
             aligned_tool.aligned_last_dim(param.bias()->data()+weights_bias_size,_aligned_weights_peephole.mutable_data(),
                                           weights_peephole_size,_hidden_size,_aligned_hidden_size);
         }
+        init_step_weights(param);
 
         return SaberSuccess;
     };
@@ -126,6 +120,7 @@ private:
     int _hidden_size;
     int _aligned_word_size;
     int _aligned_hidden_size;
+    const X86Kernels* _kernels;
 
 
     OpTensor _weights_i2h;
@@ -140,6 +135,7 @@ private:
     OpTensor _aligned_weights_peephole;
 
     OpTensor _aligned_init_hidden;
+    OpTensor _aligned_init_cell;
 
     OpTensor _temp_wx;
     OpTensor _temp_wh;
@@ -149,11 +145,37 @@ private:
     OpTensor _temp_out;
     OpTensor _temp_h_init;
 
-    template <typename BIT,bool with_peephole>
-    SaberStatus avx_dispatch(const std::vector<DataTensor_in*>& inputs,
+    SaberStatus vec_dispatch(const std::vector<DataTensor_in*>& inputs,
                                            std::vector<DataTensor_out*>& outputs,
                                            LstmParam<OpTensor>& param);
 
+    ///< threads of the batch 1 recurrence, it runs on the batch path with 1
+    int _step_threads{1};
+    ///< hidden units [_step_slices[t], _step_slices[t + 1]) belong to thread t
+    std::vector<int> _step_slices;
+    ///< per thread h2h weights of its units [hidden, 4, units], bias [4, units], peephole [3, units]
+    std::vector<OpTensor> _step_weights_h2h;
+    std::vector<OpTensor> _step_bias;
+    std::vector<OpTensor> _step_peephole;
+    ///< per thread gates of its units in one word
+    std::vector<OpTensor> _step_gates;
+    utils::SpinBarrier _step_barrier;
+
+    /**
+     * \brief split the hidden units over the threads of the context, every thread packs
+     *  its slice of weights, so they are first touched by the thread which reads them.
+     */
+    void init_step_weights(LstmParam<OpTensor>& param);
+
+    /**
+     * \brief the recurrence of a batch of one sequence on _step_threads threads, each computes
+     *  the gates and cells of its hidden units from its slice of h2h weights, which stays in
+     *  its cache. The threads meet at a spin barrier after every word.
+     */
+    void step_dispatch(const OpDataType* wx, const OpDataType* h_init, OpDataType* h_out,
+                       OpDataType* cell, const std::vector<int>& emit_offset_vec, int emit_length,
+                       LstmParam<OpTensor>& param);
+
 
 
 
@@ -0,0 +1,101 @@
+#include "saber/funcs/impl/x86/saber_mat_mul.h"
+#include "mkl_cblas.h"
+#include <omp.h>
+
+namespace anakin{
+namespace saber {
+
+template class SaberMatMul<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMatMul<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MatMulParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMatMul<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MatMulParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    this->_param = &param;
+    const DataTensor_in* x = inputs[0];
+    const DataTensor_in* y = inputs[1];
+    _batch = x->num() * x->channel();
+    _m = param._is_transpose_X ? x->width() : x->height();
+    _k = param._is_transpose_X ? x->height() : x->width();
+    _n = param._is_transpose_Y ? y->height() : y->width();
+    int k_y = param._is_transpose_Y ? y->width() : y->height();
+    if (_k != k_y) {
+        LOG(ERROR) << "mat mul inner dims of x (" << _k << ") and y (" << k_y << ") mismatch";
+        return SaberInvalidValue;
+    }
+    const int batch_y = y->num() * y->channel();
+    if (batch_y != _batch && batch_y != 1) {
+        LOG(ERROR) << "mat mul y holds " << batch_y << " matrices, expect 1 or " << _batch;
+        return SaberInvalidValue;
+    }
+    _batched_y = batch_y != 1;
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMatMul<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MatMulParam<OpTensor> &param) {
+    const float* x = inputs[0]->data();
+    const float* y = inputs[1]->data();
+    float* out = outputs[0]->mutable_data();
+    const int m = _m;
+    const int n = _n;
+    const int k = _k;
+    const size_t x_stride = (size_t)m * k;
+    const size_t y_stride = _batched_y ? (size_t)k * n : 0;
+    const size_t out_stride = (size_t)m * n;
+    const CBLAS_TRANSPOSE trans_x = param._is_transpose_X ? CblasTrans : CblasNoTrans;
+    const CBLAS_TRANSPOSE trans_y = param._is_transpose_Y ? CblasTrans : CblasNoTrans;
+    const int ld_x = param._is_transpose_X ? m : k;
+    const int ld_y = param._is_transpose_Y ? k : n;
+    auto gemm = [&](int b) {
+        cblas_sgemm(CblasRowMajor, trans_x, trans_y, m, n, k, 1.f, x + b * x_stride, ld_x,
+                    y + b * y_stride, ld_y, 0.f, out + b * out_stride, n);
+    };
+
+    if (_batch >= omp_get_max_threads()) {
+        #pragma omp parallel for schedule(static)
+        for (int b = 0; b < _batch; ++b) {
+            gemm(b);
+        }
+    } else {
+        for (int b = 0; b < _batch; ++b) {
+            gemm(b);
+        }
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -0,0 +1,160 @@
+#include "saber/funcs/impl/x86/saber_multi_head_attention.h"
+#include "mkl_cblas.h"
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+
+namespace anakin{
+namespace saber {
+
+template class SaberMultiHeadAttention<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMultiHeadAttention<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MultiHeadAttentionParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMultiHeadAttention<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MultiHeadAttentionParam<OpTensor> &param, Context<X86> &ctx) {
+    if (inDtype != AK_FLOAT) {
+        LOG(ERROR) << "multi head attention only supports FP32 currently";
+        return SaberUnImplError;
+    }
+    this->_ctx = &ctx;
+    this->_param = &param;
+
+    FcParam<OpTensor>& fc_param = param.fc_param;
+    _words = inputs[0]->count_valid(0, fc_param.axis);
+    _dim = inputs[0]->count_valid(fc_param.axis, inputs[0]->dims());
+    int qkv_dim = _dim;
+    if (fc_param.weights) {
+        qkv_dim = fc_param.num_output > 0 ? fc_param.num_output : fc_param.weights->valid_size() / _dim;
+        _qkv.reshape(Shape(_words, qkv_dim, 1, 1));
+    }
+    _hidden = qkv_dim / 3;
+    if (_hidden * 3 != qkv_dim || param.head_num <= 0 || _hidden % param.head_num != 0) {
+        LOG(ERROR) << "multi head attention can't split q k v of " << qkv_dim
+                   << " into " << param.head_num << " heads";
+        return SaberInvalidValue;
+    }
+    _head_dim = _hidden / param.head_num;
+    _scale = param.scale > 0.f ? param.scale : 1.f / sqrtf(_head_dim);
+    _thread_num = omp_get_max_threads();
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMultiHeadAttention<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MultiHeadAttentionParam<OpTensor> &param) {
+    FcParam<OpTensor>& fc_param = param.fc_param;
+    const int words = _words;
+    const int hidden = _hidden;
+    const int qkv_ld = 3 * hidden;
+    const int head_dim = _head_dim;
+    const int head_num = param.head_num;
+    std::vector<int> offset = inputs[0]->get_seq_offset();
+    if (offset.size() < 2) {
+        offset = {0, words};
+    }
+    if (offset.back() != words) {
+        LOG(ERROR) << "seq offset ends at " << offset.back() << ", the input has " << words << " words";
+        return SaberInvalidValue;
+    }
+    outputs[0]->set_seq_offset(inputs[0]->get_seq_offset());
+
+    // q k v projection of all the words at once
+    const float* qkv = inputs[0]->data();
+    if (fc_param.weights) {
+        float* proj = _qkv.mutable_data();
+        const float* weights = fc_param.weights->data();
+        if (fc_param.is_transpose_weights) {
+            // weights is dim * qkv
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, words, qkv_ld, _dim,
+                        1.f, qkv, _dim, weights, qkv_ld, 0.f, proj, qkv_ld);
+        } else {
+            // weights is qkv * dim
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, words, qkv_ld, _dim,
+                        1.f, qkv, _dim, weights, _dim, 0.f, proj, qkv_ld);
+        }
+        if (fc_param.bias) {
+            const float* bias = fc_param.bias->data();
+            const X86Kernels& kernels = *_kernels;
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < words; ++i) {
+                kernels.elt_apply(Eltwise_sum, proj + (size_t)i * qkv_ld, bias, false, 1.f, qkv_ld);
+            }
+        }
+        qkv = proj;
+    }
+
+    int max_len = 0;
+    for (int s = 0; s + 1 < offset.size(); ++s) {
+        max_len = std::max(max_len, offset[s + 1] - offset[s]);
+    }
+    if (_scores.valid_size() < _thread_num * max_len * max_len) {
+        _scores.reshape(Shape(_thread_num, max_len, max_len, 1));
+    }
+    float* scores_all = _scores.mutable_data();
+    float* out = outputs[0]->mutable_data();
+    const int seq_num = offset.size() - 1;
+    const float scale = _scale;
+    const X86Kernels& kernels = *_kernels;
+
+    #pragma omp parallel for schedule(dynamic) num_threads(_thread_num)
+    for (int task = 0; task < seq_num * head_num; ++task) {
+        const int s = task / head_num;
+        const int h = task % head_num;
+        const int start = offset[s];
+        const int len = offset[s + 1] - start;
+        if (len == 0) {
+            continue;
+        }
+        float* scores = scores_all + (size_t)omp_get_thread_num() * max_len * max_len;
+        const float* q = qkv + (size_t)start * qkv_ld + h * head_dim;
+        const float* k = q + hidden;
+        const float* v = q + 2 * hidden;
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, len, len, head_dim,
+                    scale, q, qkv_ld, k, qkv_ld, 0.f, scores, len);
+        for (int i = 0; i < len; ++i) {
+            float* row = scores + i * len;
+            float max = 0.f;
+            float sum = 0.f;
+            kernels.softmax_stat(row, len, max, sum);
+            kernels.softmax_norm(row, row, len, max, 1.f / sum);
+        }
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, len, head_dim, len,
+                    1.f, scores, len, v, qkv_ld, 0.f, out + (size_t)start * hidden + h * head_dim, hidden);
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -0,0 +1,84 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_MULTI_HEAD_ATTENTION_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_MULTI_HEAD_ATTENTION_H
+
+#include "saber/funcs/impl/impl_multi_head_attention.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#include "saber/saber_funcs_param.h"
+
+namespace anakin{
+namespace saber {
+
+/**
+ * q, k and v of all the words come from one gemm, then every (sequence, head) pair is a
+ * task: the scores of the sequence against itself, the softmax of every row and the
+ * weighted sum of v, in a per thread buffer of len * len scores. Sequences are never
+ * padded, so the seq offsets are the mask.
+ */
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+class SaberMultiHeadAttention<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out> : public ImplBase<
+        Tensor<X86, inDtype, LayOutType_in>,
+        Tensor<X86, outDtype, LayOutType_out>,
+        Tensor<X86, OpDtype, LayOutType_op>,
+        MultiHeadAttentionParam<Tensor<X86, OpDtype, LayOutType_op> > > {
+public:
+    typedef Tensor<X86, inDtype, LayOutType_in> DataTensor_in;
+    typedef Tensor<X86, outDtype, LayOutType_out> DataTensor_out;
+    typedef Tensor<X86, OpDtype, LayOutType_op> OpTensor;
+
+    SaberMultiHeadAttention() = default;
+
+    ~SaberMultiHeadAttention() {}
+
+    virtual SaberStatus init(const std::vector<DataTensor_in*>& inputs,
+                             std::vector<DataTensor_out*>& outputs,
+                             MultiHeadAttentionParam<OpTensor> &param,
+                             Context<X86> &ctx) override;
+
+    virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
+                               std::vector<DataTensor_out*>& outputs,
+                               MultiHeadAttentionParam<OpTensor> &param,
+                               Context<X86> &ctx) override;
+
+    virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
+                                 std::vector<DataTensor_out*>& outputs,
+                                 MultiHeadAttentionParam<OpTensor> &param) override;
+
+private:
+    int _words{0};
+    int _dim{0};
+    int _hidden{0};
+    int _head_dim{0};
+    float _scale{1.f};
+    int _thread_num{1};
+    ///< q, k and v of every word, (words, 3 * hidden), unused when the input holds them
+    DataTensor_in _qkv;
+    ///< scores of every thread, grown to the longest sequence
+    DataTensor_in _scores;
+    const X86Kernels* _kernels{nullptr};
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "saber/funcs/impl/x86/saber_multiclass_nms.h"
+#include "saber/funcs/impl/x86/x86_detection.h"
+#include <cstring>
+
+namespace anakin{
+namespace saber {
+
+template class SaberMultiClassNMS<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMultiClassNMS<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MultiClassNMSParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMultiClassNMS<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MultiClassNMSParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    //! inputs[0]: bbox map {N, boxes, 4(xmin, ymin, xmax, ymax), 1}
+    //! inputs[1]: score map {N, classes, boxes, 1}
+    Shape sh_bbox = inputs[0]->valid_shape();
+    Shape sh_conf = inputs[1]->valid_shape();
+    _num_priors = sh_bbox[1];
+    if (sh_conf[2] != sh_bbox[1]) {
+        LOG(ERROR) << "Number of bboxes must match the number of scores per class.";
+        return SaberInvalidValue;
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMultiClassNMS<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MultiClassNMSParam<OpTensor>& param) {
+    const int num = inputs[0]->num();
+    const int class_num = inputs[1]->valid_shape()[1];
+    x86_multiclass_nms(inputs[0]->data(), inputs[1]->data(), num, class_num, _num_priors, true,
+                       make_x86_nms_param(param), _result);
+
+    if (_result.empty()) {
+        _result.assign(7, -1.f);
+    }
+    const int rows = _result.size() / 7;
+    outputs[0]->reshape(Shape(1, 1, rows, 7));
+    memcpy(outputs[0]->mutable_data(), _result.data(), sizeof(float) * _result.size());
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -0,0 +1,83 @@
+#include "saber/funcs/impl/x86/saber_mvn.h"
+#include <cstring>
+
+namespace anakin{
+namespace saber {
+
+template class SaberMvn<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMvn<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MvnParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMvn<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MvnParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    this->_param = &param;
+    _rows = param.across_channels ? inputs[0]->num() : inputs[0]->num() * inputs[0]->channel();
+    _row_size = _rows > 0 ? inputs[0]->valid_size() / _rows : 0;
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberMvn<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        MvnParam<OpTensor> &param) {
+    const float* src = inputs[0]->data();
+    float* dst = outputs[0]->mutable_data();
+    const int row_size = _row_size;
+    const X86Kernels& kernels = *_kernels;
+    if (row_size == 0) {
+        return SaberSuccess;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < _rows; ++i) {
+        const float* src_row = src + (size_t)i * row_size;
+        float* dst_row = dst + (size_t)i * row_size;
+        if (param.normalize_variance) {
+            kernels.layer_norm(src_row, dst_row, row_size, nullptr, nullptr, param.eps);
+        } else {
+            float mean = 0.f;
+            float var = 0.f;
+            kernels.mean_var(src_row, row_size, mean, var);
+            float neg_mean = -mean;
+            if (dst_row != src_row) {
+                memcpy(dst_row, src_row, row_size * sizeof(float));
+            }
+            kernels.elt_apply(Eltwise_sum, dst_row, &neg_mean, true, 1.f, row_size);
+        }
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
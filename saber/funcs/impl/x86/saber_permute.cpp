@@ -0,0 +1,68 @@
+#include "saber/funcs/impl/x86/saber_permute.h"
+#include "saber/funcs/impl/x86/x86_permute.h"
+
+namespace anakin{
+namespace saber {
+
+template class SaberPermute<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberPermute<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        PermuteParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberPermute<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        PermuteParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    if (param.order.size() != inputs[0]->valid_shape().dims()) {
+        LOG(ERROR) << "permute order has " << param.order.size() << " dims, the input has "
+                   << inputs[0]->valid_shape().dims();
+        return SaberInvalidValue;
+    }
+    if (!inputs[0]->is_continue_mem() || !outputs[0]->is_continue_mem()) {
+        LOG(ERROR) << "x86 permute only supports dense tensors";
+        return SaberUnImplError;
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberPermute<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        PermuteParam<OpTensor>& param) {
+    x86_permute_forward(inputs[0]->data(), inputs[0]->valid_shape(),
+                        outputs[0]->mutable_data(), param.order);
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
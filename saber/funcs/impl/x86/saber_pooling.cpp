@@ -1,207 +1,36 @@
 #include "saber/funcs/impl/x86/saber_pooling.h"
 #include "saber/funcs/impl/x86/kernel/jit_uni_pool_kernel_f32.h"
+#include <omp.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 
 namespace anakin {
 namespace saber {
 
 using namespace jit;
-template <typename HTensor>
-static void pooling_basic(HTensor& tensor_out, \
-                          HTensor& tensor_in, PoolingType type, bool global, \
-                          int kernel_w, int kernel_h, int stride_w, int stride_h, int pad_w, int pad_h) {
-    //no need to pad input tensor, border is zero pad inside this function
-    int w_in = tensor_in.width();
-    int h_in = tensor_in.height();
-    int ch_in = tensor_in.channel();
-    int num = tensor_in.num();
-
-    int size_channel_in = w_in * h_in;
-
-    int w_out = tensor_out.width();
-    int h_out = tensor_out.height();
-    int ch_out = tensor_out.channel();
-
-    int size_channel_out = w_out * h_out;
-
-    float* data_out = tensor_out.mutable_data();
-    const float* data_in = tensor_in.data();
-
-    if (global) {
-        switch (type) {
-        case Pooling_max:
-            for (int n = 0; n < num; ++n) {
-                float* data_out_batch = data_out + n * ch_out * size_channel_out;
-                const float* data_in_batch = data_in + n * ch_in * size_channel_in;
-
-                for (int c = 0; c < ch_out; ++c) {
-                    const float* data_in_channel = data_in_batch + c * size_channel_in;//in address
-                    data_out_batch[c] = data_in_channel[0];
-
-                    for (int i = 0; i < size_channel_in; ++i) {
-                        data_out_batch[c] = data_out_batch[c] > data_in_channel[i] ? \
-                                            data_out_batch[c] : data_in_channel[i];
-                    }
-                }
-            }
-
-            break;
-
-        case Pooling_average_include_padding:
-
-        case Pooling_average_exclude_padding:
-            for (int n = 0; n < num; ++n) {
-                float* data_out_batch = data_out + n * ch_out * size_channel_out;
-                const float* data_in_batch = data_in + n * ch_in * size_channel_in;
-
-                for (int c = 0; c < ch_out; ++c) {
-                    const float* data_in_channel = data_in_batch + c * size_channel_in;//in address
-                    float sum = 0.f;
-
-                    for (int i = 0; i < size_channel_in; ++i) {
-                        sum += data_in_channel[i];
-                    }
-
-                    data_out_batch[c] = sum / size_channel_in;
-                }
-            }
-
-            break;
-
-        default:
-            LOG(INFO) << "not support";
-        }
-
-        return;
-    }
-
-    switch (type) {
-    case Pooling_max:
-        for (int n = 0; n < num; ++n) {
-            float* data_out_channel = data_out + n * ch_out * size_channel_out;
-            const float* data_in_batch = data_in + n * ch_in * size_channel_in;
-
-            for (int q = 0; q < ch_out; q++) {
-
-                float* data_out_row = data_out_channel + q * size_channel_out;
-                const float* data_in_channel = data_in_batch + q * size_channel_in;
-
-                for (int i = 0; i < h_out; i++) {
-                    for (int j = 0; j < w_out; j++) {
-                        int hstart = i * stride_h - pad_h;
-                        int wstart = j * stride_w - pad_w;
-                        int hend = std::min(hstart + kernel_h, h_in + pad_h);
-                        int wend = std::min(wstart + kernel_w, w_in + pad_w);
-                        hstart = std::max(hstart, 0);
-                        wstart = std::max(wstart, 0);
-                        hend = std::min(hend, h_in);
-                        wend = std::min(wend, w_in);
-
-                        data_out_row[j] = data_in_channel[hstart * w_in + wstart];
-
-                        for (int h = hstart; h < hend; ++h) {
-                            for (int w = wstart; w < wend; ++w) {
-                                data_out_row[j] = data_out_row[j] > \
-                                                  data_in_channel[h * w_in + w] ? \
-                                                  data_out_row[j] : data_in_channel[h * w_in + w];
-                            }
-                        }
-                    }
-
-                    data_out_row += w_out;
-                }
-            }
-        }
-
-        break;
-
-    case Pooling_average_include_padding:
-        for (int n = 0; n < num; ++n) {
-            int pool_size = kernel_w * kernel_h;//(hend - hstart) * (wend - wstart);//problem
-            float* data_out_channel = data_out + n * ch_out * size_channel_out;
-            const float* data_in_batch = data_in + n * ch_in * size_channel_in;
-
-            for (int q = 0; q < ch_out; q++) {
-
-                float* data_out_row = data_out_channel + q * size_channel_out;
-                const float* data_in_channel = data_in_batch + q * size_channel_in;
-
-                for (int i = 0; i < h_out; i++) {
-                    for (int j = 0; j < w_out; j++) {
-                        int hstart = i * stride_h - pad_h;
-                        int wstart = j * stride_w - pad_w;
-                        int hend = std::min(hstart + kernel_h, h_in + pad_h);
-                        int wend = std::min(wstart + kernel_w, w_in + pad_w);
-                        hstart = std::max(hstart, 0);
-                        wstart = std::max(wstart, 0);
-                        hend = std::min(hend, h_in);
-                        wend = std::min(wend, w_in);
-
-                        data_out_row[j] = data_in_channel[hstart * w_in + wstart];
-                        float sum = 0.f;
-
-                        for (int h = hstart; h < hend; ++h) {
-                            for (int w = wstart; w < wend; ++w) {
-                                sum += data_in_channel[h * w_in + w];
-                            }
-                        }
-
-                        data_out_row[j] = sum / pool_size;
-                    }
-
-                    data_out_row += w_out;
-                }
-            }
-        }
-
-        break;
-
-    case Pooling_average_exclude_padding:
-        for (int n = 0; n < num; ++n) {
-            float* data_out_channel = data_out + n * ch_out * size_channel_out;
-            const float* data_in_batch = data_in + n * ch_in * size_channel_in;
-
-            for (int q = 0; q < ch_out; q++) {
 
-                float* data_out_row = data_out_channel + q * size_channel_out;
-                const float* data_in_channel = data_in_batch + q * size_channel_in;
-
-                for (int i = 0; i < h_out; i++) {
-                    for (int j = 0; j < w_out; j++) {
-                        int hstart = i * stride_h - pad_h;
-                        int wstart = j * stride_w - pad_w;
-                        int hend = std::min(hstart + kernel_h, h_in + pad_h);
-                        int wend = std::min(wstart + kernel_w, w_in + pad_w);
-                        hstart = std::max(hstart, 0);
-                        wstart = std::max(wstart, 0);
-                        hend = std::min(hend, h_in);
-                        wend = std::min(wend, w_in);
-
-                        data_out_row[j] = data_in_channel[hstart * w_in + wstart];
-                        float sum = 0.f;
-
-                        for (int h = hstart; h < hend; ++h) {
-                            for (int w = wstart; w < wend; ++w) {
-                                sum += data_in_channel[h * w_in + w];
-                            }
-                        }
-
-                        int pool_size = (hend - hstart) * (wend - wstart);
-                        data_out_row[j] = sum / pool_size;
-                    }
-
-                    data_out_row += w_out;
-                }
-            }
-        }
-
-        break;
-
-    default:
-        LOG(FATAL) << "not support";
+namespace {
+
+/// window of every output coordinate clipped to the image, and the reciprocal of the area it
+/// divides by: the window clipped to the padded image, or to the image when padding is excluded
+void pool_table(int out_size, int in_size, int window, int stride, int pad, bool exclude_pad,
+                std::vector<int>& start, std::vector<int>& end, std::vector<float>& inv) {
+    start.resize(out_size);
+    end.resize(out_size);
+    inv.resize(out_size);
+    for (int o = 0; o < out_size; ++o) {
+        const int lo = o * stride - pad;
+        const int hi = std::min(lo + window, in_size + pad);
+        start[o] = std::max(lo, 0);
+        end[o] = std::min(hi, in_size);
+        const int area = exclude_pad ? end[o] - start[o] : hi - lo;
+        inv[o] = area > 0 ? 1.f / area : 0.f;
     }
 }
 
+} // namespace
 
 template <DataType OpDtype,
           DataType inDtype,
@@ -219,6 +48,7 @@ PoolingParam<OpTensor>& param, Context<X86>& ctx) {
     typedef typename DataTensor_out::Dtype DataType_out;
     typedef typename OpTensor::Dtype DataType_op;
     this->_ctx = &ctx;
+    _kernels = &x86_kernels();
 
     return create(inputs, outputs, param, ctx);
 }
@@ -235,7 +65,32 @@ SaberStatus SaberPooling<X86, OpDtype, inDtype, outDtype,
                 std::vector<DataTensor_out*>& outputs,
                 PoolingParam<OpTensor>& param,
 Context<X86>& ctx) {
+    this->_param = &param;
     if(std::is_same<LayOutType_in,NCHW>::value&&std::is_same<LayOutType_out,NCHW>::value&&std::is_same<LayOutType_op,NCHW>::value){
+        if (param.pooling_type != Pooling_max && param.pooling_type != Pooling_average_include_padding
+                && param.pooling_type != Pooling_average_exclude_padding) {
+            LOG(ERROR) << "pooling type " << param.pooling_type << " is not supported";
+            return SaberUnImplError;
+        }
+        const int in_h = inputs[0]->height();
+        const int in_w = inputs[0]->width();
+        const int out_h = outputs[0]->height();
+        const int out_w = outputs[0]->width();
+        _thread_num = omp_get_max_threads();
+        _global = param.global_pooling
+                  || (out_h == 1 && out_w == 1 && param.pad_h == 0 && param.pad_w == 0
+                      && param.window_h >= in_h && param.window_w >= in_w);
+        if (_global) {
+            return SaberSuccess;
+        }
+        const bool exclude_pad = param.pooling_type == Pooling_average_exclude_padding;
+        std::vector<int> w_start;
+        std::vector<int> w_end;
+        pool_table(out_h, in_h, param.window_h, param.stride_h, param.pad_h, exclude_pad,
+                   _h_start, _h_end, _inv_h);
+        pool_table(out_w, in_w, param.window_w, param.stride_w, param.pad_w, exclude_pad,
+                   w_start, w_end, _inv_w);
+        _row.reshape(Shape(_thread_num, 1, 1, (out_w - 1) * param.stride_w + param.window_w));
         return SaberSuccess;
     }
     jit_pool_conf_t jpp_;
@@ -244,6 +99,7 @@ Context<X86>& ctx) {
         return SaberUnImplError;
     }
 
+    delete kernel_;
     kernel_ = new jit_uni_pool_kernel_f32<avx512_common>(jpp_);
     return SaberSuccess;
 }
@@ -265,7 +121,65 @@ PoolingParam<OpTensor>& param) {
 
     if(std::is_same<LayOutType_in,NCHW>::value&&std::is_same<LayOutType_out,NCHW>::value&&std::is_same<LayOutType_op,NCHW>::value){
 
-        pooling_basic(*outputs[0],*inputs[0],param.pooling_type,param.global_pooling,param.window_w,param.window_h,param.stride_w,param.stride_h,param.pad_w,param.pad_h);
+        const float* src = inputs[0]->data();
+        float* dst = outputs[0]->mutable_data();
+        const int planes = inputs[0]->num() * inputs[0]->channel();
+        const int in_h = inputs[0]->height();
+        const int in_w = inputs[0]->width();
+        const int out_h = outputs[0]->height();
+        const int out_w = outputs[0]->width();
+        const bool is_max = param.pooling_type == Pooling_max;
+        const EltwiseType reduce = is_max ? Eltwise_max : Eltwise_sum;
+        const X86Kernels& kernels = *_kernels;
+
+        if (_global) {
+            const float scale = is_max ? 1.f : 1.f / (in_h * in_w);
+            #pragma omp parallel for schedule(static) num_threads(_thread_num)
+            for (int p = 0; p < planes; ++p) {
+                dst[p] = kernels.reduce(reduce, src + (size_t)p * in_h * in_w, in_h * in_w) * scale;
+            }
+            return SaberSuccess;
+        }
+
+        // the padded row starts pad_w columns left of the image, the rest of it holds identities
+        const int stride_w = param.stride_w;
+        const int pad_w = param.pad_w;
+        const int row_len = _row.width();
+        const int cols = std::max(std::min(in_w, row_len - pad_w), 0);
+        const float identity = is_max ? -std::numeric_limits<float>::max() : 0.f;
+        float* row_all = _row.mutable_data();
+
+        #pragma omp parallel for schedule(static) num_threads(_thread_num)
+        for (int p = 0; p < planes; ++p) {
+            const float* plane = src + (size_t)p * in_h * in_w;
+            float* out = dst + (size_t)p * out_h * out_w;
+            float* row = row_all + (size_t)omp_get_thread_num() * row_len;
+            for (int oh = 0; oh < out_h; ++oh, out += out_w) {
+                const int h_start = _h_start[oh];
+                const int h_end = _h_end[oh];
+                if (h_end <= h_start) {
+                    std::fill(out, out + out_w, 0.f);
+                    continue;
+                }
+                std::fill(row, row + pad_w, identity);
+                std::fill(row + pad_w + cols, row + row_len, identity);
+                memcpy(row + pad_w, plane + h_start * in_w, cols * sizeof(float));
+                for (int h = h_start + 1; h < h_end; ++h) {
+                    kernels.elt_apply(reduce, row + pad_w, plane + h * in_w, false, 1.f, cols);
+                }
+                kernels.pool_window(reduce, row, (out_w - 1) * stride_w + 1, param.window_w);
+                if (stride_w == 1) {
+                    memcpy(out, row, out_w * sizeof(float));
+                } else {
+                    for (int ow = 0; ow < out_w; ++ow) {
+                        out[ow] = row[ow * stride_w];
+                    }
+                }
+                if (!is_max) {
+                    kernels.elt_apply(Eltwise_prod, out, _inv_w.data(), false, _inv_h[oh], out_w);
+                }
+            }
+        }
         return SaberSuccess;
     }
 
@@ -16,6 +16,7 @@
 #define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_POOLING_H
 
 #include "saber/funcs/impl/impl_pooling.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
 #include "saber/funcs/impl/x86/kernel/jit_uni_pool_kernel_f32.h"
 #include "saber/funcs/impl/x86/kernel/jit_generator.h"
 
@@ -24,6 +25,15 @@ namespace saber {
 
 using namespace jit;
 
+/**
+ * pooling of NCHW runs the kernel table over one channel per task, chosen at create:
+ * global pooling, or a window equal to the image, reduces the plane in one vector pass.
+ * Otherwise every output row reduces the rows of its window into one padded row with vector
+ * max or sum, slides the horizontal window over it in vector steps and keeps every stride-th.
+ * Averages divide by the window area clipped to the padded image as caffe does,
+ * or to the image when padding is excluded.
+ * Blocked layouts go to the avx512 jit kernel.
+ */
 template <DataType OpDtype ,
         DataType inDtype,
         DataType outDtype,
@@ -72,6 +82,18 @@ public:
                                   PoolingParam<OpTensor>& param);
 private:
     jit_uni_pool_kernel_f32<avx512_common> *kernel_;
+
+    const X86Kernels* _kernels{nullptr};
+    int _thread_num{1};
+    bool _global{false};
+    ///< rows of the window of every output row, clipped to the image
+    std::vector<int> _h_start;
+    std::vector<int> _h_end;
+    ///< reciprocal window height of every output row and width of every output column, averages only
+    std::vector<float> _inv_h;
+    std::vector<float> _inv_w;
+    ///< padded row of every thread
+    DataTensor_in _row;
 };
 
 
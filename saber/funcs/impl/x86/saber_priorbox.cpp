@@ -0,0 +1,217 @@
+#include "saber/funcs/impl/x86/saber_priorbox.h"
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace anakin{
+namespace saber {
+
+template class SaberPriorBox<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+namespace {
+
+/// writes the box of center (cx, cy) and size (bw, bh) normalized by the image, clamped to [0, 1]
+inline void put_clamped_box(float*& out, float cx, float cy, float bw, float bh,
+                            int img_width, int img_height) {
+    const float xmin = (cx - bw / 2.) / img_width;
+    const float ymin = (cy - bh / 2.) / img_height;
+    const float xmax = (cx + bw / 2.) / img_width;
+    const float ymax = (cy + bh / 2.) / img_height;
+    *out++ = xmin >= 0 ? xmin : 0;
+    *out++ = ymin >= 0 ? ymin : 0;
+    *out++ = xmax <= 1 ? xmax : 1;
+    *out++ = ymax <= 1 ? ymax : 1;
+}
+
+inline void put_box(float* out, float cx, float cy, float bw, float bh, int img_width, int img_height) {
+    out[0] = (cx - bw / 2.f) / img_width;
+    out[1] = (cy - bh / 2.f) / img_height;
+    out[2] = (cx + bw / 2.f) / img_width;
+    out[3] = (cy + bh / 2.f) / img_height;
+}
+
+/// the dense anchors of the fixed sizes at one location, as the arm and cuda priorbox
+template <typename ParamT>
+void fixed_size_priors(const ParamT& param, float center_x, float center_y, int step_average,
+                       int img_width, int img_height, float*& out) {
+    for (int s = 0; s < param.fixed_size.size(); ++s) {
+        const int fixed_size = param.fixed_size[s];
+        const int density = param.density_size[s];
+        if (param.fixed_ratio.size() > 0) {
+            const int shift = step_average / density;
+            for (int r = 0; r < param.fixed_ratio.size(); ++r) {
+                const float ar = param.fixed_ratio[r];
+                const float box_width = param.fixed_size[s] * sqrt(ar);
+                const float box_height = param.fixed_size[s] / sqrt(ar);
+                for (int p = 0; p < density; ++p) {
+                    for (int c = 0; c < density; ++c) {
+                        put_clamped_box(out, center_x - step_average / 2 + shift / 2. + c * shift,
+                                        center_y - step_average / 2 + shift / 2. + p * shift,
+                                        box_width, box_height, img_width, img_height);
+                    }
+                }
+            }
+            continue;
+        }
+        const int shift = fixed_size / density;
+        for (int r = 0; r < density; ++r) {
+            for (int c = 0; c < density; ++c) {
+                put_clamped_box(out, center_x - fixed_size / 2 + shift / 2. + c * shift,
+                                center_y - fixed_size / 2 + shift / 2. + r * shift,
+                                fixed_size, fixed_size, img_width, img_height);
+            }
+        }
+        for (int r = 0; r < param.aspect_ratio.size(); ++r) {
+            const float ar = param.aspect_ratio[r];
+            if (fabs(ar - 1.) < 1e-6) {
+                continue;
+            }
+            const float box_width = param.fixed_size[s] * sqrt(ar);
+            const float box_height = param.fixed_size[s] / sqrt(ar);
+            for (int p = 0; p < density; ++p) {
+                for (int c = 0; c < density; ++c) {
+                    put_clamped_box(out, center_x - fixed_size / 2 + shift / 2. + c * shift,
+                                    center_y - fixed_size / 2 + shift / 2. + p * shift,
+                                    box_width, box_height, img_width, img_height);
+                }
+            }
+        }
+    }
+}
+
+/// the min size, max size and aspect ratio priors at one location, in the order of param.order
+template <typename ParamT>
+void min_max_priors(const ParamT& param, float center_x, float center_y,
+                    int img_width, int img_height, float*& out) {
+    for (int s = 0; s < param.min_size.size(); ++s) {
+        const int min_size = param.min_size[s];
+        for (const auto& type : param.order) {
+            if (type == PRIOR_MIN) {
+                put_box(out, center_x, center_y, min_size, min_size, img_width, img_height);
+                out += 4;
+            } else if (type == PRIOR_MAX && param.max_size.size() > 0) {
+                const int max_size = param.max_size[s];
+                const float size = sqrtf(min_size * max_size);
+                put_box(out, center_x, center_y, size, size, img_width, img_height);
+                out += 4;
+            } else if (type == PRIOR_COM) {
+                for (int r = 0; r < param.aspect_ratio.size(); ++r) {
+                    const float ar = param.aspect_ratio[r];
+                    if (fabs(ar - 1.) < 1e-6) {
+                        continue;
+                    }
+                    put_box(out, center_x, center_y, min_size * sqrt(ar), min_size / sqrt(ar),
+                            img_width, img_height);
+                    out += 4;
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberPriorBox<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        PriorBoxParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberPriorBox<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        PriorBoxParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    if (param.fixed_size.size() == 0) {
+        CHECK_EQ(param.order.size(), 3) << "Incorrect size of priorbox order list.";
+        CHECK_EQ(std::accumulate(param.order.begin(), param.order.end(), 0), 3) \
+            << "Incorrect type of priorbox order.";
+    }
+    SABER_CHECK(_priors.reshape(outputs[0]->valid_shape()));
+
+    const int width = inputs[0]->width();
+    const int height = inputs[0]->height();
+    int img_width = param.img_w;
+    int img_height = param.img_h;
+    if (img_width == 0 || img_height == 0) {
+        img_width = inputs[1]->width();
+        img_height = inputs[1]->height();
+    }
+    float step_w = param.step_w;
+    float step_h = param.step_h;
+    if (step_w == 0 || step_h == 0) {
+        step_w = static_cast<float>(img_width) / width;
+        step_h = static_cast<float>(img_height) / height;
+    }
+    const int step_average = static_cast<int>((step_w + step_h) * 0.5);
+    const int channel_size = height * width * param.prior_num * 4;
+
+    float* priors = _priors.mutable_data();
+    float* out = priors;
+    for (int h = 0; h < height; ++h) {
+        for (int w = 0; w < width; ++w) {
+            const float center_x = (w + param.offset) * step_w;
+            const float center_y = (h + param.offset) * step_h;
+            if (param.fixed_size.size() > 0) {
+                fixed_size_priors(param, center_x, center_y, step_average, img_width, img_height, out);
+            } else {
+                min_max_priors(param, center_x, center_y, img_width, img_height, out);
+            }
+        }
+    }
+    if (out - priors != channel_size) {
+        LOG(ERROR) << "priorbox gives " << (out - priors) / 4 << " priors, prior_num expects "
+                   << channel_size / 4;
+        return SaberInvalidValue;
+    }
+
+    //! clip the prior's coordinate such that it is within [0, 1]
+    if (param.is_clip) {
+        for (int d = 0; d < channel_size; ++d) {
+            priors[d] = std::min(std::max(priors[d], 0.f), 1.f);
+        }
+    }
+    //! the variances follow the boxes
+    float* variance = priors + channel_size;
+    for (int i = 0; i < channel_size; i += 4) {
+        memcpy(variance + i, param.variance.data(), sizeof(float) * 4);
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberPriorBox<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        PriorBoxParam<OpTensor>& param) {
+    memcpy(outputs[0]->mutable_data(), _priors.data(), sizeof(float) * outputs[0]->valid_size());
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -0,0 +1,152 @@
+#include "saber/funcs/impl/x86/saber_resize.h"
+#include <omp.h>
+#include <algorithm>
+#include <cstring>
+
+namespace anakin{
+namespace saber {
+
+template class SaberResize<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+namespace {
+
+/// source index, neighbour and weight of the neighbour of every output coordinate
+void resize_table(int out_size, int in_size, float scale, bool bilinear,
+                  std::vector<int>& i0, std::vector<int>& i1, std::vector<float>& w) {
+    i0.resize(out_size);
+    i1.resize(out_size);
+    w.resize(out_size);
+    const float inv_scale = 1.f / scale;
+    for (int o = 0; o < out_size; ++o) {
+        const float f = inv_scale * o;
+        const int src = static_cast<int>(f);
+        i0[o] = std::min(src, in_size - 1);
+        i1[o] = bilinear ? std::min(src + 1, in_size - 1) : i0[o];
+        w[o] = (bilinear && i1[o] != i0[o]) ? f - src : 0.f;
+    }
+}
+
+} // namespace
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberResize<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ResizeParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberResize<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ResizeParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    this->_param = &param;
+    if (param.resize_type != Resize_bilinear && param.resize_type != Resize_nearest) {
+        LOG(ERROR) << "resize type " << param.resize_type << " is not supported";
+        return SaberUnImplError;
+    }
+    const bool bilinear = param.resize_type == Resize_bilinear;
+    resize_table(outputs[0]->width(), inputs[0]->width(), param.width_scale, bilinear, _x0, _x1, _fx);
+    resize_table(outputs[0]->height(), inputs[0]->height(), param.height_scale, bilinear, _y0, _y1, _fy);
+    _thread_num = omp_get_max_threads();
+    if (bilinear) {
+        _rows.reshape(Shape(_thread_num, 2, 1, outputs[0]->width()));
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberResize<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ResizeParam<OpTensor> &param) {
+    const float* src = inputs[0]->data();
+    float* dst = outputs[0]->mutable_data();
+    const int in_h = inputs[0]->height();
+    const int in_w = inputs[0]->width();
+    const int out_h = outputs[0]->height();
+    const int out_w = outputs[0]->width();
+    const int rows = inputs[0]->num() * inputs[0]->channel() * out_h;
+    const int* x0 = _x0.data();
+    const int* x1 = _x1.data();
+    const float* fx = _fx.data();
+
+    if (param.resize_type == Resize_nearest) {
+        #pragma omp parallel for schedule(static)
+        for (int r = 0; r < rows; ++r) {
+            const int plane = r / out_h;
+            const float* src_row = src + ((size_t)plane * in_h + _y0[r % out_h]) * in_w;
+            float* dst_row = dst + (size_t)r * out_w;
+            for (int w = 0; w < out_w; ++w) {
+                dst_row[w] = src_row[x0[w]];
+            }
+        }
+        return SaberSuccess;
+    }
+
+    float* rows_all = _rows.mutable_data();
+    const X86Kernels& kernels = *_kernels;
+    #pragma omp parallel num_threads(_thread_num)
+    {
+        float* buf[2] = {rows_all + (size_t)omp_get_thread_num() * 2 * out_w,
+                         rows_all + ((size_t)omp_get_thread_num() * 2 + 1) * out_w};
+        // absolute source rows held in buf, reused by the following output rows
+        long long held[2] = {-1, -1};
+        // the buffer of src_row, interpolated into the older buffer unless that one is keep
+        auto interpolate = [&](long long src_row, int keep) -> int {
+            for (int b = 0; b < 2; ++b) {
+                if (held[b] == src_row) {
+                    return b;
+                }
+            }
+            const int b = keep >= 0 ? 1 - keep : (held[0] <= held[1] ? 0 : 1);
+            const float* row = src + src_row * in_w;
+            for (int w = 0; w < out_w; ++w) {
+                const float left = row[x0[w]];
+                buf[b][w] = left + (row[x1[w]] - left) * fx[w];
+            }
+            held[b] = src_row;
+            return b;
+        };
+        #pragma omp for schedule(static)
+        for (int r = 0; r < rows; ++r) {
+            const long long plane_row = (long long)(r / out_h) * in_h;
+            const int h = r % out_h;
+            float* dst_row = dst + (size_t)r * out_w;
+            const int top = interpolate(plane_row + _y0[h], -1);
+            if (_fy[h] == 0.f) {
+                memcpy(dst_row, buf[top], out_w * sizeof(float));
+                continue;
+            }
+            const int bottom = interpolate(plane_row + _y1[h], top);
+            kernels.elt_scale(dst_row, buf[top], 1.f - _fy[h], out_w);
+            kernels.elt_apply(Eltwise_sum, dst_row, buf[bottom], false, _fy[h], out_w);
+        }
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -0,0 +1,85 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_RESIZE_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_RESIZE_H
+
+#include "saber/funcs/impl/impl_resize.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+
+namespace anakin{
+namespace saber {
+
+/**
+ * resize of NCHW planes. The source index and weight of every output column and row are
+ * tabulated at create, so the forward is a gather per source row and, for bilinear, a blend
+ * of two horizontally interpolated rows. Rows interpolated by a thread are kept while the
+ * next output row still uses them, so upsampling reads and interpolates every row once.
+ * Coordinates follow the cuda kernel, src = dst / scale, clamped to the last row and column.
+ */
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+class SaberResize<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out> : public ImplBase<
+        Tensor<X86, inDtype, LayOutType_in>,
+        Tensor<X86, outDtype, LayOutType_out>,
+        Tensor<X86, OpDtype, LayOutType_op>,
+        ResizeParam<Tensor<X86, OpDtype, LayOutType_op> > > {
+public:
+    typedef Tensor<X86, inDtype, LayOutType_in> DataTensor_in;
+    typedef Tensor<X86, outDtype, LayOutType_out> DataTensor_out;
+    typedef Tensor<X86, OpDtype, LayOutType_op> OpTensor;
+
+    SaberResize() = default;
+
+    ~SaberResize() {}
+
+    virtual SaberStatus init(const std::vector<DataTensor_in*>& inputs,
+                             std::vector<DataTensor_out*>& outputs,
+                             ResizeParam<OpTensor> &param,
+                             Context<X86> &ctx) override;
+
+    virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
+                               std::vector<DataTensor_out*>& outputs,
+                               ResizeParam<OpTensor> &param,
+                               Context<X86> &ctx) override;
+
+    virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
+                                 std::vector<DataTensor_out*>& outputs,
+                                 ResizeParam<OpTensor> &param) override;
+
+private:
+    ///< source columns, right neighbours and weights of the right neighbours
+    std::vector<int> _x0;
+    std::vector<int> _x1;
+    std::vector<float> _fx;
+    ///< source rows, next rows and weights of the next rows
+    std::vector<int> _y0;
+    std::vector<int> _y1;
+    std::vector<float> _fy;
+    int _thread_num{1};
+    ///< two interpolated rows of every thread
+    DataTensor_in _rows;
+    const X86Kernels* _kernels{nullptr};
+};
+
+}
+}
+
+#endif
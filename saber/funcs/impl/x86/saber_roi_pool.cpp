@@ -0,0 +1,160 @@
+#include "saber/funcs/impl/x86/saber_roi_pool.h"
+#include <omp.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace anakin{
+namespace saber {
+
+template class SaberRoiPool<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberRoiPool<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        RoiPoolParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberRoiPool<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        RoiPoolParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    this->_param = &param;
+    if (inputs.size() != 2 || inputs[1]->valid_size() != inputs[1]->num() * 5) {
+        LOG(ERROR) << "roi pooling needs the rois as the second input, 5 floats each";
+        return SaberInvalidValue;
+    }
+    if (param.pooled_height <= 0 || param.pooled_width <= 0) {
+        LOG(ERROR) << "roi pooling output " << param.pooled_height << "x" << param.pooled_width
+                   << " should be positive";
+        return SaberInvalidValue;
+    }
+    _thread_num = omp_get_max_threads();
+    _row_max.reshape(Shape(_thread_num, 1, 1, inputs[0]->width()));
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberRoiPool<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        RoiPoolParam<OpTensor> &param) {
+    const float* src = inputs[0]->data();
+    const float* rois = inputs[1]->data();
+    float* dst = outputs[0]->mutable_data();
+    float* dst_index = outputs.size() == 2 ? outputs[1]->mutable_data() : nullptr;
+    const int num = inputs[0]->num();
+    const int channel = inputs[0]->channel();
+    const int in_h = inputs[0]->height();
+    const int in_w = inputs[0]->width();
+    const int roi_num = inputs[1]->num();
+    const int pooled_h = param.pooled_height;
+    const int pooled_w = param.pooled_width;
+    const float spatial_scale = param.spatial_scale;
+    for (int r = 0; r < roi_num; ++r) {
+        const int batch_id = static_cast<int>(rois[r * 5]);
+        if (batch_id < 0 || batch_id >= num) {
+            LOG(ERROR) << "roi " << r << " is of image " << batch_id << ", the batch has " << num;
+            return SaberInvalidValue;
+        }
+    }
+    float* row_max_all = _row_max.mutable_data();
+    const X86Kernels& kernels = *_kernels;
+
+    #pragma omp parallel for schedule(static) num_threads(_thread_num)
+    for (int task = 0; task < roi_num * channel; ++task) {
+        const int r = task / channel;
+        const int c = task % channel;
+        const float* roi = rois + r * 5;
+        const int roi_start_w = static_cast<int>(roundf(roi[1] * spatial_scale));
+        const int roi_start_h = static_cast<int>(roundf(roi[2] * spatial_scale));
+        const int roi_end_w = static_cast<int>(roundf(roi[3] * spatial_scale));
+        const int roi_end_h = static_cast<int>(roundf(roi[4] * spatial_scale));
+        const int roi_w = std::max(roi_end_w - roi_start_w + 1, 1);
+        const int roi_h = std::max(roi_end_h - roi_start_h + 1, 1);
+        const float bin_h = static_cast<float>(roi_h) / pooled_h;
+        const float bin_w = static_cast<float>(roi_w) / pooled_w;
+        // columns of the roi inside the image, the reduced row covers them
+        const int row_lo = std::min(std::max(roi_start_w, 0), in_w);
+        const int row_hi = std::min(std::max(roi_start_w + roi_w, 0), in_w);
+        const float* plane = src + ((size_t)static_cast<int>(roi[0]) * channel + c) * in_h * in_w;
+        float* out = dst + (size_t)task * pooled_h * pooled_w;
+        float* out_index = dst_index ? dst_index + (size_t)task * pooled_h * pooled_w : nullptr;
+        float* row_max = row_max_all + (size_t)omp_get_thread_num() * in_w;
+
+        for (int ph = 0; ph < pooled_h; ++ph) {
+            int h_start = static_cast<int>(floorf(ph * bin_h)) + roi_start_h;
+            int h_end = static_cast<int>(ceilf((ph + 1) * bin_h)) + roi_start_h;
+            h_start = std::min(std::max(h_start, 0), in_h);
+            h_end = std::min(std::max(h_end, 0), in_h);
+            if (!out_index && h_end > h_start && row_hi > row_lo) {
+                memcpy(row_max + row_lo, plane + h_start * in_w + row_lo, (row_hi - row_lo) * sizeof(float));
+                for (int h = h_start + 1; h < h_end; ++h) {
+                    kernels.elt_apply(Eltwise_max, row_max + row_lo, plane + h * in_w + row_lo,
+                                      false, 1.f, row_hi - row_lo);
+                }
+            }
+            for (int pw = 0; pw < pooled_w; ++pw) {
+                int w_start = static_cast<int>(floorf(pw * bin_w)) + roi_start_w;
+                int w_end = static_cast<int>(ceilf((pw + 1) * bin_w)) + roi_start_w;
+                w_start = std::min(std::max(w_start, 0), in_w);
+                w_end = std::min(std::max(w_end, 0), in_w);
+                const int bin = ph * pooled_w + pw;
+                if (h_end <= h_start || w_end <= w_start) {
+                    out[bin] = 0.f;
+                    if (out_index) {
+                        out_index[bin] = -1;
+                    }
+                    continue;
+                }
+                float max_val = -FLT_MAX;
+                if (out_index) {
+                    int max_idx = -1;
+                    for (int h = h_start; h < h_end; ++h) {
+                        for (int w = w_start; w < w_end; ++w) {
+                            if (plane[h * in_w + w] > max_val) {
+                                max_val = plane[h * in_w + w];
+                                max_idx = h * in_w + w;
+                            }
+                        }
+                    }
+                    out_index[bin] = max_idx;
+                } else {
+                    for (int w = w_start; w < w_end; ++w) {
+                        max_val = std::max(max_val, row_max[w]);
+                    }
+                }
+                out[bin] = max_val;
+            }
+        }
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
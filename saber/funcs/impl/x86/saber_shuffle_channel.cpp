@@ -0,0 +1,76 @@
+#include "saber/funcs/impl/x86/saber_shuffle_channel.h"
+#include "saber/funcs/impl/x86/x86_permute.h"
+
+namespace anakin{
+namespace saber {
+
+template class SaberShuffleChannel<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberShuffleChannel<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ShuffleChannelParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberShuffleChannel<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ShuffleChannelParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    const int channel = inputs[0]->channel();
+    if (param.group <= 0 || channel % param.group != 0) {
+        LOG(ERROR) << "shuffle channel group " << param.group << " doesn't divide " << channel << " channels";
+        return SaberInvalidValue;
+    }
+    if (!inputs[0]->is_continue_mem() || !outputs[0]->is_continue_mem()) {
+        LOG(ERROR) << "x86 shuffle_channel only supports dense tensors";
+        return SaberUnImplError;
+    }
+    return SaberSuccess;
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberShuffleChannel<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        ShuffleChannelParam<OpTensor>& param) {
+    if (inputs[0]->valid_size() == 0) {
+        return SaberSuccess;
+    }
+    const int num = inputs[0]->num();
+    const int channel = inputs[0]->channel();
+    const int group = param.group;
+    const int spatial = inputs[0]->valid_size() / (num * channel);
+    const std::vector<int> dims = {num, group, channel / group, spatial};
+    const std::vector<int> order = {0, 2, 1, 3};
+    x86_permute_forward(inputs[0]->data(), dims, outputs[0]->mutable_data(), order);
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -1,12 +1,57 @@
 #include "saber/funcs/impl/x86/saber_softmax.h"
-#include "mkl_cblas.h"
-#include "mkl_vml_functions.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+#include <cmath>
+#include <limits>
+#include <vector>
 
 namespace anakin{
 namespace saber {
 
 template class SaberSoftmax<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
 
+///< rows at least this long are split across threads when there are fewer rows than threads
+static const int kSoftmaxSplitRow = 16 * 1024;
+///< columns of one thread task when the softmax axis is strided
+static const int kSoftmaxColBlock = 64;
+
+/// softmax of a [outer, n] tensor along n, every row split across all threads
+static void softmax_split_rows(const X86Kernels& kernels, const float* src, float* dst,
+                               int outer, int n) {
+    const int max_thr = omp_get_max_threads();
+    std::vector<float> part_max(max_thr);
+    std::vector<float> part_sum(max_thr);
+    #pragma omp parallel
+    {
+        const int ithr = omp_get_thread_num();
+        const int nthr = omp_get_num_threads();
+        int start{0}, end{0};
+        utils::balance211(n, nthr, ithr, start, end);
+        for (int row = 0; row < outer; ++row) {
+            const float* row_src = src + (size_t)row * n;
+            float* row_dst = dst + (size_t)row * n;
+            part_max[ithr] = -std::numeric_limits<float>::max();
+            part_sum[ithr] = 0.f;
+            if (end > start) {
+                kernels.softmax_stat(row_src + start, end - start, part_max[ithr], part_sum[ithr]);
+            }
+            #pragma omp barrier
+            // every thread merges the partial results itself rather than waiting for one to do it
+            float max = part_max[0];
+            for (int t = 1; t < nthr; ++t) {
+                max = part_max[t] > max ? part_max[t] : max;
+            }
+            float sum = 0.f;
+            for (int t = 0; t < nthr; ++t) {
+                sum += part_sum[t] * expf(part_max[t] - max);
+            }
+            if (end > start) {
+                kernels.softmax_norm(row_src + start, row_dst + start, end - start, max, 1.f / sum);
+            }
+            #pragma omp barrier
+        }
+    }
+}
+
 template <DataType OpDtype ,
         DataType inDtype,
         DataType outDtype,
@@ -20,6 +65,7 @@ SaberStatus SaberSoftmax<X86, OpDtype, inDtype, outDtype,
         SoftmaxParam<OpTensor> &param, Context<X86> &ctx)
 {
     this->_ctx = &ctx;
+    _kernels = &x86_kernels();
     return create(inputs, outputs, param, ctx);
 }
 
@@ -35,95 +81,13 @@ SaberStatus SaberSoftmax<X86, OpDtype, inDtype, outDtype,
         std::vector<DataTensor_out*>& outputs,
         SoftmaxParam<OpTensor> &param, Context<X86> &ctx)
 {
-//    LOG(INFO)<<"here!!!";
     this->_param = &param;
     this->_ctx = &ctx;
-
-    return SaberSuccess;
-}
-
-template <DataType OpDtype ,
-        DataType inDtype,
-        DataType outDtype,
-        typename LayOutType_op,
-        typename LayOutType_in,
-        typename LayOutType_out>
-void SaberSoftmax<X86, OpDtype, inDtype, outDtype,
-        LayOutType_op, LayOutType_in, LayOutType_out>::_max(
-        int n, const float *x, float *max_data) {
-    max_data[0] = x[0];
-    for (int c = 1; c < n; ++c) {
-        max_data[0] = max_data[0] > x[c] ? max_data[0] : x[c];
+    if (param.axis < 0 || param.axis >= inputs[0]->valid_shape().dims()) {
+        LOG(ERROR) << "softmax axis " << param.axis << " is out of the input dims";
+        return SaberInvalidValue;
     }
-}
-
-template <DataType OpDtype ,
-        DataType inDtype,
-        DataType outDtype,
-        typename LayOutType_op,
-        typename LayOutType_in,
-        typename LayOutType_out>
-void SaberSoftmax<X86, OpDtype, inDtype, outDtype,
-        LayOutType_op, LayOutType_in, LayOutType_out>::_sub(
-        int n, float alpha, const float *x, float *y) {
-    for (int c = 0; c < n; ++c) {
-        y[c] = x[c] - alpha;
-    }
-}
-
-template <DataType OpDtype ,
-        DataType inDtype,
-        DataType outDtype,
-        typename LayOutType_op,
-        typename LayOutType_in,
-        typename LayOutType_out>
-void SaberSoftmax<X86, OpDtype, inDtype, outDtype,
-        LayOutType_op, LayOutType_in, LayOutType_out>::_exp(
-        int n, const float *a, float *r) {
-#if 1
-    vsExp(n, a, r);
-#else
-    #pragma omp parallel for
-    for (int c = 0; c < n; ++c) {
-        r[c] = expf(a[c]);
-    }
-#endif
-    return;
-}
-
-template <DataType OpDtype ,
-        DataType inDtype,
-        DataType outDtype,
-        typename LayOutType_op,
-        typename LayOutType_in,
-        typename LayOutType_out>
-void SaberSoftmax<X86, OpDtype, inDtype, outDtype,
-        LayOutType_op, LayOutType_in, LayOutType_out>::_sum(
-        int n, const float *x, float *sum_data) {
-    sum_data[0] = 0;
-    for (int c = 0; c < n; ++c) {
-        sum_data[0] += x[c];
-    }
-}
-
-template <DataType OpDtype ,
-        DataType inDtype,
-        DataType outDtype,
-        typename LayOutType_op,
-        typename LayOutType_in,
-        typename LayOutType_out>
-void SaberSoftmax<X86, OpDtype, inDtype, outDtype,
-        LayOutType_op, LayOutType_in, LayOutType_out>::_scal
-        (int n, float alpha, float *x) {
-#if 0
-    cblas_sscal(n, alpha, x, 1);
-#else
-#pragma omp parallel for
-    for (int c = 0; c < n; ++c) {
-        x[c] *= alpha;
-    }
-#endif
-    return;
+    return SaberSuccess;
 }
 
 template <DataType OpDtype ,
@@ -137,24 +101,46 @@ SaberStatus SaberSoftmax<X86, OpDtype, inDtype, outDtype,
         const std::vector<DataTensor_in*>& inputs,
         std::vector<DataTensor_out*>& outputs,
         SoftmaxParam<OpTensor>& param) {
-//            LOG(INFO)<<"here!!!";
-    int num = inputs[0] -> num();
-    int channel = inputs[0]->channel();
-    float *src_ptr = inputs[0]->mutable_data();
+    const Shape shape = inputs[0]->valid_shape();
+    const int axis_size = shape[param.axis];
+    const int inner = shape.count(param.axis + 1);
+    const int outer = axis_size * inner > 0 ? shape.count() / (axis_size * inner) : 0;
+    const float *src_ptr = inputs[0]->data();
     float *dst_ptr = outputs[0]->mutable_data();
     outputs[0]->set_seq_offset(inputs[0]->get_seq_offset());
+    if (outer == 0) {
+        return SaberSuccess;
+    }
+    const X86Kernels& kernels = *_kernels;
 
-#pragma omp parallel for schedule(static)
-    for (int ou = 0; ou < num ; ou++) {
-        const float *src_data = src_ptr + ou * channel;
-        float *dst_data = dst_ptr + ou * channel;
-        float scalar = 0;
+    if (inner == 1) {
+        // two passes per row, online max and sum, then exp and scale
+        if (outer < omp_get_max_threads() && axis_size >= kSoftmaxSplitRow) {
+            softmax_split_rows(kernels, src_ptr, dst_ptr, outer, axis_size);
+            return SaberSuccess;
+        }
+        #pragma omp parallel for schedule(static) if (outer > 1)
+        for (int ou = 0; ou < outer; ++ou) {
+            const float* src_data = src_ptr + (size_t)ou * axis_size;
+            float* dst_data = dst_ptr + (size_t)ou * axis_size;
+            float max = 0.f;
+            float sum = 0.f;
+            kernels.softmax_stat(src_data, axis_size, max, sum);
+            kernels.softmax_norm(src_data, dst_data, axis_size, max, 1.f / sum);
+        }
+        return SaberSuccess;
+    }
 
-        _max(channel, src_data, &scalar);
-        _sub(channel, scalar, src_data, dst_data);
-        _exp(channel, dst_data, dst_data);
-        _sum(channel, dst_data, &scalar);
-        _scal(channel, float(1)/scalar, dst_data);
+    // axis is strided, e.g. per pixel softmax over channels: vectorize across inner
+    const int col_blocks = utils::div_up(inner, kSoftmaxColBlock);
+    const int tasks = outer * col_blocks;
+    #pragma omp parallel for schedule(static) if (tasks > 1)
+    for (int t = 0; t < tasks; ++t) {
+        const int ou = t / col_blocks;
+        const int col = (t % col_blocks) * kSoftmaxColBlock;
+        const size_t offset = (size_t)ou * axis_size * inner + col;
+        const int width = inner - col < kSoftmaxColBlock ? inner - col : kSoftmaxColBlock;
+        kernels.softmax_strided(src_ptr + offset, dst_ptr + offset, axis_size, inner, width);
     }
     return SaberSuccess;
 }
@@ -16,6 +16,7 @@
 #define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_SOFTMAX_H
 
 #include "saber/funcs/impl/impl_softmax.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
 
 namespace anakin{
 namespace saber {
@@ -58,11 +59,7 @@ public:
                                  SoftmaxParam<OpTensor> &param) override;
 
 private:
-    void _max(int n, const float *x, float *max_data);
-    void _sub(int n, float alpha, const float *x, float *y);
-    void _exp(int n, const float *a, float *r);
-    void _sum(int n, const float *x, float *sum_data);
-    void _scal(int n, float alpha, float *x);
+    const X86Kernels* _kernels{nullptr};
 };
 
 }
@@ -0,0 +1,145 @@
+#include "saber/funcs/impl/x86/saber_spp.h"
+#include <omp.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace anakin{
+namespace saber {
+
+template class SaberSpp<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberSpp<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        SPPParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    _kernels = &x86_kernels();
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberSpp<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        SPPParam<OpTensor> &param, Context<X86> &ctx) {
+    this->_ctx = &ctx;
+    this->_param = &param;
+    if (param.pyramid_height <= 0) {
+        LOG(ERROR) << "spp pyramid height " << param.pyramid_height << " should be positive";
+        return SaberInvalidValue;
+    }
+    if (param.pool_type != Pooling_max && param.pool_type != Pooling_average_include_padding
+            && param.pool_type != Pooling_average_exclude_padding) {
+        LOG(ERROR) << "spp pooling type " << param.pool_type << " is not supported";
+        return SaberUnImplError;
+    }
+    const int in_h = inputs[0]->height();
+    const int in_w = inputs[0]->width();
+    _window_h.resize(param.pyramid_height);
+    _window_w.resize(param.pyramid_height);
+    _pad_h.resize(param.pyramid_height);
+    _pad_w.resize(param.pyramid_height);
+    for (int i = 0; i < param.pyramid_height; ++i) {
+        const int bins = 1 << i;
+        _window_h[i] = static_cast<int>(std::ceil(in_h / static_cast<double>(bins)));
+        _window_w[i] = static_cast<int>(std::ceil(in_w / static_cast<double>(bins)));
+        _pad_h[i] = (_window_h[i] * bins - in_h + 1) / 2;
+        _pad_w[i] = (_window_w[i] * bins - in_w + 1) / 2;
+    }
+    _thread_num = omp_get_max_threads();
+    _row.reshape(Shape(_thread_num, 1, 1, in_w));
+    return SaberSuccess;
+}
+
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberSpp<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        SPPParam<OpTensor> &param) {
+    const float* src = inputs[0]->data();
+    float* dst = outputs[0]->mutable_data();
+    const int planes = inputs[0]->num() * inputs[0]->channel();
+    const int in_h = inputs[0]->height();
+    const int in_w = inputs[0]->width();
+    const int out_w = outputs[0]->width();
+    const bool is_max = param.pool_type == Pooling_max;
+    const bool include_pad = param.pool_type == Pooling_average_include_padding;
+    const EltwiseType reduce = is_max ? Eltwise_max : Eltwise_sum;
+    float* row_all = _row.mutable_data();
+    const X86Kernels& kernels = *_kernels;
+
+    #pragma omp parallel for schedule(static) num_threads(_thread_num)
+    for (int p = 0; p < planes; ++p) {
+        const float* plane = src + (size_t)p * in_h * in_w;
+        float* row = row_all + (size_t)omp_get_thread_num() * in_w;
+        float* out = dst + (size_t)p * out_w;
+        for (int level = 0; level < param.pyramid_height; ++level) {
+            const int bins = 1 << level;
+            const int window_h = _window_h[level];
+            const int window_w = _window_w[level];
+            const int pad_h = _pad_h[level];
+            const int pad_w = _pad_w[level];
+            for (int ph = 0; ph < bins; ++ph) {
+                int h_start = ph * window_h - pad_h;
+                int h_end = std::min(h_start + window_h, in_h + pad_h);
+                const int pool_h = h_end - h_start;
+                h_start = std::max(h_start, 0);
+                h_end = std::min(h_end, in_h);
+                if (h_end > h_start) {
+                    memcpy(row, plane + h_start * in_w, in_w * sizeof(float));
+                    for (int h = h_start + 1; h < h_end; ++h) {
+                        kernels.elt_apply(reduce, row, plane + h * in_w, false, 1.f, in_w);
+                    }
+                }
+                for (int pw = 0; pw < bins; ++pw) {
+                    int w_start = pw * window_w - pad_w;
+                    int w_end = std::min(w_start + window_w, in_w + pad_w);
+                    const int pool_w = w_end - w_start;
+                    w_start = std::max(w_start, 0);
+                    w_end = std::min(w_end, in_w);
+                    float val = 0.f;
+                    if (h_end > h_start && w_end > w_start) {
+                        if (is_max) {
+                            val = -FLT_MAX;
+                            for (int w = w_start; w < w_end; ++w) {
+                                val = std::max(val, row[w]);
+                            }
+                        } else {
+                            for (int w = w_start; w < w_end; ++w) {
+                                val += row[w];
+                            }
+                            val /= include_pad ? pool_h * pool_w : (h_end - h_start) * (w_end - w_start);
+                        }
+                    }
+                    out[ph * bins + pw] = val;
+                }
+            }
+            out += bins * bins;
+        }
+    }
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
@@ -0,0 +1,81 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_SPP_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_SPP_H
+
+#include "saber/funcs/impl/impl_spp.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+
+namespace anakin{
+namespace saber {
+
+/**
+ * spatial pyramid pooling of NCHW, level i pools 2^i x 2^i bins with the window and padding
+ * of caffe. The bins of every channel are laid out level after level along the width of the
+ * output, (num, channel, 1, (4^levels - 1) / 3). Every channel is a task: the rows of a bin
+ * row are reduced into one row with vector max or sum, then every bin reduces its columns.
+ */
+template <DataType OpDtype,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+class SaberSpp<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out> : public ImplBase<
+        Tensor<X86, inDtype, LayOutType_in>,
+        Tensor<X86, outDtype, LayOutType_out>,
+        Tensor<X86, OpDtype, LayOutType_op>,
+        SPPParam<Tensor<X86, OpDtype, LayOutType_op> > > {
+public:
+    typedef Tensor<X86, inDtype, LayOutType_in> DataTensor_in;
+    typedef Tensor<X86, outDtype, LayOutType_out> DataTensor_out;
+    typedef Tensor<X86, OpDtype, LayOutType_op> OpTensor;
+
+    SaberSpp() = default;
+
+    ~SaberSpp() {}
+
+    virtual SaberStatus init(const std::vector<DataTensor_in*>& inputs,
+                             std::vector<DataTensor_out*>& outputs,
+                             SPPParam<OpTensor> &param,
+                             Context<X86> &ctx) override;
+
+    virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
+                               std::vector<DataTensor_out*>& outputs,
+                               SPPParam<OpTensor> &param,
+                               Context<X86> &ctx) override;
+
+    virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
+                                 std::vector<DataTensor_out*>& outputs,
+                                 SPPParam<OpTensor> &param) override;
+
+private:
+    ///< window and padding of every level
+    std::vector<int> _window_h;
+    std::vector<int> _window_w;
+    std::vector<int> _pad_h;
+    std::vector<int> _pad_w;
+    int _thread_num{1};
+    ///< reduced row of every thread
+    DataTensor_in _row;
+    const X86Kernels* _kernels{nullptr};
+};
+
+}
+}
+
+#endif
@@ -11,12 +11,43 @@
 
 #ifndef ANAKIN_SABER_SSE_MATH_H
 #define ANAKIN_SABER_SSE_MATH_H
-#if defined(__SSE4_2__) and defined(__FMA__)
+#if defined(__SSE4_2__)
 
 #include <immintrin.h>
 namespace anakin {
 namespace saber {
 
+/// cephes exp of sse4 hosts without fma
+static inline __m128 exp128_ps(__m128 x) {
+    __m128 one = _mm_set1_ps(1.f);
+    x = _mm_min_ps(x, _mm_set1_ps(88.3762626647949f));
+    x = _mm_max_ps(x, _mm_set1_ps(-88.3762626647949f));
+
+    __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+    __m128 tmp = _mm_floor_ps(fx);
+    __m128 mask = _mm_and_ps(_mm_cmpgt_ps(tmp, fx), one);
+    fx = _mm_sub_ps(tmp, mask);
+
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440E-4f)));
+    __m128 z = _mm_mul_ps(x, x);
+
+    __m128 y = _mm_set1_ps(1.9875691500E-4f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507E-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073E-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894E-2f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459E-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201E-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, z), x);
+    y = _mm_add_ps(y, one);
+
+    __m128i imm0 = _mm_cvttps_epi32(fx);
+    imm0 = _mm_add_epi32(imm0, _mm_set1_epi32(0x7f));
+    imm0 = _mm_slli_epi32(imm0, 23);
+    return _mm_mul_ps(y, _mm_castsi128_ps(imm0));
+}
+
+#if defined(__FMA__)
 
 static inline __m128 exp128_ps_fma(__m128 x) {
     __m128 tmp = _mm_setzero_ps(), fx;
@@ -70,9 +101,10 @@ static inline __m128 exp128_ps_fma(__m128 x) {
     y = _mm_mul_ps(y, pow2n);
     return y;
 }
+#endif
 
 }
 }
 #endif
 
-#endif
\ No newline at end of file
+#endif
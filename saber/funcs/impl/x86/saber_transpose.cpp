@@ -0,0 +1,74 @@
+#include "saber/funcs/impl/x86/saber_transpose.h"
+#include "saber/funcs/impl/x86/x86_permute.h"
+#include <algorithm>
+#include <numeric>
+
+namespace anakin{
+namespace saber {
+
+template class SaberTranspose<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>;
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberTranspose<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::init(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        TransposeParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_ctx = &ctx;
+    return create(inputs, outputs, param, ctx);
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberTranspose<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::create(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        TransposeParam<OpTensor> &param, Context<X86> &ctx)
+{
+    this->_param = &param;
+    this->_ctx = &ctx;
+    const int height_idx = inputs[0]->height_index();
+    const int width_idx = inputs[0]->width_index();
+    if (height_idx < 0 || width_idx < 0) {
+        LOG(ERROR) << "transpose needs the height and width dims";
+        return SaberInvalidValue;
+    }
+    if (!inputs[0]->is_continue_mem() || !outputs[0]->is_continue_mem()) {
+        LOG(ERROR) << "x86 transpose only supports dense tensors";
+        return SaberUnImplError;
+    }
+    _order.resize(inputs[0]->valid_shape().dims());
+    std::iota(_order.begin(), _order.end(), 0);
+    std::swap(_order[height_idx], _order[width_idx]);
+    return SaberSuccess;
+}
+
+template <DataType OpDtype ,
+        DataType inDtype,
+        DataType outDtype,
+        typename LayOutType_op,
+        typename LayOutType_in,
+        typename LayOutType_out>
+SaberStatus SaberTranspose<X86, OpDtype, inDtype, outDtype,
+        LayOutType_op, LayOutType_in, LayOutType_out>::dispatch(
+        const std::vector<DataTensor_in*>& inputs,
+        std::vector<DataTensor_out*>& outputs,
+        TransposeParam<OpTensor>& param) {
+    x86_permute_forward(inputs[0]->data(), inputs[0]->valid_shape(),
+                        outputs[0]->mutable_data(), _order);
+    return SaberSuccess;
+}
+
+}
+} // namespace anakin
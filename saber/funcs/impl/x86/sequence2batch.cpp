@@ -7,9 +7,9 @@ namespace math {
 template <DataType Dtype, typename LayOutType>
 void CopyMatrixRowsFunctor<Dtype, LayOutType>::operator()(
         ioTensor* src,
-        std::vector<int> index_lod, ioTensor* dst,
+        const std::vector<int>& index_lod, ioTensor* dst,
         bool is_src_index, int fragment_num) {
-    int* index = index_lod.data();
+    const int* index = index_lod.data();
     auto src_shape = src->valid_shape();
     auto dst_shape = dst->valid_shape();
     /*if (src_shape.size() != 2) {
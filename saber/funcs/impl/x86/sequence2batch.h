@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <vector>
 #include "saber/core/tensor.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
 #ifdef USE_OPENMP
 #include "omp.h"
 #endif
@@ -23,7 +24,7 @@ public:
     // copy the input src to the indexed rows of output dst.
     // The indexed rows are based on the input index.
     void operator()(ioTensor* src,
-                    std::vector<int> index_lod, ioTensor* dst,
+                    const std::vector<int>& index_lod, ioTensor* dst,
                     bool is_src_index, int fragment_num);
 };
 
@@ -69,8 +70,22 @@ public:
             exit(-1);
         }
 
-        auto seq_meta = seq_to_batch_meta[0];
+        // the recurrent ops of a net run share the meta of their seq offset
+        static thread_local utils::SeqLayoutCache<std::vector<std::vector<int>>> cache;
+        const std::vector<int> seq_meta = seq_to_batch_meta[0];
+        auto batch_seq_meta = cache.get(seq_meta, is_reverse,
+                                        [&seq_meta, is_reverse](std::vector<std::vector<int>>& meta) {
+            build_batch_meta(seq_meta, is_reverse, meta);
+        });
+        seq_to_batch_meta = *batch_seq_meta;
+
+        CopyMatrixRowsFunctor<Dtype, LayOutType> to_batch;
+        to_batch(seq, seq_to_batch_meta[1], batch, true, fragment_num);
+    }
 
+private:
+    static void build_batch_meta(const std::vector<int>& seq_meta, bool is_reverse,
+                                 std::vector<std::vector<int>>& batch_seq_meta) {
         std::vector<SeqInfo> seq_info;
 
         for (int seq_id = 0; seq_id < seq_meta.size() - 1; ++seq_id) {
@@ -107,7 +122,6 @@ public:
         // The num_batch represents batch size after rearranging the
         // input LodTensor. It is also the maximum length of input sequence.
 
-        std::vector<std::vector<int>> batch_seq_meta;
         batch_seq_meta.emplace_back(std::vector<int> {0});
         batch_seq_meta.emplace_back(std::vector<int> {0});
         batch_seq_meta.emplace_back(std::vector<int> {0});
@@ -116,7 +130,7 @@ public:
         int num_batch = seq_info[0].length;
         batch_seq_meta[0].resize(static_cast<int>(num_batch + 1));
         // batch_seq_meta[1] is the raw index in the input LoDTensor
-        batch_seq_meta[1].resize(static_cast<int>(seq->num()));
+        batch_seq_meta[1].resize(static_cast<int>(seq_meta.back()));
         // batch_seq_meta[2] is the sort order for the input LoDTensor.
         batch_seq_meta[2].resize(seq_info.size());
 
@@ -148,11 +162,6 @@ public:
         for (int i = 0; i < seq_info.size(); ++i) {
             seq_order[i] = seq_info[i].seq_idx;
         }
-
-        seq_to_batch_meta = batch_seq_meta;
-
-        CopyMatrixRowsFunctor<Dtype, LayOutType> to_batch;
-        to_batch(seq, batch_seq_meta[1], batch, true, fragment_num);
     }
 };
 
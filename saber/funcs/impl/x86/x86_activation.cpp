@@ -0,0 +1,68 @@
+#include "saber/funcs/impl/x86/x86_activation.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+#include <cstring>
+#include <algorithm>
+
+namespace anakin {
+namespace saber {
+
+///< elements of one thread task, it fits L1/L2 cache with its output
+static const int kActBlockSize = 16 * 1024;
+
+bool x86_act_supported(ActiveType type) {
+    switch (type) {
+        case Active_sigmoid:
+        case Active_sigmoid_fluid:
+        case Active_relu:
+        case Active_prelu:
+        case Active_tanh:
+        case Active_tanh_fluid:
+        case Active_stanh:
+        case Active_clipped_relu:
+        case Active_elu:
+        case Active_identity:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void x86_act_range(const float* src, float* dst, size_t len,
+                   const X86ActParam& param, int channel) {
+    if (param.type == Active_identity) {
+        if (src != dst) {
+            memcpy(dst, src, sizeof(float) * len);
+        }
+        return;
+    }
+    float slope = param.alpha;
+    if (param.type == Active_prelu) {
+        CHECK(param.slope != nullptr) << "prelu needs slope";
+        slope = param.slope[param.channel_shared ? 0 : channel];
+    }
+    x86_kernels().act(src, dst, len, param, slope);
+}
+
+void x86_act_forward(const float* src, float* dst, int outer, int channel, int inner,
+                     const X86ActParam& param) {
+    CHECK(x86_act_supported(param.type)) << "x86 activation doesn't support type " << param.type;
+    const size_t len = (size_t)outer * channel * inner;
+    if (param.type == Active_prelu && !param.channel_shared) {
+        const int planes = outer * channel;
+        #pragma omp parallel for schedule(static) if (len > kActBlockSize)
+        for (int i = 0; i < planes; ++i) {
+            const size_t offset = (size_t)i * inner;
+            x86_act_range(src + offset, dst + offset, inner, param, i % channel);
+        }
+        return;
+    }
+    const int blocks = utils::div_up(len, (size_t)kActBlockSize);
+    #pragma omp parallel for schedule(static) if (blocks > 1)
+    for (int b = 0; b < blocks; ++b) {
+        const size_t offset = (size_t)b * kActBlockSize;
+        x86_act_range(src + offset, dst + offset, std::min((size_t)kActBlockSize, len - offset), param);
+    }
+}
+
+} // namespace saber
+} // namespace anakin
@@ -0,0 +1,72 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_X86_ACTIVATION_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_X86_ACTIVATION_H
+
+#include <cstddef>
+#include "saber/saber_types.h"
+#include "saber/saber_funcs_param.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+
+namespace anakin {
+namespace saber {
+
+template <typename opTensor>
+inline X86ActParam make_x86_act_param(const ActivationParam<opTensor>& param) {
+    X86ActParam act;
+    act.type = param.active;
+    switch (param.active) {
+        case Active_relu:
+            act.alpha = param.negative_slope;
+            break;
+        case Active_stanh:
+            act.alpha = param.negative_slope;
+            act.beta = param.coef;
+            break;
+        case Active_clipped_relu:
+        case Active_elu:
+            act.beta = param.coef;
+            break;
+        case Active_prelu:
+            act.slope = param.prelu_param.slope ? param.prelu_param.slope->data() : nullptr;
+            act.channel_shared = param.prelu_param.channel_shared;
+            break;
+        default:
+            break;
+    }
+    return act;
+}
+
+/// whether the engine implements the activation
+bool x86_act_supported(ActiveType type);
+
+/**
+ * \brief activation of len contiguous elements by the calling thread, src may equal dst.
+ *  It's the epilogue entry for other kernels, elements of prelu must belong to channel.
+ */
+void x86_act_range(const float* src, float* dst, size_t len,
+                   const X86ActParam& param, int channel = 0);
+
+/**
+ * \brief activation of a [outer, channel, inner] tensor, split across omp threads when it's large.
+ */
+void x86_act_forward(const float* src, float* dst, int outer, int channel, int inner,
+                     const X86ActParam& param);
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_X86_ACTIVATION_H
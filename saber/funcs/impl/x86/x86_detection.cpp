@@ -0,0 +1,196 @@
+#include "saber/funcs/impl/x86/x86_detection.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#include <algorithm>
+#include <utility>
+
+namespace anakin {
+namespace saber {
+
+///< priors of one decoding block, the transposed offsets and boxes of it stay in L1 cache
+static const int kDecodeBlock = 128;
+
+/// the area bbox_size of detection_helper gives, 0 for an invalid box
+static inline float bbox_area(const float* box) {
+    if (box[2] < box[0] || box[3] < box[1]) {
+        return 0.f;
+    }
+    return (box[2] - box[0]) * (box[3] - box[1]);
+}
+
+/// higher score first, the lower index first between equal scores as a stable sort keeps them
+static inline bool score_higher(const std::pair<float, int>& a, const std::pair<float, int>& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+void x86_prior_table(const float* prior, int num_priors, CodeType code_type,
+                     bool variance_encoded_in_target, float* table) {
+    const float* variance = prior + 4 * num_priors;
+    for (int p = 0; p < num_priors; ++p) {
+        const float* box = prior + 4 * p;
+        float var[4] = {1.f, 1.f, 1.f, 1.f};
+        if (!variance_encoded_in_target) {
+            std::copy(variance + 4 * p, variance + 4 * p + 4, var);
+        }
+        const float width = box[2] - box[0];
+        const float height = box[3] - box[1];
+        if (code_type == CENTER_SIZE) {
+            table[p] = (box[0] + box[2]) / 2.f;
+            table[num_priors + p] = (box[1] + box[3]) / 2.f;
+            table[2 * num_priors + p] = width * var[0];
+            table[3 * num_priors + p] = height * var[1];
+            table[4 * num_priors + p] = var[2];
+            table[5 * num_priors + p] = var[3];
+            table[6 * num_priors + p] = width / 2.f;
+            table[7 * num_priors + p] = height / 2.f;
+        } else {
+            // bbox = base + loc * scale, base then scale in the layout of the boxes
+            float* base = table + 4 * p;
+            float* scale = table + 4 * num_priors + 4 * p;
+            for (int k = 0; k < 4; ++k) {
+                base[k] = box[k];
+                scale[k] = var[k];
+            }
+            if (code_type == CORNER_SIZE) {
+                scale[0] *= width;
+                scale[1] *= height;
+                scale[2] *= width;
+                scale[3] *= height;
+            }
+        }
+    }
+}
+
+void x86_decode_bboxes(const float* loc, const float* table, int num_priors,
+                       CodeType code_type, float* bbox) {
+    if (code_type != CENTER_SIZE) {
+        const float* base = table;
+        const float* scale = table + 4 * num_priors;
+        for (int i = 0; i < 4 * num_priors; ++i) {
+            bbox[i] = base[i] + loc[i] * scale[i];
+        }
+        return;
+    }
+    const X86Kernels& kernels = x86_kernels();
+    float loc_planes[4 * kDecodeBlock];
+    float bbox_planes[4 * kDecodeBlock];
+    for (int p = 0; p < num_priors; p += kDecodeBlock) {
+        const int n = std::min(kDecodeBlock, num_priors - p);
+        kernels.transpose(loc + 4 * p, 4, loc_planes, kDecodeBlock, n, 4, 1.f, 0.f);
+        kernels.bbox_decode_center(loc_planes, kDecodeBlock, table + p, num_priors,
+                                   bbox_planes, kDecodeBlock, n);
+        kernels.transpose(bbox_planes, kDecodeBlock, bbox + 4 * p, 4, 4, n, 1.f, 0.f);
+    }
+}
+
+void x86_nms(const float* bboxes, const float* scores, int num, const X86NmsParam& param,
+             std::vector<int>& indices) {
+    std::vector<std::pair<float, int> > candidates;
+    for (int i = 0; i < num; ++i) {
+        if (scores[i] > param.conf_thresh) {
+            candidates.push_back(std::make_pair(scores[i], i));
+        }
+    }
+    int count = candidates.size();
+    if (param.nms_top_k > -1 && param.nms_top_k < count) {
+        count = param.nms_top_k;
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                          score_higher);
+    } else {
+        std::sort(candidates.begin(), candidates.end(), score_higher);
+    }
+
+    // planes of the kept boxes and their areas, so a candidate is tested against them simd wide
+    const X86Kernels& kernels = x86_kernels();
+    std::vector<float> kept(5 * count);
+    int num_kept = 0;
+    float thresh = param.nms_thresh;
+    for (int k = 0; k < count; ++k) {
+        const int idx = candidates[k].second;
+        const float* box = bboxes + 4 * idx;
+        const float area = bbox_area(box);
+        if (kernels.nms_overlap(box, area, kept.data(), count, num_kept, thresh)) {
+            continue;
+        }
+        for (int c = 0; c < 4; ++c) {
+            kept[c * count + num_kept] = box[c];
+        }
+        kept[4 * count + num_kept] = area;
+        ++num_kept;
+        indices.push_back(idx);
+        if (param.nms_eta < 1.f && thresh > 0.5f) {
+            thresh *= param.nms_eta;
+        }
+    }
+}
+
+void x86_multiclass_nms(const float* bboxes, const float* conf, int batch, int classes,
+                        int num_priors, bool share_location, const X86NmsParam& param,
+                        std::vector<float>& result) {
+    const int tasks = batch * classes;
+    std::vector<std::vector<int> > kept(tasks);
+    #pragma omp parallel for schedule(dynamic) if (tasks > 1)
+    for (int t = 0; t < tasks; ++t) {
+        const int image = t / classes;
+        if (t % classes == param.background_id) {
+            continue;
+        }
+        const size_t box_set = share_location ? image : t;
+        x86_nms(bboxes + box_set * num_priors * 4, conf + (size_t)t * num_priors, num_priors,
+                param, kept[t]);
+    }
+
+    // (label, position in kept) of the detections of every image, by label then position
+    std::vector<std::vector<std::pair<int, int> > > dets(batch);
+    #pragma omp parallel for schedule(static) if (batch > 1)
+    for (int i = 0; i < batch; ++i) {
+        const std::vector<int>* image_kept = kept.data() + (size_t)i * classes;
+        std::vector<std::pair<int, int> >& det = dets[i];
+        for (int c = 0; c < classes; ++c) {
+            for (int j = 0; j < image_kept[c].size(); ++j) {
+                det.push_back(std::make_pair(c, j));
+            }
+        }
+        if (param.keep_top_k < 0 || det.size() <= param.keep_top_k) {
+            continue;
+        }
+        const float* image_conf = conf + (size_t)i * classes * num_priors;
+        auto score_of = [&](const std::pair<int, int>& d) {
+            return image_conf[(size_t)d.first * num_priors + image_kept[d.first][d.second]];
+        };
+        std::nth_element(det.begin(), det.begin() + param.keep_top_k, det.end(),
+                         [&](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+            const float score_a = score_of(a);
+            const float score_b = score_of(b);
+            return score_a > score_b || (score_a == score_b && a < b);
+        });
+        det.resize(param.keep_top_k);
+        std::sort(det.begin(), det.end());
+    }
+
+    size_t rows = 0;
+    for (int i = 0; i < batch; ++i) {
+        rows += dets[i].size();
+    }
+    result.resize(rows * 7);
+    float* row = result.data();
+    for (int i = 0; i < batch; ++i) {
+        for (auto& d : dets[i]) {
+            const int label = d.first;
+            const size_t t = (size_t)i * classes + label;
+            const int idx = kept[t][d.second];
+            const size_t box_set = share_location ? i : t;
+            const float* box = bboxes + (box_set * num_priors + idx) * 4;
+            row[0] = i;
+            row[1] = label;
+            row[2] = conf[t * num_priors + idx];
+            row[3] = box[0];
+            row[4] = box[1];
+            row[5] = box[2];
+            row[6] = box[3];
+            row += 7;
+        }
+    }
+}
+
+} // namespace saber
+} // namespace anakin
@@ -0,0 +1,93 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_X86_DETECTION_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_X86_DETECTION_H
+
+#include <vector>
+#include "saber/saber_types.h"
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief parameter of the x86 multiclass nms, shared by DetectionOutput and MultiClassNMS.
+ *  nms_top_k: candidates of one class kept before nms, -1 keeps all.
+ *  keep_top_k: detections of one image kept after nms, -1 keeps all.
+ */
+struct X86NmsParam {
+    int background_id{0};
+    int keep_top_k{-1};
+    int nms_top_k{-1};
+    float conf_thresh{0.f};
+    float nms_thresh{0.3f};
+    float nms_eta{1.f};
+};
+
+template <typename ParamT>
+inline X86NmsParam make_x86_nms_param(const ParamT& param) {
+    X86NmsParam nms;
+    nms.background_id = param.background_id;
+    nms.keep_top_k = param.keep_top_k;
+    nms.nms_top_k = param.nms_top_k;
+    nms.conf_thresh = param.conf_thresh;
+    nms.nms_thresh = param.nms_thresh;
+    nms.nms_eta = param.nms_eta;
+    return nms;
+}
+
+/// floats of the table x86_decode_bboxes reads
+inline int x86_prior_table_size(int num_priors) {
+    return 8 * num_priors;
+}
+
+/**
+ * \brief decoding constants of the priors, built once per forward and shared by every image.
+ *  prior: the priorbox output, num_priors boxes then their variances.
+ */
+void x86_prior_table(const float* prior, int num_priors, CodeType code_type,
+                     bool variance_encoded_in_target, float* table);
+
+/**
+ * \brief decodes the loc offsets of num_priors boxes, [num_priors, 4] in and out.
+ *  Center size boxes are transposed to planes in cache blocks for the simd kernel,
+ *  the corner codes are one multiply add per coordinate.
+ */
+void x86_decode_bboxes(const float* loc, const float* table, int num_priors,
+                       CodeType code_type, float* bbox);
+
+/**
+ * \brief greedy nms of num boxes [num, 4], appends the indices of the kept ones in
+ *  descending score. Candidates above conf_thresh are ranked with a partial sort when
+ *  nms_top_k cuts them, and the iou against kept boxes is tested simd wide.
+ */
+void x86_nms(const float* bboxes, const float* scores, int num, const X86NmsParam& param,
+             std::vector<int>& indices);
+
+/**
+ * \brief nms of every class of every image, in parallel over (image, class), then the
+ *  keep_top_k cut of every image.
+ *  bboxes: [batch, num_priors, 4] when share_location, else [batch, classes, num_priors, 4].
+ *  conf: [batch, classes, num_priors].
+ *  result: rows of (image, label, score, xmin, ymin, xmax, ymax), by image then label.
+ */
+void x86_multiclass_nms(const float* bboxes, const float* conf, int batch, int classes,
+                        int num_priors, bool share_location, const X86NmsParam& param,
+                        std::vector<float>& result);
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_X86_DETECTION_H
@@ -0,0 +1,153 @@
+#include "saber/funcs/impl/x86/x86_eltwise.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+#include <cstring>
+#include <algorithm>
+
+namespace anakin {
+namespace saber {
+
+///< floats of one thread task, the running result stays in L1/L2 cache across all inputs
+static const size_t kEltBlockSize = 4 * 1024;
+
+/// acc = c * src, src is a single value broadcast along the row when scalar is true
+static inline void init_row(const X86Kernels& kernels, float* acc, const float* src,
+                            bool scalar, float c, size_t len) {
+    if (scalar) {
+        std::fill(acc, acc + len, src[0] * c);
+    } else {
+        kernels.elt_scale(acc, src, c, len);
+    }
+}
+
+/**
+ * \brief merges adjacent dims which every input broadcasts (or not) alike,
+ *  so the last group is the longest contiguous row the kernels can stream over.
+ *  strides[k][g] is the step of input k along group g, 0 when it's broadcast.
+ */
+static void collapse_dims(const std::vector<Shape>& src_shapes, const Shape& dst_shape,
+                          std::vector<size_t>& dims, std::vector<std::vector<char> >& bcast,
+                          std::vector<std::vector<size_t> >& strides) {
+    const int input_num = src_shapes.size();
+    dims.clear();
+    bcast.clear();
+    for (int d = 0; d < dst_shape.dims(); ++d) {
+        if (dst_shape[d] == 1) {
+            continue;
+        }
+        std::vector<char> mask(input_num);
+        for (int k = 0; k < input_num; ++k) {
+            mask[k] = src_shapes[k][d] == 1;
+        }
+        if (!dims.empty() && bcast.back() == mask) {
+            dims.back() *= dst_shape[d];
+        } else {
+            dims.push_back(dst_shape[d]);
+            bcast.push_back(mask);
+        }
+    }
+    if (dims.empty()) {
+        dims.push_back(1);
+        bcast.push_back(std::vector<char>(input_num, 0));
+    }
+    const int group_num = dims.size();
+    strides.assign(input_num, std::vector<size_t>(group_num, 0));
+    for (int k = 0; k < input_num; ++k) {
+        size_t step = 1;
+        for (int g = group_num - 1; g >= 0; --g) {
+            if (!bcast[g][k]) {
+                strides[k][g] = step;
+                step *= dims[g];
+            }
+        }
+    }
+}
+
+bool x86_eltwise_supported(const X86EltwiseParam& param, int input_num) {
+    if (input_num < 1 || param.ops.size() != input_num - 1 || param.coeff.size() < input_num) {
+        return false;
+    }
+    for (auto op : param.ops) {
+        if (op != Eltwise_sum && op != Eltwise_prod && op != Eltwise_max) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void x86_eltwise_forward(const std::vector<const float*>& srcs,
+                         const std::vector<Shape>& src_shapes,
+                         float* dst, const Shape& dst_shape,
+                         const X86EltwiseParam& param,
+                         const X86ActParam* act) {
+    const int input_num = srcs.size();
+    CHECK(x86_eltwise_supported(param, input_num)) << "x86 eltwise doesn't support the op chain";
+    CHECK(act == nullptr || act->type != Active_prelu) << "prelu isn't supported as eltwise epilogue";
+    for (int k = 0; k < input_num; ++k) {
+        CHECK_EQ(src_shapes[k].dims(), dst_shape.dims()) << "eltwise inputs must have the same rank";
+        for (int d = 0; d < dst_shape.dims(); ++d) {
+            CHECK(src_shapes[k][d] == dst_shape[d] || src_shapes[k][d] == 1)
+                    << "input " << k << " can't broadcast to output at dim " << d;
+        }
+    }
+
+    std::vector<size_t> dims;
+    std::vector<std::vector<char> > bcast;
+    std::vector<std::vector<size_t> > strides;
+    collapse_dims(src_shapes, dst_shape, dims, bcast, strides);
+    const int group_num = dims.size();
+    const size_t inner = dims.back();
+    size_t outer = 1;
+    for (int g = 0; g < group_num - 1; ++g) {
+        outer *= dims[g];
+    }
+    // an output sharing memory with a later input needs a buffer, it's read after the first write
+    bool alias = false;
+    for (int k = 1; k < input_num; ++k) {
+        alias = alias || srcs[k] == dst;
+    }
+    const size_t row_blocks = utils::div_up(inner, kEltBlockSize);
+    const size_t tasks = outer * row_blocks;
+    const X86Kernels& kernels = x86_kernels();
+
+    #pragma omp parallel if (tasks > 1)
+    {
+        const int ithr = omp_get_thread_num();
+        const int nthr = omp_get_num_threads();
+        size_t start{0}, end{0};
+        utils::balance211(tasks, nthr, ithr, start, end);
+        std::vector<const float*> ptrs(input_num);
+        std::vector<float> buffer(alias ? kEltBlockSize : 0);
+        for (size_t t = start; t < end; ++t) {
+            const size_t row = t / row_blocks;
+            const size_t offset = (t % row_blocks) * kEltBlockSize;
+            const size_t len = std::min(kEltBlockSize, inner - offset);
+            for (int k = 0; k < input_num; ++k) {
+                size_t pos = 0;
+                size_t rest = row;
+                for (int g = group_num - 2; g >= 0; --g) {
+                    pos += (rest % dims[g]) * strides[k][g];
+                    rest /= dims[g];
+                }
+                ptrs[k] = srcs[k] + pos + (bcast.back()[k] ? 0 : offset);
+            }
+            float* out = dst + row * inner + offset;
+            float* acc = alias ? buffer.data() : out;
+
+            const bool sum_first = param.ops.empty() || param.ops[0] == Eltwise_sum;
+            init_row(kernels, acc, ptrs[0], bcast.back()[0], sum_first ? param.coeff[0] : 1.f, len);
+            for (int k = 1; k < input_num; ++k) {
+                const EltwiseType op = param.ops[k - 1];
+                kernels.elt_apply(op, acc, ptrs[k], bcast.back()[k], op == Eltwise_sum ? param.coeff[k] : 1.f, len);
+            }
+            if (act != nullptr) {
+                x86_act_range(acc, out, len, *act);
+            } else if (acc != out) {
+                memcpy(out, acc, sizeof(float) * len);
+            }
+        }
+    }
+}
+
+} // namespace saber
+} // namespace anakin
@@ -0,0 +1,69 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_X86_ELTWISE_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_X86_ELTWISE_H
+
+#include <vector>
+#include "saber/saber_types.h"
+#include "saber/saber_funcs_param.h"
+#include "saber/funcs/impl/x86/x86_activation.h"
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief parameter of the x86 eltwise engine.
+ *  ops[i] combines the result so far with input i + 1,
+ *  coeff[i] scales input i when it's consumed by a sum (input 0 belongs to ops[0]).
+ */
+struct X86EltwiseParam {
+    std::vector<EltwiseType> ops;
+    std::vector<float> coeff;
+};
+
+template <typename opTensor>
+inline X86EltwiseParam make_x86_eltwise_param(EltwiseParam<opTensor>& param, int input_num) {
+    X86EltwiseParam elt;
+    if (param.chain_ops.empty()) {
+        elt.ops.assign(input_num - 1, param.operation);
+    } else {
+        elt.ops = param.chain_ops;
+    }
+    elt.coeff.assign(input_num, 1.f);
+    for (int i = 0; i < input_num && i < param.coeff.size(); ++i) {
+        elt.coeff[i] = param.coeff[i];
+    }
+    return elt;
+}
+
+/// whether the engine implements the eltwise (ops, coeff and shapes) of input_num inputs
+bool x86_eltwise_supported(const X86EltwiseParam& param, int input_num);
+
+/**
+ * \brief eltwise of inputs which broadcast to dst_shape, numpy style: every dim of an input
+ *  equals the one of dst or is 1. act runs as epilogue on every block while it's in cache,
+ *  it can be nullptr, prelu isn't supported as epilogue.
+ */
+void x86_eltwise_forward(const std::vector<const float*>& srcs,
+                         const std::vector<Shape>& src_shapes,
+                         float* dst, const Shape& dst_shape,
+                         const X86EltwiseParam& param,
+                         const X86ActParam* act = nullptr);
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_X86_ELTWISE_H
@@ -0,0 +1,37 @@
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#include "saber/funcs/impl/x86/x86_kernels_impl.h"
+
+namespace anakin {
+namespace saber {
+
+const X86Kernels* x86_kernels_scalar() {
+    static const X86Kernels kernels = make_x86_kernels<VecScalar>(X86_ISA_SCALAR);
+    return &kernels;
+}
+
+const X86Kernels* x86_kernels_of(X86Isa isa) {
+    switch (isa) {
+        case X86_ISA_SSE42:
+            return x86_kernels_sse42();
+        case X86_ISA_AVX2:
+            return x86_kernels_avx2();
+        case X86_ISA_AVX512:
+            return x86_kernels_avx512();
+        default:
+            return x86_kernels_scalar();
+    }
+}
+
+const X86Kernels& x86_kernels() {
+    static const X86Kernels* kernels = [] {
+        const X86Kernels* best = nullptr;
+        for (int isa = x86_isa(); best == nullptr && isa >= X86_ISA_SCALAR; --isa) {
+            best = x86_kernels_of((X86Isa)isa);
+        }
+        return best;
+    }();
+    return *kernels;
+}
+
+} // namespace saber
+} // namespace anakin
@@ -0,0 +1,176 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_X86_KERNELS_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_X86_KERNELS_H
+
+#include <cstddef>
+#include "saber/saber_types.h"
+#include "saber/core/impl/x86/x86_isa.h"
+
+/**
+ * SIMD kernels of the x86 ops are built once per isa level, every level in its own
+ * translation unit x86_kernels_<isa>.cpp compiled with that level's flags, and ops pick
+ * the table of the running host at init. Keep this header free of heavy includes:
+ * inline code the isa units share with the rest of the library must not be built with
+ * their wider flags.
+ */
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief parameter of the x86 activation engine.
+ *  alpha: negative slope of relu, input scale of stanh.
+ *  beta: threshold of clipped relu, coef of elu, output scale of stanh.
+ *  slope: per channel slopes of prelu (slope[0] when channel_shared).
+ */
+struct X86ActParam {
+    ActiveType type{Active_unknow};
+    float alpha{0.f};
+    float beta{1.f};
+    const float* slope{nullptr};
+    bool channel_shared{false};
+};
+
+/**
+ * \brief lstm cells of rows [row_start, row_end) in one step.
+ *  wx: [row, 4, hidden] gates i f c o of x and h, indexed by the absolute row.
+ *  hout, cell: hidden and cell of the rows, from row_start, cell is updated in place.
+ *  first: no previous hidden nor cell, so the forget gate is skipped.
+ */
+struct X86LstmCellArgs {
+    int row_start;
+    int row_end;
+    const float* wx;
+    const float* bias;      ///< [4, hidden]
+    const float* peephole;  ///< [3, hidden], nullptr without peephole
+    float* hout;
+    float* cell;
+    ActiveType gate_act;
+    ActiveType cell_act;
+    ActiveType candi_act;
+    int hidden;             ///< aligned hidden size, a multiple of the kernel width
+    bool first;
+};
+
+/**
+ * \brief gru cells of rows [row_start, row_end) in one step, gate order is o r z.
+ *  wx: [row, 3, hidden] indexed by the absolute row; wh: [row, 2, hidden] r z of hidden;
+ *  whr: [row, hidden] o of (r * hidden); hin, hout, wh and whr are from row_start.
+ */
+struct X86GruCellArgs {
+    int row_start;
+    int row_end;
+    const float* wx;
+    const float* wh;
+    const float* whr;
+    const float* bias;      ///< [3, hidden]
+    const float* hin;
+    float* hout;
+    ActiveType gate_act;
+    ActiveType hid_act;
+    int hidden;             ///< aligned hidden size, a multiple of the kernel width
+};
+
+struct X86Kernels {
+    X86Isa isa;
+    int width;  ///< floats per vector, rnn and crf pad their rows to it
+    /// activation of len floats, slope is the one of relu or of the prelu channel
+    void (*act)(const float* src, float* dst, size_t len, const X86ActParam& param, float slope);
+    /// acc = c * src
+    void (*elt_scale)(float* acc, const float* src, float c, size_t len);
+    /// acc = acc op (c * src), src is one value broadcast along the row when scalar is true
+    void (*elt_apply)(EltwiseType op, float* acc, const float* src, bool scalar, float c, size_t len);
+    void (*lstm_cell)(const X86LstmCellArgs& args);
+    /// hout = r * hin
+    void (*gru_reset)(const X86GruCellArgs& args);
+    /// hout = (1 - z) * hin + z * act(o)
+    void (*gru_update)(const X86GruCellArgs& args);
+    /**
+     * viterbi of one sequence. emission and alpha: [seq_len, aligned_tag];
+     * transition: [tag + 2, aligned_tag], start, end, then row i holds the scores of moving to i.
+     */
+    void (*crf_viterbi)(float* path, const float* emission, const float* transition,
+                        float* alpha, int* track, int seq_len, int tag_num, int aligned_tag);
+    /// online max and sum of exp(x - max) of n contiguous floats, in one pass
+    void (*softmax_stat)(const float* src, int n, float& max, float& sum);
+    /// dst = exp(src - max) * scale
+    void (*softmax_norm)(const float* src, float* dst, int n, float max, float scale);
+    /// softmax of width adjacent columns, each of n floats apart by stride
+    void (*softmax_strided)(const float* src, float* dst, int n, int stride, int width);
+    /**
+     * transpose of a rows x cols block, dst[c * dst_ld + r] = src[r * src_ld + c] * scale + shift.
+     * Done in square register tiles, callers block it so both sides stay in cache.
+     */
+    void (*transpose)(const float* src, int src_ld, float* dst, int dst_ld,
+                      int rows, int cols, float scale, float shift);
+    /**
+     * center size decoding of n boxes, every argument is a set of planes ld floats apart.
+     * loc: the 4 offsets; prior: center x, center y, width * var0, height * var1, var2, var3,
+     * width / 2, height / 2; bbox: xmin, ymin, xmax, ymax.
+     */
+    void (*bbox_decode_center)(const float* loc, int loc_ld, const float* prior, int prior_ld,
+                               float* bbox, int bbox_ld, int n);
+    /**
+     * whether box (xmin, ymin, xmax, ymax) of area overlaps any of n kept boxes by an iou
+     * above thresh. kept holds the planes xmin, ymin, xmax, ymax and area, ld floats apart.
+     */
+    bool (*nms_overlap)(const float* box, float area, const float* kept, int ld, int n, float thresh);
+    /**
+     * layer norm of n floats in one pass over the statistics,
+     * dst = (src - mean) / (std + eps) * scale + bias, scale and bias may be nullptr.
+     */
+    void (*layer_norm)(const float* src, float* dst, int n, const float* scale, const float* bias, float eps);
+    /// mean and biased variance of n floats, in one pass
+    void (*mean_var)(const float* src, int n, float& mean, float& var);
+    /**
+     * lrn across channels of n adjacent pixels, the planes of the channels are stride floats apart.
+     * dst = src * pow(k + alpha * sum of the squares in the window of size, -beta);
+     * accum is scratch of n floats.
+     */
+    void (*lrn_across)(const float* src, float* dst, int n, int channels, size_t stride, int size,
+                       float alpha, float beta, float k, float* accum);
+    /// sum or max of n floats, op is Eltwise_sum or Eltwise_max
+    float (*reduce)(EltwiseType op, const float* src, int n);
+    /**
+     * sum or max of every window of adjacent floats, in place:
+     * row[j] = op(row[j], ..., row[j + window - 1]) for j < n, row holds n + window - 1 floats.
+     */
+    void (*pool_window)(EltwiseType op, float* row, int n, int window);
+};
+
+/// activations the rnn cell kernels implement
+inline bool x86_rnn_act_supported(ActiveType type) {
+    return type == Active_sigmoid || type == Active_relu || type == Active_tanh
+           || type == Active_identity || type == Active_sigmoid_fluid || type == Active_tanh_fluid;
+}
+
+///< tables of every level, nullptr when the library isn't built with that level
+const X86Kernels* x86_kernels_scalar();
+const X86Kernels* x86_kernels_sse42();
+const X86Kernels* x86_kernels_avx2();
+const X86Kernels* x86_kernels_avx512();
+
+/// the table of isa, nullptr when the library isn't built with it
+const X86Kernels* x86_kernels_of(X86Isa isa);
+
+/// the best table the host runs, see x86_isa()
+const X86Kernels& x86_kernels();
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_X86_KERNELS_H
@@ -0,0 +1,20 @@
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#if defined(__AVX2__) and defined(__FMA__)
+#include "saber/funcs/impl/x86/x86_kernels_impl.h"
+#endif
+
+namespace anakin {
+namespace saber {
+
+// built with -mavx2 -mfma, see saber/CMakeLists.txt
+const X86Kernels* x86_kernels_avx2() {
+#if defined(__AVX2__) and defined(__FMA__)
+    static const X86Kernels kernels = make_x86_kernels<VecAvx2>(X86_ISA_AVX2);
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace saber
+} // namespace anakin
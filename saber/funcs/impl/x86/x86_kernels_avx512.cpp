@@ -0,0 +1,20 @@
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#if defined(__AVX512F__)
+#include "saber/funcs/impl/x86/x86_kernels_impl.h"
+#endif
+
+namespace anakin {
+namespace saber {
+
+// built with -mavx512f, see saber/CMakeLists.txt
+const X86Kernels* x86_kernels_avx512() {
+#if defined(__AVX512F__)
+    static const X86Kernels kernels = make_x86_kernels<VecAvx512>(X86_ISA_AVX512);
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace saber
+} // namespace anakin
@@ -0,0 +1,865 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_X86_KERNELS_IMPL_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_X86_KERNELS_IMPL_H
+
+#include <cmath>
+#include <limits>
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#include "saber/funcs/impl/x86/x86_vec_traits.h"
+
+/**
+ * Kernel bodies written once over a vector trait V, include it only from the
+ * x86_kernels_<isa>.cpp units, each of them builds one table with make_x86_kernels<V>.
+ */
+
+namespace anakin {
+namespace saber {
+namespace {
+
+/// tanh(x) = 1 - 2 / (exp(2x) + 1), saturates to +-1 as exp is clamped
+template <typename V>
+inline typename V::vec vec_tanh(typename V::vec x) {
+    typename V::vec one = V::set1(1.f);
+    typename V::vec e = V::exp(V::add(x, x));
+    return V::sub(one, V::div(V::set1(2.f), V::add(e, one)));
+}
+
+template <typename V>
+inline typename V::vec vec_sigmoid(typename V::vec x) {
+    typename V::vec one = V::set1(1.f);
+    return V::div(one, V::add(one, V::exp(V::sub(V::set1(0.f), x))));
+}
+
+template <typename V>
+inline typename V::vec vec_relu(typename V::vec x) {
+    return V::max(x, V::set1(0.f));
+}
+
+template <typename V>
+inline typename V::vec vec_identity(typename V::vec x) {
+    return x;
+}
+
+/// activations of the rnn cells, see x86_rnn_act_supported
+template <typename V>
+inline typename V::vec (*rnn_act(ActiveType type))(typename V::vec) {
+    switch (type) {
+        case Active_sigmoid:
+        case Active_sigmoid_fluid:
+            return vec_sigmoid<V>;
+        case Active_relu:
+            return vec_relu<V>;
+        case Active_tanh:
+        case Active_tanh_fluid:
+            return vec_tanh<V>;
+        default:
+            return vec_identity<V>;
+    }
+}
+
+/// returns number of elements done, a multiple of V::width
+template <typename V>
+size_t act_block(const float* src, float* dst, size_t len, const X86ActParam& param, float slope) {
+    typedef typename V::vec vec;
+    const size_t vec_len = len / V::width * V::width;
+    const vec zero = V::set1(0.f);
+    const vec one = V::set1(1.f);
+    size_t i = 0;
+    switch (param.type) {
+        case Active_sigmoid:
+        case Active_sigmoid_fluid:
+            for (; i < vec_len; i += V::width) {
+                V::store(dst + i, vec_sigmoid<V>(V::load(src + i)));
+            }
+            break;
+        case Active_relu:
+        case Active_prelu:
+            if (slope == 0.f) {
+                for (; i < vec_len; i += V::width) {
+                    V::store(dst + i, V::max(V::load(src + i), zero));
+                }
+            } else {
+                const vec v_slope = V::set1(slope);
+                for (; i < vec_len; i += V::width) {
+                    vec x = V::load(src + i);
+                    V::store(dst + i, V::select_pos(x, x, V::mul(x, v_slope)));
+                }
+            }
+            break;
+        case Active_tanh:
+        case Active_tanh_fluid:
+            for (; i < vec_len; i += V::width) {
+                V::store(dst + i, vec_tanh<V>(V::load(src + i)));
+            }
+            break;
+        case Active_stanh: {
+            const vec scale_in = V::set1(param.alpha);
+            const vec scale_out = V::set1(param.beta);
+            for (; i < vec_len; i += V::width) {
+                vec x = V::mul(V::load(src + i), scale_in);
+                V::store(dst + i, V::mul(scale_out, vec_tanh<V>(x)));
+            }
+            break;
+        }
+        case Active_clipped_relu: {
+            const vec threshold = V::set1(param.beta);
+            for (; i < vec_len; i += V::width) {
+                V::store(dst + i, V::min(V::max(V::load(src + i), zero), threshold));
+            }
+            break;
+        }
+        case Active_elu: {
+            const vec coef = V::set1(param.beta);
+            for (; i < vec_len; i += V::width) {
+                vec x = V::load(src + i);
+                vec neg = V::mul(coef, V::sub(V::exp(V::min(x, zero)), one));
+                V::store(dst + i, V::select_pos(x, x, neg));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return i;
+}
+
+template <typename V>
+void act_kernel(const float* src, float* dst, size_t len, const X86ActParam& param, float slope) {
+    size_t i = act_block<V>(src, dst, len, param, slope);
+    if (i < len) {
+        act_block<VecScalar>(src + i, dst + i, len - i, param, slope);
+    }
+}
+
+struct EltSum {
+    template <typename V>
+    static inline typename V::vec apply(typename V::vec a, typename V::vec b) { return V::add(a, b); }
+};
+
+struct EltProd {
+    template <typename V>
+    static inline typename V::vec apply(typename V::vec a, typename V::vec b) { return V::mul(a, b); }
+};
+
+struct EltMax {
+    template <typename V>
+    static inline typename V::vec apply(typename V::vec a, typename V::vec b) { return V::max(a, b); }
+};
+
+template <typename V>
+size_t elt_scale_block(float* acc, const float* src, float c, size_t len) {
+    const size_t vec_len = len / V::width * V::width;
+    const typename V::vec v_c = V::set1(c);
+    for (size_t i = 0; i < vec_len; i += V::width) {
+        V::store(acc + i, V::mul(V::load(src + i), v_c));
+    }
+    return vec_len;
+}
+
+template <typename V>
+void elt_scale_kernel(float* acc, const float* src, float c, size_t len) {
+    size_t i = elt_scale_block<V>(acc, src, c, len);
+    elt_scale_block<VecScalar>(acc + i, src + i, c, len - i);
+}
+
+template <typename V, typename Op>
+size_t elt_apply_block(float* acc, const float* src, bool scalar, float c, size_t len) {
+    const size_t vec_len = len / V::width * V::width;
+    if (scalar) {
+        const typename V::vec b = V::set1(src[0] * c);
+        for (size_t i = 0; i < vec_len; i += V::width) {
+            V::store(acc + i, Op::template apply<V>(V::load(acc + i), b));
+        }
+    } else {
+        const typename V::vec v_c = V::set1(c);
+        for (size_t i = 0; i < vec_len; i += V::width) {
+            V::store(acc + i, Op::template apply<V>(V::load(acc + i), V::mul(V::load(src + i), v_c)));
+        }
+    }
+    return vec_len;
+}
+
+template <typename V, typename Op>
+void elt_apply_row(float* acc, const float* src, bool scalar, float c, size_t len) {
+    size_t i = elt_apply_block<V, Op>(acc, src, scalar, c, len);
+    elt_apply_block<VecScalar, Op>(acc + i, scalar ? src : src + i, scalar, c, len - i);
+}
+
+template <typename V>
+void elt_apply_kernel(EltwiseType op, float* acc, const float* src, bool scalar, float c, size_t len) {
+    switch (op) {
+        case Eltwise_sum:
+            elt_apply_row<V, EltSum>(acc, src, scalar, c, len);
+            break;
+        case Eltwise_prod:
+            elt_apply_row<V, EltProd>(acc, src, scalar, c, len);
+            break;
+        default:
+            elt_apply_row<V, EltMax>(acc, src, scalar, c, len);
+            break;
+    }
+}
+
+template <typename V>
+void lstm_cell_kernel(const X86LstmCellArgs& args) {
+    typedef typename V::vec vec;
+    vec (*gate_act)(vec) = rnn_act<V>(args.gate_act);
+    vec (*cell_act)(vec) = rnn_act<V>(args.cell_act);
+    vec (*candi_act)(vec) = rnn_act<V>(args.candi_act);
+    const int hidden = args.hidden;
+    const float* b_i = args.bias;
+    const float* b_f = args.bias + hidden;
+    const float* b_c = args.bias + 2 * hidden;
+    const float* b_o = args.bias + 3 * hidden;
+    const bool peephole = args.peephole != nullptr;
+    const float* w_ci = args.peephole;
+    const float* w_cf = peephole ? args.peephole + hidden : nullptr;
+    const float* w_co = peephole ? args.peephole + 2 * hidden : nullptr;
+
+    for (int row = args.row_start; row < args.row_end; ++row) {
+        const float* w_x_i = args.wx + (size_t)row * 4 * hidden;
+        const float* w_x_f = w_x_i + hidden;
+        const float* w_x_c = w_x_i + 2 * hidden;
+        const float* w_x_o = w_x_i + 3 * hidden;
+        float* hout = args.hout + (size_t)(row - args.row_start) * hidden;
+        float* cell = args.cell + (size_t)(row - args.row_start) * hidden;
+
+        for (int j = 0; j < hidden; j += V::width) {
+            vec gate_i = V::add(V::load(w_x_i + j), V::load(b_i + j));
+            vec gate_o = V::add(V::load(w_x_o + j), V::load(b_o + j));
+            vec gate_c_s = cell_act(V::add(V::load(w_x_c + j), V::load(b_c + j)));
+            vec gate_c;
+            if (args.first) {
+                gate_c = V::mul(gate_act(gate_i), gate_c_s);
+            } else {
+                vec c_1 = V::load(cell + j);
+                vec gate_f = V::add(V::load(w_x_f + j), V::load(b_f + j));
+                if (peephole) {
+                    gate_i = V::add(gate_i, V::mul(V::load(w_ci + j), c_1));
+                    gate_f = V::add(gate_f, V::mul(V::load(w_cf + j), c_1));
+                }
+                gate_c = V::add(V::mul(gate_act(gate_f), c_1), V::mul(gate_act(gate_i), gate_c_s));
+            }
+            if (peephole) {
+                gate_o = V::add(gate_o, V::mul(gate_c, V::load(w_co + j)));
+            }
+            V::store(cell + j, gate_c);
+            V::store(hout + j, V::mul(gate_act(gate_o), candi_act(gate_c)));
+        }
+    }
+}
+
+template <typename V>
+void gru_reset_kernel(const X86GruCellArgs& args) {
+    typedef typename V::vec vec;
+    vec (*gate_act)(vec) = rnn_act<V>(args.gate_act);
+    const int hidden = args.hidden;
+    const float* b_r = args.bias + hidden;
+
+    for (int row = args.row_start; row < args.row_end; ++row) {
+        const size_t offset = (size_t)(row - args.row_start);
+        const float* w_x_r = args.wx + (size_t)row * 3 * hidden + hidden;
+        const float* w_h_r = args.wh + offset * 2 * hidden;
+        const float* hin = args.hin + offset * hidden;
+        float* hout = args.hout + offset * hidden;
+
+        for (int j = 0; j < hidden; j += V::width) {
+            vec r = gate_act(V::add(V::add(V::load(w_x_r + j), V::load(w_h_r + j)), V::load(b_r + j)));
+            V::store(hout + j, V::mul(r, V::load(hin + j)));
+        }
+    }
+}
+
+template <typename V>
+void gru_update_kernel(const X86GruCellArgs& args) {
+    typedef typename V::vec vec;
+    vec (*gate_act)(vec) = rnn_act<V>(args.gate_act);
+    vec (*hid_act)(vec) = rnn_act<V>(args.hid_act);
+    const int hidden = args.hidden;
+    const float* b_o = args.bias;
+    const float* b_z = args.bias + 2 * hidden;
+    const vec one = V::set1(1.f);
+
+    for (int row = args.row_start; row < args.row_end; ++row) {
+        const size_t offset = (size_t)(row - args.row_start);
+        const float* w_x_o = args.wx + (size_t)row * 3 * hidden;
+        const float* w_x_z = w_x_o + 2 * hidden;
+        const float* w_h_z = args.wh + offset * 2 * hidden + hidden;
+        const float* w_h_o = args.whr + offset * hidden;
+        const float* hin = args.hin + offset * hidden;
+        float* hout = args.hout + offset * hidden;
+
+        for (int j = 0; j < hidden; j += V::width) {
+            vec z = gate_act(V::add(V::add(V::load(w_x_z + j), V::load(w_h_z + j)), V::load(b_z + j)));
+            vec h = hid_act(V::add(V::add(V::load(w_x_o + j), V::load(w_h_o + j)), V::load(b_o + j)));
+            V::store(hout + j, V::add(V::mul(V::sub(one, z), V::load(hin + j)), V::mul(z, h)));
+        }
+    }
+}
+
+/// max of a[j] + b[j] over j < num, the first index wins ties
+template <typename V>
+inline float max_sum(const float* a, const float* b, int num, int& arg) {
+    float buf[V::width];
+    float max_score = -std::numeric_limits<float>::max();
+    arg = 0;
+    for (int j = 0; j < num; j += V::width) {
+        V::store(buf, V::add(V::load(a + j), V::load(b + j)));
+        const int valid = num - j < V::width ? num - j : V::width;
+        for (int m = 0; m < valid; ++m) {
+            if (buf[m] > max_score) {
+                max_score = buf[m];
+                arg = j + m;
+            }
+        }
+    }
+    return max_score;
+}
+
+template <typename V>
+void crf_viterbi_kernel(float* path, const float* x, const float* w, float* alpha, int* track,
+                        int seq_len, int tag_num, int aligned_tag) {
+    const int state_trans_base_idx = 2;
+    for (int j = 0; j < aligned_tag; j += V::width) {
+        V::store(alpha + j, V::add(V::load(w + j), V::load(x + j)));
+    }
+    for (int k = 1; k < seq_len; ++k) {
+        const float* alpha_prev = alpha + (size_t)(k - 1) * aligned_tag;
+        for (int i = 0; i < tag_num; ++i) {
+            int max_j = 0;
+            float max_score = max_sum<V>(alpha_prev, w + (size_t)(i + state_trans_base_idx) * aligned_tag,
+                                         tag_num, max_j);
+            alpha[(size_t)k * aligned_tag + i] = max_score + x[(size_t)k * aligned_tag + i];
+            track[(size_t)k * tag_num + i] = max_j;
+        }
+    }
+    int max_i = 0;
+    max_sum<V>(alpha + (size_t)(seq_len - 1) * aligned_tag, w + aligned_tag, tag_num, max_i);
+    path[seq_len - 1] = max_i;
+    for (int k = seq_len - 1; k >= 1; --k) {
+        path[k - 1] = max_i = track[(size_t)k * tag_num + max_i];
+    }
+}
+
+///< vectors whose max is taken before the running sum is rescaled, so that costs one exp per block
+static const int kSoftmaxBlock = 8;
+
+template <typename V>
+void softmax_stat_kernel(const float* src, int n, float& max, float& sum) {
+    typedef typename V::vec vec;
+    const int vec_len = n / V::width * V::width;
+    const int block = kSoftmaxBlock * V::width;
+    max = src[0];
+    sum = 0.f;
+    if (vec_len > 0) {
+        vec m = V::load(src);
+        vec s = V::set1(0.f);
+        for (int i = 0; i < vec_len; i += block) {
+            const int end = i + block < vec_len ? i + block : vec_len;
+            vec m_new = m;
+            for (int j = i; j < end; j += V::width) {
+                m_new = V::max(m_new, V::load(src + j));
+            }
+            s = V::mul(s, V::exp(V::sub(m, m_new)));
+            for (int j = i; j < end; j += V::width) {
+                s = V::add(s, V::exp(V::sub(V::load(src + j), m_new)));
+            }
+            m = m_new;
+        }
+        float lane_max[V::width];
+        float lane_sum[V::width];
+        V::store(lane_max, m);
+        V::store(lane_sum, s);
+        max = lane_max[0];
+        for (int l = 1; l < V::width; ++l) {
+            max = lane_max[l] > max ? lane_max[l] : max;
+        }
+        for (int l = 0; l < V::width; ++l) {
+            sum += lane_sum[l] * expf(lane_max[l] - max);
+        }
+    }
+    for (int i = vec_len; i < n; ++i) {
+        if (src[i] > max) {
+            sum = sum * expf(max - src[i]) + 1.f;
+            max = src[i];
+        } else {
+            sum += expf(src[i] - max);
+        }
+    }
+}
+
+template <typename V>
+int softmax_norm_block(const float* src, float* dst, int n, float max, float scale) {
+    const int vec_len = n / V::width * V::width;
+    const typename V::vec v_max = V::set1(max);
+    const typename V::vec v_scale = V::set1(scale);
+    for (int i = 0; i < vec_len; i += V::width) {
+        V::store(dst + i, V::mul(V::exp(V::sub(V::load(src + i), v_max)), v_scale));
+    }
+    return vec_len;
+}
+
+template <typename V>
+void softmax_norm_kernel(const float* src, float* dst, int n, float max, float scale) {
+    int i = softmax_norm_block<V>(src, dst, n, max, scale);
+    softmax_norm_block<VecScalar>(src + i, dst + i, n - i, max, scale);
+}
+
+/// softmax of V::width adjacent columns, the running max and sum live in one vector each
+template <typename V>
+void softmax_cols(const float* src, float* dst, int n, int stride) {
+    typedef typename V::vec vec;
+    vec m = V::load(src);
+    vec s = V::set1(0.f);
+    for (int k = 0; k < n; k += kSoftmaxBlock) {
+        const int end = k + kSoftmaxBlock < n ? k + kSoftmaxBlock : n;
+        vec m_new = m;
+        for (int t = k; t < end; ++t) {
+            m_new = V::max(m_new, V::load(src + (size_t)t * stride));
+        }
+        s = V::mul(s, V::exp(V::sub(m, m_new)));
+        for (int t = k; t < end; ++t) {
+            s = V::add(s, V::exp(V::sub(V::load(src + (size_t)t * stride), m_new)));
+        }
+        m = m_new;
+    }
+    const vec scale = V::div(V::set1(1.f), s);
+    for (int t = 0; t < n; ++t) {
+        const size_t offset = (size_t)t * stride;
+        V::store(dst + offset, V::mul(V::exp(V::sub(V::load(src + offset), m)), scale));
+    }
+}
+
+template <typename V>
+void softmax_strided_kernel(const float* src, float* dst, int n, int stride, int width) {
+    int j = 0;
+    for (; j + V::width <= width; j += V::width) {
+        softmax_cols<V>(src + j, dst + j, n, stride);
+    }
+    for (; j < width; ++j) {
+        softmax_cols<VecScalar>(src + j, dst + j, n, stride);
+    }
+}
+
+/// square tile of size x size floats transposed in registers, one float without simd
+template <typename V>
+struct TransposeTile {
+    static const int size = 1;
+    static inline void run(const float* src, int src_ld, float* dst, int dst_ld, float scale, float shift) {
+        *dst = *src * scale + shift;
+    }
+};
+
+#if defined(__SSE4_2__)
+template <>
+struct TransposeTile<VecSse42> {
+    static const int size = 4;
+    static inline void run(const float* src, int src_ld, float* dst, int dst_ld, float scale, float shift) {
+        __m128 r0 = _mm_loadu_ps(src);
+        __m128 r1 = _mm_loadu_ps(src + src_ld);
+        __m128 r2 = _mm_loadu_ps(src + 2 * src_ld);
+        __m128 r3 = _mm_loadu_ps(src + 3 * src_ld);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        const __m128 v_scale = _mm_set1_ps(scale);
+        const __m128 v_shift = _mm_set1_ps(shift);
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(r0, v_scale), v_shift));
+        _mm_storeu_ps(dst + dst_ld, _mm_add_ps(_mm_mul_ps(r1, v_scale), v_shift));
+        _mm_storeu_ps(dst + 2 * dst_ld, _mm_add_ps(_mm_mul_ps(r2, v_scale), v_shift));
+        _mm_storeu_ps(dst + 3 * dst_ld, _mm_add_ps(_mm_mul_ps(r3, v_scale), v_shift));
+    }
+};
+#endif
+
+#if defined(__AVX2__) and defined(__FMA__)
+/// 8x8 in three rounds of unpack, shuffle and lane permute, all in registers
+inline void transpose_8x8_avx(const float* src, int src_ld, float* dst, int dst_ld, float scale, float shift) {
+    const __m256 r0 = _mm256_loadu_ps(src);
+    const __m256 r1 = _mm256_loadu_ps(src + src_ld);
+    const __m256 r2 = _mm256_loadu_ps(src + 2 * src_ld);
+    const __m256 r3 = _mm256_loadu_ps(src + 3 * src_ld);
+    const __m256 r4 = _mm256_loadu_ps(src + 4 * src_ld);
+    const __m256 r5 = _mm256_loadu_ps(src + 5 * src_ld);
+    const __m256 r6 = _mm256_loadu_ps(src + 6 * src_ld);
+    const __m256 r7 = _mm256_loadu_ps(src + 7 * src_ld);
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 v_scale = _mm256_set1_ps(scale);
+    const __m256 v_shift = _mm256_set1_ps(shift);
+    _mm256_storeu_ps(dst, _mm256_fmadd_ps(_mm256_permute2f128_ps(s0, s4, 0x20), v_scale, v_shift));
+    _mm256_storeu_ps(dst + dst_ld, _mm256_fmadd_ps(_mm256_permute2f128_ps(s1, s5, 0x20), v_scale, v_shift));
+    _mm256_storeu_ps(dst + 2 * dst_ld, _mm256_fmadd_ps(_mm256_permute2f128_ps(s2, s6, 0x20), v_scale, v_shift));
+    _mm256_storeu_ps(dst + 3 * dst_ld, _mm256_fmadd_ps(_mm256_permute2f128_ps(s3, s7, 0x20), v_scale, v_shift));
+    _mm256_storeu_ps(dst + 4 * dst_ld, _mm256_fmadd_ps(_mm256_permute2f128_ps(s0, s4, 0x31), v_scale, v_shift));
+    _mm256_storeu_ps(dst + 5 * dst_ld, _mm256_fmadd_ps(_mm256_permute2f128_ps(s1, s5, 0x31), v_scale, v_shift));
+    _mm256_storeu_ps(dst + 6 * dst_ld, _mm256_fmadd_ps(_mm256_permute2f128_ps(s2, s6, 0x31), v_scale, v_shift));
+    _mm256_storeu_ps(dst + 7 * dst_ld, _mm256_fmadd_ps(_mm256_permute2f128_ps(s3, s7, 0x31), v_scale, v_shift));
+}
+
+template <>
+struct TransposeTile<VecAvx2> {
+    static const int size = 8;
+    static inline void run(const float* src, int src_ld, float* dst, int dst_ld, float scale, float shift) {
+        transpose_8x8_avx(src, src_ld, dst, dst_ld, scale, shift);
+    }
+};
+#endif
+
+#if defined(__AVX512F__) and defined(__AVX2__) and defined(__FMA__)
+/// a 16x16 tile spills zmm registers for little gain, avx512 keeps the 8x8 one of avx
+template <>
+struct TransposeTile<VecAvx512> {
+    static const int size = 8;
+    static inline void run(const float* src, int src_ld, float* dst, int dst_ld, float scale, float shift) {
+        transpose_8x8_avx(src, src_ld, dst, dst_ld, scale, shift);
+    }
+};
+#endif
+
+template <typename V>
+void transpose_kernel(const float* src, int src_ld, float* dst, int dst_ld,
+                      int rows, int cols, float scale, float shift) {
+    const int size = TransposeTile<V>::size;
+    const int tile_rows = rows / size * size;
+    const int tile_cols = cols / size * size;
+    for (int r = 0; r < tile_rows; r += size) {
+        for (int c = 0; c < tile_cols; c += size) {
+            TransposeTile<V>::run(src + (size_t)r * src_ld + c, src_ld,
+                                  dst + (size_t)c * dst_ld + r, dst_ld, scale, shift);
+        }
+    }
+    for (int r = 0; r < rows; ++r) {
+        const int c_start = r < tile_rows ? tile_cols : 0;
+        for (int c = c_start; c < cols; ++c) {
+            dst[(size_t)c * dst_ld + r] = src[(size_t)r * src_ld + c] * scale + shift;
+        }
+    }
+}
+
+template <typename V>
+int bbox_decode_center_block(const float* loc, int loc_ld, const float* prior, int prior_ld,
+                             float* bbox, int bbox_ld, int n) {
+    typedef typename V::vec vec;
+    const int vec_len = n / V::width * V::width;
+    for (int i = 0; i < vec_len; i += V::width) {
+        const vec cx = V::add(V::mul(V::load(loc + i), V::load(prior + 2 * prior_ld + i)),
+                              V::load(prior + i));
+        const vec cy = V::add(V::mul(V::load(loc + loc_ld + i), V::load(prior + 3 * prior_ld + i)),
+                              V::load(prior + prior_ld + i));
+        const vec half_w = V::mul(V::exp(V::mul(V::load(loc + 2 * loc_ld + i),
+                                                V::load(prior + 4 * prior_ld + i))),
+                                  V::load(prior + 6 * prior_ld + i));
+        const vec half_h = V::mul(V::exp(V::mul(V::load(loc + 3 * loc_ld + i),
+                                                V::load(prior + 5 * prior_ld + i))),
+                                  V::load(prior + 7 * prior_ld + i));
+        V::store(bbox + i, V::sub(cx, half_w));
+        V::store(bbox + bbox_ld + i, V::sub(cy, half_h));
+        V::store(bbox + 2 * bbox_ld + i, V::add(cx, half_w));
+        V::store(bbox + 3 * bbox_ld + i, V::add(cy, half_h));
+    }
+    return vec_len;
+}
+
+template <typename V>
+void bbox_decode_center_kernel(const float* loc, int loc_ld, const float* prior, int prior_ld,
+                               float* bbox, int bbox_ld, int n) {
+    int i = bbox_decode_center_block<V>(loc, loc_ld, prior, prior_ld, bbox, bbox_ld, n);
+    bbox_decode_center_block<VecScalar>(loc + i, loc_ld, prior + i, prior_ld, bbox + i, bbox_ld, n - i);
+}
+
+/// iou of the box against kept boxes [begin, end), V::width of them at a time
+template <typename V>
+bool nms_overlap_range(const float* box, float area, const float* kept, int ld,
+                       int begin, int end, float thresh) {
+    typedef typename V::vec vec;
+    const vec xmin = V::set1(box[0]);
+    const vec ymin = V::set1(box[1]);
+    const vec xmax = V::set1(box[2]);
+    const vec ymax = V::set1(box[3]);
+    const vec v_area = V::set1(area);
+    const vec v_thresh = V::set1(thresh);
+    const vec zero = V::set1(0.f);
+    for (int i = begin; i + V::width <= end; i += V::width) {
+        const vec w = V::sub(V::min(xmax, V::load(kept + 2 * ld + i)), V::max(xmin, V::load(kept + i)));
+        const vec h = V::sub(V::min(ymax, V::load(kept + 3 * ld + i)),
+                             V::max(ymin, V::load(kept + ld + i)));
+        const vec inter = V::mul(V::max(w, zero), V::max(h, zero));
+        const vec iou = V::div(inter, V::sub(V::add(v_area, V::load(kept + 4 * ld + i)), inter));
+        if (V::any_gt(iou, v_thresh)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename V>
+bool nms_overlap_kernel(const float* box, float area, const float* kept, int ld, int n, float thresh) {
+    const int vec_len = n / V::width * V::width;
+    return nms_overlap_range<V>(box, area, kept, ld, 0, vec_len, thresh)
+           || nms_overlap_range<VecScalar>(box, area, kept, ld, vec_len, n, thresh);
+}
+
+/// sums of (x - shift) and of its square, shifting by a sample of the row keeps the variance exact
+template <typename V>
+int layer_norm_stat_block(const float* src, int n, float shift, float& sum, float& sq_sum) {
+    typedef typename V::vec vec;
+    const int vec_len = n / V::width * V::width;
+    const vec v_shift = V::set1(shift);
+    vec s = V::set1(0.f);
+    vec q = V::set1(0.f);
+    for (int i = 0; i < vec_len; i += V::width) {
+        const vec d = V::sub(V::load(src + i), v_shift);
+        s = V::add(s, d);
+        q = V::add(q, V::mul(d, d));
+    }
+    float lane_sum[V::width];
+    float lane_sq_sum[V::width];
+    V::store(lane_sum, s);
+    V::store(lane_sq_sum, q);
+    for (int l = 0; l < V::width; ++l) {
+        sum += lane_sum[l];
+        sq_sum += lane_sq_sum[l];
+    }
+    return vec_len;
+}
+
+template <typename V>
+int layer_norm_apply_block(const float* src, float* dst, int n, float mean, float inv_std,
+                           const float* scale, const float* bias) {
+    typedef typename V::vec vec;
+    const int vec_len = n / V::width * V::width;
+    const vec v_mean = V::set1(mean);
+    const vec v_inv_std = V::set1(inv_std);
+    for (int i = 0; i < vec_len; i += V::width) {
+        vec x = V::mul(V::sub(V::load(src + i), v_mean), v_inv_std);
+        if (scale) {
+            x = V::mul(x, V::load(scale + i));
+        }
+        if (bias) {
+            x = V::add(x, V::load(bias + i));
+        }
+        V::store(dst + i, x);
+    }
+    return vec_len;
+}
+
+template <typename V>
+void mean_var_kernel(const float* src, int n, float& mean, float& var) {
+    const float shift = src[0];
+    float sum = 0.f;
+    float sq_sum = 0.f;
+    int i = layer_norm_stat_block<V>(src, n, shift, sum, sq_sum);
+    layer_norm_stat_block<VecScalar>(src + i, n - i, shift, sum, sq_sum);
+    const float mean_shifted = sum / n;
+    var = sq_sum / n - mean_shifted * mean_shifted;
+    var = var > 0.f ? var : 0.f;
+    mean = shift + mean_shifted;
+}
+
+template <typename V>
+void layer_norm_kernel(const float* src, float* dst, int n, const float* scale, const float* bias, float eps) {
+    float mean = 0.f;
+    float var = 0.f;
+    mean_var_kernel<V>(src, n, mean, var);
+    const float inv_std = 1.f / (sqrtf(var) + eps);
+    int i = layer_norm_apply_block<V>(src, dst, n, mean, inv_std, scale, bias);
+    layer_norm_apply_block<VecScalar>(src + i, dst + i, n - i, mean, inv_std,
+                                      scale ? scale + i : nullptr, bias ? bias + i : nullptr);
+}
+
+/// pow(mid, -beta), the usual betas take square roots instead of a pow per lane
+template <typename V>
+inline typename V::vec lrn_pow(typename V::vec mid, float beta) {
+    typedef typename V::vec vec;
+    const vec one = V::set1(1.f);
+    if (beta == 0.75f) {
+        const vec s = V::sqrt(mid);
+        return V::div(one, V::mul(s, V::sqrt(s)));
+    }
+    if (beta == 0.5f) {
+        return V::div(one, V::sqrt(mid));
+    }
+    if (beta == 1.f) {
+        return V::div(one, mid);
+    }
+    float lanes[V::width];
+    V::store(lanes, mid);
+    for (int l = 0; l < V::width; ++l) {
+        lanes[l] = powf(lanes[l], -beta);
+    }
+    return V::load(lanes);
+}
+
+/// n pixels of every channel, n a multiple of the width, the window slides along the channels
+template <typename V>
+void lrn_across_range(const float* src, float* dst, int n, int channels, size_t stride, int size,
+                      float alpha, float beta, float k, float* accum) {
+    typedef typename V::vec vec;
+    const int pre_pad = (size - 1) / 2;
+    const int post_pad = size - pre_pad - 1;
+    const vec v_alpha = V::set1(alpha);
+    const vec v_k = V::set1(k);
+    for (int i = 0; i < n; i += V::width) {
+        V::store(accum + i, V::set1(0.f));
+    }
+    for (int index = 0; index < channels + post_pad; ++index) {
+        if (index < channels) {
+            const float* in = src + index * stride;
+            for (int i = 0; i < n; i += V::width) {
+                const vec x = V::load(in + i);
+                V::store(accum + i, V::add(V::load(accum + i), V::mul(x, x)));
+            }
+        }
+        if (index >= size) {
+            const float* in = src + (index - size) * stride;
+            for (int i = 0; i < n; i += V::width) {
+                const vec x = V::load(in + i);
+                V::store(accum + i, V::sub(V::load(accum + i), V::mul(x, x)));
+            }
+        }
+        if (index >= post_pad) {
+            const size_t offset = (index - post_pad) * stride;
+            for (int i = 0; i < n; i += V::width) {
+                const vec mid = V::add(v_k, V::mul(v_alpha, V::load(accum + i)));
+                V::store(dst + offset + i, V::mul(V::load(src + offset + i), lrn_pow<V>(mid, beta)));
+            }
+        }
+    }
+}
+
+template <typename V>
+void lrn_across_kernel(const float* src, float* dst, int n, int channels, size_t stride, int size,
+                       float alpha, float beta, float k, float* accum) {
+    const int vec_len = n / V::width * V::width;
+    lrn_across_range<V>(src, dst, vec_len, channels, stride, size, alpha, beta, k, accum);
+    lrn_across_range<VecScalar>(src + vec_len, dst + vec_len, n - vec_len, channels, stride, size,
+                                alpha, beta, k, accum + vec_len);
+}
+
+/// four accumulators to hide the latency of the adds, returns the floats it reduced
+template <typename V, typename Op>
+int reduce_block(const float* src, int n, float& acc) {
+    typedef typename V::vec vec;
+    const int step = 4 * V::width;
+    const int vec_len = n / step * step;
+    if (vec_len == 0) {
+        return 0;
+    }
+    vec a0 = V::load(src);
+    vec a1 = V::load(src + V::width);
+    vec a2 = V::load(src + 2 * V::width);
+    vec a3 = V::load(src + 3 * V::width);
+    for (int i = step; i < vec_len; i += step) {
+        a0 = Op::template apply<V>(a0, V::load(src + i));
+        a1 = Op::template apply<V>(a1, V::load(src + i + V::width));
+        a2 = Op::template apply<V>(a2, V::load(src + i + 2 * V::width));
+        a3 = Op::template apply<V>(a3, V::load(src + i + 3 * V::width));
+    }
+    float lanes[V::width];
+    V::store(lanes, Op::template apply<V>(Op::template apply<V>(a0, a1), Op::template apply<V>(a2, a3)));
+    for (int l = 0; l < V::width; ++l) {
+        acc = Op::template apply<VecScalar>(acc, lanes[l]);
+    }
+    return vec_len;
+}
+
+template <typename V, typename Op>
+float reduce_row(const float* src, int n, float acc) {
+    int i = reduce_block<V, Op>(src, n, acc);
+    for (; i < n; ++i) {
+        acc = Op::template apply<VecScalar>(acc, src[i]);
+    }
+    return acc;
+}
+
+template <typename V>
+float reduce_kernel(EltwiseType op, const float* src, int n) {
+    if (op == Eltwise_max) {
+        return reduce_row<V, EltMax>(src, n, -std::numeric_limits<float>::max());
+    }
+    return reduce_row<V, EltSum>(src, n, 0.f);
+}
+
+/// a vector of windows is stored after its last read, so the next one still sees the input
+template <typename V, typename Op>
+int pool_window_block(float* row, int n, int window) {
+    const int vec_len = n / V::width * V::width;
+    for (int i = 0; i < vec_len; i += V::width) {
+        typename V::vec acc = V::load(row + i);
+        for (int k = 1; k < window; ++k) {
+            acc = Op::template apply<V>(acc, V::load(row + i + k));
+        }
+        V::store(row + i, acc);
+    }
+    return vec_len;
+}
+
+template <typename V>
+void pool_window_kernel(EltwiseType op, float* row, int n, int window) {
+    if (op == Eltwise_max) {
+        int i = pool_window_block<V, EltMax>(row, n, window);
+        pool_window_block<VecScalar, EltMax>(row + i, n - i, window);
+    } else {
+        int i = pool_window_block<V, EltSum>(row, n, window);
+        pool_window_block<VecScalar, EltSum>(row + i, n - i, window);
+    }
+}
+
+template <typename V>
+X86Kernels make_x86_kernels(X86Isa isa) {
+    X86Kernels kernels;
+    kernels.isa = isa;
+    kernels.width = V::width;
+    kernels.act = act_kernel<V>;
+    kernels.elt_scale = elt_scale_kernel<V>;
+    kernels.elt_apply = elt_apply_kernel<V>;
+    kernels.lstm_cell = lstm_cell_kernel<V>;
+    kernels.gru_reset = gru_reset_kernel<V>;
+    kernels.gru_update = gru_update_kernel<V>;
+    kernels.crf_viterbi = crf_viterbi_kernel<V>;
+    kernels.softmax_stat = softmax_stat_kernel<V>;
+    kernels.softmax_norm = softmax_norm_kernel<V>;
+    kernels.softmax_strided = softmax_strided_kernel<V>;
+    kernels.transpose = transpose_kernel<V>;
+    kernels.bbox_decode_center = bbox_decode_center_kernel<V>;
+    kernels.nms_overlap = nms_overlap_kernel<V>;
+    kernels.layer_norm = layer_norm_kernel<V>;
+    kernels.mean_var = mean_var_kernel<V>;
+    kernels.lrn_across = lrn_across_kernel<V>;
+    kernels.reduce = reduce_kernel<V>;
+    kernels.pool_window = pool_window_kernel<V>;
+    return kernels;
+}
+
+} // namespace
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_X86_KERNELS_IMPL_H
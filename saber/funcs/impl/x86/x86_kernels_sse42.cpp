@@ -0,0 +1,20 @@
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#if defined(__SSE4_2__)
+#include "saber/funcs/impl/x86/x86_kernels_impl.h"
+#endif
+
+namespace anakin {
+namespace saber {
+
+// built with -msse4.2, see saber/CMakeLists.txt
+const X86Kernels* x86_kernels_sse42() {
+#if defined(__SSE4_2__)
+    static const X86Kernels kernels = make_x86_kernels<VecSse42>(X86_ISA_SSE42);
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace saber
+} // namespace anakin
@@ -0,0 +1,193 @@
+#include "saber/funcs/impl/x86/x86_permute.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <numeric>
+
+namespace anakin {
+namespace saber {
+
+///< rows and columns of one transpose block, its source and destination both stay in L1 cache
+static const int kPermuteBlock = 64;
+///< floats of one thread task when the permute is a plain copy
+static const int kPermuteCopyBlock = 16 * 1024;
+
+static inline void copy_affine(const float* src, float* dst, size_t len, float scale, float shift) {
+    if (scale == 1.f && shift == 0.f) {
+        memcpy(dst, src, sizeof(float) * len);
+        return;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        dst[i] = src[i] * scale + shift;
+    }
+}
+
+/**
+ * \brief drops the dims of size 1 and merges the runs of src dims which the order keeps adjacent.
+ *  dims are the merged dims in src order, dst dim i is dims[perm[i]].
+ */
+static void merge_dims(const std::vector<int>& src_dims, const std::vector<int>& order,
+                       std::vector<int>& dims, std::vector<int>& perm) {
+    std::vector<int> squeezed(src_dims.size(), -1);
+    std::vector<int> squeezed_dims;
+    for (int d = 0; d < src_dims.size(); ++d) {
+        if (src_dims[d] != 1) {
+            squeezed[d] = squeezed_dims.size();
+            squeezed_dims.push_back(src_dims[d]);
+        }
+    }
+    // runs [first, last] of squeezed dims, in dst order
+    std::vector<std::pair<int, int> > runs;
+    for (int d : order) {
+        const int s = squeezed[d];
+        if (s < 0) {
+            continue;
+        }
+        if (!runs.empty() && runs.back().second + 1 == s) {
+            runs.back().second = s;
+        } else {
+            runs.push_back(std::make_pair(s, s));
+        }
+    }
+    std::vector<int> by_src(runs.size());
+    std::iota(by_src.begin(), by_src.end(), 0);
+    std::sort(by_src.begin(), by_src.end(), [&runs](int a, int b) {
+        return runs[a].first < runs[b].first;
+    });
+    dims.assign(runs.size(), 1);
+    perm.assign(runs.size(), 0);
+    for (int k = 0; k < by_src.size(); ++k) {
+        const std::pair<int, int>& run = runs[by_src[k]];
+        for (int s = run.first; s <= run.second; ++s) {
+            dims[k] *= squeezed_dims[s];
+        }
+        perm[by_src[k]] = k;
+    }
+}
+
+/// [batch, rows, cols] -> [batch, cols, rows], in square blocks of register tiles
+static void batched_transpose(const X86Kernels& kernels, const float* src, float* dst,
+                              int batch, int rows, int cols, float scale, float shift) {
+    const int row_blocks = utils::div_up(rows, kPermuteBlock);
+    const int col_blocks = utils::div_up(cols, kPermuteBlock);
+    const int tasks = batch * row_blocks * col_blocks;
+    #pragma omp parallel for schedule(static) if (tasks > 1)
+    for (int t = 0; t < tasks; ++t) {
+        const int b = t / (row_blocks * col_blocks);
+        const int r = (t / col_blocks) % row_blocks * kPermuteBlock;
+        const int c = t % col_blocks * kPermuteBlock;
+        const size_t offset = (size_t)b * rows * cols;
+        kernels.transpose(src + offset + (size_t)r * cols + c, cols,
+                          dst + offset + (size_t)c * rows + r, rows,
+                          std::min(kPermuteBlock, rows - r), std::min(kPermuteBlock, cols - c),
+                          scale, shift);
+    }
+}
+
+/// [batch, rows, cols, inner] -> [batch, cols, rows, inner], rows of inner floats are copied whole
+static void batched_transpose_rows(const float* src, float* dst, int batch, int rows, int cols,
+                                   int inner, float scale, float shift) {
+    const int tasks = batch * cols * rows;
+    #pragma omp parallel for schedule(static) if (tasks > 1)
+    for (int t = 0; t < tasks; ++t) {
+        const int b = t / (cols * rows);
+        const int c = (t / rows) % cols;
+        const int r = t % rows;
+        const float* src_row = src + (((size_t)b * rows + r) * cols + c) * inner;
+        copy_affine(src_row, dst + (size_t)t * inner, inner, scale, shift);
+    }
+}
+
+/// any other order, one dst row per task with its src walked by stride
+static void strided_gather(const float* src, float* dst, const std::vector<int>& dims,
+                           const std::vector<int>& perm, float scale, float shift) {
+    const int n = dims.size();
+    std::vector<size_t> src_strides(n);
+    size_t stride = 1;
+    for (int k = n - 1; k >= 0; --k) {
+        src_strides[k] = stride;
+        stride *= dims[k];
+    }
+    std::vector<int> dst_dims(n);
+    std::vector<size_t> steps(n);
+    for (int i = 0; i < n; ++i) {
+        dst_dims[i] = dims[perm[i]];
+        steps[i] = src_strides[perm[i]];
+    }
+    const int inner = dst_dims[n - 1];
+    const size_t inner_step = steps[n - 1];
+    const int rows = stride / inner;
+    #pragma omp parallel for schedule(static) if (rows > 1)
+    for (int row = 0; row < rows; ++row) {
+        size_t pos = 0;
+        int rest = row;
+        for (int i = n - 2; i >= 0; --i) {
+            pos += (rest % dst_dims[i]) * steps[i];
+            rest /= dst_dims[i];
+        }
+        const float* src_row = src + pos;
+        float* dst_row = dst + (size_t)row * inner;
+        for (int j = 0; j < inner; ++j) {
+            dst_row[j] = src_row[j * inner_step] * scale + shift;
+        }
+    }
+}
+
+void x86_permute_forward(const float* src, const std::vector<int>& src_dims,
+                         float* dst, const std::vector<int>& order,
+                         const X86PermuteEpilogue& epilogue) {
+    CHECK_EQ(order.size(), src_dims.size()) << "permute order must have one entry per dim";
+    size_t count = 1;
+    for (int d : src_dims) {
+        count *= d;
+    }
+    if (count == 0) {
+        return;
+    }
+    std::vector<int> dims;
+    std::vector<int> perm;
+    merge_dims(src_dims, order, dims, perm);
+    const int n = dims.size();
+    const float scale = epilogue.scale;
+    const float shift = epilogue.shift;
+
+    if (n <= 1) {
+        const int tasks = utils::div_up(count, (size_t)kPermuteCopyBlock);
+        #pragma omp parallel for schedule(static) if (tasks > 1)
+        for (int t = 0; t < tasks; ++t) {
+            const size_t offset = (size_t)t * kPermuteCopyBlock;
+            copy_affine(src + offset, dst + offset, std::min((size_t)kPermuteCopyBlock, count - offset),
+                        scale, shift);
+        }
+    } else {
+        // after merging, a leading dim in place is a batch and a trailing one is the inner row,
+        // what is left in between is either a swap of two dims or a general order
+        const int lead = perm[0] == 0 ? 1 : 0;
+        const int tail = perm[n - 1] == n - 1 ? 1 : 0;
+        if (n - lead - tail == 2 && perm[lead] == lead + 1 && perm[lead + 1] == lead) {
+            const int batch = lead ? dims[0] : 1;
+            const int rows = dims[lead];
+            const int cols = dims[lead + 1];
+            if (tail) {
+                batched_transpose_rows(src, dst, batch, rows, cols, dims[n - 1], scale, shift);
+            } else {
+                batched_transpose(x86_kernels(), src, dst, batch, rows, cols, scale, shift);
+            }
+        } else {
+            strided_gather(src, dst, dims, perm, scale, shift);
+        }
+    }
+
+    if (epilogue.power != 1.f) {
+        const float power = epilogue.power;
+        #pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = powf(dst[i], power);
+        }
+    }
+}
+
+} // namespace saber
+} // namespace anakin
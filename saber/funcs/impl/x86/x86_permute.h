@@ -0,0 +1,48 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_X86_PERMUTE_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_X86_PERMUTE_H
+
+#include <vector>
+#include "saber/saber_types.h"
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief epilogue of the x86 permute engine, dst = pow(src * scale + shift, power),
+ *  the power op the permute is fused with.
+ */
+struct X86PermuteEpilogue {
+    float scale{1.f};
+    float shift{0.f};
+    float power{1.f};
+};
+
+/**
+ * \brief permute of a dense tensor, dim i of dst is dim order[i] of src.
+ *  Dims the order keeps adjacent are merged first, so NCHW<->NHWC, the transpose of the
+ *  last two dims and channel shuffle all run as batched 2d transposes in cache blocks,
+ *  and only the other orders fall back to a strided gather.
+ */
+void x86_permute_forward(const float* src, const std::vector<int>& src_dims,
+                         float* dst, const std::vector<int>& order,
+                         const X86PermuteEpilogue& epilogue = X86PermuteEpilogue());
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_X86_PERMUTE_H
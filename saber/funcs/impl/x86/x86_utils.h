@@ -19,6 +19,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <immintrin.h>
 #include "core/common.h"
 #include "saber/core/tensor.h"
 #include "mkl_cblas.h"
@@ -83,6 +88,94 @@ public:
 
 };
 
+/**
+ * \brief sense reversing barrier of a fixed team, waiters spin on one atomic instead of sleeping,
+ *  for steps too short to pay the wake up of a blocking barrier. After a while of spinning
+ *  they yield, so an oversubscribed team still makes progress.
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int num = 1) : _num(num), _count(num), _sense(false) {}
+
+    /// resize the team, while nobody waits
+    void reset(int num) {
+        _num = num;
+        _count.store(num, std::memory_order_relaxed);
+    }
+
+    void wait() {
+        // the sense can't flip before this thread arrives, so it's the one of this round
+        const bool sense = !_sense.load(std::memory_order_acquire);
+        if (_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            _count.store(_num, std::memory_order_relaxed);
+            _sense.store(sense, std::memory_order_release);
+            return;
+        }
+        for (int spin = 0; _sense.load(std::memory_order_acquire) != sense; ++spin) {
+            if (spin < 4096) {
+                _mm_pause();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    int _num;
+    std::atomic<int> _count;
+    std::atomic<bool> _sense;
+};
+
+/**
+ * \brief per thread cache of layouts built from a seq offset, the last few of them.
+ *  The recurrent ops of a net run see the same seq offset, the first of them builds the
+ *  layout and the others share it.
+ */
+template <typename Layout>
+class SeqLayoutCache {
+public:
+    template <typename Builder>
+    std::shared_ptr<const Layout> get(const std::vector<int>& offset_vec, bool is_reverse,
+                                      Builder build) {
+        for (auto& entry : _entries) {
+            if (entry.layout && entry.is_reverse == is_reverse && entry.offset_vec == offset_vec) {
+                return entry.layout;
+            }
+        }
+        Entry& entry = _entries[_next];
+        _next = (_next + 1) % kEntryNum;
+        std::shared_ptr<Layout> layout = std::make_shared<Layout>();
+        build(*layout);
+        entry.offset_vec = offset_vec;
+        entry.is_reverse = is_reverse;
+        entry.layout = layout;
+        return entry.layout;
+    }
+
+private:
+    ///< both directions of a bidirectional net and a seq offset of another input
+    static const int kEntryNum = 4;
+    struct Entry {
+        std::vector<int> offset_vec;
+        bool is_reverse{false};
+        std::shared_ptr<const Layout> layout;
+    };
+    Entry _entries[kEntryNum];
+    int _next{0};
+};
+
+/**
+ * \brief sequences sorted by length, longest first, and their words laid out step by step:
+ *  the first word of every sequence, then the second of the ones still going, and so on.
+ */
+struct SeqSortedMap {
+    std::vector<int> length_index;      ///< sorted position -> batch id
+    std::vector<int> map_vec;           ///< word id -> row in the sorted layout
+    std::vector<int> emit_offset_vec;   ///< first row of every step
+    int emit_length{0};
+    bool transform{false};              ///< false when the layout is the seq offset one
+};
+
 class SeqSortedseqTranseUtil {
 public:
     SeqSortedseqTranseUtil(bool is_reverse = false, bool is_bi = false)
@@ -95,79 +188,56 @@ public:
     }
     template <typename Dtype>
     void seq_2_sorted_seq(const Dtype*  input, Dtype* output, int word_size) {
-        //        _map_vec.resize(word_sum);
-        int word_sum = _map_vec.size();
-        //        std::cout << "word_sum = " << word_sum << std::endl;
+        const std::vector<int>& map_vec = _map->map_vec;
+        int word_sum = map_vec.size();
 
         for (int ori_word_id = 0; ori_word_id < word_sum; ++ori_word_id) {
-            //can param
-            int word_start = ori_word_id * word_size;
-            int maped_id = _map_vec[ori_word_id];
-            int maped_start = maped_id * word_size;
-
-            for (int word_vec_offset = 0; word_vec_offset < word_size; ++word_vec_offset) {
-                //                std::cout<<maped_start + word_vec_offset<<" --> "<<word_start + word_vec_offset<<" , = "<<input[maped_start + word_vec_offset]<<std::endl;
-
-                output[maped_start + word_vec_offset] = input[word_start + word_vec_offset];
-
-            }
+            memcpy(output + map_vec[ori_word_id] * word_size, input + ori_word_id * word_size,
+                   word_size * sizeof(Dtype));
         }
     }
     template <typename Dtype>
     void hidden_2_sorted_hidden(const Dtype*  input, Dtype* output, int hidden_size) {
-        //        _map_vec.resize(word_sum);
-        int batch_size = _length_index.size();
-        //        std::cout << "word_sum = " << word_sum << std::endl;
+        const std::vector<int>& length_index = _map->length_index;
+        int batch_size = length_index.size();
 
-        for (int ori_word_id = 0; ori_word_id < batch_size; ++ori_word_id) {
-            //can param
-            int word_start = ori_word_id * hidden_size;
-            int maped_id = _length_index[ori_word_id];
-            int maped_start = maped_id * hidden_size;
-
-            for (int word_vec_offset = 0; word_vec_offset < hidden_size; ++word_vec_offset) {
-                //                std::cout<<maped_start + word_vec_offset<<" --> "<<word_start + word_vec_offset<<" , = "<<input[maped_start + word_vec_offset]<<std::endl;
-
-                output[word_start + word_vec_offset] = input[maped_start + word_vec_offset];
-
-            }
+        for (int sorted_id = 0; sorted_id < batch_size; ++sorted_id) {
+            memcpy(output + sorted_id * hidden_size, input + length_index[sorted_id] * hidden_size,
+                   hidden_size * sizeof(Dtype));
         }
     }
+    /**
+     * inverse of hidden_2_sorted_hidden, also drops the aligned tail of each row
+     */
     template <typename Dtype>
-    void sorted_seq_2_seq(const Dtype* input, Dtype* output, int hidden_size) {
-        int word_sum = _map_vec.size();
-
-        for (int ori_word_id = 0; ori_word_id < word_sum; ori_word_id++) {
-            //can param
-            int word_start = ori_word_id * hidden_size;
-            int maped_id = _map_vec[ori_word_id];
-            int maped_start = maped_id * hidden_size;
-
-            for (int word_vec_offset = 0; word_vec_offset < hidden_size; word_vec_offset++) {
-                //            std::cout<<ori_word_id+word_vec_offset<<" -> "<<maped_start+word_vec_offset<<std::endl;
-                output[word_start + word_vec_offset] = input[maped_start + word_vec_offset];
-            }
+    void sorted_hidden_2_hidden(const Dtype* input, Dtype* output, int hidden_size,
+                                int alligned_hidden_size) {
+        const std::vector<int>& length_index = _map->length_index;
+        int batch_size = length_index.size();
+
+        for (int sorted_id = 0; sorted_id < batch_size; ++sorted_id) {
+            memcpy(output + length_index[sorted_id] * hidden_size,
+                   input + sorted_id * alligned_hidden_size, hidden_size * sizeof(Dtype));
         }
     }
     template <typename Dtype>
+    void sorted_seq_2_seq(const Dtype* input, Dtype* output, int hidden_size) {
+        sorted_seq_2_seq(input, output, hidden_size, hidden_size);
+    }
+    template <typename Dtype>
     void sorted_seq_2_seq(const Dtype* input, Dtype* output, int hidden_size,
                           int alligned_hidden_size) {
-        int word_sum = _map_vec.size();
+        const std::vector<int>& map_vec = _map->map_vec;
+        int word_sum = map_vec.size();
 
         for (int ori_word_id = 0; ori_word_id < word_sum; ori_word_id++) {
-            //can param
-            int word_start = ori_word_id * hidden_size;
-            int maped_id = _map_vec[ori_word_id];
-            int maped_start = maped_id * alligned_hidden_size;
-
-            for (int word_vec_offset = 0; word_vec_offset < hidden_size; word_vec_offset++) {
-                //            std::cout<<ori_word_id+word_vec_offset<<" -> "<<maped_start+word_vec_offset<<std::endl;
-                output[word_start + word_vec_offset] = input[maped_start + word_vec_offset];
-            }
+            memcpy(output + ori_word_id * hidden_size, input + map_vec[ori_word_id] * alligned_hidden_size,
+                   hidden_size * sizeof(Dtype));
         }
     }
     /**
-     * return whether need to transform
+     * return whether need to transform, the map is shared with the other ops of the thread
+     * which sort the same seq offset
      * @param offset_vec
      * @param emit_offset_vec
      * @param emit_length
@@ -175,20 +245,37 @@ public:
      */
     bool get_sorted_map(std::vector<int>& offset_vec,
                         std::vector<int>& emit_offset_vec, int& emit_length) {
+        static thread_local SeqLayoutCache<SeqSortedMap> cache;
+        const bool is_reverse = _is_reverse;
+        _map = cache.get(offset_vec, is_reverse, [&offset_vec, is_reverse](SeqSortedMap& map) {
+            build_sorted_map(offset_vec, is_reverse, map);
+        });
+        emit_offset_vec = _map->emit_offset_vec;
+        emit_length = _map->emit_length;
+        return _map->transform;
+    }
+
+private:
+    static void build_sorted_map(const std::vector<int>& offset_vec, bool is_reverse,
+                                 SeqSortedMap& map) {
         int batch_size = offset_vec.size() - 1;
         int word_sum = offset_vec[offset_vec.size() - 1];
         std::vector<int>length_vec(batch_size);
-        _length_index.resize(batch_size);
+        std::vector<int>& length_index = map.length_index;
+        std::vector<int>& emit_offset_vec = map.emit_offset_vec;
+        length_index.resize(batch_size);
 
         if (batch_size == 1) {
-            emit_length = offset_vec[1] - offset_vec[0];
-            emit_offset_vec.resize(emit_length + 1);
+            length_index[0] = 0;
+            map.emit_length = offset_vec[1] - offset_vec[0];
+            emit_offset_vec.resize(map.emit_length + 1);
 
-            for (int i = 0; i <= emit_length; i++) {
+            for (int i = 0; i <= map.emit_length; i++) {
                 emit_offset_vec[i] = i;
             }
 
-            return false;
+            map.transform = false;
+            return;
         }
 
         int max_len = 0;
@@ -197,23 +284,24 @@ public:
             int len = offset_vec[i + 1] - offset_vec[i];
             max_len = max_len > len ? max_len : len;
             length_vec[i] = len;
-            _length_index[i] = i;
+            length_index[i] = i;
         }
 
-        emit_length = max_len;
+        map.emit_length = max_len;
 
         if (max_len == 1) {
             emit_offset_vec.push_back(0);
-            emit_offset_vec.push_back(emit_length * batch_size);
-            return false;
+            emit_offset_vec.push_back(max_len * batch_size);
+            map.transform = false;
+            return;
         }
 
-        std::sort(_length_index.begin(), _length_index.end(), [&length_vec](int i1, int i2) {
+        std::sort(length_index.begin(), length_index.end(), [&length_vec](int i1, int i2) {
             return length_vec[i1] > length_vec[i2];
         });
 
         emit_offset_vec.resize(max_len + 1);
-        _map_vec.resize(word_sum);
+        map.map_vec.resize(word_sum);
 
         int target_word_id = 0;
         std::vector<int> length_vec_cnt = length_vec;
@@ -222,18 +310,17 @@ public:
             emit_offset_vec[word_id_in_seq] = target_word_id;
 
             for (int batch_id = 0; batch_id < batch_size; batch_id++) {
-                int old_batch_id = _length_index[batch_id];
+                int old_batch_id = length_index[batch_id];
 
                 if (length_vec_cnt[old_batch_id] > 0) {
                     int inner_word_id_in_seq = word_id_in_seq;
 
-                    if (_is_reverse) {
+                    if (is_reverse) {
                         inner_word_id_in_seq = length_vec[old_batch_id] - 1 - word_id_in_seq;
                     }
 
                     int old_word_id = offset_vec[old_batch_id] + inner_word_id_in_seq;
-                    _map_vec[old_word_id] = target_word_id;
-                    //                    printf("map %d -> %d\n",old_word_id,target_word_id);
+                    map.map_vec[old_word_id] = target_word_id;
                     length_vec_cnt[old_batch_id]--;
                     target_word_id++;
                 } else {
@@ -243,16 +330,11 @@ public:
             }
         }
 
-        //        print_vec(_map_vec.data(),word_sum,"map");
         emit_offset_vec[max_len] = word_sum;
-        return true;
+        map.transform = true;
     }
 
-
-private:
-    //    std::vector<int> _length_vec;
-    std::vector<int> _length_index;
-    std::vector<int> _map_vec;
+    std::shared_ptr<const SeqSortedMap> _map;
     bool _is_reverse;
     bool _is_bi;
 
@@ -266,6 +348,21 @@ inline int div_up(int k, int c) {
     return (k + c - 1) / c;
 }
 
+/**
+ * \brief split size floats, a multiple of width, in at most max_parts slices of at least
+ *  min_size floats each, on width boundaries.
+ * \return bounds of the slices, slice i is [bounds[i], bounds[i + 1]).
+ */
+inline std::vector<int> split_aligned(int size, int width, int max_parts, int min_size) {
+    int blocks = size / width;
+    int parts = std::max(1, std::min(std::min(max_parts, blocks), size / std::max(min_size, 1)));
+    std::vector<int> bounds(parts + 1);
+    for (int i = 0; i <= parts; ++i) {
+        bounds[i] = (int)((long long)i * blocks / parts) * width;
+    }
+    return bounds;
+}
+
 template<bool expr, class T = void> struct enable_if {};
 template<class T> struct enable_if<true, T> {
     typedef T type;
@@ -885,11 +982,12 @@ inline void mkl_gemm(const bool TransA, const bool TransB, int m, int n, int k,
     cblas_sgemm(CblasRowMajor, cuTransA, cuTransB, m, n, k, alpha, a, k, b, n, beta, c, n);
 };
 
+/// flag_sum accumulates into what tensor_out holds, the residual of a fused eltwise sum
 template<typename DataTensor_in, typename DataTensor_out,typename DataTensor_op>
 inline void im2col_conv_cpu(DataTensor_in& tensor_out, DataTensor_out& tensor_in,DataTensor_op& tensor_temp,
                         const float* weights, const float* bias, int group,
                         int kernel_w, int kernel_h, int stride_w, int stride_h, int dila_w, int dila_h,
-                        int pad_w, int pad_h, bool flag_bias, bool flag_relu ) {
+                        int pad_w, int pad_h, bool flag_bias, bool flag_relu, bool flag_sum = false) {
     int in_c = tensor_in.channel();
     int in_h = tensor_in.height();
     int in_w = tensor_in.width();
@@ -903,7 +1001,8 @@ inline void im2col_conv_cpu(DataTensor_in& tensor_out, DataTensor_out& tensor_in
 
     for(int i=0;i<batch_size;i++){
         im2col_cpu(tensor_in.data()+i*(in_c*in_h*in_w),in_c,in_h,in_w,kernel_h,kernel_w,pad_h,pad_w,stride_h,stride_w,dila_h,dila_w,tensor_temp.mutable_data());
-        mkl_gemm(false,false,out_c,out_h*out_w,in_c*kernel_h*kernel_w,1.f,weights,tensor_temp.data(),0,tensor_out.mutable_data()+i*out_c*out_h*out_w);
+        mkl_gemm(false,false,out_c,out_h*out_w,in_c*kernel_h*kernel_w,1.f,weights,tensor_temp.data(),
+                 flag_sum ? 1.f : 0.f,tensor_out.mutable_data()+i*out_c*out_h*out_w);
     }
 
     if(flag_bias&& !flag_relu){
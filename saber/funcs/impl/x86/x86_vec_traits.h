@@ -0,0 +1,130 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_X86_VEC_TRAITS_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_X86_VEC_TRAITS_H
+
+#include <cmath>
+#include "saber/funcs/impl/x86/saber_sse_math.h"
+#include "saber/funcs/impl/x86/saber_avx2_math.h"
+#include "saber/funcs/impl/x86/saber_avx512_math.h"
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief float vector traits of the x86 kernels, one per isa level.
+ *  A trait exists only when the translation unit is compiled for its isa. They have
+ *  internal linkage, so the same trait built with different flags never merges across units.
+ */
+namespace {
+
+struct VecScalar {
+    typedef float vec;
+    static const int width = 1;
+    static inline vec load(const float* p) { return *p; }
+    static inline void store(float* p, vec v) { *p = v; }
+    static inline vec set1(float v) { return v; }
+    static inline vec add(vec a, vec b) { return a + b; }
+    static inline vec sub(vec a, vec b) { return a - b; }
+    static inline vec mul(vec a, vec b) { return a * b; }
+    static inline vec div(vec a, vec b) { return a / b; }
+    static inline vec max(vec a, vec b) { return a > b ? a : b; }
+    static inline vec min(vec a, vec b) { return a < b ? a : b; }
+    static inline vec exp(vec a) { return expf(a); }
+    static inline vec sqrt(vec a) { return sqrtf(a); }
+    /// x > 0 ? a : b
+    static inline vec select_pos(vec x, vec a, vec b) { return x > 0.f ? a : b; }
+    /// whether any lane of a is greater than b
+    static inline bool any_gt(vec a, vec b) { return a > b; }
+};
+
+#if defined(__SSE4_2__)
+struct VecSse42 {
+    typedef __m128 vec;
+    static const int width = 4;
+    static inline vec load(const float* p) { return _mm_loadu_ps(p); }
+    static inline void store(float* p, vec v) { _mm_storeu_ps(p, v); }
+    static inline vec set1(float v) { return _mm_set1_ps(v); }
+    static inline vec add(vec a, vec b) { return _mm_add_ps(a, b); }
+    static inline vec sub(vec a, vec b) { return _mm_sub_ps(a, b); }
+    static inline vec mul(vec a, vec b) { return _mm_mul_ps(a, b); }
+    static inline vec div(vec a, vec b) { return _mm_div_ps(a, b); }
+    static inline vec max(vec a, vec b) { return _mm_max_ps(a, b); }
+    static inline vec min(vec a, vec b) { return _mm_min_ps(a, b); }
+    static inline vec exp(vec a) { return exp128_ps(a); }
+    static inline vec sqrt(vec a) { return _mm_sqrt_ps(a); }
+    /// x > 0 ? a : b
+    static inline vec select_pos(vec x, vec a, vec b) {
+        return _mm_blendv_ps(b, a, _mm_cmpgt_ps(x, _mm_setzero_ps()));
+    }
+    static inline bool any_gt(vec a, vec b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)) != 0; }
+};
+#endif
+
+#if defined(__AVX2__) and defined(__FMA__)
+struct VecAvx2 {
+    typedef __m256 vec;
+    static const int width = 8;
+    static inline vec load(const float* p) { return _mm256_loadu_ps(p); }
+    static inline void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+    static inline vec set1(float v) { return _mm256_set1_ps(v); }
+    static inline vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+    static inline vec sub(vec a, vec b) { return _mm256_sub_ps(a, b); }
+    static inline vec mul(vec a, vec b) { return _mm256_mul_ps(a, b); }
+    static inline vec div(vec a, vec b) { return _mm256_div_ps(a, b); }
+    static inline vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+    static inline vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+    static inline vec exp(vec a) { return exp256_ps_fma(a); }
+    static inline vec sqrt(vec a) { return _mm256_sqrt_ps(a); }
+    /// x > 0 ? a : b
+    static inline vec select_pos(vec x, vec a, vec b) {
+        return _mm256_blendv_ps(b, a, _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ));
+    }
+    static inline bool any_gt(vec a, vec b) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)) != 0;
+    }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct VecAvx512 {
+    typedef __m512 vec;
+    static const int width = 16;
+    static inline vec load(const float* p) { return _mm512_loadu_ps(p); }
+    static inline void store(float* p, vec v) { _mm512_storeu_ps(p, v); }
+    static inline vec set1(float v) { return _mm512_set1_ps(v); }
+    static inline vec add(vec a, vec b) { return _mm512_add_ps(a, b); }
+    static inline vec sub(vec a, vec b) { return _mm512_sub_ps(a, b); }
+    static inline vec mul(vec a, vec b) { return _mm512_mul_ps(a, b); }
+    static inline vec div(vec a, vec b) { return _mm512_div_ps(a, b); }
+    static inline vec max(vec a, vec b) { return _mm512_max_ps(a, b); }
+    static inline vec min(vec a, vec b) { return _mm512_min_ps(a, b); }
+    static inline vec exp(vec a) { return exp512_ps_fma(a); }
+    static inline vec sqrt(vec a) { return _mm512_sqrt_ps(a); }
+    /// x > 0 ? a : b
+    static inline vec select_pos(vec x, vec a, vec b) {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_GT_OQ), b, a);
+    }
+    static inline bool any_gt(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ) != 0; }
+};
+#endif
+
+} // namespace
+
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_X86_VEC_TRAITS_H
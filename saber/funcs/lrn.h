@@ -24,7 +24,7 @@
 #endif
 
 #ifdef USE_X86_PLACE
-#include "saber/funcs/impl/impl_lrn.h"
+#include "saber/funcs/impl/x86/saber_lrn.h"
 #endif
 #ifdef USE_ARM_PLACE
 //todo
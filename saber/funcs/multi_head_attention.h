@@ -0,0 +1,132 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_MULTI_HEAD_ATTENTION_H
+#define ANAKIN_SABER_FUNCS_MULTI_HEAD_ATTENTION_H
+
+#include "saber/funcs/base.h"
+#include "saber/funcs/impl/impl_base.h"
+#include "saber/funcs/impl/impl_multi_head_attention.h"
+
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_multi_head_attention.h"
+#endif
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief multi-head self attention of transformer encoders.
+ * The input is (words, dim) with the seq offset of the batch, a word only attends to the
+ * words of its own sequence. dim is the input of the q k v projection, or q, k and v
+ * concatenated when fc_param has no weights. The output is (words, hidden), the heads
+ * concatenated, the output projection is left to the next fc.
+ */
+template<typename TargetType,
+        DataType OpDtype,
+        DataType inDtype = AK_FLOAT,
+        DataType outDtype = AK_FLOAT,
+        typename LayOutType_op = NCHW,
+        typename LayOutType_in = NCHW,
+        typename LayOutType_out = NCHW
+>
+class MultiHeadAttention : public BaseFunc<
+        Tensor<TargetType, inDtype, LayOutType_in>,
+        Tensor<TargetType, outDtype, LayOutType_out>,
+        Tensor<TargetType, OpDtype, LayOutType_op>,
+        ImplBase,
+        MultiHeadAttentionParam
+> {
+public:
+    using BaseFunc<
+            Tensor<TargetType, inDtype, LayOutType_in>,
+            Tensor<TargetType, outDtype, LayOutType_out>,
+            Tensor<TargetType, OpDtype, LayOutType_op>,
+            ImplBase,
+            MultiHeadAttentionParam>::BaseFunc;
+
+    MultiHeadAttention() = default;
+
+    typedef Tensor<TargetType, inDtype, LayOutType_in> InDataTensor;
+    typedef Tensor<TargetType, outDtype, LayOutType_out> OutDataTensor;
+    typedef Tensor<TargetType, OpDtype, LayOutType_op> OpTensor;
+    typedef MultiHeadAttentionParam<OpTensor> Param_t;
+    typedef std::vector<InDataTensor *> Input_v;
+    typedef std::vector<OutDataTensor *> Output_v;
+    typedef std::vector<Shape> Shape_v;
+
+    virtual SaberStatus compute_output_shape(const Input_v& input, Output_v& output, \
+        Param_t& param) override {
+
+        FcParam<OpTensor>& fc_param = param.fc_param;
+        int words = input[0]->count_valid(0, fc_param.axis);
+        int dim = input[0]->count_valid(fc_param.axis, input[0]->dims());
+        int qkv_dim = dim;
+        if (fc_param.weights) {
+            qkv_dim = fc_param.num_output;
+            if (qkv_dim <= 0) {
+                qkv_dim = fc_param.weights->valid_size() / dim;
+            }
+            CHECK_EQ(fc_param.weights->valid_size() / qkv_dim, dim)
+                << "weights size does not meet the input size";
+        }
+        CHECK_EQ(qkv_dim % 3, 0) << "q k v size should be 3 times of the hidden size";
+        int hidden = qkv_dim / 3;
+        CHECK_GT(param.head_num, 0) << "head num should be positive";
+        CHECK_EQ(hidden % param.head_num, 0) << "hidden size should be a multiple of head num";
+
+        Shape output_shape = input[0]->valid_shape();
+        for (int i = 0; i < output_shape.dims(); ++i) {
+            output_shape[i] = 1;
+        }
+        output_shape[0] = words;
+        output_shape[1] = hidden;
+        output[0]->set_seq_offset(input[0]->get_seq_offset());
+        return output[0]->set_shape(output_shape);
+    }
+
+    virtual SaberStatus init_impl(ImplEnum implenum) override {
+        switch (implenum) {
+            case VENDER_IMPL:
+                this->_impl.push_back(new VenderMultiHeadAttention <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            case SABER_IMPL:
+                this->_impl.push_back(new SaberMultiHeadAttention <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            default:
+                return SaberUnImplError;
+        }
+    }
+
+private:
+
+    virtual void pick_best_static() override {
+        this->_best_impl = this->_impl[0];
+    }
+
+    virtual void pick_best_specify(ImplEnum implenum) override {
+        this->_best_impl = this->_impl[0];
+    }
+
+};
+
+}
+}
+
+#endif //ANAKIN_SABER_FUNCS_MULTI_HEAD_ATTENTION_H
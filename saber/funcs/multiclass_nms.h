@@ -0,0 +1,117 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#ifndef ANAKIN_SABER_FUNCS_MULTICLASS_NMS_H
+#define ANAKIN_SABER_FUNCS_MULTICLASS_NMS_H
+
+#include "saber/funcs/base.h"
+#include "saber/funcs/impl/impl_base.h"
+#include "saber/funcs/impl/impl_multiclass_nms.h"
+#ifdef NVIDIA_GPU
+#include "saber/funcs/impl/cuda/saber_multiclass_nms.h"
+#endif
+
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_multiclass_nms.h"
+#endif
+
+namespace anakin {
+namespace saber {
+
+template<typename TargetType,
+        DataType OpDtype,
+        DataType inDtype = AK_FLOAT,
+        DataType outDtype = AK_FLOAT,
+        typename LayOutType_op = NCHW,
+        typename LayOutType_in = NCHW,
+        typename LayOutType_out = NCHW
+>
+class MultiClassNMS : public BaseFunc<
+        Tensor<TargetType, inDtype, LayOutType_in>,
+        Tensor<TargetType, outDtype, LayOutType_out>,
+        Tensor<TargetType, OpDtype, LayOutType_op>,
+        ImplBase,
+        MultiClassNMSParam
+> {
+public:
+    using BaseFunc<
+            Tensor<TargetType, inDtype, LayOutType_in>,
+            Tensor<TargetType, outDtype, LayOutType_out>,
+            Tensor<TargetType, OpDtype, LayOutType_op>,
+            ImplBase,
+            MultiClassNMSParam>::BaseFunc;
+
+    MultiClassNMS() = default;
+
+    typedef Tensor<TargetType, inDtype, LayOutType_in> InDataTensor;
+    typedef Tensor<TargetType, outDtype, LayOutType_out> OutDataTensor;
+    typedef Tensor<TargetType, OpDtype, LayOutType_op> OpTensor;
+    typedef MultiClassNMSParam<OpTensor> Param_t;
+    typedef std::vector<InDataTensor *> Input_v;
+    typedef std::vector<OutDataTensor *> Output_v;
+    typedef std::vector<Shape> Shape_v;
+
+    virtual SaberStatus compute_output_shape(const Input_v &input, \
+        Output_v &output, Param_t &param) override {
+        //! rows of (image, label, score, xmin, ymin, xmax, ymax), at most keep_top_k per image
+        //! or every score when keep_top_k is -1, and one row of -1 when nothing is detected
+        Shape shape_out = output[0]->valid_shape();
+        CHECK_EQ(shape_out.dims(), 4) << "only support 4d layout";
+        int max_rows = input[1]->valid_size();
+        if (param.keep_top_k > -1) {
+            max_rows = input[0]->num() * param.keep_top_k;
+        }
+        shape_out[0] = 1;
+        shape_out[1] = 1;
+        shape_out[2] = max_rows > 1 ? max_rows : 1;
+        shape_out[3] = 7;
+
+        return output[0]->set_shape(shape_out);
+    }
+
+    virtual SaberStatus init_impl(ImplEnum implenum) override {
+        switch (implenum) {
+            case VENDER_IMPL:
+                this->_impl.push_back(new VenderMultiClassNMS <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            case SABER_IMPL:
+                this->_impl.push_back(new SaberMultiClassNMS <TargetType, OpDtype, inDtype, outDtype,
+                LayOutType_op, LayOutType_in, LayOutType_out>);
+                return SaberSuccess;
+
+            default:
+                return SaberUnImplError;
+        }
+    }
+
+private:
+
+    virtual void pick_best_static() override {
+        if (true) // some condition?
+            this->_best_impl = this->_impl[0];
+    }
+
+    virtual void pick_best_specify(ImplEnum implenum) override {
+        this->_best_impl = this->_impl[0];
+    }
+
+};
+
+} // namespace saber
+} // namespace anakin
+
+
+#endif
\ No newline at end of file
@@ -24,7 +24,7 @@
 #endif
 
 #ifdef USE_X86_PLACE
-#include "saber/funcs/impl/impl_mvn.h"
+#include "saber/funcs/impl/x86/saber_mvn.h"
 #endif
 #ifdef USE_ARM_PLACE
 //todo
@@ -72,7 +72,7 @@ public:
 
         //! support inplace computation, output shape = input shape
         Shape output_shape = input[0]->valid_shape();
-        output[0]->set_shape(output_shape);
+        return output[0]->set_shape(output_shape);
     }
 
     virtual SaberStatus init_impl(ImplEnum implenum) override {
@@ -24,7 +24,7 @@
 #endif
 
 #ifdef USE_X86_PLACE
-#include "saber/funcs/impl/impl_permute.h"
+#include "saber/funcs/impl/x86/saber_permute.h"
 #endif
 #ifdef USE_ARM_PLACE
 #include "saber/funcs/impl/arm/saber_permute.h"
@@ -25,7 +25,7 @@
 #endif
 
 #ifdef USE_X86_PLACE
-#include "saber/funcs/impl/impl_permute_power.h"
+#include "saber/funcs/impl/x86/saber_permute_power.h"
 #endif
 #ifdef USE_ARM_PLACE
 //todo
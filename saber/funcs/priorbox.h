@@ -24,7 +24,7 @@
 #endif
 
 #ifdef USE_X86_PLACE
-#include "saber/funcs/impl/impl_priorbox.h"
+#include "saber/funcs/impl/x86/saber_priorbox.h"
 #endif
 #ifdef USE_ARM_PLACE
 #include "saber/funcs/impl/arm/saber_priorbox.h"
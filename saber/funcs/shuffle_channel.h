@@ -18,6 +18,9 @@
 
 #include "saber/funcs/base.h"
 #include "saber/funcs/impl/impl_shuffle_channel.h"
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_shuffle_channel.h"
+#endif
 
 namespace anakin {
 
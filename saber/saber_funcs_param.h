@@ -34,6 +34,7 @@ struct MatMulParam {
     {
         _is_transpose_X = right._is_transpose_X;
         _is_transpose_Y = right._is_transpose_Y;
+        return *this;
     }
     bool operator==(const MatMulParam &right) {
         bool comp_eq = true;
@@ -71,7 +72,9 @@ template <typename opTensor>
 struct TransposeParam {
     TransposeParam() = default;
     TransposeParam(const TransposeParam& right){}
-    TransposeParam& operator=(const TransposeParam& right){}
+    TransposeParam& operator=(const TransposeParam& right){
+        return *this;
+    }
     bool operator==(const TransposeParam& right){
         return true;
     }
@@ -143,6 +146,7 @@ struct GruParam {
         is_reverse=right.is_reverse;
         formula=right.formula;
         init_hidden_tensor=right.init_hidden_tensor;
+        last_hidden_tensor=right.last_hidden_tensor;
         return *this;
     }
 
@@ -173,6 +177,20 @@ struct GruParam {
         return init_hidden_tensor;
     }
 
+    /**
+     * last hidden of each sequence (batch_size * hidden_size) is written here after dispatch,
+     * it is not compared in operator== because it's a runtime binding, not a parameter
+     */
+    inline opTensor* last_hidden() {
+        return last_hidden_tensor;
+    }
+
+    /// bind state tensors used by stateful streaming inference, nullptr to unbind
+    void set_state(opTensor* hidden_init_in, opTensor* last_hidden_out) {
+        init_hidden_tensor = hidden_init_in;
+        last_hidden_tensor = last_hidden_out;
+    }
+
     int num_direction;
     float dropout_param;
     int num_layers;
@@ -184,6 +202,7 @@ private:
     opTensor* weight_tensor;
     opTensor* bias_tensor;
     opTensor* init_hidden_tensor;
+    opTensor* last_hidden_tensor{nullptr};
 };
 
 template <typename opTensor>
@@ -249,6 +268,9 @@ struct LstmParam{
         skip_input=right.skip_input;
         is_reverse=right.is_reverse;
         init_hidden_tensor=right.init_hidden_tensor;
+        init_cell_tensor=right.init_cell_tensor;
+        last_hidden_tensor=right.last_hidden_tensor;
+        last_cell_tensor=right.last_cell_tensor;
         return *this;
     }
 
@@ -282,6 +304,31 @@ struct LstmParam{
         return init_hidden_tensor;
     }
 
+    inline const opTensor* init_cell() {
+        return init_cell_tensor;
+    }
+
+    /**
+     * last hidden and cell of each sequence (batch_size * hidden_size) are written here after dispatch,
+     * they are not compared in operator== because they are runtime bindings, not parameters
+     */
+    inline opTensor* last_hidden() {
+        return last_hidden_tensor;
+    }
+
+    inline opTensor* last_cell() {
+        return last_cell_tensor;
+    }
+
+    /// bind state tensors used by stateful streaming inference, nullptr to unbind
+    void set_state(opTensor* hidden_init_in, opTensor* cell_init_in,
+                   opTensor* last_hidden_out, opTensor* last_cell_out) {
+        init_hidden_tensor = hidden_init_in;
+        init_cell_tensor = cell_init_in;
+        last_hidden_tensor = last_hidden_out;
+        last_cell_tensor = last_cell_out;
+    }
+
     int num_direction;
     float dropout_param;
     int num_layers;
@@ -300,6 +347,9 @@ private:
     opTensor* weight_tensor;
     opTensor* bias_tensor;
     opTensor* init_hidden_tensor;
+    opTensor* init_cell_tensor{nullptr};
+    opTensor* last_hidden_tensor{nullptr};
+    opTensor* last_cell_tensor{nullptr};
 };
 
 
@@ -618,9 +668,9 @@ struct PowerParam {
 };
 template<typename opTensor>
 struct PermutePowerParam {
-    PermutePowerParam() {}
+    PermutePowerParam(): has_power_param(false) {}
     PermutePowerParam(PermuteParam<opTensor> permute_param):
-            power_param(power_param), has_power_param(false) {}
+            permute_param(permute_param), has_power_param(false) {}
     PermutePowerParam(PermuteParam<opTensor> permute_param, PowerParam<opTensor> power_param):
             power_param(power_param), permute_param(permute_param), has_power_param(true) {}
     PermutePowerParam(const PermutePowerParam & right):
@@ -733,7 +783,7 @@ struct SoftmaxParam {
     bool operator==(const SoftmaxParam<type>& right){
         return axis == right.axis;
     }
-    int axis;
+    int axis{1};
 };
 template <typename opTensor>
 struct BatchnormParam {
@@ -1244,16 +1294,21 @@ struct ConvActiveParam {
             , activation_param(right.activation_param)
             , batchnorm_param(right.batchnorm_param)
             , scale_param(right.scale_param)
+            , eltwise_param(right.eltwise_param)
+            , eltwise_act_param(right.eltwise_act_param)
             , has_batchnorm(right.has_batchnorm)
             , has_scale(right.has_scale)
             , has_active(right.has_active)
-            , has_eltwise_act(right.has_active)
+            , has_eltwise(right.has_eltwise)
+            , has_eltwise_act(right.has_eltwise_act)
     {}
     ConvActiveParam &operator=(const ConvActiveParam &right) {
         conv_param = right.conv_param;
         activation_param = right.activation_param;
         batchnorm_param = right.batchnorm_param;
         scale_param = right.scale_param;
+        eltwise_param = right.eltwise_param;
+        eltwise_act_param = right.eltwise_act_param;
         has_batchnorm = right.has_batchnorm;
         has_scale = right.has_scale;
         has_active = right.has_active;
@@ -1287,6 +1342,35 @@ struct ConvActiveParam {
     bool has_eltwise;
     bool has_eltwise_act;
 };
+// Fusion of a depthwise conv and the 1x1 conv that consumes it (mobilenet blocks),
+// each one with its own batchnorm, scale and activation.
+template <typename opTensor>
+struct ConvDwPwParam {
+    ConvDwPwParam() = default;
+    ConvDwPwParam(ConvActiveParam<opTensor> &dw_param_in,
+                  ConvActiveParam<opTensor> &pw_param_in)
+            : dw_param(dw_param_in)
+            , pw_param(pw_param_in)
+    {}
+    ConvDwPwParam(const ConvDwPwParam &right)
+            : dw_param(right.dw_param)
+            , pw_param(right.pw_param)
+    {}
+    ConvDwPwParam &operator=(const ConvDwPwParam &right) {
+        dw_param = right.dw_param;
+        pw_param = right.pw_param;
+        return *this;
+    }
+    bool operator==(const ConvDwPwParam &right) {
+        bool comp_eq = true;
+        comp_eq = comp_eq && (dw_param == right.dw_param);
+        comp_eq = comp_eq && (pw_param == right.pw_param);
+        return comp_eq;
+    }
+
+    ConvActiveParam<opTensor> dw_param;
+    ConvActiveParam<opTensor> pw_param;
+};
 // Fusion conv with batchnorm, scale, activation(sigmoid, relu, tanh, clipped_relu, elu)
 template <typename opTensor>
 struct ConvActivePoolingParam {
@@ -1382,29 +1466,34 @@ struct ConvActivePoolingParam {
 template <typename opTensor>
 struct ResizeParam {
     ResizeParam() = default;
-    explicit ResizeParam(float scale_w, float scale_h){
+    explicit ResizeParam(float scale_w, float scale_h, ResizeType type = Resize_bilinear){
         bool flag = scale_w > 0.f && scale_h > 0.f;
         CHECK_EQ(flag, true) << "wrong parameters";
         width_scale = scale_w;
         height_scale = scale_h;
+        resize_type = type;
     }
     ResizeParam(const ResizeParam<opTensor>& right){
         width_scale = right.width_scale;
         height_scale = right.height_scale;
+        resize_type = right.resize_type;
     }
     ResizeParam<opTensor>& operator=(const ResizeParam<opTensor>& right){
         this->width_scale = right.width_scale;
         this->height_scale = right.height_scale;
+        this->resize_type = right.resize_type;
         return *this;
     }
     bool operator==(const ResizeParam<opTensor> right){
         float eps = 1e-6f;
         bool flag = fabsf(width_scale - right.width_scale) < eps;
         flag &= fabsf(height_scale - right.height_scale) < eps;
+        flag &= resize_type == right.resize_type;
         return flag;
     }
     float width_scale{0.f};
     float height_scale{0.f};
+    ResizeType resize_type{Resize_bilinear};
 };
 
 template <typename opTensor>
@@ -1632,6 +1721,7 @@ struct EltwiseParam {
     EltwiseParam(const EltwiseParam<opTensor>& right)
         : operation(right.operation)
         , coeff(right.coeff)
+        , chain_ops(right.chain_ops)
     {}
 
     EltwiseParam<opTensor>& operator=(const EltwiseParam<opTensor>& right) {
@@ -1640,12 +1730,14 @@ struct EltwiseParam {
         for (int i = 0; i < coeff.size(); ++i) {
             coeff[i] = right.coeff[i];
         }
+        chain_ops = right.chain_ops;
         return *this;
     }
 
     bool operator==(const EltwiseParam<opTensor>& right) {
         bool comp_eq = true;
         comp_eq = comp_eq && (operation == right.operation);
+        comp_eq = comp_eq && (chain_ops == right.chain_ops);
         comp_eq = comp_eq && (coeff.size() == right.coeff.size());
         if (!comp_eq) {
             return comp_eq;
@@ -1657,6 +1749,9 @@ struct EltwiseParam {
     }
     EltwiseType operation;
     std::vector<DataDtype> coeff;
+    ///< fused n-ary chain, chain_ops[i] combines the result so far with input i + 1,
+    ///< e.g. {prod, sum} is (in0 * in1) + in2. operation is used between all inputs when empty.
+    std::vector<EltwiseType> chain_ops;
 };
 
 template <typename opTensor>
@@ -1696,6 +1791,82 @@ struct EltwiseActiveParam {
     bool has_activation;
 };
 
+// Fusion fc(output layer) with softmax and top-k argmax,
+// only the top k ids (and probabilities) of every row are produced.
+template <typename opTensor>
+struct FcSoftmaxArgmaxParam {
+    FcSoftmaxArgmaxParam() = default;
+    FcSoftmaxArgmaxParam(FcParam<opTensor> &fc_param_in,
+                         SoftmaxParam<opTensor> &softmax_param_in,
+                         ArgmaxParam<opTensor> &argmax_param_in)
+            : fc_param(fc_param_in)
+            , softmax_param(softmax_param_in)
+            , argmax_param(argmax_param_in)
+    {}
+    FcSoftmaxArgmaxParam(const FcSoftmaxArgmaxParam &right)
+            : fc_param(right.fc_param)
+            , softmax_param(right.softmax_param)
+            , argmax_param(right.argmax_param)
+    {}
+    FcSoftmaxArgmaxParam &operator=(const FcSoftmaxArgmaxParam &right) {
+        fc_param = right.fc_param;
+        softmax_param = right.softmax_param;
+        argmax_param = right.argmax_param;
+        return *this;
+    }
+    bool operator==(const FcSoftmaxArgmaxParam &right) {
+        bool comp_eq = true;
+        comp_eq = comp_eq && (fc_param == right.fc_param);
+        comp_eq = comp_eq && (softmax_param == right.softmax_param);
+        comp_eq = comp_eq && (argmax_param == right.argmax_param);
+        return comp_eq;
+    }
+
+    FcParam<opTensor> fc_param;
+    SoftmaxParam<opTensor> softmax_param;
+    ArgmaxParam<opTensor> argmax_param;
+};
+
+// Fused multi-head self attention of the sequences given by the seq offset:
+// q, k and v projection, then softmax(q * k^T * scale) * v of every head within every sequence.
+template <typename opTensor>
+struct MultiHeadAttentionParam {
+    MultiHeadAttentionParam() = default;
+    MultiHeadAttentionParam(FcParam<opTensor> &fc_param_in, int head_num_in, float scale_in = 0.f)
+            : fc_param(fc_param_in)
+            , head_num(head_num_in)
+            , scale(scale_in)
+    {}
+    MultiHeadAttentionParam(int head_num_in, float scale_in = 0.f)
+            : head_num(head_num_in)
+            , scale(scale_in)
+    {}
+    MultiHeadAttentionParam(const MultiHeadAttentionParam &right)
+            : fc_param(right.fc_param)
+            , head_num(right.head_num)
+            , scale(right.scale)
+    {}
+    MultiHeadAttentionParam &operator=(const MultiHeadAttentionParam &right) {
+        fc_param = right.fc_param;
+        head_num = right.head_num;
+        scale = right.scale;
+        return *this;
+    }
+    bool operator==(const MultiHeadAttentionParam &right) {
+        bool comp_eq = true;
+        comp_eq = comp_eq && (fc_param == right.fc_param);
+        comp_eq = comp_eq && (head_num == right.head_num);
+        comp_eq = comp_eq && (scale == right.scale);
+        return comp_eq;
+    }
+
+    ///< projection to q, k and v, without weights the input holds them already
+    FcParam<opTensor> fc_param;
+    int head_num{1};
+    ///< scale of the scores, 1 / sqrt(head size) when it isn't positive
+    float scale{0.f};
+};
+
 template <typename opTensor>
 struct PriorBoxParam {
 
@@ -2708,8 +2879,8 @@ struct LayerNormParam {
     float eps{1e-5f};
 
 private:
-    opTensor* scale;
-    opTensor* bias;
+    opTensor* scale{nullptr};
+    opTensor* bias{nullptr};
 };
 
 template <typename opTensor>
@@ -138,6 +138,11 @@ typedef enum{
     Eltwise_max = 3
 } EltwiseType;
 
+typedef enum{
+    Resize_bilinear = 0,
+    Resize_nearest = 1
+} ResizeType;
+
 typedef enum{
     ACROSS_CHANNELS = 0,
     WITHIN_CHANNEL = 1
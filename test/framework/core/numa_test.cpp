@@ -0,0 +1,76 @@
+#include "core_test.h"
+#include "numa.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+TEST(CoreComponentsTest, core_parse_cpu_list_test) {
+    CHECK(parse_cpu_list("0-3,8,10-11") == std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    // as read from /sys/devices/system/node/node*/cpulist
+    CHECK(parse_cpu_list("0-3,8,10-11\n") == std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    CHECK(parse_cpu_list("5") == std::vector<int>({5}));
+    CHECK(parse_cpu_list("").empty());
+    CHECK(parse_cpu_list("\n").empty());
+}
+
+#ifdef __linux__
+TEST(CoreComponentsTest, core_numa_node_gap_test) {
+    // node 1 is offline, node 3 holds memory only
+    std::string node_dir = "numa_test_nodes";
+    for (auto node : {"0", "2", "3"}) {
+        CHECK_EQ(system(("mkdir -p " + node_dir + "/node" + node).c_str()), 0);
+    }
+    std::ofstream(node_dir + "/online") << "0,2-3\n";
+    std::ofstream(node_dir + "/node0/cpulist") << "0-1\n";
+    std::ofstream(node_dir + "/node2/cpulist") << "2-3\n";
+    std::ofstream(node_dir + "/node3/cpulist") << "\n";
+    NumaInfo numa(node_dir);
+    CHECK_EQ(numa.node_num(), 2);
+    CHECK(numa.cpus_of_node(0) == std::vector<int>({0, 1}));
+    CHECK(numa.cpus_of_node(1) == std::vector<int>({2, 3}));
+    CHECK_EQ(numa.node_of_cpu(3), 1);
+    CHECK_EQ(system(("rm -rf " + node_dir).c_str()), 0);
+}
+#endif
+
+TEST(CoreComponentsTest, core_numa_topology_test) {
+    const NumaInfo& numa = NumaTopology::Global();
+    LOG(INFO) << " numa nodes : " << numa.node_num();
+    CHECK_GE(numa.node_num(), 1);
+    // every cpu is on one node only
+    std::vector<int> all_cpus;
+    for (int node = 0; node < numa.node_num(); node++) {
+        CHECK(!numa.cpus_of_node(node).empty()) << " node " << node << " has no cpu";
+        for (auto cpu : numa.cpus_of_node(node)) {
+            CHECK_EQ(numa.node_of_cpu(cpu), node);
+            all_cpus.push_back(cpu);
+        }
+    }
+    std::sort(all_cpus.begin(), all_cpus.end());
+    CHECK(std::unique(all_cpus.begin(), all_cpus.end()) == all_cpus.end());
+
+    // a thread bound to a node only runs on its cpus
+    int last = numa.node_num() - 1;
+    std::thread bound([&]() {
+        if (!numa.bind_current_thread(last)) {
+            LOG(WARNING) << " thread binding isn't supported here";
+            return;
+        }
+#ifdef __linux__
+        auto& cpus = numa.cpus_of_node(last);
+        CHECK(std::find(cpus.begin(), cpus.end(), sched_getcpu()) != cpus.end());
+#endif
+    });
+    bound.join();
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <string>
+#include "net_test.h"
+#include "saber/funcs/priorbox.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+typedef Tensor4d<X86, AK_FLOAT> TensorX86;
+
+const int class_num = 3;
+const int prior_num = 4;
+
+static void add_conv(GraphX86& graph, std::string name, std::string bottom, int in_c, int out_c,
+                     int stride, unsigned int seed) {
+    auto conv = add_test_node(graph, name, "Convolution", {bottom});
+    conv->set_attr("group", 1);
+    conv->set_attr("filter_num", out_c);
+    conv->set_attr("kernel_size", PTuple<int>(std::vector<int>{3, 3}));
+    conv->set_attr("padding", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("strides", PTuple<int>(std::vector<int>{stride, stride}));
+    conv->set_attr("dilation_rate", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("bias_term", false);
+    conv->set_attr("axis", 1);
+    conv->set_attr("weight_1", add_test_weights(graph, Shape(out_c, in_c, 3, 3), -0.3f, 0.3f, seed));
+}
+
+/// conv to NHWC, flattened to a row per image as DetectionOutput takes it
+static void add_head(GraphX86& graph, std::string name, int out_c, unsigned int seed) {
+    add_conv(graph, name, "feature_split", 8, out_c, 1, seed);
+    auto permute = add_test_node(graph, name + "_permute", "Permute", {name});
+    permute->set_attr("dims", PTuple<int>(std::vector<int>{0, 2, 3, 1}));
+    auto flatten = add_test_node(graph, name + "_flatten", "Flatten", {name + "_permute"});
+    flatten->set_attr("start_axis", 1);
+    flatten->set_attr("end_axis", -1);
+}
+
+/// a ssd head on one feature map, the prior boxes only depend on the input shape
+static void build_ssd_head(GraphX86& graph) {
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{1, 3, 16, 16}));
+    // every fan out goes through a split, as in the parsed models
+    auto in_split = add_test_node(graph, "input_split", "Split", {"input_0"});
+    in_split->set_attr("split_num", 2);
+    add_conv(graph, "feature", "input_split", 3, 8, 2, 3);
+    auto feature_split = add_test_node(graph, "feature_split", "Split", {"feature"});
+    feature_split->set_attr("split_num", 3);
+    add_head(graph, "loc", prior_num * 4, 5);
+    add_head(graph, "conf", prior_num * class_num, 7);
+
+    auto priorbox = add_test_node(graph, "priorbox", "PriorBox", {"feature_split", "input_split"});
+    priorbox->set_attr("min_size", PTuple<float>(std::vector<float>{4.f}));
+    priorbox->set_attr("max_size", PTuple<float>(std::vector<float>{8.f}));
+    priorbox->set_attr("aspect_ratio", PTuple<float>(std::vector<float>{2.f}));
+    priorbox->set_attr("is_flip", true);
+    priorbox->set_attr("is_clip", false);
+    priorbox->set_attr("variance", PTuple<float>(std::vector<float>{0.1f, 0.1f, 0.2f, 0.2f}));
+    priorbox->set_attr("img_h", 0);
+    priorbox->set_attr("img_w", 0);
+    priorbox->set_attr("step_h", 0.f);
+    priorbox->set_attr("step_w", 0.f);
+    priorbox->set_attr("offset", 0.5f);
+    priorbox->set_attr("order", PTuple<std::string>(std::vector<std::string>{"MIN", "MAX", "COM"}));
+
+    auto detection = add_test_node(graph, "detection", "DetectionOutput",
+                                   {"loc_flatten", "conf_flatten", "priorbox"});
+    detection->set_attr("share_location", true);
+    detection->set_attr("variance_encode_in_target", false);
+    detection->set_attr("class_num", class_num);
+    detection->set_attr("background_id", 0);
+    detection->set_attr("keep_top_k", 20);
+    detection->set_attr("code_type", std::string("CENTER_SIZE"));
+    detection->set_attr("conf_thresh", 0.01f);
+    detection->set_attr("nms_top_k", 50);
+    detection->set_attr("nms_thresh", 0.45f);
+    detection->set_attr("nms_eta", 1.f);
+    add_test_node(graph, "output_0", "Output", {"detection"});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+}
+
+static void fill_image(NetX86& net, Shape shape) {
+    auto in = net.get_in("input_0");
+    in->reshape(shape);
+    for (int i = 0; i < in->valid_size(); i++) {
+        in->mutable_data()[i] = ((i * 29) % 31) / 15.f - 1.f;
+    }
+}
+
+/// prior boxes computed by the op itself for a feature map and an image of these shapes
+static void check_priorbox(NetX86& net, Shape feature_shape, Shape image_shape) {
+    TensorX86 feature(feature_shape);
+    TensorX86 image(image_shape);
+    TensorX86 ref;
+    std::vector<TensorX86*> inputs = {&feature, &image};
+    std::vector<TensorX86*> outputs = {&ref};
+    std::vector<PriorType> order = {PRIOR_MIN, PRIOR_MAX, PRIOR_COM};
+    PriorBoxParam<TensorX86> param({0.1f, 0.1f, 0.2f, 0.2f}, true, false, 0, 0, 0.f, 0.f, 0.5f,
+                                   order, {4.f}, {8.f}, {2.f});
+    Context<X86> ctx;
+    PriorBox<X86, AK_FLOAT> priorbox;
+    SABER_CHECK(priorbox.compute_output_shape(inputs, outputs, param));
+    ref.re_alloc(ref.valid_shape());
+    SABER_CHECK(priorbox.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx));
+    SABER_CHECK(priorbox(inputs, outputs, param, ctx));
+
+    auto folded = net.get_tensor_from_edge("priorbox", "detection");
+    CHECK(folded->valid_shape() == ref.valid_shape());
+    CHECK_EQ(max_abs_diff(*folded, ref), 0.f);
+}
+
+/// the folded tensor owns its memory, no other tensor of net is planned on top of it
+static void check_not_aliased(NetX86& net) {
+    std::vector<std::pair<std::string, std::string> > edges = {
+        {"input_0", "input_split"}, {"input_split", "feature"}, {"input_split", "priorbox"},
+        {"feature", "feature_split"}, {"feature_split", "loc"}, {"feature_split", "conf"},
+        {"feature_split", "priorbox"}, {"loc", "loc_permute"}, {"loc_permute", "loc_flatten"},
+        {"loc_flatten", "detection"}, {"conf", "conf_permute"}, {"conf_permute", "conf_flatten"},
+        {"conf_flatten", "detection"}, {"detection", "output_0"}};
+    auto folded = net.get_tensor_from_edge("priorbox", "detection");
+    const float* begin = folded->data();
+    const float* end = begin + folded->valid_size();
+    for (auto& edge : edges) {
+        auto tensor = net.get_tensor_from_edge(edge.first.c_str(), edge.second.c_str());
+        const float* other_begin = tensor->data();
+        const float* other_end = other_begin + tensor->valid_size();
+        CHECK(other_end <= begin || other_begin >= end)
+                << " edge " << edge.first << " -> " << edge.second << " aliases the prior boxes";
+    }
+}
+
+TEST(NetTest, constant_folding_test) {
+    GraphX86 graph;
+    build_ssd_head(graph);
+    CHECK(graph.Optimize());
+    NetX86 net(graph);
+
+    fill_image(net, Shape(1, 3, 16, 16));
+    net.prediction();
+    check_priorbox(net, Shape(1, 8, 8, 8), Shape(1, 3, 16, 16));
+    check_not_aliased(net);
+
+    // a larger image gives a larger feature map, the prior boxes are folded again
+    fill_image(net, Shape(1, 3, 24, 24));
+    net.prediction();
+    check_priorbox(net, Shape(1, 8, 12, 12), Shape(1, 3, 24, 24));
+    check_not_aliased(net);
+
+    // and the detections are those of a net initialized for that size
+    GraphX86 large_graph;
+    build_ssd_head(large_graph);
+    large_graph.Reshape("input_0", {1, 3, 24, 24});
+    CHECK(large_graph.Optimize());
+    NetX86 large_net(large_graph);
+    fill_image(large_net, Shape(1, 3, 24, 24));
+    large_net.prediction();
+    auto out = net.get_out("output_0");
+    auto large_out = large_net.get_out("output_0");
+    CHECK(out->valid_shape() == large_out->valid_shape());
+    CHECK_LT(max_abs_diff(*out, *large_out), 1e-5f);
+    LOG(INFO) << " detections at 24x24: " << out->height();
+}
+
+#endif
+
+int main(int argc, const char** argv){
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
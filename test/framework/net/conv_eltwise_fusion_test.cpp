@@ -0,0 +1,113 @@
+#include <string>
+#include "net_test.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+
+/// 3x3 conv + batchnorm + scale (+ relu) keeping the channels of its input
+static void add_conv_bn_scale(GraphX86& graph, std::string name, std::string bottom,
+                              int channels, bool relu, unsigned int seed) {
+    auto conv = add_test_node(graph, name, "Convolution", {bottom});
+    conv->set_attr("group", 1);
+    conv->set_attr("filter_num", channels);
+    conv->set_attr("kernel_size", PTuple<int>(std::vector<int>{3, 3}));
+    conv->set_attr("padding", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("strides", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("dilation_rate", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("bias_term", false);
+    conv->set_attr("axis", 1);
+    conv->set_attr("weight_1", add_test_weights(graph, Shape(channels, channels, 3, 3), -0.2f, 0.2f, seed));
+
+    auto bn = add_test_node(graph, name + "_bn", "BatchNorm", {name});
+    bn->set_attr("epsilon", 1e-5f);
+    bn->set_attr("momentum", 1.f);
+    bn->set_attr("weight_1", add_test_weights(graph, Shape(channels, 1, 1, 1), -0.5f, 0.5f, seed + 1));
+    bn->set_attr("weight_2", add_test_weights(graph, Shape(channels, 1, 1, 1), 0.5f, 1.5f, seed + 2));
+    bn->set_attr("weight_3", add_test_weights(graph, Shape(1, 1, 1, 1), 1.f, 1.f, seed + 3));
+
+    auto scale = add_test_node(graph, name + "_scale", "Scale", {name + "_bn"});
+    scale->set_attr("axis", 1);
+    scale->set_attr("num_axes", 1);
+    scale->set_attr("bias_term", true);
+    scale->set_attr("weight_1", add_test_weights(graph, Shape(channels, 1, 1, 1), 0.5f, 1.5f, seed + 4));
+    scale->set_attr("weight_2", add_test_weights(graph, Shape(channels, 1, 1, 1), -0.5f, 0.5f, seed + 5));
+
+    if (relu) {
+        auto relu_node = add_test_node(graph, name + "_relu", "ReLU", {name + "_scale"});
+        relu_node->set_attr("alpha", 0.f);
+    }
+}
+
+/// a resnet basic block behind a stem conv: relu(conv_b(conv_a(x)) + x)
+static void build_residual_block(GraphX86& graph, int channels) {
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{2, channels, 7, 7}));
+    add_conv_bn_scale(graph, "stem", "input_0", channels, true, 11);
+    auto split = add_test_node(graph, "split", "Split", {"stem_relu"});
+    split->set_attr("split_num", 2);
+    add_conv_bn_scale(graph, "conv_a", "split", channels, true, 23);
+    add_conv_bn_scale(graph, "conv_b", "conv_a_relu", channels, false, 37);
+    auto eltwise = add_test_node(graph, "eltwise", "Eltwise", {"split", "conv_b_scale"});
+    eltwise->set_attr("type", std::string("Add"));
+    eltwise->set_attr("coeff", PTuple<float>(std::vector<float>{1.f, 1.f}));
+    auto relu = add_test_node(graph, "eltwise_relu", "ReLU", {"eltwise"});
+    relu->set_attr("alpha", 0.f);
+    add_test_node(graph, "output_0", "Output", {"eltwise_relu"});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+}
+
+static void fill_input(NetX86& net, int round) {
+    auto in = net.get_in("input_0");
+    for (int i = 0; i < in->valid_size(); i++) {
+        in->mutable_data()[i] = ((i * 7 + round * 13) % 17) / 8.f - 1.f;
+    }
+}
+
+TEST(NetTest, conv_eltwise_fusion_test) {
+    const int channels = 8;
+    GraphX86 graph;
+    build_residual_block(graph, channels);
+    GraphX86 fused_graph;
+    build_residual_block(fused_graph, channels);
+    // on by default, turned off the residual sum stays an op of its own
+    CHECK(fused_graph.conv_eltwise_fusion());
+    graph.set_conv_eltwise_fusion(false);
+    CHECK(graph.Optimize());
+    CHECK(fused_graph.Optimize());
+
+    // conv_b accumulates into the residual, the eltwise is left as a gather of its output
+    CHECK_EQ(graph["eltwise"]->get_op_name(), "EltwiseRelu");
+    CHECK_EQ(fused_graph["eltwise"]->get_op_name(), "Gather");
+
+    NetX86 net(graph);
+    NetX86 fused_net(fused_graph);
+    // the residual buffer is rewritten on every run, so the sums of two runs don't pile up
+    for (int round = 0; round < 2; round++) {
+        fill_input(net, round);
+        fill_input(fused_net, round);
+        net.prediction();
+        fused_net.prediction();
+        auto out = net.get_out("output_0");
+        auto fused_out = fused_net.get_out("output_0");
+        CHECK(out->valid_shape() == fused_out->valid_shape());
+        float max_diff = max_abs_diff(*out, *fused_out);
+        LOG(INFO) << " round " << round << " max diff of the fused block: " << max_diff;
+        CHECK_LT(max_diff, 1e-4f);
+    }
+}
+
+#endif
+
+int main(int argc, const char** argv){
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
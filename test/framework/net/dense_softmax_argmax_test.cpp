@@ -0,0 +1,94 @@
+#include <string>
+#include <algorithm>
+#include "net_test.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+
+/// input -> dense of 12 to 10 -> softmax -> top 2 argmax -> output
+static void build_head(GraphX86& graph, int softmax_axis, int argmax_axis) {
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{4, 12, 1, 1}));
+    auto dense = add_test_node(graph, "dense", "Dense", {"input_0"});
+    dense->set_attr("axis", 1);
+    dense->set_attr("out_dim", 10);
+    dense->set_attr("bias_term", true);
+    dense->set_attr("weight_1", add_test_weights(graph, Shape(1, 1, 10, 12), -0.5f, 0.5f, 5));
+    dense->set_attr("weight_2", add_test_weights(graph, Shape(1, 1, 1, 10), -0.5f, 0.5f, 6));
+    auto softmax = add_test_node(graph, "softmax", "Softmax", {"dense"});
+    softmax->set_attr("axis", softmax_axis);
+    auto argmax = add_test_node(graph, "argmax", "Argmax", {"softmax"});
+    argmax->set_attr("out_max_val", false);
+    argmax->set_attr("top_k", 2);
+    argmax->set_attr("axis_term", argmax_axis >= 0);
+    argmax->set_attr("axis", argmax_axis);
+    add_test_node(graph, "output_0", "Output", {"argmax"});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+}
+
+TEST(NetTest, dense_softmax_argmax_fusion_test) {
+    // softmax and argmax along the dense outputs fuse
+    GraphX86 graph;
+    build_head(graph, 1, -1);
+    CHECK(graph.Optimize());
+    CHECK_EQ(graph["dense"]->get_op_name(), "DenseSoftmaxArgmax");
+    CHECK(!graph.has_vertex("softmax"));
+
+    // and give the top logits
+    NetX86 net(graph);
+    auto in = net.get_in("input_0");
+    for (int i = 0; i < in->valid_size(); i++) {
+        in->mutable_data()[i] = ((i * 7) % 17) / 8.f - 1.f;
+    }
+    net.prediction();
+    GraphX86 ref_graph;
+    build_head(ref_graph, 1, -1);
+    std::string weight_name = "weight_1";
+    std::string bias_name = "weight_2";
+    auto weights = ref_graph["dense"]->get_attr<PBlock<float, X86> >(weight_name).vector();
+    auto bias = ref_graph["dense"]->get_attr<PBlock<float, X86> >(bias_name).vector();
+    auto out = net.get_out("output_0");
+    CHECK(out->valid_shape() == Shape(4, 1, 2, 1));
+    for (int m = 0; m < 4; m++) {
+        std::vector<std::pair<float, int> > logits;
+        for (int n = 0; n < 10; n++) {
+            float sum = bias[n];
+            for (int k = 0; k < 12; k++) {
+                sum += in->data()[m * 12 + k] * weights[n * 12 + k];
+            }
+            logits.emplace_back(-sum, n);
+        }
+        std::sort(logits.begin(), logits.end());
+        CHECK_EQ(out->data()[m * 2], logits[0].second);
+        CHECK_EQ(out->data()[m * 2 + 1], logits[1].second);
+    }
+
+    // the x86 kernel has no other axis, those heads keep their ops
+    GraphX86 softmax_axis_graph;
+    build_head(softmax_axis_graph, 0, -1);
+    CHECK(softmax_axis_graph.Optimize());
+    CHECK_EQ(softmax_axis_graph["dense"]->get_op_name(), "Dense");
+    CHECK_EQ(softmax_axis_graph["softmax"]->get_op_name(), "Softmax");
+
+    GraphX86 argmax_axis_graph;
+    build_head(argmax_axis_graph, 1, 0);
+    CHECK(argmax_axis_graph.Optimize());
+    CHECK_EQ(argmax_axis_graph["dense"]->get_op_name(), "Dense");
+    CHECK_EQ(argmax_axis_graph["argmax"]->get_op_name(), "Argmax");
+}
+
+#endif
+
+int main(int argc, const char** argv){
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include "net_test.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+
+/// conv + batchnorm + scale (+ relu), padded to keep the spatial size
+static void add_conv_bn_scale(GraphX86& graph, std::string name, std::string bottom, int in_c,
+                              int out_c, int kernel, int group, bool relu, unsigned int seed) {
+    auto conv = add_test_node(graph, name, "Convolution", {bottom});
+    conv->set_attr("group", group);
+    conv->set_attr("filter_num", out_c);
+    conv->set_attr("kernel_size", PTuple<int>(std::vector<int>{kernel, kernel}));
+    conv->set_attr("padding", PTuple<int>(std::vector<int>{kernel / 2, kernel / 2}));
+    conv->set_attr("strides", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("dilation_rate", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("bias_term", false);
+    conv->set_attr("axis", 1);
+    conv->set_attr("weight_1", add_test_weights(graph, Shape(out_c, in_c / group, kernel, kernel),
+                                                -0.3f, 0.3f, seed));
+
+    auto bn = add_test_node(graph, name + "_bn", "BatchNorm", {name});
+    bn->set_attr("epsilon", 1e-5f);
+    bn->set_attr("momentum", 1.f);
+    bn->set_attr("weight_1", add_test_weights(graph, Shape(out_c, 1, 1, 1), -0.5f, 0.5f, seed + 1));
+    bn->set_attr("weight_2", add_test_weights(graph, Shape(out_c, 1, 1, 1), 0.5f, 1.5f, seed + 2));
+    bn->set_attr("weight_3", add_test_weights(graph, Shape(1, 1, 1, 1), 1.f, 1.f, seed + 3));
+
+    auto scale = add_test_node(graph, name + "_scale", "Scale", {name + "_bn"});
+    scale->set_attr("axis", 1);
+    scale->set_attr("num_axes", 1);
+    scale->set_attr("bias_term", true);
+    scale->set_attr("weight_1", add_test_weights(graph, Shape(out_c, 1, 1, 1), 0.5f, 1.5f, seed + 4));
+    scale->set_attr("weight_2", add_test_weights(graph, Shape(out_c, 1, 1, 1), -0.5f, 0.5f, seed + 5));
+
+    if (relu) {
+        auto relu_node = add_test_node(graph, name + "_relu", "ReLU", {name + "_scale"});
+        relu_node->set_attr("alpha", 0.f);
+    }
+}
+
+enum BlockKind {
+    MOBILENET,      ///< depthwise 3x3 then pointwise 1x1, each with bn, scale and relu
+    SECOND_3X3,     ///< a 3x3 second conv, not pointwise
+    SHORT_CHAIN     ///< the graph ends right after the second conv, before the pattern does
+};
+
+static void build_block(GraphX86& graph, BlockKind kind) {
+    const int channels = 8;
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{2, channels, 9, 9}));
+    add_conv_bn_scale(graph, "dw", "input_0", channels, channels, 3, channels, true, 7);
+    std::string pw_bottom = "dw_relu";
+    std::string top;
+    if (kind == SHORT_CHAIN) {
+        auto pw = add_test_node(graph, "pw", "Convolution", {pw_bottom});
+        pw->set_attr("group", 1);
+        pw->set_attr("filter_num", 2 * channels);
+        pw->set_attr("kernel_size", PTuple<int>(std::vector<int>{1, 1}));
+        pw->set_attr("padding", PTuple<int>(std::vector<int>{0, 0}));
+        pw->set_attr("strides", PTuple<int>(std::vector<int>{1, 1}));
+        pw->set_attr("dilation_rate", PTuple<int>(std::vector<int>{1, 1}));
+        pw->set_attr("bias_term", false);
+        pw->set_attr("axis", 1);
+        pw->set_attr("weight_1", add_test_weights(graph, Shape(2 * channels, channels, 1, 1), -0.3f, 0.3f, 19));
+        top = "pw";
+    } else {
+        add_conv_bn_scale(graph, "pw", pw_bottom, channels, 2 * channels,
+                          kind == SECOND_3X3 ? 3 : 1, 1, true, 19);
+        top = "pw_relu";
+    }
+    add_test_node(graph, "output_0", "Output", {top});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+}
+
+static void fill_input(Tensor4d<X86, AK_FLOAT>& in) {
+    for (int i = 0; i < in.valid_size(); i++) {
+        in.mutable_data()[i] = ((i * 5) % 23) / 11.f - 1.f;
+    }
+}
+
+static std::vector<float> weights_of(GraphX86& graph, std::string node, std::string name) {
+    return graph[node]->get_attr<PBlock<float, X86> >(name).vector();
+}
+
+/// conv of the nchw input, then batchnorm, scale and relu per channel, computed on the host
+static std::vector<float> conv_bn_scale_relu(GraphX86& graph, std::string name,
+                                             const std::vector<float>& in, int num, int in_c,
+                                             int out_c, int h, int w, int kernel, int group) {
+    auto weight = weights_of(graph, name, "weight_1");
+    auto mean = weights_of(graph, name + "_bn", "weight_1");
+    auto variance = weights_of(graph, name + "_bn", "weight_2");
+    auto scale = weights_of(graph, name + "_scale", "weight_1");
+    auto bias = weights_of(graph, name + "_scale", "weight_2");
+    const int pad = kernel / 2;
+    const int in_c_per_group = in_c / group;
+    const int out_c_per_group = out_c / group;
+    std::vector<float> out(num * out_c * h * w);
+    for (int n = 0; n < num; n++) {
+        for (int oc = 0; oc < out_c; oc++) {
+            int g = oc / out_c_per_group;
+            float alpha = scale[oc] / std::sqrt(variance[oc] + 1e-5f);
+            for (int y = 0; y < h; y++) {
+                for (int x = 0; x < w; x++) {
+                    float sum = 0.f;
+                    for (int ic = 0; ic < in_c_per_group; ic++) {
+                        int c = g * in_c_per_group + ic;
+                        for (int ky = 0; ky < kernel; ky++) {
+                            for (int kx = 0; kx < kernel; kx++) {
+                                int iy = y + ky - pad;
+                                int ix = x + kx - pad;
+                                if (iy < 0 || iy >= h || ix < 0 || ix >= w) {
+                                    continue;
+                                }
+                                sum += in[((n * in_c + c) * h + iy) * w + ix]
+                                       * weight[((oc * in_c_per_group + ic) * kernel + ky) * kernel + kx];
+                            }
+                        }
+                    }
+                    float value = (sum - mean[oc]) * alpha + bias[oc];
+                    out[((n * out_c + oc) * h + y) * w + x] = std::max(value, 0.f);
+                }
+            }
+        }
+    }
+    return out;
+}
+
+TEST(NetTest, dw_pw_fusion_test) {
+    // a mobilenet v1 block fuses into one op
+    GraphX86 graph;
+    build_block(graph, MOBILENET);
+    CHECK(graph.Optimize());
+    CHECK_EQ(graph["dw"]->get_op_name(), "DepthwisePointwiseConv");
+    CHECK(!graph.has_vertex("pw"));
+
+    // and computes what the two convs compute apart. the x86 conv doesn't run a depthwise
+    // conv on its own, so the unfused block is computed on the host
+    NetX86 net(graph);
+    auto in = net.get_in("input_0");
+    fill_input(*in);
+    net.prediction();
+    GraphX86 ref_graph;
+    build_block(ref_graph, MOBILENET);
+    std::vector<float> input(in->data(), in->data() + in->valid_size());
+    auto dw_out = conv_bn_scale_relu(ref_graph, "dw", input, 2, 8, 8, 9, 9, 3, 8);
+    auto ref = conv_bn_scale_relu(ref_graph, "pw", dw_out, 2, 8, 16, 9, 9, 1, 1);
+    auto out = net.get_out("output_0");
+    CHECK(out->valid_shape() == Shape(2, 16, 9, 9));
+    float max_diff = 0.f;
+    for (int i = 0; i < out->valid_size(); i++) {
+        max_diff = std::max(max_diff, std::abs(out->data()[i] - ref[i]));
+    }
+    LOG(INFO) << " max diff of the fused block: " << max_diff;
+    CHECK_LT(max_diff, 1e-4f);
+
+    // lazily loaded weights aren't filled yet when Optimize picks the fusions, it fuses all the same
+    std::string path = "dw_pw_fusion.anakin.bin";
+    {
+        GraphX86 unfused;
+        build_block(unfused, MOBILENET);
+        // only scheduled, so the block is saved unfused
+        unfused.statistics.set_info<graph::IS_OPTIMIZED>(true);
+        CHECK(unfused.Optimize());
+        CHECK(unfused.save(path));
+    }
+    GraphX86 lazy;
+    lazy.set_lazy_weights(true);
+    CHECK(lazy.load(path));
+    lazy.statistics.set_info<graph::IS_OPTIMIZED>(false);
+    CHECK(lazy.Optimize());
+    CHECK_EQ(lazy["dw"]->get_op_name(), "DepthwisePointwiseConv");
+    NetX86 lazy_net(lazy);
+    fill_input(*lazy_net.get_in("input_0"));
+    lazy_net.prediction();
+    CHECK_LT(max_abs_diff(*lazy_net.get_out("output_0"), *out), 1e-5f);
+    remove(path.c_str());
+
+    // a 3x3 second conv matches the pattern, the fusion filter turns it down
+    GraphX86 conv3x3_graph;
+    build_block(conv3x3_graph, SECOND_3X3);
+    CHECK(conv3x3_graph.Optimize());
+    CHECK_EQ(conv3x3_graph["dw"]->get_op_name(), "ConvBatchnormScaleRelu");
+    CHECK_EQ(conv3x3_graph["pw"]->get_op_name(), "ConvBatchnormScaleRelu");
+
+    // a chain ending before the pattern does doesn't match it
+    GraphX86 short_graph;
+    build_block(short_graph, SHORT_CHAIN);
+    CHECK(short_graph.Optimize());
+    CHECK_EQ(short_graph["dw"]->get_op_name(), "ConvBatchnormScaleRelu");
+    CHECK_EQ(short_graph["pw"]->get_op_name(), "Convolution");
+}
+
+#endif
+
+int main(int argc, const char** argv){
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <string>
+#include "net_test.h"
+#include "framework/operators/eltwise_op.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+
+/// (in0 * in1) + in2 as one eltwise node with a chain, followed by a relu or not
+static void build_chain(GraphX86& graph, bool relu) {
+    std::vector<std::string> bottoms;
+    for (int i = 0; i < 3; i++) {
+        std::string name = "input_" + std::to_string(i);
+        auto in = add_test_node(graph, name, "Input");
+        in->set_attr("input_shape", PTuple<int>(std::vector<int>{2, 4, 3, 5}));
+        graph.add_in(name);
+        bottoms.push_back(name);
+    }
+    auto eltwise = add_test_node(graph, "eltwise", "Eltwise", bottoms);
+    eltwise->set_attr("type", std::string("Mul"));
+    eltwise->set_attr("coeff", PTuple<float>(std::vector<float>{1.f, 1.f, 1.f}));
+    eltwise->set_attr("chain", PTuple<std::string>(std::vector<std::string>{"Mul", "Add"}));
+    std::string top = "eltwise";
+    if (relu) {
+        auto relu_node = add_test_node(graph, "eltwise_relu", "ReLU", {"eltwise"});
+        relu_node->set_attr("alpha", 0.f);
+        top = "eltwise_relu";
+    }
+    add_test_node(graph, "output_0", "Output", {top});
+    graph.add_out("output_0");
+}
+
+static void check_chain(bool relu) {
+    GraphX86 graph;
+    build_chain(graph, relu);
+    CHECK(graph.Optimize());
+    if (relu) {
+        // the relu is fused and the chain goes along with the eltwise attributes
+        CHECK_EQ(graph["eltwise"]->get_op_name(), "EltwiseRelu");
+    }
+    NetX86 net(graph);
+
+    std::vector<float*> ins;
+    for (int i = 0; i < 3; i++) {
+        auto in = net.get_in("input_" + std::to_string(i));
+        for (int j = 0; j < in->valid_size(); j++) {
+            in->mutable_data()[j] = ((j * (i + 3) + 5 * i) % 11) / 4.f - 1.25f;
+        }
+        ins.push_back(in->mutable_data());
+    }
+    net.prediction();
+
+    auto out = net.get_out("output_0");
+    float max_diff = 0.f;
+    for (int j = 0; j < out->valid_size(); j++) {
+        float ref = ins[0][j] * ins[1][j] + ins[2][j];
+        if (relu) {
+            ref = std::max(ref, 0.f);
+        }
+        max_diff = std::max(max_diff, std::abs(out->data()[j] - ref));
+    }
+    LOG(INFO) << "eltwise chain" << (relu ? " relu" : "") << ", max_diff " << max_diff;
+    CHECK_LT(max_diff, 1e-5f) << "eltwise chain check failed";
+}
+
+TEST(NetTest, eltwise_chain_test) {
+    check_chain(false);
+    check_chain(true);
+
+    // an op the kernels don't know is refused instead of taken for a product
+    std::vector<EltwiseType> chain_ops;
+    CHECK(ops::parse_eltwise_chain(PTuple<std::string>(std::vector<std::string>{"Multiply", "Max"}),
+                                   chain_ops));
+    CHECK(chain_ops == std::vector<EltwiseType>({Eltwise_prod, Eltwise_max}));
+    CHECK(!ops::parse_eltwise_chain(PTuple<std::string>(std::vector<std::string>{"Add", "Sub"}),
+                                    chain_ops));
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
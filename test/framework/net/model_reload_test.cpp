@@ -0,0 +1,261 @@
+#include <string>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include "net_test.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+typedef Tensor4d<X86, AK_FLOAT> TensorX86;
+
+/// input -> 3x3 conv of 4 to 6 channels -> output saved as a model, weights drawn from seed
+static void save_conv_model(std::string path, unsigned int seed) {
+    GraphX86 graph;
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{2, 4, 5, 5}));
+    auto conv = add_test_node(graph, "conv_0", "Convolution", {"input_0"});
+    conv->set_attr("group", 1);
+    conv->set_attr("filter_num", 6);
+    conv->set_attr("kernel_size", PTuple<int>(std::vector<int>{3, 3}));
+    conv->set_attr("padding", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("strides", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("dilation_rate", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("bias_term", true);
+    conv->set_attr("axis", 1);
+    conv->set_attr("weight_1", add_test_weights(graph, Shape(6, 4, 3, 3), -0.3f, 0.3f, seed));
+    conv->set_attr("weight_2", add_test_weights(graph, Shape(1, 6, 1, 1), -0.3f, 0.3f, seed + 1));
+    add_test_node(graph, "output_0", "Output", {"conv_0"});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+    // the nodes are saved in their exec order
+    CHECK(graph.Optimize());
+    CHECK(graph.save(path));
+}
+
+static void fill_input(TensorX86& in) {
+    for (int i = 0; i < in.valid_size(); i++) {
+        in.mutable_data()[i] = ((i * 7) % 19) / 9.f - 1.f;
+    }
+}
+
+/// output of a model for fill_input, run on a net of its own
+static void model_output(std::string path, TensorX86& out) {
+    GraphX86 graph;
+    CHECK(graph.load(path));
+    CHECK(graph.Optimize());
+    NetX86 net(graph);
+    fill_input(*net.get_in("input_0"));
+    net.prediction();
+    out.re_alloc(net.get_out("output_0")->valid_shape());
+    out.copy_from(*net.get_out("output_0"));
+}
+
+TEST(NetTest, weights_arena_test) {
+    std::string path = "model_reload_a.anakin.bin";
+    save_conv_model(path, 3);
+    TensorX86 expect;
+    model_output(path, expect);
+
+    GraphX86* graph = new GraphX86();
+    CHECK(graph->load(path));
+    auto arena = graph->weights_arena();
+    CHECK_EQ(arena->get_pool_size<AK_FLOAT>(), 2);
+    CHECK_EQ(arena->get_pending_size(), 0);
+    // weights are allocated aligned for the simd kernels
+    std::string weight_name = "weight_1";
+    auto weight = (*graph)["conv_0"]->get_attr<PBlock<float, X86> >(weight_name);
+    CHECK_EQ(reinterpret_cast<size_t>(weight.h_tensor().data()) % MALLOC_ALIGN, 0);
+    CHECK(graph->Optimize());
+
+    // the graphs copied from a graph, like the one of a net, share its arena
+    NetX86* net = new NetX86(*graph);
+    {
+        GraphX86 copy;
+        copy.CopyFrom(*graph);
+        CHECK(copy.weights_arena() == arena);
+    }
+    // and keep the weights alive once the graph is gone
+    delete graph;
+    CHECK_GT(arena.use_count(), 1);
+    fill_input(*net->get_in("input_0"));
+    net->prediction();
+    CHECK_LT(max_abs_diff(*net->get_out("output_0"), expect), 1e-5f);
+    // the last one frees them
+    delete net;
+    CHECK_EQ(arena.use_count(), 1);
+    remove(path.c_str());
+}
+
+TEST(NetTest, lazy_weights_test) {
+    std::string path = "model_reload_a.anakin.bin";
+    save_conv_model(path, 3);
+    TensorX86 expect;
+    model_output(path, expect);
+    std::string weight_name = "weight_1";
+    std::string bias_name = "weight_2";
+    GraphX86 eager;
+    CHECK(eager.load(path));
+    auto eager_weight = eager["conv_0"]->get_attr<PBlock<float, X86> >(weight_name);
+
+    // the weights are filled at the end of Optimize, just as they would have been at load
+    GraphX86 lazy;
+    lazy.set_lazy_weights(true);
+    CHECK(lazy.load(path));
+    CHECK_EQ(lazy.weights_arena()->get_pending_size(), 2);
+    // shaped right away, optimization looks at the shapes
+    auto pending_weight = lazy["conv_0"]->get_attr<PBlock<float, X86> >(weight_name);
+    CHECK(pending_weight.shape() == eager_weight.shape());
+    CHECK(lazy.Optimize());
+    CHECK_EQ(lazy.weights_arena()->get_pending_size(), 0);
+    auto lazy_weight = lazy["conv_0"]->get_attr<PBlock<float, X86> >(weight_name);
+    CHECK(lazy_weight.shape() == eager_weight.shape());
+    CHECK_EQ(max_abs_diff(lazy_weight.h_tensor(), eager_weight.h_tensor()), 0.f);
+    NetX86 net(lazy);
+    fill_input(*net.get_in("input_0"));
+    net.prediction();
+    CHECK_LT(max_abs_diff(*net.get_out("output_0"), expect), 1e-5f);
+
+    // a block no node refers to any more is released unfilled
+    GraphX86 dropped;
+    dropped.set_lazy_weights(true);
+    CHECK(dropped.load(path));
+    dropped["conv_0"]->remove_attr(bias_name);
+    dropped.weights_arena()->materialize(2);
+    CHECK_EQ(dropped.weights_arena()->get_pending_size(), 0);
+    CHECK_EQ(dropped.weights_arena()->get_pool_size<AK_FLOAT>(), 1);
+    auto dropped_weight = dropped["conv_0"]->get_attr<PBlock<float, X86> >(weight_name);
+    CHECK_EQ(max_abs_diff(dropped_weight.h_tensor(), eager_weight.h_tensor()), 0.f);
+    remove(path.c_str());
+}
+
+TEST(NetTest, worker_reload_test) {
+    std::string path_a = "model_reload_a.anakin.bin";
+    std::string path_b = "model_reload_b.anakin.bin";
+    save_conv_model(path_a, 3);
+    save_conv_model(path_b, 31);
+    TensorX86 expect_a;
+    TensorX86 expect_b;
+    model_output(path_a, expect_a);
+    model_output(path_b, expect_b);
+    CHECK_GT(max_abs_diff(expect_a, expect_b), 1e-2f);
+
+    Worker<X86, AK_FLOAT, Precision::FP32> worker(path_a, 3);
+    worker.register_inputs({"input_0"});
+    worker.register_outputs({"output_0"});
+    worker.Reshape("input_0", {2, 4, 5, 5});
+    worker.launch();
+
+    // every request is served by one version or the other, and a client never goes back
+    const int client_num = 3;
+    std::atomic<bool> reloaded{false};
+    std::atomic<int> served_a{0};
+    std::atomic<int> served_b{0};
+    auto client = [&]() {
+        TensorX86 in(Shape(2, 4, 5, 5));
+        TensorX86 out(expect_a.valid_shape());
+        fill_input(in);
+        std::vector<Tensor4dPtr<X86, AK_FLOAT> > ins(1, &in);
+        std::vector<Tensor4dPtr<X86, AK_FLOAT> > outs(1, &out);
+        bool on_b = false;
+        // keeps going until 20 requests are sent after the reload is done
+        for (int after_reload = 0; after_reload < 20; ) {
+            bool sent_after_reload = reloaded;
+            worker.sync_prediction_zero_copy(ins, outs);
+            if (max_abs_diff(out, expect_a) < 1e-5f) {
+                CHECK(!on_b) << " request went back to the old version";
+                CHECK(!sent_after_reload) << " request served by the old version after the reload";
+                served_a++;
+            } else {
+                CHECK_LT(max_abs_diff(out, expect_b), 1e-5f) << " output of neither version";
+                on_b = true;
+                served_b++;
+            }
+            after_reload += sent_after_reload;
+        }
+    };
+    std::vector<std::thread> clients;
+    for (int i = 0; i < client_num; i++) {
+        clients.emplace_back(client);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    // ready once the old version is freed
+    CHECK(worker.reload(path_b).get());
+    reloaded = true;
+    for (auto& thread : clients) {
+        thread.join();
+    }
+    LOG(INFO) << " requests served by the old version: " << served_a << ", by the new one: " << served_b;
+
+    // everything after the reload runs on the new version
+    TensorX86 in(Shape(2, 4, 5, 5));
+    TensorX86 out(expect_b.valid_shape());
+    fill_input(in);
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> > ins(1, &in);
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> > outs(1, &out);
+    worker.sync_prediction_zero_copy(ins, outs);
+    CHECK_LT(max_abs_diff(out, expect_b), 1e-5f);
+    CHECK_GE(served_b, client_num * 20);
+
+    // outputs handed back by a version outlive it
+    auto results = worker.sync_prediction(ins);
+    CHECK_LT(max_abs_diff(*results[0], expect_b), 1e-5f);
+    CHECK(worker.reload(path_a).get());
+    CHECK_LT(max_abs_diff(*results[0], expect_b), 1e-5f);
+    remove(path_a.c_str());
+    remove(path_b.c_str());
+}
+
+TEST(NetTest, worker_shutdown_test) {
+    std::string path = "model_reload_a.anakin.bin";
+    save_conv_model(path, 3);
+    TensorX86 expect;
+    model_output(path, expect);
+    TensorX86 in(Shape(2, 4, 5, 5));
+    fill_input(in);
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> > ins(1, &in);
+
+    // every request reaches its callback, run or dropped at shutdown
+    const int request_num = 64;
+    std::atomic<int> done{0};
+    std::atomic<int> dropped{0};
+    {
+        Worker<X86, AK_FLOAT, Precision::FP32> worker(path, 2);
+        worker.register_inputs({"input_0"});
+        worker.register_outputs({"output_0"});
+        worker.Reshape("input_0", {2, 4, 5, 5});
+        worker.launch();
+        for (int i = 0; i < request_num; i++) {
+            worker.async_submit(ins, [&](size_t id, Worker<X86, AK_FLOAT, Precision::FP32>::AsyncOutputs& outs) {
+                if (outs.empty()) {
+                    dropped++;
+                    return;
+                }
+                CHECK_LT(max_abs_diff(*outs[0], expect), 1e-5f);
+                done++;
+            });
+            // some are served, the others are still queued at shutdown
+            while (i == request_num / 2 && done == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+    LOG(INFO) << " requests done: " << done << ", dropped: " << dropped;
+    CHECK_GT(done, 0);
+    CHECK_EQ(done + dropped, request_num);
+    remove(path.c_str());
+}
+
+#endif
+
+int main(int argc, const char** argv){
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
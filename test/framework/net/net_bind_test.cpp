@@ -0,0 +1,205 @@
+#include <string>
+#include <cstdio>
+#include "net_test.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+typedef Tensor4d<X86, AK_FLOAT> TensorX86;
+
+/// input -> 3x3 conv of 4 to 6 channels -> output
+static void build_conv_net(GraphX86& graph) {
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{2, 4, 5, 5}));
+    auto conv = add_test_node(graph, "conv_0", "Convolution", {"input_0"});
+    conv->set_attr("group", 1);
+    conv->set_attr("filter_num", 6);
+    conv->set_attr("kernel_size", PTuple<int>(std::vector<int>{3, 3}));
+    conv->set_attr("padding", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("strides", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("dilation_rate", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("bias_term", true);
+    conv->set_attr("axis", 1);
+    conv->set_attr("weight_1", add_test_weights(graph, Shape(6, 4, 3, 3), -0.3f, 0.3f, 3));
+    conv->set_attr("weight_2", add_test_weights(graph, Shape(1, 6, 1, 1), -0.3f, 0.3f, 17));
+    add_test_node(graph, "output_0", "Output", {"conv_0"});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+}
+
+/// input -> split -> 3x3 conv of 4 to 6 channels -> flatten -> output, the edges next to
+/// split and flatten alias the memory of another edge
+static void build_aliased_net(GraphX86& graph) {
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{2, 4, 5, 5}));
+    auto split = add_test_node(graph, "split_0", "Split", {"input_0"});
+    split->set_attr("split_num", 1);
+    auto conv = add_test_node(graph, "conv_0", "Convolution", {"split_0"});
+    conv->set_attr("group", 1);
+    conv->set_attr("filter_num", 6);
+    conv->set_attr("kernel_size", PTuple<int>(std::vector<int>{3, 3}));
+    conv->set_attr("padding", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("strides", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("dilation_rate", PTuple<int>(std::vector<int>{1, 1}));
+    conv->set_attr("bias_term", true);
+    conv->set_attr("axis", 1);
+    conv->set_attr("weight_1", add_test_weights(graph, Shape(6, 4, 3, 3), -0.3f, 0.3f, 3));
+    conv->set_attr("weight_2", add_test_weights(graph, Shape(1, 6, 1, 1), -0.3f, 0.3f, 17));
+    auto flatten = add_test_node(graph, "flatten_0", "Flatten", {"conv_0"});
+    flatten->set_attr("start_axis", 1);
+    flatten->set_attr("end_axis", -1);
+    add_test_node(graph, "output_0", "Output", {"flatten_0"});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+}
+
+static void fill_input(TensorX86& in) {
+    for (int i = 0; i < in.valid_size(); i++) {
+        in.mutable_data()[i] = ((i * 7) % 19) / 9.f - 1.f;
+    }
+}
+
+TEST(NetTest, net_bind_test) {
+    GraphX86 graph;
+    build_conv_net(graph);
+    CHECK(graph.Optimize());
+    NetX86 net(graph);
+
+    // outputs of the net on its own memory
+    auto own_in = net.get_in("input_0");
+    auto own_out = net.get_out("output_0");
+    const float* own_in_data = own_in->data();
+    const float* own_out_data = own_out->data();
+    fill_input(*own_in);
+    net.prediction();
+    TensorX86 expect(own_out->valid_shape());
+    expect.copy_from(*own_out);
+
+    // bound tensors are used as they are, nothing is copied in or out
+    TensorX86 in(Shape(2, 4, 5, 5));
+    TensorX86 out(expect.valid_shape());
+    fill_input(in);
+    const float* out_data = out.data();
+    CHECK(net.bind_in("input_0", &in));
+    CHECK(net.bind_out("output_0", &out));
+    CHECK(!net.bind_out("output_0", &out)) << " an output is bound only once";
+    CHECK_EQ(net.get_in("input_0")->data(), in.data());
+    CHECK_EQ(net.get_out("output_0")->data(), out_data);
+    net.prediction();
+    net.unbind();
+    CHECK_EQ(out.data(), out_data);
+    CHECK(out.valid_shape() == expect.valid_shape());
+    CHECK_LT(max_abs_diff(out, expect), 1e-5f);
+
+    // unbind gives the net its own memory back
+    CHECK_EQ(net.get_in("input_0")->data(), own_in_data);
+    CHECK_EQ(net.get_out("output_0")->data(), own_out_data);
+
+    // an output outgrowing the bound tensor is computed on the net's memory, then copied
+    TensorX86 small_out(Shape(1, 6, 5, 5));
+    fill_input(in);
+    CHECK(net.bind_in("input_0", &in));
+    CHECK(net.bind_out("output_0", &small_out));
+    net.prediction();
+    CHECK_EQ(net.get_out("output_0")->data(), own_out_data);
+    net.unbind();
+    CHECK(small_out.valid_shape() == expect.valid_shape());
+    CHECK_LT(max_abs_diff(small_out, expect), 1e-5f);
+
+    // and the net still runs on its own memory
+    fill_input(*net.get_in("input_0"));
+    net.prediction();
+    CHECK_EQ(net.get_out("output_0")->data(), own_out_data);
+    CHECK_LT(max_abs_diff(*net.get_out("output_0"), expect), 1e-5f);
+}
+
+TEST(NetTest, net_bind_aliased_test) {
+    GraphX86 graph;
+    build_aliased_net(graph);
+    CHECK(graph.Optimize());
+    NetX86 net(graph);
+    fill_input(*net.get_in("input_0"));
+    net.prediction();
+    TensorX86 expect(net.get_out("output_0")->valid_shape());
+    expect.copy_from(*net.get_out("output_0"));
+    CHECK(expect.valid_shape() == Shape(2, 150, 1, 1));
+
+    // the split and flatten would keep the old memory, nothing is bound
+    TensorX86 in(Shape(2, 4, 5, 5));
+    TensorX86 out(expect.valid_shape());
+    CHECK(!net.bind_in("input_0", &in)) << " an input feeding a split is bound";
+    CHECK(!net.bind_out("output_0", &out)) << " an output of a flatten is bound";
+    net.unbind();
+
+    // and the worker copies them instead
+    std::string path = "net_bind_aliased.anakin.bin";
+    CHECK(graph.save(path));
+    Worker<X86, AK_FLOAT, Precision::FP32> worker(path, 1);
+    worker.register_inputs({"input_0"});
+    worker.register_outputs({"output_0"});
+    worker.Reshape("input_0", {2, 4, 5, 5});
+    worker.launch();
+    fill_input(in);
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> > ins(1, &in);
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> > outs(1, &out);
+    for (int i = 0; i < 2; i++) {
+        fill_input(out);
+        worker.sync_prediction_zero_copy(ins, outs);
+        CHECK(out.valid_shape() == expect.valid_shape());
+        CHECK_LT(max_abs_diff(out, expect), 1e-5f);
+    }
+    remove(path.c_str());
+}
+
+TEST(NetTest, worker_zero_copy_test) {
+    std::string path = "net_bind_conv.anakin.bin";
+    GraphX86 graph;
+    build_conv_net(graph);
+    // the nodes are saved in their exec order
+    CHECK(graph.Optimize());
+    CHECK(graph.save(path));
+    Worker<X86, AK_FLOAT, Precision::FP32> worker(path, 1);
+    worker.register_inputs({"input_0"});
+    worker.register_outputs({"output_0"});
+    worker.Reshape("input_0", {2, 4, 5, 5});
+    worker.launch();
+
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> > ins(1, new TensorX86(Shape(2, 4, 5, 5)));
+    fill_input(*ins[0]);
+    auto results = worker.sync_prediction(ins);
+    TensorX86 expect(results[0]->valid_shape());
+    expect.copy_from(*results[0]);
+
+    // the output is computed right into a tensor big enough, and copied into one too small
+    std::vector<Tensor4dPtr<X86, AK_FLOAT> > outs(1, new TensorX86(expect.valid_shape()));
+    const float* out_data = outs[0]->data();
+    worker.sync_prediction_zero_copy(ins, outs);
+    CHECK_EQ(outs[0]->data(), out_data);
+    CHECK_LT(max_abs_diff(*outs[0], expect), 1e-5f);
+    delete outs[0];
+    outs[0] = new TensorX86(Shape(1, 6, 5, 5));
+    worker.sync_prediction_zero_copy(ins, outs);
+    CHECK(outs[0]->valid_shape() == expect.valid_shape());
+    CHECK_LT(max_abs_diff(*outs[0], expect), 1e-5f);
+
+    // the worker's net isn't left on the caller memory
+    delete outs[0];
+    results = worker.sync_prediction(ins);
+    CHECK_LT(max_abs_diff(*results[0], expect), 1e-5f);
+    delete ins[0];
+    remove(path.c_str());
+}
+
+#endif
+
+int main(int argc, const char** argv){
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
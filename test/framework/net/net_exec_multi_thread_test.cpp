@@ -154,8 +154,61 @@ TEST(NetTest, net_execute_muti_thread_async_test) {
 
 	check.join();
 }
-#endif 
 #endif
+#endif
+
+TEST(NetTest, net_execute_muti_thread_async_submit_test) {
+    LOG(WARNING) << "Async submit multi_threads for model: " << model_path;
+    // callbacks may still run while workers shut down, so it outlives them
+    std::atomic<int> callback_num{0};
+    Worker<Target, AK_FLOAT, Precision::FP32>  workers(model_path, 4);
+    workers.register_inputs({"input_0"});
+    workers.register_outputs({"prob_out"});
+    workers.Reshape("input_0", {1, 3, 224, 224});
+
+    workers.launch();
+
+    std::vector<Tensor4dPtr<target_host<Target>::type, AK_FLOAT> > host_tensor_p_in_list;
+    saber::Shape valid_shape_in({1, 3, 224, 224});
+    Tensor4dPtr<target_host<Target>::type, AK_FLOAT> h_tensor_in = new Tensor4d<target_host<Target>::type, AK_FLOAT>(valid_shape_in);
+    float* h_data = h_tensor_in->mutable_data();
+    for (int i=0; i<h_tensor_in->size(); i++) {
+        h_data[i] = 1.0f;
+    }
+    host_tensor_p_in_list.push_back(h_tensor_in);
+
+    int epoch = 200;
+    for (int i = 0; i < epoch; i++) {
+        if (i % 2) {
+            workers.async_submit(host_tensor_p_in_list,
+                    [&](size_t id, Worker<Target, AK_FLOAT, Precision::FP32>::AsyncOutputs& outs) {
+                CHECK_EQ(outs.size(), 1);
+                callback_num++;
+            });
+        } else {
+            workers.async_submit(host_tensor_p_in_list);
+        }
+    }
+
+    // every request has its own outputs, so they all hold the same result
+    Worker<Target, AK_FLOAT, Precision::FP32>::AsyncOutputs first;
+    int ready_num = 0;
+    Worker<Target, AK_FLOAT, Precision::FP32>::AsyncOutputs outs;
+    while (workers.async_get_ready(outs)) {
+        if (first.empty()) {
+            first = outs;
+            continue;
+        }
+        CHECK_EQ(outs[0]->valid_size(), first[0]->valid_size());
+        CHECK_NE(outs[0]->data(), first[0]->data());
+        for (int i = 0; i < outs[0]->valid_size(); i++) {
+            CHECK_EQ(outs[0]->data()[i], first[0]->data()[i]);
+        }
+        ready_num++;
+    }
+    LOG(INFO) << "requests taken: " << ready_num + 1 << ", done by callback: " << callback_num;
+    CHECK_EQ(ready_num + 1, epoch / 2);
+}
 
 int main(int argc, const char** argv){
 
@@ -17,6 +17,8 @@
 #define ANAKIN_NET_TEST_H
 
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 #include "utils/unit_test/aktest.h"
 #include "utils/logger/logger.h"
 #include "graph_base.h"
@@ -92,6 +94,57 @@ static int record_dev_tensorfile(const Tensor4d<X86, AK_FLOAT>* dev_tensor, cons
 }
 #endif
 
+/**
+ * \brief Add a node of op_name to a graph built by hand, fed by the outputs of bottoms in order.
+ *  the attributes are set on the returned node, as the model parser would.
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+NodePtr<Ttype, Dtype, Ptype> add_test_node(Graph<Ttype, Dtype, Ptype>& graph, std::string name,
+                                           std::string op_name,
+                                           std::vector<std::string> bottoms = std::vector<std::string>()) {
+    NodePtr<Ttype, Dtype, Ptype> node_p = std::make_shared<Node<Ttype, Dtype, Ptype> >();
+    node_p->name() = name;
+    node_p->get_op_name() = op_name;
+    graph.add_vertex(name, node_p);
+    for (auto& bottom : bottoms) {
+        Edge<Ttype, Dtype> edge(bottom, name);
+        graph.add_in_arc(edge);
+        graph.add_out_arc(edge);
+    }
+    return node_p;
+}
+
+/**
+ * \brief Weights of a graph built by hand, a fixed pseudo random sequence in [lo, hi).
+ */
+template<typename Ttype, DataType Dtype, Precision Ptype>
+PBlock<float, Ttype> add_test_weights(Graph<Ttype, Dtype, Ptype>& graph, Shape shape,
+                                      float lo, float hi, unsigned int seed) {
+    auto* block = graph.weights_arena()->template new_block<AK_FLOAT>(shape);
+    float* data = block->h_tensor().mutable_data();
+    for (int i = 0; i < shape.count(); i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = lo + (hi - lo) * ((seed >> 16) & 0x7fff) / 32768.f;
+    }
+#ifdef USE_CUDA
+    if (!block->host_only()) {
+        block->d_tensor().copy_from(block->h_tensor());
+    }
+#endif
+    return *block;
+}
+
+/// largest difference between two tensors of the same size, on host
+template<typename TensorType>
+float max_abs_diff(TensorType& a, TensorType& b) {
+    CHECK_EQ(a.valid_size(), b.valid_size()) << " tensors of different sizes";
+    float max_diff = 0.f;
+    for (int i = 0; i < a.valid_size(); i++) {
+        max_diff = std::max(max_diff, std::abs(a.data()[i] - b.data()[i]));
+    }
+    return max_diff;
+}
+
 #endif
 
 
@@ -0,0 +1,179 @@
+#include <string>
+#include <cstdio>
+#include "net_test.h"
+#include "framework/core/net/seq_bucket.h"
+
+#if defined(USE_CUDA)
+using Target = NV;
+using Target_H = X86;
+#elif defined(USE_X86_PLACE)
+using Target = X86;
+using Target_H = X86;
+#elif defined(USE_ARM_PLACE)
+using Target = ARM;
+using Target_H = ARM;
+#endif
+
+typedef Tensor4d<Target_H, AK_FLOAT> HostTensor;
+
+TEST(NetTest, seq_bucket_test) {
+    // two requests, sequences of 10, 3 words and of 9, 1, 5 words
+    std::vector<std::vector<int> > offsets = {{0, 10, 13}, {0, 9, 10, 15}};
+    const int width = 3;
+    SeqBuckets buckets(offsets, 2);
+
+    // longest first, at most 2 a bucket, 1 word is less than half of 5
+    CHECK_EQ(buckets.bucket_num(), 3);
+    std::vector<std::vector<int> > lengths = {{10, 9}, {5, 3}, {1}};
+    for (int b = 0; b < buckets.bucket_num(); b++) {
+        CHECK_EQ(buckets.members(b).size(), lengths[b].size());
+        for (int i = 0; i < lengths[b].size(); i++) {
+            CHECK_EQ(buckets.members(b)[i].length, lengths[b][i]);
+        }
+    }
+    CHECK(buckets.seq_offset(0) == std::vector<int>({0, 10, 19}));
+
+    std::vector<HostTensor*> ins;
+    std::vector<HostTensor*> word_outs;
+    std::vector<HostTensor*> seq_outs;
+    for (int r = 0; r < offsets.size(); r++) {
+        HostTensor* in = new HostTensor(Shape(buckets.request_words(r), width, 1, 1));
+        for (int i = 0; i < in->valid_size(); i++) {
+            in->mutable_data()[i] = r * 1000 + i;
+        }
+        in->set_seq_offset(offsets[r]);
+        ins.push_back(in);
+        word_outs.push_back(new HostTensor(Shape(buckets.request_words(r), width, 1, 1)));
+        seq_outs.push_back(new HostTensor(Shape(buckets.request_seqs(r), 1, 1, 1)));
+    }
+
+    // words go back where they came from, and a row per sequence to its sequence
+    for (int b = 0; b < buckets.bucket_num(); b++) {
+        HostTensor merged;
+        buckets.gather(b, ins, merged);
+        CHECK_EQ(merged.num(), buckets.seq_offset(b).back());
+        CHECK(merged.get_seq_offset() == buckets.seq_offset(b));
+        buckets.scatter(b, merged, true, word_outs);
+
+        HostTensor per_seq(Shape(buckets.members(b).size(), 1, 1, 1));
+        for (int i = 0; i < buckets.members(b).size(); i++) {
+            per_seq.mutable_data()[i] = buckets.members(b)[i].length;
+        }
+        buckets.scatter(b, per_seq, false, seq_outs);
+    }
+    for (int r = 0; r < offsets.size(); r++) {
+        for (int i = 0; i < ins[r]->valid_size(); i++) {
+            CHECK_EQ(word_outs[r]->data()[i], ins[r]->data()[i]);
+        }
+        for (int s = 0; s < buckets.request_seqs(r); s++) {
+            CHECK_EQ(seq_outs[r]->data()[s], offsets[r][s + 1] - offsets[r][s]);
+        }
+        delete ins[r];
+        delete word_outs[r];
+        delete seq_outs[r];
+    }
+
+    // outputs of as many rows as the sequences, or the words, of every bucket
+    bool word_rows = true;
+    CHECK(buckets.per_word({2, 2, 1}, word_rows));
+    CHECK(!word_rows);
+    CHECK(buckets.per_word({19, 8, 1}, word_rows));
+    CHECK(word_rows);
+    // a row for the whole batch is neither
+    CHECK(!buckets.per_word({1, 1, 1}, word_rows));
+}
+
+#ifdef USE_X86_PLACE
+/// input -> lstm (-> permute) -> output saved as a model, word_size features a word
+static void save_lstm_model(std::string path, int word_size, int hidden_size, bool transpose) {
+    Graph<X86, AK_FLOAT, Precision::FP32> graph;
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{1, word_size, 1, 1}));
+    auto lstm = add_test_node(graph, "lstm_0", "Lstm", {"input_0"});
+    lstm->set_attr("num_direction", 1);
+    lstm->set_attr("dropout_param", 0.f);
+    lstm->set_attr("num_layers", 1);
+    lstm->set_attr("input_activation", std::string("null"));
+    lstm->set_attr("gate_activation", std::string("sigmoid"));
+    lstm->set_attr("cell_activation", std::string("tanh"));
+    lstm->set_attr("candidate_activation", std::string("tanh"));
+    lstm->set_attr("is_reverse", false);
+    lstm->set_attr("use_peepholes", false);
+    lstm->set_attr("weight_1", add_test_weights(graph,
+            Shape(1, 1, 1, hidden_size * hidden_size * 4 + hidden_size * word_size * 4), -0.3f, 0.3f, 5));
+    lstm->set_attr("weight_2", add_test_weights(graph, Shape(1, 1, 1, hidden_size * 4), -0.3f, 0.3f, 9));
+    std::string top = "lstm_0";
+    if (transpose) {
+        // a row per hidden unit, which has nothing to do with the words or the sequences
+        auto permute = add_test_node(graph, "permute_0", "Permute", {"lstm_0"});
+        permute->set_attr("dims", PTuple<int>(std::vector<int>{1, 0, 2, 3}));
+        top = "permute_0";
+    }
+    add_test_node(graph, "output_0", "Output", {top});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+    // the nodes are saved in their exec order
+    CHECK(graph.Optimize());
+    CHECK(graph.save(path));
+}
+
+/// a bucketed run of a few requests gives every request the outputs of a run of its own
+static void check_bucketed(bool transpose) {
+    const int word_size = 6;
+    const int hidden_size = 5;
+    std::string path = "seq_bucket_lstm.anakin.bin";
+    save_lstm_model(path, word_size, hidden_size, transpose);
+    Worker<X86, AK_FLOAT, Precision::FP32> worker(path, 2);
+    worker.register_inputs({"input_0"});
+    worker.register_outputs({"output_0"});
+    worker.Reshape("input_0", {1, word_size, 1, 1});
+    worker.launch();
+
+    // requests of sequences of unlike lengths, so the buckets mix them
+    std::vector<std::vector<int> > offsets = {{0, 7, 9}, {0, 1, 12}, {0, 4}, {0, 3, 6, 14}};
+    std::vector<std::vector<Tensor4dPtr<X86, AK_FLOAT> > > requests_in;
+    std::vector<std::vector<Tensor4dPtr<X86, AK_FLOAT> > > requests_out;
+    for (int r = 0; r < offsets.size(); r++) {
+        HostTensor* in = new HostTensor(Shape(offsets[r].back(), word_size, 1, 1));
+        for (int i = 0; i < in->valid_size(); i++) {
+            in->mutable_data()[i] = ((i * 5 + r * 3) % 13) / 6.f - 1.f;
+        }
+        in->set_seq_offset(offsets[r]);
+        requests_in.push_back({in});
+        requests_out.push_back({new HostTensor()});
+    }
+    // transposed outputs can't be split back into the requests, which then run one by one
+    worker.sync_prediction_bucketed(requests_in, requests_out, 2);
+
+    for (int r = 0; r < offsets.size(); r++) {
+        auto outs = worker.sync_prediction(requests_in[r]);
+        HostTensor* out = requests_out[r][0];
+        CHECK(out->valid_shape() == outs[0]->valid_shape()) << " request " << r;
+        if (!transpose) {
+            CHECK(out->get_seq_offset() == offsets[r]);
+        }
+        float max_diff = max_abs_diff(*out, *outs[0]);
+        LOG(INFO) << " request " << r << " max diff of the bucketed run: " << max_diff;
+        CHECK_LT(max_diff, 1e-5f) << " request " << r;
+        delete requests_in[r][0];
+        delete requests_out[r][0];
+    }
+    remove(path.c_str());
+}
+
+TEST(NetTest, worker_bucketed_test) {
+    check_bucketed(false);
+    check_bucketed(true);
+}
+#endif
+
+int main(int argc, const char** argv){
+
+	Env<Target>::env_init();
+
+    // initial logger
+    logger::init(argv[0]);
+	InitTest();
+	RUN_ALL_TESTS(argv[0]);
+	return 0;
+}
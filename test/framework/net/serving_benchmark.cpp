@@ -0,0 +1,310 @@
+#include <string>
+#include "net_test.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "saber/core/tensor_op.h"
+
+#if defined(USE_CUDA)
+using Target = NV;
+using Target_H = X86;
+#elif defined(USE_X86_PLACE)
+using Target = X86;
+using Target_H = X86;
+#elif defined(USE_ARM_PLACE)
+using Target = ARM;
+using Target_H = ARM;
+#endif
+
+/**
+ * Open-loop serving benchmark of Worker.
+ * Requests arrive as a poisson process of rate qps, whether the earlier ones are done or not,
+ * and the latency of a request is measured from its scheduled arrival, so a stalled worker
+ * shows up in the tail instead of slowing the load down.
+ *
+ * The workload file gives the request mix, one "batch seq_len weight" per line ('#' comments).
+ * seq_len 0 resizes dim 0 of the inputs to batch, otherwise dim 0 holds batch sequences of
+ * seq_len words and the inputs get the matching seq offset. Without it every request is batch 1.
+ * Throughput and latency percentiles are written as json.
+ */
+
+#ifdef USE_GFLAGS
+#include <gflags/gflags.h>
+
+DEFINE_string(model_file, "", "model file");
+DEFINE_int32(thread_num, 4, "worker threads");
+DEFINE_double(qps, 100, "request arrival rate");
+DEFINE_int32(requests, 1000, "requests measured");
+DEFINE_int32(warmup, 100, "requests run before measuring");
+DEFINE_string(workload, "", "workload file");
+DEFINE_string(json, "", "json output file, stdout by default");
+DEFINE_int32(seed, 1, "random seed");
+#else
+std::string FLAGS_model_file;
+int FLAGS_thread_num = 4;
+double FLAGS_qps = 100;
+int FLAGS_requests = 1000;
+int FLAGS_warmup = 100;
+std::string FLAGS_workload;
+std::string FLAGS_json;
+int FLAGS_seed = 1;
+#endif
+
+typedef Worker<Target, AK_FLOAT, Precision::FP32> BenchWorker;
+typedef Tensor4d<target_host<Target>::type, AK_FLOAT> HostTensor;
+
+/// latency histogram in us, log-linear buckets with 1/64 relative precision, as hdr histograms
+class LatencyHistogram {
+public:
+    LatencyHistogram() : _counts(kSubBuckets + 58 * kHalfSubBuckets, 0) {}
+
+    void record(uint64_t us) {
+        std::lock_guard<std::mutex> guard(_mut);
+        _counts[index_of(us)]++;
+        _total++;
+        _max = std::max(_max, us);
+        _sum += us;
+    }
+
+    /// the highest value equivalent to the one at quantile q
+    uint64_t percentile(double q) {
+        std::lock_guard<std::mutex> guard(_mut);
+        uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(q * _total));
+        uint64_t seen = 0;
+        for (int i = 0; i < _counts.size(); i++) {
+            seen += _counts[i];
+            if (seen >= rank) {
+                return std::min(highest_of(i), _max);
+            }
+        }
+        return _max;
+    }
+
+    uint64_t total() { return _total; }
+    uint64_t max() { return _max; }
+    double mean() { return _total ? (double)_sum / _total : 0.; }
+
+private:
+    static const int kSubBuckets = 128;
+    static const int kHalfSubBuckets = 64;
+
+    static int index_of(uint64_t v) {
+        if (v < kSubBuckets) {
+            return v;
+        }
+        int shift = 63 - __builtin_clzll(v) - 6;
+        return kSubBuckets + (shift - 1) * kHalfSubBuckets + (int)(v >> shift) - kHalfSubBuckets;
+    }
+
+    static uint64_t highest_of(int index) {
+        if (index < kSubBuckets) {
+            return index;
+        }
+        int shift = (index - kSubBuckets) / kHalfSubBuckets + 1;
+        uint64_t sub = (index - kSubBuckets) % kHalfSubBuckets + kHalfSubBuckets;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> _counts;
+    uint64_t _total{0};
+    uint64_t _max{0};
+    uint64_t _sum{0};
+    std::mutex _mut;
+};
+
+struct WorkloadEntry {
+    int batch{1};
+    int seq_len{0};
+    double weight{1.};
+    ///< inputs of the requests of this entry, read only so they are shared.
+    std::vector<Tensor4dPtr<target_host<Target>::type, AK_FLOAT> > ins;
+};
+
+std::vector<WorkloadEntry> load_workload(std::string path) {
+    std::vector<WorkloadEntry> entries;
+    if (path.empty()) {
+        entries.push_back(WorkloadEntry());
+        return entries;
+    }
+    std::ifstream file(path);
+    CHECK(file.is_open()) << " can't open workload file " << path;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        WorkloadEntry entry;
+        if (!(fields >> entry.batch >> entry.seq_len)) {
+            continue;
+        }
+        fields >> entry.weight;
+        CHECK_GT(entry.batch, 0) << " batch of workload should be positive";
+        entries.push_back(entry);
+    }
+    CHECK(!entries.empty()) << " workload file " << path << " is empty";
+    return entries;
+}
+
+TEST(NetTest, net_serving_benchmark) {
+    auto entries = load_workload(FLAGS_workload);
+
+    // input names and shapes of the model
+    Graph<Target, AK_FLOAT, Precision::FP32> graph;
+    auto status = graph.load(FLAGS_model_file);
+    if (!status) {
+        LOG(FATAL) << " [ERROR] " << status.info();
+    }
+    std::vector<std::string> in_names = graph.get_ins();
+    std::vector<std::string> out_names = graph.get_outs();
+    std::vector<std::vector<int> > in_shapes;
+    for (auto& in : in_names) {
+        auto shape = graph[in]->get_attr<PTuple<int>>("input_shape");
+        in_shapes.push_back(shape.vector());
+    }
+    for (auto& entry : entries) {
+        for (auto& in_shape : in_shapes) {
+            Shape shape(in_shape[0], in_shape[1], in_shape[2], in_shape[3]);
+            std::vector<int> seq_offset;
+            if (entry.seq_len > 0) {
+                shape[0] = entry.batch * entry.seq_len;
+                for (int i = 0; i <= entry.batch; i++) {
+                    seq_offset.push_back(i * entry.seq_len);
+                }
+            } else {
+                shape[0] = entry.batch;
+            }
+            auto tensor = new HostTensor(shape);
+            fill_tensor_host_rand(*tensor, -1.f, 1.f);
+            tensor->set_seq_offset(seq_offset);
+            entry.ins.push_back(tensor);
+        }
+    }
+    std::vector<double> weights;
+    for (auto& entry : entries) {
+        weights.push_back(entry.weight);
+    }
+
+    // callbacks run on the worker threads, so the results outlive the worker
+    LatencyHistogram histogram;
+    std::atomic<int> done{0};
+    std::atomic<int64_t> last_done_us{0};
+
+    BenchWorker workers(FLAGS_model_file, FLAGS_thread_num);
+    workers.register_inputs(in_names);
+    workers.register_outputs(out_names);
+    workers.launch();
+
+    std::mt19937_64 rng(FLAGS_seed);
+    std::discrete_distribution<int> pick_entry(weights.begin(), weights.end());
+    std::exponential_distribution<double> interarrival(FLAGS_qps);
+
+    LOG(WARNING) << "warm up with " << FLAGS_warmup << " requests";
+    for (int i = 0; i < FLAGS_warmup; i++) {
+        workers.sync_prediction(entries[pick_entry(rng)].ins);
+    }
+
+    LOG(WARNING) << "run " << FLAGS_requests << " requests at " << FLAGS_qps << " qps, "
+                 << FLAGS_thread_num << " threads";
+    typedef std::chrono::steady_clock clock;
+    auto start = clock::now();
+    auto us_since_start = [&start]() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+    };
+    double arrival_s = 0.;
+    int64_t max_send_lag_us = 0;
+    for (int i = 0; i < FLAGS_requests; i++) {
+        arrival_s += interarrival(rng);
+        int64_t arrival_us = (int64_t)(arrival_s * 1e6);
+        std::this_thread::sleep_until(start + std::chrono::microseconds(arrival_us));
+        max_send_lag_us = std::max(max_send_lag_us, us_since_start() - arrival_us);
+        workers.async_submit(entries[pick_entry(rng)].ins, [&, arrival_us](size_t id, BenchWorker::AsyncOutputs& outs) {
+            int64_t now_us = us_since_start();
+            histogram.record(now_us - arrival_us);
+            int64_t last = last_done_us;
+            while (now_us > last && !last_done_us.compare_exchange_weak(last, now_us)) {}
+            done++;
+        });
+    }
+    while (done < FLAGS_requests) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    double seconds = last_done_us / 1e6;
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"model\": \"" << FLAGS_model_file << "\",\n"
+         << "  \"threads\": " << FLAGS_thread_num << ",\n"
+         << "  \"offered_qps\": " << FLAGS_qps << ",\n"
+         << "  \"requests\": " << histogram.total() << ",\n"
+         << "  \"throughput_qps\": " << (seconds > 0 ? histogram.total() / seconds : 0.) << ",\n"
+         << "  \"max_send_lag_ms\": " << max_send_lag_us / 1e3 << ",\n"
+         << "  \"latency_ms\": {\n"
+         << "    \"mean\": " << histogram.mean() / 1e3 << ",\n"
+         << "    \"p50\": " << histogram.percentile(0.5) / 1e3 << ",\n"
+         << "    \"p90\": " << histogram.percentile(0.9) / 1e3 << ",\n"
+         << "    \"p99\": " << histogram.percentile(0.99) / 1e3 << ",\n"
+         << "    \"p999\": " << histogram.percentile(0.999) / 1e3 << ",\n"
+         << "    \"max\": " << histogram.max() / 1e3 << "\n"
+         << "  }\n"
+         << "}\n";
+    if (FLAGS_json.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream file(FLAGS_json);
+        file << json.str();
+        LOG(INFO) << "result is written to " << FLAGS_json;
+    }
+}
+
+int main(int argc, const char** argv){
+
+    Env<Target>::env_init();
+
+    // initial logger
+    logger::init(argv[0]);
+
+#ifdef USE_GFLAGS
+    google::ParseCommandLineFlags(&argc, &argv, true);
+#else
+    LOG(INFO)<< "Serving benchmark usage:";
+    LOG(INFO)<< "   $serving_benchmark <model_file> <thread_num> <qps> <requests> <warmup> <workload> <json>";
+    LOG(INFO)<< "   model_file:     path to model";
+    LOG(INFO)<< "   thread_num:     worker threads default to 4";
+    LOG(INFO)<< "   qps:            request arrival rate default to 100";
+    LOG(INFO)<< "   requests:       requests measured default to 1000";
+    LOG(INFO)<< "   warmup:         requests run before measuring default to 100";
+    LOG(INFO)<< "   workload:       file of \"batch seq_len weight\" lines, batch 1 by default";
+    LOG(INFO)<< "   json:           output file, stdout by default";
+    if(argc < 2) {
+        LOG(ERROR) << "You should fill in the variable model_file at least.";
+        return 0;
+    }
+    FLAGS_model_file = argv[1];
+    if(argc > 2) {
+        FLAGS_thread_num = atoi(argv[2]);
+    }
+    if(argc > 3) {
+        FLAGS_qps = atof(argv[3]);
+    }
+    if(argc > 4) {
+        FLAGS_requests = atoi(argv[4]);
+    }
+    if(argc > 5) {
+        FLAGS_warmup = atoi(argv[5]);
+    }
+    if(argc > 6) {
+        FLAGS_workload = argv[6];
+    }
+    if(argc > 7) {
+        FLAGS_json = argv[7];
+    }
+#endif
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <string>
+#include <cstring>
+#include "net_test.h"
+#include "framework/core/net/stream_session.h"
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, AK_FLOAT, Precision::FP32> GraphX86;
+typedef Net<X86, AK_FLOAT, Precision::FP32> NetX86;
+
+/// input -> gru -> output, word_size features a word
+static void build_gru_net(GraphX86& graph, int word_size, int hidden_size) {
+    auto in = add_test_node(graph, "input_0", "Input");
+    in->set_attr("input_shape", PTuple<int>(std::vector<int>{1, word_size, 1, 1}));
+    auto gru = add_test_node(graph, "gru_0", "Gru", {"input_0"});
+    gru->set_attr("is_reverse", false);
+    gru->set_attr("gate_activation", std::string("sigmoid_fluid"));
+    gru->set_attr("activation", std::string("tanh_fluid"));
+    gru->set_attr("gru_formula", std::string("gru_origin"));
+    gru->set_attr("weight_1", add_test_weights(graph,
+            Shape(1, 1, 1, hidden_size * word_size * 3 + hidden_size * hidden_size * 3), -0.3f, 0.3f, 7));
+    gru->set_attr("weight_2", add_test_weights(graph, Shape(1, 1, 1, hidden_size * 3), -0.3f, 0.3f, 13));
+    add_test_node(graph, "output_0", "Output", {"gru_0"});
+    graph.add_in("input_0");
+    graph.add_out("output_0");
+}
+
+/// words [begin, end) of every sequence of src into the net input, one sequence after another
+static void feed_words(NetX86& net, Tensor4d<X86, AK_FLOAT>& src, const std::vector<int>& seqs,
+                       const std::vector<int>& begin, const std::vector<int>& end) {
+    const int word_size = src.channel();
+    const std::vector<int>& src_offset = src.get_seq_offset();
+    std::vector<int> offset(1, 0);
+    for (int i = 0; i < seqs.size(); i++) {
+        offset.push_back(offset.back() + end[i] - begin[i]);
+    }
+    auto in = net.get_in("input_0");
+    in->reshape(Shape(offset.back(), word_size, 1, 1));
+    for (int i = 0; i < seqs.size(); i++) {
+        memcpy(in->mutable_data() + offset[i] * word_size,
+               src.data() + (src_offset[seqs[i]] + begin[i]) * word_size,
+               sizeof(float) * (end[i] - begin[i]) * word_size);
+    }
+    in->set_seq_offset(offset);
+}
+
+/// outputs of the last run for words [begin, end) of every sequence match the rows of a whole run
+static void check_words(NetX86& net, Tensor4d<X86, AK_FLOAT>& whole_out,
+                        const std::vector<int>& whole_offset, const std::vector<int>& seqs,
+                        const std::vector<int>& begin, const std::vector<int>& end) {
+    auto out = net.get_out("output_0");
+    const int hidden_size = whole_out.valid_size() / whole_out.num();
+    int row = 0;
+    for (int i = 0; i < seqs.size(); i++) {
+        for (int w = begin[i]; w < end[i]; w++, row++) {
+            for (int k = 0; k < hidden_size; k++) {
+                float expect = whole_out.data()[(whole_offset[seqs[i]] + w) * hidden_size + k];
+                float result = out->data()[row * hidden_size + k];
+                CHECK_LT(std::abs(expect - result), 1e-5f) << " word " << w << " of sequence " << seqs[i];
+            }
+        }
+    }
+    CHECK_EQ(row, out->num());
+}
+
+TEST(NetTest, stream_session_test) {
+    const int word_size = 16;
+    const int hidden_size = 24;
+    GraphX86 graph;
+    build_gru_net(graph, word_size, hidden_size);
+    CHECK(graph.Optimize());
+
+    // two sequences of 7 and 4 words
+    std::vector<int> whole_offset = {0, 7, 11};
+    Tensor4d<X86, AK_FLOAT> words(Shape(whole_offset.back(), word_size, 1, 1));
+    for (int i = 0; i < words.valid_size(); i++) {
+        words.mutable_data()[i] = ((i * 37) % 23) / 11.f - 1.f;
+    }
+    words.set_seq_offset(whole_offset);
+
+    // both sequences at once from zero state
+    NetX86 whole_net(graph);
+    feed_words(whole_net, words, {0, 1}, {0, 0}, {7, 4});
+    whole_net.prediction();
+    Tensor4d<X86, AK_FLOAT> whole_out(whole_net.get_out("output_0")->valid_shape());
+    whole_out.copy_from(*whole_net.get_out("output_0"));
+
+    NetX86 net(graph);
+    StreamSession<X86, AK_FLOAT, Precision::FP32> session(net);
+    CHECK_EQ(session.stateful_op_num(), 1);
+
+    // the same words in two chunks, the second one with the sequences swapped
+    feed_words(net, words, {0, 1}, {0, 0}, {3, 1});
+    session.prediction({"a", "b"});
+    check_words(net, whole_out, whole_offset, {0, 1}, {0, 0}, {3, 1});
+    CHECK(session.has_state("a") && session.has_state("b"));
+    auto snapshot = session.checkpoint("a");
+
+    feed_words(net, words, {1, 0}, {1, 3}, {4, 7});
+    session.prediction({"b", "a"});
+    check_words(net, whole_out, whole_offset, {1, 0}, {1, 3}, {4, 7});
+
+    // a restored sequence continues from its snapshot
+    session.restore("a", snapshot);
+    feed_words(net, words, {0}, {3}, {7});
+    session.prediction({"a"});
+    check_words(net, whole_out, whole_offset, {0}, {3}, {7});
+
+    // and a reset one starts over
+    session.reset("b");
+    CHECK(!session.has_state("b"));
+    feed_words(net, words, {1}, {0}, {4});
+    session.prediction({"b"});
+    check_words(net, whole_out, whole_offset, {1}, {0}, {4});
+}
+
+#endif
+
+int main(int argc, const char** argv){
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
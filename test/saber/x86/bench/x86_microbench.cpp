@@ -0,0 +1,374 @@
+#include "x86_microbench.h"
+#include <immintrin.h>
+#include <omp.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include "saber/core/impl/x86/x86_isa.h"
+
+/**
+ * Operator microbenchmarks of the saber x86 kernels.
+ * Every case of the op families is run at each thread count and reported as ms, GFLOP/s, GB/s
+ * and the fraction of the roofline of the host, min(peak flops, bandwidth * intensity), with
+ * the peak and the bandwidth measured by this binary at the same thread count and isa.
+ * The isa is the one the kernels picked for the process, cap it with ANAKIN_X86_ISA to sweep it.
+ *
+ * Results are written as tsv, which is also the baseline format: given a baseline the cases
+ * slower than it by more than the tolerance are reported and the exit code is 1.
+ */
+
+#ifdef USE_GFLAGS
+#include <gflags/gflags.h>
+
+DEFINE_string(filter, "", "run only the cases whose \"op shape\" contains it");
+DEFINE_string(threads, "", "comma separated thread counts, 1 and all cores by default");
+DEFINE_string(out, "", "tsv result file");
+DEFINE_string(baseline, "", "tsv result file of an earlier run to compare with");
+DEFINE_double(tolerance, 0.1, "slowdown over the baseline reported as regression");
+DEFINE_double(min_ms, 100, "time spent measuring every case");
+#else
+std::string FLAGS_filter;
+std::string FLAGS_threads;
+std::string FLAGS_out;
+std::string FLAGS_baseline;
+double FLAGS_tolerance = 0.1;
+double FLAGS_min_ms = 100;
+#endif
+
+using namespace anakin::saber;
+using namespace anakin::saber::bench;
+
+namespace {
+
+typedef std::chrono::steady_clock bench_clock;
+
+double ms_since(bench_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+/// independent multiply add chains, enough to cover the latency of the fma units
+const int kChains = 12;
+const long kPeakIters = 1 << 22;
+
+/// the chains in named registers, an array of them is kept in memory by some compilers
+#define BENCH_FOR_CHAINS(step, x, y) \
+    step(0, x, y) step(1, x, y) step(2, x, y) step(3, x, y) step(4, x, y) step(5, x, y) \
+    step(6, x, y) step(7, x, y) step(8, x, y) step(9, x, y) step(10, x, y) step(11, x, y)
+
+#define BENCH_DECLARE_CHAIN(j, vec, set1) vec acc##j = set1((float)j);
+#define BENCH_STEP_CHAIN(j, madd, unused) acc##j = madd(acc##j, mul, inc);
+#define BENCH_SUM_CHAIN(j, add, unused) sum = add(sum, acc##j);
+
+#define BENCH_PEAK_LOOP(vec, set1, madd, add, store, width) \
+    vec mul = set1(0.999f); \
+    vec inc = set1(0.001f); \
+    BENCH_FOR_CHAINS(BENCH_DECLARE_CHAIN, vec, set1) \
+    for (long i = 0; i < iters; i++) { \
+        BENCH_FOR_CHAINS(BENCH_STEP_CHAIN, madd, 0) \
+    } \
+    vec sum = set1(0.f); \
+    BENCH_FOR_CHAINS(BENCH_SUM_CHAIN, add, 0) \
+    float out[width]; \
+    store(out, sum); \
+    return out[0] + out[width - 1];
+
+inline float scalar_madd(float a, float b, float c) {
+    return a * b + c;
+}
+
+inline float scalar_add(float a, float b) {
+    return a + b;
+}
+
+inline float scalar_set1(float a) {
+    return a;
+}
+
+inline void scalar_store(float* dst, float a) {
+    *dst = a;
+}
+
+__attribute__((optimize("no-tree-vectorize")))
+float peak_loop_scalar(long iters) {
+    BENCH_PEAK_LOOP(float, scalar_set1, scalar_madd, scalar_add, scalar_store, 1)
+}
+
+__attribute__((target("sse4.2")))
+inline __m128 sse_madd(__m128 a, __m128 b, __m128 c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+__attribute__((target("sse4.2")))
+float peak_loop_sse42(long iters) {
+    BENCH_PEAK_LOOP(__m128, _mm_set1_ps, sse_madd, _mm_add_ps, _mm_storeu_ps, 4)
+}
+
+__attribute__((target("avx2,fma")))
+float peak_loop_avx2(long iters) {
+    BENCH_PEAK_LOOP(__m256, _mm256_set1_ps, _mm256_fmadd_ps, _mm256_add_ps, _mm256_storeu_ps, 8)
+}
+
+__attribute__((target("avx512f")))
+float peak_loop_avx512(long iters) {
+    BENCH_PEAK_LOOP(__m512, _mm512_set1_ps, _mm512_fmadd_ps, _mm512_add_ps, _mm512_storeu_ps, 16)
+}
+
+/// peak GFLOP/s of multiply adds at the isa, best of 3
+double measure_peak_gflops(X86Isa isa, int threads) {
+    const int width[] = {1, 4, 8, 16};
+    double best_ms = 1e30;
+    volatile float sink = 0.f;
+    for (int rep = 0; rep < 3; rep++) {
+        auto start = bench_clock::now();
+        #pragma omp parallel num_threads(threads)
+        {
+            float sum = 0.f;
+            switch (isa) {
+            case X86_ISA_AVX512:
+                sum = peak_loop_avx512(kPeakIters);
+                break;
+            case X86_ISA_AVX2:
+                sum = peak_loop_avx2(kPeakIters);
+                break;
+            case X86_ISA_SSE42:
+                sum = peak_loop_sse42(kPeakIters);
+                break;
+            default:
+                sum = peak_loop_scalar(kPeakIters);
+            }
+            sink = sum;
+        }
+        best_ms = std::min(best_ms, ms_since(start));
+    }
+    double flops = 2. * width[isa] * kChains * kPeakIters * threads;
+    return flops / best_ms / 1e6;
+}
+
+/// stream triad bandwidth in GB/s over arrays far bigger than the caches, best of 5
+double measure_bandwidth_gbps(int threads) {
+    const long size = 1 << 24;
+    std::vector<float> a(size, 0.f);
+    std::vector<float> b(size, 1.f);
+    std::vector<float> c(size, 2.f);
+    float* pa = a.data();
+    const float* pb = b.data();
+    const float* pc = c.data();
+    double best_ms = 1e30;
+    for (int rep = 0; rep < 5; rep++) {
+        auto start = bench_clock::now();
+        #pragma omp parallel for num_threads(threads) schedule(static)
+        for (long i = 0; i < size; i++) {
+            pa[i] = pb[i] + 3.f * pc[i];
+        }
+        best_ms = std::min(best_ms, ms_since(start));
+    }
+    return 3. * sizeof(float) * size / best_ms / 1e6;
+}
+
+/// ms of one run, from the best of 4 batches of runs, each batch taking about min_ms / 4
+double time_ms(const std::function<void()>& run, double min_ms) {
+    // the first run pays for lazy allocations and cold caches
+    run();
+    long iters = 1;
+    double batch_ms = 0.;
+    while (true) {
+        auto start = bench_clock::now();
+        for (long i = 0; i < iters; i++) {
+            run();
+        }
+        batch_ms = ms_since(start);
+        if (batch_ms >= min_ms / 4 || iters >= (1 << 20)) {
+            break;
+        }
+        iters *= 2;
+    }
+    double best_ms = batch_ms / iters;
+    for (int rep = 1; rep < 4; rep++) {
+        auto start = bench_clock::now();
+        for (long i = 0; i < iters; i++) {
+            run();
+        }
+        best_ms = std::min(best_ms, ms_since(start) / iters);
+    }
+    return best_ms;
+}
+
+struct BenchResult {
+    std::string op;
+    std::string shape;
+    std::string isa;
+    int threads;
+    double ms;
+    double gflops;
+    double gbps;
+    double roofline;
+
+    std::string key() const {
+        return op + "\t" + shape + "\t" + isa + "\t" + std::to_string(threads);
+    }
+};
+
+const char* kTsvHeader = "#op\tshape\tisa\tthreads\tms\tgflops\tgbps\troofline";
+
+void write_results(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream file(path);
+    CHECK(file.is_open()) << " can't open result file " << path;
+    file << kTsvHeader << "\n";
+    for (auto& r : results) {
+        file << r.key() << "\t" << r.ms << "\t" << r.gflops << "\t" << r.gbps << "\t" << r.roofline << "\n";
+    }
+    LOG(INFO) << "results are written to " << path;
+}
+
+/// ms of every case of the baseline, by key
+std::map<std::string, double> load_baseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream file(path);
+    CHECK(file.is_open()) << " can't open baseline file " << path;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        BenchResult r;
+        std::istringstream fields(line);
+        if (std::getline(fields, r.op, '\t') && std::getline(fields, r.shape, '\t')
+                && std::getline(fields, r.isa, '\t') && (fields >> r.threads >> r.ms)) {
+            baseline[r.key()] = r.ms;
+        }
+    }
+    return baseline;
+}
+
+std::vector<int> parse_threads(const std::string& list) {
+    std::vector<int> threads;
+    std::istringstream fields(list);
+    std::string field;
+    while (std::getline(fields, field, ',')) {
+        if (!field.empty()) {
+            threads.push_back(std::max(1, atoi(field.c_str())));
+        }
+    }
+    if (threads.empty()) {
+        threads.push_back(1);
+        if (omp_get_max_threads() > 1) {
+            threads.push_back(omp_get_max_threads());
+        }
+    }
+    return threads;
+}
+
+} // namespace
+
+int main(int argc, const char** argv) {
+    logger::init(argv[0]);
+#ifdef USE_GFLAGS
+    google::ParseCommandLineFlags(&argc, &argv, true);
+#else
+    LOG(INFO) << "x86 microbenchmark usage:";
+    LOG(INFO) << "   $saber_x86_microbench <filter> <threads> <out> <baseline> <tolerance> <min_ms>";
+    LOG(INFO) << "   filter:     run only the cases whose \"op shape\" contains it, all by default";
+    LOG(INFO) << "   threads:    comma separated thread counts, 1 and all cores by default";
+    LOG(INFO) << "   out:        tsv result file";
+    LOG(INFO) << "   baseline:   tsv result file of an earlier run to compare with";
+    LOG(INFO) << "   tolerance:  slowdown over the baseline reported as regression, default 0.1";
+    LOG(INFO) << "   min_ms:     time spent measuring every case, default 100";
+    LOG(INFO) << "   set ANAKIN_X86_ISA to scalar, sse42, avx2 or avx512 to cap the isa of the kernels";
+    if (argc > 1) {
+        FLAGS_filter = argv[1];
+    }
+    if (argc > 2) {
+        FLAGS_threads = argv[2];
+    }
+    if (argc > 3) {
+        FLAGS_out = argv[3];
+    }
+    if (argc > 4) {
+        FLAGS_baseline = argv[4];
+    }
+    if (argc > 5) {
+        FLAGS_tolerance = atof(argv[5]);
+    }
+    if (argc > 6) {
+        FLAGS_min_ms = atof(argv[6]);
+    }
+#endif
+    Env<X86>::env_init();
+
+    std::vector<BenchCase> cases;
+    add_conv_cases(cases);
+    add_fc_cases(cases);
+    add_pooling_cases(cases);
+    add_softmax_cases(cases);
+    add_rnn_cases(cases);
+    add_embedding_cases(cases);
+    add_sequence_cases(cases);
+
+    X86Isa isa = x86_isa();
+    std::string isa_name = x86_isa_name(isa);
+    std::map<std::string, double> baseline;
+    if (!FLAGS_baseline.empty()) {
+        baseline = load_baseline(FLAGS_baseline);
+    }
+
+    std::vector<BenchResult> results;
+    int regressions = 0;
+    for (int threads : parse_threads(FLAGS_threads)) {
+        omp_set_num_threads(threads);
+        double peak_gflops = measure_peak_gflops(isa, threads);
+        double bandwidth_gbps = measure_bandwidth_gbps(threads);
+        printf("isa %s, %d threads: peak %.1f GFLOP/s, bandwidth %.1f GB/s\n",
+               isa_name.c_str(), threads, peak_gflops, bandwidth_gbps);
+        printf("%-22s %-52s %10s %9s %9s %9s %s\n",
+               "op", "shape", "ms", "GFLOP/s", "GB/s", "roofline", "baseline");
+
+        for (auto& bench_case : cases) {
+            if ((bench_case.op + " " + bench_case.shape).find(FLAGS_filter) == std::string::npos) {
+                continue;
+            }
+            auto run = bench_case.make();
+            if (!run) {
+                printf("%-22s %-52s %10s\n", bench_case.op.c_str(), bench_case.shape.c_str(), "skipped");
+                continue;
+            }
+            BenchResult r;
+            r.op = bench_case.op;
+            r.shape = bench_case.shape;
+            r.isa = isa_name;
+            r.threads = threads;
+            r.ms = time_ms(run, FLAGS_min_ms);
+            r.gflops = bench_case.flops / r.ms / 1e6;
+            r.gbps = bench_case.bytes / r.ms / 1e6;
+            double bound_ms = std::max(bench_case.flops / peak_gflops, bench_case.bytes / bandwidth_gbps) / 1e6;
+            r.roofline = bound_ms / r.ms;
+            results.push_back(r);
+
+            std::string versus;
+            auto base = baseline.find(r.key());
+            if (base != baseline.end()) {
+                double change = r.ms / base->second - 1.;
+                char buf[64];
+                snprintf(buf, sizeof(buf), "%+.1f%%", change * 100.);
+                versus = buf;
+                if (change > FLAGS_tolerance) {
+                    versus += " REGRESSION";
+                    regressions++;
+                }
+            }
+            printf("%-22s %-52s %10.4f %9.2f %9.2f %9.3f %s\n", r.op.c_str(), r.shape.c_str(),
+                   r.ms, r.gflops, r.gbps, r.roofline, versus.c_str());
+        }
+    }
+
+    if (!FLAGS_out.empty()) {
+        write_results(FLAGS_out, results);
+    }
+    if (regressions > 0) {
+        LOG(ERROR) << regressions << " cases are slower than the baseline by more than "
+                   << FLAGS_tolerance * 100. << "%";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_TEST_SABER_X86_BENCH_X86_MICROBENCH_H
+#define ANAKIN_TEST_SABER_X86_BENCH_X86_MICROBENCH_H
+
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "saber/core/context.h"
+#include "saber/core/tensor.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_funcs_param.h"
+#include "saber/saber_types.h"
+
+namespace anakin {
+namespace saber {
+namespace bench {
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/**
+ * one point of an operator shape sweep.
+ * make() builds and inits the operator on random data and returns one forward call,
+ * or an empty function when the operator has no implementation for the shape on this host.
+ * It is called again for every thread count, as some kernels size their buffers at init.
+ */
+struct BenchCase {
+    std::string op;
+    std::string shape;
+    double flops;   ///< arithmetic of one forward, an exp or a compare counts as one
+    double bytes;   ///< compulsory memory traffic of one forward: inputs, weights and outputs once
+    std::function<std::function<void()>()> make;
+};
+
+/// the cases of every op family, each defined in its own file
+void add_conv_cases(std::vector<BenchCase>& cases);
+void add_fc_cases(std::vector<BenchCase>& cases);
+void add_pooling_cases(std::vector<BenchCase>& cases);
+void add_softmax_cases(std::vector<BenchCase>& cases);
+void add_rnn_cases(std::vector<BenchCase>& cases);
+void add_embedding_cases(std::vector<BenchCase>& cases);
+void add_sequence_cases(std::vector<BenchCase>& cases);
+
+/**
+ * the tensors, param and context of one operator, which outlive the returned forward call.
+ * Weight tensors are kept in the state as params only hold pointers to them.
+ */
+template <typename OpT, typename ParamT, typename InT = Tensor4f, typename OutT = Tensor4f>
+struct OpState {
+    OpT op;
+    ParamT param;
+    Context<X86> ctx;
+    std::vector<InT*> ins;
+    std::vector<OutT*> outs;
+
+    Tensor4f* weight(Shape shape) {
+        _weights.emplace_back(new Tensor4f(shape));
+        fill_tensor_host_rand(*_weights.back(), -0.5f, 0.5f);
+        return _weights.back().get();
+    }
+
+    InT* input(Shape shape, std::vector<int> seq_offset = std::vector<int>()) {
+        _ins.emplace_back(new InT(shape));
+        fill_tensor_host_rand(*_ins.back(), -1.f, 1.f);
+        _ins.back()->set_seq_offset(seq_offset);
+        ins.push_back(_ins.back().get());
+        return _ins.back().get();
+    }
+
+    /// an output shaped by the op, or by out_shape for layouts compute_output_shape doesn't give
+    OutT* output(Shape out_shape = Shape()) {
+        _outs.emplace_back(out_shape.dims() > 0 ? new OutT(out_shape) : new OutT());
+        outs.push_back(_outs.back().get());
+        return _outs.back().get();
+    }
+
+    /// the forward call, empty if the op can't init
+    static std::function<void()> init(std::shared_ptr<OpState> state, ImplEnum impl = SABER_IMPL,
+                                      bool shape_outputs = true) {
+        if (shape_outputs) {
+            if (state->op.compute_output_shape(state->ins, state->outs, state->param) != SaberSuccess) {
+                return std::function<void()>();
+            }
+            for (auto out : state->outs) {
+                out->re_alloc(out->valid_shape());
+            }
+        }
+        if (state->op.init(state->ins, state->outs, state->param,
+                           SPECIFY, impl, state->ctx) != SaberSuccess) {
+            return std::function<void()>();
+        }
+        return [state]() {
+            state->op(state->ins, state->outs, state->param, state->ctx);
+        };
+    }
+
+private:
+    std::vector<std::shared_ptr<Tensor4f> > _weights;
+    std::vector<std::shared_ptr<InT> > _ins;
+    std::vector<std::shared_ptr<OutT> > _outs;
+};
+
+/// "n1_c64" style shape names out of (key, value) pairs
+inline std::string shape_name(std::initializer_list<std::pair<const char*, int> > dims) {
+    std::ostringstream name;
+    for (auto& dim : dims) {
+        name << (name.tellp() > 0 ? "_" : "") << dim.first << dim.second;
+    }
+    return name.str();
+}
+
+/// offsets of batch sequences of seq_len words
+inline std::vector<int> even_seq_offset(int batch, int seq_len) {
+    std::vector<int> offset;
+    for (int i = 0; i <= batch; i++) {
+        offset.push_back(i * seq_len);
+    }
+    return offset;
+}
+
+} // namespace bench
+} // namespace saber
+} // namespace anakin
+
+#endif // ANAKIN_TEST_SABER_X86_BENCH_X86_MICROBENCH_H
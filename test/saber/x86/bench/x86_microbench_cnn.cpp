@@ -0,0 +1,231 @@
+#include "x86_microbench.h"
+#include "saber/core/impl/x86/x86_isa.h"
+#include "saber/funcs/conv.h"
+#include "saber/funcs/conv_act.h"
+#include "saber/funcs/fc.h"
+#include "saber/funcs/pooling.h"
+#include "saber/funcs/softmax.h"
+
+namespace anakin {
+namespace saber {
+namespace bench {
+
+namespace {
+
+struct ConvShape {
+    int ic, h, w, oc, k, stride, pad, group;
+};
+
+/// layers of resnet50 and mobilenet, from the stem to the depthwise and pointwise pairs
+const ConvShape conv_shapes[] = {
+    {3, 224, 224, 64, 7, 2, 3, 1},
+    {64, 56, 56, 64, 3, 1, 1, 1},
+    {256, 56, 56, 64, 1, 1, 0, 1},
+    {128, 56, 56, 128, 3, 2, 1, 1},
+    {512, 7, 7, 2048, 1, 1, 0, 1},
+    {32, 112, 112, 32, 3, 1, 1, 32},
+    {32, 112, 112, 64, 1, 1, 0, 1},
+};
+
+const int conv_batches[] = {1, 8};
+
+int conv_out_size(int in, int k, int stride, int pad) {
+    return (in + 2 * pad - k) / stride + 1;
+}
+
+void add_conv_variant(std::vector<BenchCase>& cases, const std::string& op, int n, const ConvShape& s) {
+    int oh = conv_out_size(s.h, s.k, s.stride, s.pad);
+    int ow = conv_out_size(s.w, s.k, s.stride, s.pad);
+    BenchCase bench_case;
+    bench_case.op = op;
+    bench_case.shape = shape_name({{"n", n}, {"ic", s.ic}, {"h", s.h}, {"w", s.w}, {"oc", s.oc},
+                                   {"k", s.k}, {"s", s.stride}, {"g", s.group}});
+    bench_case.flops = 2. * n * s.oc * oh * ow * (s.ic / s.group) * s.k * s.k;
+    bench_case.bytes = 4. * ((double)n * s.ic * s.h * s.w + (double)s.oc * s.ic / s.group * s.k * s.k
+                             + s.oc + (double)n * s.oc * oh * ow);
+    Shape in_shape(n, s.ic, s.h, s.w);
+    Shape weight_shape(s.oc, s.ic / s.group, s.k, s.k);
+    Shape bias_shape(1, s.oc, 1, 1);
+
+    if (op == "conv") {
+        bench_case.make = [=]() {
+            typedef OpState<Conv<X86, AK_FLOAT>, ConvParam<Tensor4f> > State;
+            // im2col and gemm, which only takes group 1
+            if (s.group != 1) {
+                return std::function<void()>();
+            }
+            auto state = std::make_shared<State>();
+            state->input(in_shape);
+            state->output();
+            state->param = ConvParam<Tensor4f>(s.group, s.pad, s.pad, s.stride, s.stride, 1, 1,
+                                               state->weight(weight_shape), state->weight(bias_shape));
+            return State::init(state);
+        };
+    } else if (op == "conv_relu") {
+        bench_case.make = [=]() {
+            typedef OpState<ConvAct<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>,
+                            ConvActiveParam<Tensor4f> > State;
+            if (s.group != 1) {
+                return std::function<void()>();
+            }
+            auto state = std::make_shared<State>();
+            state->input(in_shape);
+            state->output(Shape(n, s.oc, oh, ow));
+            ConvParam<Tensor4f> conv_param(s.group, s.pad, s.pad, s.stride, s.stride, 1, 1,
+                                           state->weight(weight_shape), state->weight(bias_shape));
+            ActivationParam<Tensor4f> act_param(Active_relu);
+            state->param = ConvActiveParam<Tensor4f>(conv_param, act_param);
+            return State::init(state, SABER_IMPL, false);
+        };
+    } else if (op == "conv_relu_c8") {
+        // nchw in, nchw_c8 out, the avx2 jit kernels
+        bench_case.make = [=]() {
+            typedef Tensor<X86, AK_FLOAT, NCHW_C8> TensorC8;
+            typedef OpState<ConvAct<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW_C8>,
+                            ConvActiveParam<Tensor4f>, Tensor4f, TensorC8> State;
+            if (x86_isa() < X86_ISA_AVX2 || s.oc % 8 != 0) {
+                return std::function<void()>();
+            }
+            auto state = std::make_shared<State>();
+            state->input(in_shape);
+            state->output(Shape(n, s.oc / 8, oh, ow, 8));
+            ConvParam<Tensor4f> conv_param(s.group, s.pad, s.pad, s.stride, s.stride, 1, 1,
+                                           state->weight(weight_shape), state->weight(bias_shape));
+            ActivationParam<Tensor4f> act_param(Active_relu);
+            state->param = ConvActiveParam<Tensor4f>(conv_param, act_param);
+            return State::init(state, SABER_IMPL, false);
+        };
+    } else if (op == "conv_relu_c16") {
+        // nchw_c16 in and out, the avx512 jit kernels
+        bench_case.make = [=]() {
+            typedef Tensor<X86, AK_FLOAT, NCHW_C16> TensorC16;
+            typedef OpState<ConvAct<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW_C16, NCHW_C16>,
+                            ConvActiveParam<Tensor4f>, TensorC16, TensorC16> State;
+            if (x86_isa() < X86_ISA_AVX512 || s.ic % 16 != 0 || s.oc % 16 != 0) {
+                return std::function<void()>();
+            }
+            auto state = std::make_shared<State>();
+            state->input(Shape(n, s.ic / 16, s.h, s.w, 16));
+            state->output(Shape(n, s.oc / 16, oh, ow, 16));
+            ConvParam<Tensor4f> conv_param(s.group, s.pad, s.pad, s.stride, s.stride, 1, 1,
+                                           state->weight(weight_shape), state->weight(bias_shape));
+            ActivationParam<Tensor4f> act_param(Active_relu);
+            state->param = ConvActiveParam<Tensor4f>(conv_param, act_param);
+            return State::init(state, SABER_IMPL, false);
+        };
+    }
+    cases.push_back(bench_case);
+}
+
+} // namespace
+
+void add_conv_cases(std::vector<BenchCase>& cases) {
+    for (auto op : {"conv", "conv_relu", "conv_relu_c8", "conv_relu_c16"}) {
+        for (int n : conv_batches) {
+            for (auto& s : conv_shapes) {
+                add_conv_variant(cases, op, n, s);
+            }
+        }
+    }
+}
+
+void add_fc_cases(std::vector<BenchCase>& cases) {
+    // (k, n) of classifier heads and transformer projections, m rows of a batch
+    const int kn[][2] = {{2048, 1000}, {512, 512}, {1024, 4096}, {4096, 1024}};
+    for (int m : {1, 16, 128}) {
+        for (auto& w : kn) {
+            int k = w[0];
+            int out = w[1];
+            BenchCase bench_case;
+            bench_case.op = "fc";
+            bench_case.shape = shape_name({{"m", m}, {"k", k}, {"n", out}});
+            bench_case.flops = 2. * m * k * out;
+            bench_case.bytes = 4. * ((double)m * k + (double)k * out + out + (double)m * out);
+            bench_case.make = [=]() {
+                typedef OpState<Fc<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>,
+                                FcParam<Tensor4f> > State;
+                auto state = std::make_shared<State>();
+                state->input(Shape(m, k, 1, 1));
+                state->output();
+                state->param = FcParam<Tensor4f>(state->weight(Shape(out, k, 1, 1)),
+                                                 state->weight(Shape(1, 1, 1, out)), out);
+                return State::init(state, VENDER_IMPL);
+            };
+            cases.push_back(bench_case);
+        }
+    }
+}
+
+void add_pooling_cases(std::vector<BenchCase>& cases) {
+    struct PoolShape {
+        const char* op;
+        int c, h, w, k, stride, pad;
+        PoolingType type;
+        bool global;
+    };
+    const PoolShape pool_shapes[] = {
+        {"pool_max", 64, 112, 112, 3, 2, 1, Pooling_max, false},
+        {"pool_max", 256, 28, 28, 2, 2, 0, Pooling_max, false},
+        {"pool_avg", 256, 28, 28, 3, 1, 1, Pooling_average_include_padding, false},
+        {"pool_global_avg", 2048, 7, 7, 7, 1, 0, Pooling_average_include_padding, true},
+        {"pool_global_avg", 1024, 14, 14, 14, 1, 0, Pooling_average_include_padding, true},
+    };
+    for (int n : {1, 8}) {
+        for (auto& s : pool_shapes) {
+            int oh = s.global ? 1 : conv_out_size(s.h, s.k, s.stride, s.pad);
+            int ow = s.global ? 1 : conv_out_size(s.w, s.k, s.stride, s.pad);
+            BenchCase bench_case;
+            bench_case.op = s.op;
+            bench_case.shape = shape_name({{"n", n}, {"c", s.c}, {"h", s.h}, {"w", s.w},
+                                           {"k", s.k}, {"s", s.stride}});
+            bench_case.flops = (double)n * s.c * oh * ow * s.k * s.k;
+            bench_case.bytes = 4. * ((double)n * s.c * s.h * s.w + (double)n * s.c * oh * ow);
+            bench_case.make = [=]() {
+                typedef OpState<Pooling<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>,
+                                PoolingParam<Tensor4f> > State;
+                auto state = std::make_shared<State>();
+                state->input(Shape(n, s.c, s.h, s.w));
+                state->output();
+                state->param = PoolingParam<Tensor4f>(s.k, s.k, s.pad, s.pad, s.stride, s.stride,
+                                                      s.type, s.global);
+                return State::init(state);
+            };
+            cases.push_back(bench_case);
+        }
+    }
+}
+
+void add_softmax_cases(std::vector<BenchCase>& cases) {
+    struct SoftmaxShape {
+        int n, c, h, w, axis;
+    };
+    // classifier rows, attention rows and a per pixel segmentation softmax over channels
+    const SoftmaxShape softmax_shapes[] = {
+        {1, 1000, 1, 1, 1},
+        {64, 1000, 1, 1, 1},
+        {8, 12, 128, 128, 3},
+        {1, 21, 256, 256, 1},
+    };
+    for (auto& s : softmax_shapes) {
+        double count = (double)s.n * s.c * s.h * s.w;
+        BenchCase bench_case;
+        bench_case.op = "softmax";
+        bench_case.shape = shape_name({{"n", s.n}, {"c", s.c}, {"h", s.h}, {"w", s.w}, {"axis", s.axis}});
+        // max, subtract, exp, sum and scale
+        bench_case.flops = 5. * count;
+        bench_case.bytes = 8. * count;
+        bench_case.make = [=]() {
+            typedef OpState<Softmax<X86, AK_FLOAT>, SoftmaxParam<Tensor4f> > State;
+            auto state = std::make_shared<State>();
+            state->input(Shape(s.n, s.c, s.h, s.w));
+            state->output();
+            state->param = SoftmaxParam<Tensor4f>(s.axis);
+            return State::init(state);
+        };
+        cases.push_back(bench_case);
+    }
+}
+
+} // namespace bench
+} // namespace saber
+} // namespace anakin
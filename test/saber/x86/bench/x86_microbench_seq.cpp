@@ -0,0 +1,162 @@
+#include "x86_microbench.h"
+#include "saber/funcs/embedding.h"
+#include "saber/funcs/gru.h"
+#include "saber/funcs/lstm.h"
+#include "saber/funcs/sequence_conv.h"
+#include "saber/funcs/sequence_pool.h"
+
+namespace anakin {
+namespace saber {
+namespace bench {
+
+namespace {
+
+/// batch of equal sequences, from online batch 1 to offline batches
+const int seq_batches[] = {1, 16};
+const int seq_len = 32;
+
+} // namespace
+
+void add_rnn_cases(std::vector<BenchCase>& cases) {
+    // (word size, hidden size)
+    const int sizes[][2] = {{128, 128}, {512, 512}, {256, 1024}};
+    for (int batch : seq_batches) {
+        for (auto& size : sizes) {
+            int word_size = size[0];
+            int hidden_size = size[1];
+            double words = (double)batch * seq_len;
+            std::vector<int> offset = even_seq_offset(batch, seq_len);
+            Shape in_shape(batch * seq_len, word_size, 1, 1);
+
+            BenchCase lstm_case;
+            lstm_case.op = "lstm";
+            lstm_case.shape = shape_name({{"batch", batch}, {"len", seq_len},
+                                          {"word", word_size}, {"hidden", hidden_size}});
+            // the gemms of the input and the hidden state, and 10 ops per cell of the gates
+            lstm_case.flops = words * (8. * hidden_size * (word_size + hidden_size) + 10. * hidden_size);
+            lstm_case.bytes = 4. * (words * word_size + 4. * hidden_size * (word_size + hidden_size)
+                                    + 4. * hidden_size + words * hidden_size);
+            lstm_case.make = [=]() {
+                typedef OpState<Lstm<X86, AK_FLOAT>, LstmParam<Tensor4f> > State;
+                auto state = std::make_shared<State>();
+                state->input(in_shape, offset);
+                state->output();
+                Tensor4f* weight = state->weight(Shape(1, 1, 1, 4 * hidden_size * (word_size + hidden_size)));
+                Tensor4f* bias = state->weight(Shape(1, 1, 1, 4 * hidden_size));
+                state->param = LstmParam<Tensor4f>(weight, bias, nullptr, Active_unknow, Active_sigmoid,
+                                                   Active_tanh, Active_tanh, false, false, false);
+                return State::init(state);
+            };
+            cases.push_back(lstm_case);
+
+            BenchCase gru_case;
+            gru_case.op = "gru";
+            gru_case.shape = lstm_case.shape;
+            gru_case.flops = words * (6. * hidden_size * (word_size + hidden_size) + 8. * hidden_size);
+            gru_case.bytes = 4. * (words * word_size + 3. * hidden_size * (word_size + hidden_size)
+                                   + 3. * hidden_size + words * hidden_size);
+            gru_case.make = [=]() {
+                typedef OpState<Gru<X86, AK_FLOAT>, GruParam<Tensor4f> > State;
+                auto state = std::make_shared<State>();
+                state->input(in_shape, offset);
+                state->output();
+                Tensor4f* weight = state->weight(Shape(1, 1, 1, 3 * hidden_size * (word_size + hidden_size)));
+                Tensor4f* bias = state->weight(Shape(1, 1, 1, 3 * hidden_size));
+                state->param = GruParam<Tensor4f>(weight, bias, GRU_ORIGIN, Active_sigmoid, Active_tanh);
+                return State::init(state);
+            };
+            cases.push_back(gru_case);
+        }
+    }
+}
+
+void add_embedding_cases(std::vector<BenchCase>& cases) {
+    const int vocab = 30000;
+    for (int words : {128, 4096}) {
+        for (int emb_dim : {128, 512}) {
+            BenchCase bench_case;
+            bench_case.op = "embedding";
+            bench_case.shape = shape_name({{"words", words}, {"vocab", vocab}, {"dim", emb_dim}});
+            bench_case.flops = 0.;
+            // ids in, and every looked up row read once and written once
+            bench_case.bytes = 4. * words * (1 + 2. * emb_dim);
+            bench_case.make = [=]() {
+                typedef OpState<Embedding<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>,
+                                EmbeddingParam<Tensor4f> > State;
+                auto state = std::make_shared<State>();
+                Tensor4f* ids = state->input(Shape(words, 1, 1, 1), even_seq_offset(1, words));
+                float* id_data = ids->mutable_data();
+                for (int i = 0; i < words; i++) {
+                    id_data[i] = std::rand() % vocab;
+                }
+                state->output();
+                state->param = EmbeddingParam<Tensor4f>(vocab, emb_dim, -1,
+                                                        state->weight(Shape(vocab, 1, 1, emb_dim)));
+                return State::init(state);
+            };
+            cases.push_back(bench_case);
+        }
+    }
+}
+
+void add_sequence_cases(std::vector<BenchCase>& cases) {
+    const int dims[] = {128, 512};
+    const std::pair<const char*, SequencePoolType> pool_types[] = {
+        {"sequence_pool_sum", Sequence_pool_sum},
+        {"sequence_pool_average", Sequence_pool_average},
+        {"sequence_pool_max", Sequence_pool_max},
+        {"sequence_pool_last", Sequence_pool_last},
+    };
+    for (int batch : seq_batches) {
+        for (int dim : dims) {
+            double words = (double)batch * seq_len;
+            std::vector<int> offset = even_seq_offset(batch, seq_len);
+            Shape in_shape(batch * seq_len, dim, 1, 1);
+            std::string shape = shape_name({{"batch", batch}, {"len", seq_len}, {"dim", dim}});
+
+            for (auto& pool_type : pool_types) {
+                SequencePoolType type = pool_type.second;
+                BenchCase bench_case;
+                bench_case.op = pool_type.first;
+                bench_case.shape = shape;
+                bench_case.flops = type == Sequence_pool_last ? 0. : words * dim;
+                bench_case.bytes = 4. * (type == Sequence_pool_last ? 2. * batch * dim
+                                                                    : words * dim + batch * dim);
+                bench_case.make = [=]() {
+                    typedef OpState<SequencePool<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>,
+                                    SequencePoolParam<Tensor4f> > State;
+                    auto state = std::make_shared<State>();
+                    state->input(in_shape, offset);
+                    state->output();
+                    state->param = SequencePoolParam<Tensor4f>(type);
+                    return State::init(state);
+                };
+                cases.push_back(bench_case);
+            }
+
+            // context of 3 words, centered
+            const int context = 3;
+            BenchCase conv_case;
+            conv_case.op = "sequence_conv";
+            conv_case.shape = shape_name({{"batch", batch}, {"len", seq_len}, {"dim", dim},
+                                          {"ctx", context}, {"out", dim}});
+            conv_case.flops = 2. * words * context * dim * dim;
+            conv_case.bytes = 4. * (words * dim + (double)context * dim * dim + words * dim);
+            conv_case.make = [=]() {
+                typedef OpState<SequenceConv<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW>,
+                                SequenceConvParam<Tensor4f> > State;
+                auto state = std::make_shared<State>();
+                state->input(in_shape, offset);
+                state->output();
+                state->param = SequenceConvParam<Tensor4f>(state->weight(Shape(1, 1, context * dim, dim)),
+                                                           context, -1);
+                return State::init(state);
+            };
+            cases.push_back(conv_case);
+        }
+    }
+}
+
+} // namespace bench
+} // namespace saber
+} // namespace anakin
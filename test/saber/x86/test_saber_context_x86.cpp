@@ -0,0 +1,113 @@
+#include <thread>
+#include <omp.h>
+#include "saber/core/context.h"
+#include "saber/core/impl/x86/x86_thread.h"
+#include "test_saber_func_x86.h"
+
+using namespace anakin::saber;
+
+/// size of the omp team a bare parallel region of the calling thread starts
+int omp_team_size() {
+    int team = 0;
+    #pragma omp parallel
+    {
+        #pragma omp single
+        team = omp_get_num_threads();
+    }
+    return team;
+}
+
+TEST(TestSaberFuncX86, test_thread_budget) {
+    Env<X86>::env_init();
+    int core_num = x86_process_cpus().size();
+    CHECK_GT(core_num, 0);
+
+    X86ThreadBudget budget = x86_thread_budget();
+    CHECK_EQ(budget.core_num, core_num);
+    CHECK_EQ(budget.inter_op_num, 1);
+    CHECK_EQ(budget.intra_op_num, core_num);
+
+    int first = x86_reserve_inter_op_threads(2);
+    CHECK_EQ(first, 0);
+    CHECK_EQ(x86_thread_budget().intra_op_num, std::max(1, core_num / 2));
+    x86_release_inter_op_threads(first, 2);
+    CHECK_EQ(x86_thread_budget().inter_op_num, 1);
+
+    // more net threads than cores, each runs its kernels alone
+    first = x86_reserve_inter_op_threads(core_num * 4);
+    CHECK_EQ(x86_thread_budget().intra_op_num, 1);
+    x86_release_inter_op_threads(first, core_num * 4);
+}
+
+TEST(TestSaberFuncX86, test_thread_budget_two_workers) {
+    Env<X86>::env_init();
+    int core_num = x86_process_cpus().size();
+
+    // the threads of two workers add up, and each worker gets shares of its own
+    int first_a = x86_reserve_inter_op_threads(2);
+    int first_b = x86_reserve_inter_op_threads(3);
+    CHECK_EQ(first_a, 0);
+    CHECK_EQ(first_b, 2);
+    CHECK_EQ(x86_thread_budget().inter_op_num, 5);
+    CHECK_EQ(x86_thread_budget().intra_op_num, std::max(1, core_num / 5));
+
+    // the slots of a gone worker go to the next one that fits, the others keep theirs
+    x86_release_inter_op_threads(first_a, 2);
+    CHECK_EQ(x86_thread_budget().inter_op_num, 5);
+    int first_c = x86_reserve_inter_op_threads(1);
+    CHECK_EQ(first_c, 0);
+    int first_d = x86_reserve_inter_op_threads(2);
+    CHECK_EQ(first_d, 5);
+    CHECK_EQ(x86_thread_budget().inter_op_num, 7);
+
+    x86_release_inter_op_threads(first_d, 2);
+    x86_release_inter_op_threads(first_b, 3);
+    CHECK_EQ(x86_thread_budget().inter_op_num, 1);
+    x86_release_inter_op_threads(first_c, 1);
+    CHECK_EQ(x86_thread_budget().inter_op_num, 1);
+    CHECK_EQ(x86_thread_budget().intra_op_num, core_num);
+}
+
+TEST(TestSaberFuncX86, test_context_thread_num) {
+    Env<X86>::env_init();
+
+    // a default context takes the budget, fixed at its first bind
+    Context<X86> ctx_budget;
+    CHECK_EQ(ctx_budget.get_thread_num(), x86_thread_budget().intra_op_num);
+    ctx_budget.bind_dev();
+    int budget_threads = ctx_budget.get_thread_num();
+    int many = x86_process_cpus().size() * 4;
+    int first = x86_reserve_inter_op_threads(many);
+    CHECK_EQ(ctx_budget.get_thread_num(), budget_threads);
+    x86_release_inter_op_threads(first, many);
+
+    Context<X86> ctx;
+    ctx.set_thread_num(3);
+    ctx.bind_dev();
+    CHECK_EQ(omp_get_max_threads(), 3);
+    CHECK_EQ(omp_team_size(), 3);
+
+    // a copy keeps the thread num, and binding it on another thread leaves this one alone
+    Context<X86> ctx_other(ctx);
+    CHECK_EQ(ctx_other.get_thread_num(), 3);
+    ctx_other.set_thread_num(2);
+    int other_team = 0;
+    std::thread other([&]() {
+        ctx_other.bind_dev();
+        other_team = omp_team_size();
+    });
+    other.join();
+    CHECK_EQ(other_team, 2);
+    CHECK_EQ(omp_team_size(), 3);
+
+    ctx_budget.bind_dev();
+    CHECK_EQ(omp_team_size(), budget_threads);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
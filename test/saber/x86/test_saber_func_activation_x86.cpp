@@ -324,6 +324,99 @@ void test_elu(int n, int c, int h, int w){
     }
 }
 
+void test_prelu(int n, int c, int h, int w, bool channel_shared){
+    Shape shape_in(n, c, h, w);
+
+    Tensor4f src, dst, dst_host, slope;
+    src.re_alloc(shape_in);
+    fill_tensor_host_rand(src);
+    slope.re_alloc(Shape(1, c, 1, 1));
+    fill_tensor_host_rand(slope, 0.f, 1.f);
+
+    dst_host.re_alloc(shape_in);
+    float *dst_host_ptr = dst_host.mutable_data();
+    const float *src_ptr = src.data();
+    const float *slope_ptr = slope.data();
+    int inner = h * w;
+    for (int i = 0; i < dst_host.valid_size(); i++) {
+        float alpha = channel_shared ? slope_ptr[0] : slope_ptr[(i / inner) % c];
+        dst_host_ptr[i] = src_ptr[i] > 0 ? src_ptr[i] : alpha * src_ptr[i];
+    }
+
+    Context<X86> ctx_host;
+
+    std::vector<Tensor4f*> input;
+    std::vector<Tensor4f*> output;
+
+    input.push_back(&src);
+
+    dst.re_alloc(shape_in);
+    output.push_back(&dst);
+
+    PreluParam<Tensor4f> prelu_param(channel_shared, &slope);
+    ActivationParam<Tensor4f> param_host(Active_prelu, 0.f, 1.f, prelu_param);
+
+    Activation<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW> op_prelu;
+
+    op_prelu.init(input, output, param_host, SPECIFY, SABER_IMPL, ctx_host);
+
+    op_prelu(input, output, param_host, ctx_host);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_host.data(), dst.valid_size(), max_ratio, max_diff);
+    if (max_diff < 1e-6) {
+        LOG(INFO) << "Test Passed";
+    }
+    else {
+        LOG(ERROR) << "Test Failed, max_diff " << max_diff;
+    }
+}
+
+void test_leaky_relu(int n, int c, int h, int w){
+    float negative_slope = 0.1f;
+    Shape shape_in(n, c, h, w);
+
+    Tensor4f src, dst, dst_host;
+    src.re_alloc(shape_in);
+    fill_tensor_host_rand(src);
+
+    dst_host.re_alloc(shape_in);
+    float *dst_host_ptr = dst_host.mutable_data();
+    const float *src_ptr = src.data();
+    for (int i = 0; i < dst_host.valid_size(); i++) {
+        dst_host_ptr[i] = src_ptr[i] > 0 ? src_ptr[i] : negative_slope * src_ptr[i];
+    }
+
+    Context<X86> ctx_host;
+
+    std::vector<Tensor4f*> input;
+    std::vector<Tensor4f*> output;
+
+    input.push_back(&src);
+
+    dst.re_alloc(shape_in);
+    output.push_back(&dst);
+
+    ActivationParam<Tensor4f> param_host(Active_relu, negative_slope);
+
+    Activation<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW> op_relu;
+
+    op_relu.init(input, output, param_host, SPECIFY, SABER_IMPL, ctx_host);
+
+    op_relu(input, output, param_host, ctx_host);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_host.data(), dst.valid_size(), max_ratio, max_diff);
+    if (max_diff < 1e-6) {
+        LOG(INFO) << "Test Passed";
+    }
+    else {
+        LOG(ERROR) << "Test Failed, max_diff " << max_diff;
+    }
+}
+
 TEST(TestSaberActivationX86, test_tensor_activation) {
     Env<X86>::env_init();
 
@@ -405,6 +498,21 @@ TEST(TestSaberActivationX86, test_activation_elu) {
 
 }
 
+TEST(TestSaberActivationX86, test_activation_prelu) {
+    Env<X86>::env_init();
+
+    LOG(INFO) << "case 1:";
+    test_prelu(1, 3, 1, 1023, false);
+    LOG(INFO) << "case 2:";
+    test_prelu(2, 32, 64, 64, false);
+    LOG(INFO) << "case 3:";
+    test_prelu(2, 32, 64, 64, true);
+
+    LOG(INFO) << "test for leaky relu:";
+    test_leaky_relu(1, 1, 1, 1023);
+    test_leaky_relu(2, 32, 512, 512);
+}
+
 int main(int argc, const char** argv) {
     logger::init(argv[0]);
     InitTest();
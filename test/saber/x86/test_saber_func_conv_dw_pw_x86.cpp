@@ -0,0 +1,188 @@
+#include <vector>
+#include <cmath>
+#include "saber/core/context.h"
+#include "saber/funcs/conv_dw_pw.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+typedef ConvDwPw<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW> ConvDwPwX86;
+
+struct DwPwCase {
+    Shape in_shape;
+    int kernel, stride, pad, dilation;
+    int out_c;
+    bool pw_relu;
+};
+
+/// batchnorm and scale of a conv with out_c filters, and their per channel affine
+void make_bn_scale(int out_c, BatchnormParam<Tensor4f>& bn_param, ScaleParam<Tensor4f>& scale_param,
+                   std::vector<float>& alpha, std::vector<float>& beta) {
+    std::vector<float> mean, variance, scale_w, scale_b;
+    for (int i = 0; i < out_c; ++i) {
+        mean.push_back(0.1f * (i % 5) - 0.2f);
+        variance.push_back(0.5f + 0.1f * (i % 7));
+        scale_w.push_back(0.5f + 0.05f * (i % 11));
+        scale_b.push_back(-0.2f + 0.03f * (i % 13));
+        float a = 1.f / sqrtf(variance[i] + 1e-5f);
+        alpha.push_back(a * scale_w[i]);
+        beta.push_back(-mean[i] * a * scale_w[i] + scale_b[i]);
+    }
+    bn_param = BatchnormParam<Tensor4f>(mean, variance, 1.f);
+    scale_param = ScaleParam<Tensor4f>(scale_w, scale_b, true);
+}
+
+/// reference: direct grouped conv, then the per channel affine and an optional relu
+void compute_ref_conv(Tensor4f& src, Tensor4f& dst, Tensor4f& weight, Tensor4f& bias, int group,
+                      int stride, int pad, int dilation, std::vector<float>& alpha,
+                      std::vector<float>& beta, bool relu) {
+    int num = src.num();
+    int in_c = src.channel();
+    int in_h = src.height();
+    int in_w = src.width();
+    int kernel_h = weight.height();
+    int kernel_w = weight.width();
+    int out_c = weight.num();
+    int out_h = (in_h + 2 * pad - dilation * (kernel_h - 1) - 1) / stride + 1;
+    int out_w = (in_w + 2 * pad - dilation * (kernel_w - 1) - 1) / stride + 1;
+    int group_in = in_c / group;
+    int group_out = out_c / group;
+    dst.re_alloc(Shape(num, out_c, out_h, out_w));
+    const float* src_data = src.data();
+    const float* w_data = weight.data();
+    float* dst_data = dst.mutable_data();
+    for (int n = 0; n < num; ++n) {
+        for (int oc = 0; oc < out_c; ++oc) {
+            int g = oc / group_out;
+            for (int oh = 0; oh < out_h; ++oh) {
+                for (int ow = 0; ow < out_w; ++ow) {
+                    double sum = bias.data()[oc];
+                    for (int ic = 0; ic < group_in; ++ic) {
+                        for (int kh = 0; kh < kernel_h; ++kh) {
+                            for (int kw = 0; kw < kernel_w; ++kw) {
+                                int ih = oh * stride - pad + kh * dilation;
+                                int iw = ow * stride - pad + kw * dilation;
+                                if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+                                    continue;
+                                }
+                                sum += src_data[((n * in_c + g * group_in + ic) * in_h + ih) * in_w + iw]
+                                       * w_data[((oc * group_in + ic) * kernel_h + kh) * kernel_w + kw];
+                            }
+                        }
+                    }
+                    float out = sum * alpha[oc] + beta[oc];
+                    dst_data[((n * out_c + oc) * out_h + oh) * out_w + ow] = relu && out < 0.f ? 0.f : out;
+                }
+            }
+        }
+    }
+}
+
+void conv_dw_pw_ut(const DwPwCase& c) {
+    Context<X86> ctx_host;
+    int channel = c.in_shape[1];
+    Tensor4f src(c.in_shape);
+    fill_tensor_host_rand(src, -1.f, 1.f);
+
+    Tensor4f dw_weight(Shape(channel, 1, c.kernel, c.kernel));
+    Tensor4f dw_bias(Shape(1, channel, 1, 1));
+    Tensor4f pw_weight(Shape(c.out_c, channel, 1, 1));
+    Tensor4f pw_bias(Shape(1, c.out_c, 1, 1));
+    fill_tensor_host_rand(dw_weight, -0.5f, 0.5f);
+    fill_tensor_host_rand(dw_bias, -0.5f, 0.5f);
+    fill_tensor_host_rand(pw_weight, -0.2f, 0.2f);
+    fill_tensor_host_rand(pw_bias, -0.5f, 0.5f);
+
+    BatchnormParam<Tensor4f> dw_bn, pw_bn;
+    ScaleParam<Tensor4f> dw_scale, pw_scale;
+    std::vector<float> dw_alpha, dw_beta, pw_alpha, pw_beta;
+    make_bn_scale(channel, dw_bn, dw_scale, dw_alpha, dw_beta);
+    make_bn_scale(c.out_c, pw_bn, pw_scale, pw_alpha, pw_beta);
+
+    // reference: the two convs one after the other, before init folds the weights in place
+    Tensor4f dw_out;
+    Tensor4f dst_ref;
+    compute_ref_conv(src, dw_out, dw_weight, dw_bias, channel, c.stride, c.pad, c.dilation,
+                     dw_alpha, dw_beta, true);
+    compute_ref_conv(dw_out, dst_ref, pw_weight, pw_bias, 1, 1, 0, 1, pw_alpha, pw_beta, c.pw_relu);
+
+    ActivationParam<Tensor4f> relu(Active_relu);
+    ConvParam<Tensor4f> dw_conv(channel, c.pad, c.pad, c.stride, c.stride, c.dilation, c.dilation,
+                                &dw_weight, &dw_bias);
+    ConvParam<Tensor4f> pw_conv(1, 0, 0, 1, 1, 1, 1, &pw_weight, &pw_bias);
+    ConvActiveParam<Tensor4f> dw_param(dw_conv, relu, dw_bn, dw_scale);
+    ConvActiveParam<Tensor4f> pw_param = c.pw_relu ?
+            ConvActiveParam<Tensor4f>(pw_conv, relu, pw_bn, pw_scale) :
+            ConvActiveParam<Tensor4f>(pw_conv, pw_bn, pw_scale);
+    ConvDwPwParam<Tensor4f> param(dw_param, pw_param);
+
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    ConvDwPwX86 dw_pw;
+    SABER_CHECK(dw_pw.compute_output_shape(inputs, outputs, param));
+    CHECK(dst.valid_shape() == dst_ref.valid_shape()) << "output shape of conv dw pw is wrong";
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(dw_pw.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(dw_pw(inputs, outputs, param, ctx_host));
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "conv dw pw, in " << c.in_shape[0] << "x" << channel << "x" << c.in_shape[2]
+              << "x" << c.in_shape[3] << ", kernel " << c.kernel << ", stride " << c.stride
+              << ", out " << c.out_c << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-4) << "conv dw pw check failed";
+}
+
+TEST(TestSaberFuncX86, test_conv_dw_pw) {
+    Env<X86>::env_init();
+
+    // mobilenet v1 blocks, a v2 linear projection and odd shapes with dilation
+    DwPwCase cases[] = {
+        {Shape(1, 32, 112, 112), 3, 1, 1, 1, 64, true},
+        {Shape(2, 64, 56, 56), 3, 2, 1, 1, 128, true},
+        {Shape(1, 512, 14, 14), 3, 1, 1, 1, 512, true},
+        {Shape(1, 1024, 7, 7), 3, 1, 1, 1, 1024, true},
+        {Shape(2, 96, 28, 28), 3, 1, 1, 1, 24, false},
+        {Shape(1, 5, 9, 7), 3, 2, 2, 2, 3, true},
+        {Shape(3, 8, 6, 11), 5, 1, 0, 1, 7, false},
+    };
+    for (auto& c : cases) {
+        conv_dw_pw_ut(c);
+    }
+}
+
+TEST(TestSaberFuncX86, test_conv_dw_pw_unsupported) {
+    Env<X86>::env_init();
+    Context<X86> ctx_host;
+    Tensor4f src(Shape(1, 4, 5, 5));
+    Tensor4f dw_weight(Shape(4, 1, 3, 3));
+    Tensor4f dw_bias(Shape(1, 4, 1, 1));
+    Tensor4f pw_weight(Shape(8, 4, 3, 3));
+    Tensor4f pw_bias(Shape(1, 8, 1, 1));
+    ConvParam<Tensor4f> dw_conv(4, 1, 1, 1, 1, 1, 1, &dw_weight, &dw_bias);
+    ConvParam<Tensor4f> pw_conv(1, 1, 1, 1, 1, 1, 1, &pw_weight, &pw_bias);
+    ConvActiveParam<Tensor4f> dw_param(dw_conv);
+    ConvActiveParam<Tensor4f> pw_param(pw_conv);
+    ConvDwPwParam<Tensor4f> param(dw_param, pw_param);
+
+    // a 3x3 second conv is not a pointwise one
+    Tensor4f dst(Shape(1, 8, 5, 5));
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    SaberConvDwPw<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW> dw_pw;
+    CHECK_EQ(dw_pw.init(inputs, outputs, param, ctx_host), SaberUnImplError);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <vector>
+#include <cmath>
+#include "saber/core/context.h"
+#include "saber/funcs/conv_act.h"
+#include "saber/funcs/impl/x86/saber_conv_act.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+typedef ConvAct<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW> ConvActX86;
+
+/// reference: direct conv, a per channel affine for the folded batchnorm and scale,
+/// the residual already in dst, then the activation
+void compute_ref_conv_eltwise(Tensor4f& src, Tensor4f& dst, ConvParam<Tensor4f>& conv_param,
+                              std::vector<float>& alpha, std::vector<float>& beta, ActiveType act) {
+    int num = src.num();
+    int in_c = src.channel();
+    int in_h = src.height();
+    int in_w = src.width();
+    int out_c = dst.channel();
+    int out_h = dst.height();
+    int out_w = dst.width();
+    int kernel_h = conv_param.weight()->height();
+    int kernel_w = conv_param.weight()->width();
+    const float* src_data = src.data();
+    const float* weight = conv_param.weight()->data();
+    const float* bias = conv_param.bias()->data();
+    float* dst_data = dst.mutable_data();
+    for (int n = 0; n < num; ++n) {
+        for (int oc = 0; oc < out_c; ++oc) {
+            for (int oh = 0; oh < out_h; ++oh) {
+                for (int ow = 0; ow < out_w; ++ow) {
+                    double sum = bias[oc];
+                    for (int ic = 0; ic < in_c; ++ic) {
+                        for (int kh = 0; kh < kernel_h; ++kh) {
+                            for (int kw = 0; kw < kernel_w; ++kw) {
+                                int ih = oh * conv_param.stride_h - conv_param.pad_h + kh;
+                                int iw = ow * conv_param.stride_w - conv_param.pad_w + kw;
+                                if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+                                    continue;
+                                }
+                                sum += src_data[((n * in_c + ic) * in_h + ih) * in_w + iw]
+                                       * weight[((oc * in_c + ic) * kernel_h + kh) * kernel_w + kw];
+                            }
+                        }
+                    }
+                    float& out = dst_data[((n * out_c + oc) * out_h + oh) * out_w + ow];
+                    out += sum * alpha[oc] + beta[oc];
+                    if (act == Active_relu) {
+                        out = out > 0.f ? out : 0.f;
+                    } else if (act == Active_sigmoid) {
+                        out = 1.f / (1.f + expf(-out));
+                    }
+                }
+            }
+        }
+    }
+}
+
+struct ConvEltwiseCase {
+    Shape in_shape;
+    int out_c, kernel, stride, pad;
+};
+
+/// the param ConvBatchnormScale builds for a conv merged with a residual EltwiseRelu
+void conv_bn_scale_eltwise_relu_ut(const ConvEltwiseCase& c) {
+    Context<X86> ctx_host;
+    int in_c = c.in_shape[1];
+    Tensor4f src(c.in_shape);
+    Tensor4f weight(Shape(c.out_c, in_c, c.kernel, c.kernel));
+    Tensor4f bias(Shape(1, c.out_c, 1, 1));
+    fill_tensor_host_rand(src, -1.f, 1.f);
+    fill_tensor_host_rand(weight, -0.5f, 0.5f);
+    fill_tensor_host_rand(bias, -0.5f, 0.5f);
+
+    std::vector<float> mean, variance, scale_w, scale_b, alpha, beta;
+    for (int i = 0; i < c.out_c; ++i) {
+        mean.push_back(0.1f * (i % 5));
+        variance.push_back(0.5f + 0.1f * (i % 7));
+        scale_w.push_back(0.5f + 0.05f * (i % 11));
+        scale_b.push_back(-0.2f + 0.03f * (i % 13));
+        float a = 1.f / sqrtf(variance[i] + 1e-5f);
+        alpha.push_back(a * scale_w[i]);
+        beta.push_back(-mean[i] * a * scale_w[i] + scale_b[i]);
+    }
+    ConvParam<Tensor4f> conv_param(1, c.pad, c.pad, c.stride, c.stride, 1, 1, &weight, &bias);
+    BatchnormParam<Tensor4f> bn_param(mean, variance, 1.f, 0.999f, 1e-5f);
+    ScaleParam<Tensor4f> scale_param(scale_w, scale_b, true);
+    EltwiseParam<Tensor4f> elt_param(Eltwise_sum, std::vector<float>({1.f, 1.f}));
+    ActivationParam<Tensor4f> act_param(Active_relu);
+    EltwiseActiveParam<Tensor4f> elt_act_param(elt_param, act_param);
+    ConvActiveParam<Tensor4f> param(conv_param, bn_param, scale_param, elt_act_param);
+
+    // the residual is in the output before the conv runs
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    ConvActX86 conv;
+    SABER_CHECK(conv.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    fill_tensor_host_rand(dst, -1.f, 1.f);
+    Tensor4f dst_ref(dst.valid_shape());
+    dst_ref.copy_from(dst);
+    // before init, which folds batchnorm and scale into the weights
+    compute_ref_conv_eltwise(src, dst_ref, conv_param, alpha, beta, Active_relu);
+
+    SABER_CHECK(conv.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(conv(inputs, outputs, param, ctx_host));
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "conv bn scale + eltwise relu, in " << c.in_shape[1] << "x" << c.in_shape[2]
+              << "x" << c.in_shape[3] << ", out " << c.out_c << ", kernel " << c.kernel
+              << ", stride " << c.stride << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-4) << "conv eltwise check failed";
+}
+
+/// an activation other than relu runs as the epilogue after the accumulation
+void conv_eltwise_sigmoid_ut(const ConvEltwiseCase& c) {
+    Context<X86> ctx_host;
+    int in_c = c.in_shape[1];
+    Tensor4f src(c.in_shape);
+    Tensor4f weight(Shape(c.out_c, in_c, c.kernel, c.kernel));
+    Tensor4f bias(Shape(1, c.out_c, 1, 1));
+    fill_tensor_host_rand(src, -1.f, 1.f);
+    fill_tensor_host_rand(weight, -0.5f, 0.5f);
+    fill_tensor_host_rand(bias, -0.5f, 0.5f);
+    std::vector<float> alpha(c.out_c, 1.f);
+    std::vector<float> beta(c.out_c, 0.f);
+
+    ConvParam<Tensor4f> conv_param(1, c.pad, c.pad, c.stride, c.stride, 1, 1, &weight, &bias);
+    ActivationParam<Tensor4f> act_param(Active_sigmoid);
+    EltwiseParam<Tensor4f> elt_param(Eltwise_sum);
+    ConvActiveParam<Tensor4f> param(conv_param, act_param, elt_param);
+
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    ConvActX86 conv;
+    SABER_CHECK(conv.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    fill_tensor_host_rand(dst, -1.f, 1.f);
+    Tensor4f dst_ref(dst.valid_shape());
+    dst_ref.copy_from(dst);
+    compute_ref_conv_eltwise(src, dst_ref, conv_param, alpha, beta, Active_sigmoid);
+
+    SABER_CHECK(conv.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(conv(inputs, outputs, param, ctx_host));
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "conv + eltwise sigmoid, out " << c.out_c << ", kernel " << c.kernel
+              << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-5) << "conv eltwise check failed";
+}
+
+TEST(TestSaberFuncX86, test_conv_eltwise) {
+    Env<X86>::env_init();
+
+    // resnet bottleneck convs: 1x1 expansion, 3x3, and a strided projection
+    ConvEltwiseCase cases[] = {
+        {Shape(2, 64, 28, 28), 256, 1, 1, 0},
+        {Shape(1, 32, 14, 14), 32, 3, 1, 1},
+        {Shape(2, 64, 28, 28), 128, 1, 2, 0},
+        {Shape(1, 3, 9, 7), 5, 3, 2, 1},
+    };
+    for (auto& c : cases) {
+        conv_bn_scale_eltwise_relu_ut(c);
+        conv_eltwise_sigmoid_ut(c);
+    }
+}
+
+TEST(TestSaberFuncX86, test_conv_eltwise_unsupported) {
+    Env<X86>::env_init();
+    Context<X86> ctx_host;
+    Tensor4f src(Shape(1, 4, 5, 5));
+    Tensor4f weight(Shape(4, 4, 1, 1));
+    Tensor4f bias(Shape(1, 4, 1, 1));
+    fill_tensor_host_rand(weight, -0.5f, 0.5f);
+    fill_tensor_host_rand(bias, -0.5f, 0.5f);
+    ConvParam<Tensor4f> conv_param(1, 0, 0, 1, 1, 1, 1, &weight, &bias);
+    ActivationParam<Tensor4f> act_param(Active_relu);
+
+    // a max or a weighted sum can't be accumulated in place
+    EltwiseParam<Tensor4f> params[] = {
+        EltwiseParam<Tensor4f>(Eltwise_max),
+        EltwiseParam<Tensor4f>(Eltwise_sum, std::vector<float>({0.5f, 1.f})),
+    };
+    for (auto& elt_param : params) {
+        ConvActiveParam<Tensor4f> param(conv_param, act_param, elt_param);
+        Tensor4f dst(Shape(1, 4, 5, 5));
+        std::vector<Tensor4f*> inputs(1, &src);
+        std::vector<Tensor4f*> outputs(1, &dst);
+        // the impl itself, as ConvAct would fold the status into a success
+        SaberConv2DAct<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW> conv;
+        CHECK_EQ(conv.init(inputs, outputs, param, ctx_host), SaberUnImplError);
+    }
+
+    // the jit kernels of the blocked layouts don't accumulate a residual at all
+    Tensor4f blocked_weight(Shape(8, 4, 1, 1));
+    Tensor4f blocked_bias(Shape(1, 8, 1, 1));
+    fill_tensor_host_rand(blocked_weight, -0.5f, 0.5f);
+    fill_tensor_host_rand(blocked_bias, -0.5f, 0.5f);
+    ConvParam<Tensor4f> blocked_conv_param(1, 0, 0, 1, 1, 1, 1, &blocked_weight, &blocked_bias);
+    EltwiseParam<Tensor4f> sum_elt_param(Eltwise_sum);
+    ConvActiveParam<Tensor4f> sum_param(blocked_conv_param, act_param, sum_elt_param);
+    Tensor<X86, AK_FLOAT, NCHW_C8> blocked_dst(Shape(1, 1, 5, 5, 8));
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor<X86, AK_FLOAT, NCHW_C8>*> blocked_outputs(1, &blocked_dst);
+    SaberConv2DAct<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW_C8> blocked_conv;
+    CHECK_EQ(blocked_conv.init(inputs, blocked_outputs, sum_param, ctx_host), SaberUnImplError);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
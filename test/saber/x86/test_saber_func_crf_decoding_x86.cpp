@@ -1,5 +1,6 @@
 
 #include <vector>
+#include <limits>
 #include "saber/core/context.h"
 #include "saber/funcs/crf_decoding.h"
 #include "test_saber_func_x86.h"
@@ -13,6 +14,51 @@ using namespace anakin::saber;
 typedef TargetWrapper<X86> X86_API;
 typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
 
+/// plain viterbi of every sequence, transition rows are start, end, then [from, to]
+void compute_ref_crf_decoding(Tensor4f &src_in, Tensor4f &weights, std::vector<float>& path) {
+    const float* emission = src_in.data();
+    const float* w = weights.data();
+    int tag_num = src_in.channel();
+    std::vector<int> lod = src_in.get_seq_offset();
+    path.assign(src_in.num(), 0.f);
+    for (int s = 0; s < lod.size() - 1; ++s) {
+        int seq_len = lod[s + 1] - lod[s];
+        const float* x = emission + lod[s] * tag_num;
+        std::vector<float> alpha(seq_len * tag_num);
+        std::vector<int> track(seq_len * tag_num, 0);
+        for (int i = 0; i < tag_num; ++i) {
+            alpha[i] = w[i] + x[i];
+        }
+        for (int k = 1; k < seq_len; ++k) {
+            for (int i = 0; i < tag_num; ++i) {
+                float max_score = -std::numeric_limits<float>::max();
+                for (int j = 0; j < tag_num; ++j) {
+                    float score = alpha[(k - 1) * tag_num + j] + w[(j + 2) * tag_num + i];
+                    if (score > max_score) {
+                        max_score = score;
+                        track[k * tag_num + i] = j;
+                    }
+                }
+                alpha[k * tag_num + i] = max_score + x[k * tag_num + i];
+            }
+        }
+        float max_score = -std::numeric_limits<float>::max();
+        int max_i = 0;
+        for (int i = 0; i < tag_num; ++i) {
+            float score = alpha[(seq_len - 1) * tag_num + i] + w[tag_num + i];
+            if (score > max_score) {
+                max_score = score;
+                max_i = i;
+            }
+        }
+        float* seq_path = path.data() + lod[s];
+        seq_path[seq_len - 1] = max_i;
+        for (int k = seq_len - 1; k >= 1; --k) {
+            seq_path[k - 1] = max_i = track[k * tag_num + max_i];
+        }
+    }
+}
+
 void test(Tensor4f &src_in, Tensor4f &weights, int test) {
     Tensor4f dst_saber;
 
@@ -34,6 +80,13 @@ void test(Tensor4f &src_in, Tensor4f &weights, int test) {
     timer.end(ctx_host);
     LOG(INFO) << "elapse time: " << timer.get_average_ms() << " ms";
 //    print_tensor_host(dst_saber);
+    std::vector<float> path_ref;
+    compute_ref_crf_decoding(src_in, weights, path_ref);
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst_saber.data(), path_ref.data(), path_ref.size(), max_ratio, max_diff);
+    LOG(INFO) << "tag " << src_in.channel() << ", max_diff " << max_diff;
+    CHECK_EQ(max_diff, 0) << "crf decoding path differs from reference";
 }
 
 TEST(TestSaberFuncX86, test_crf_decoding) {
@@ -59,6 +112,16 @@ TEST(TestSaberFuncX86, test_crf_decoding) {
     LOG(INFO) << "crf decoding:";
     test(src_in,  weight_host, 0);
 
+    // tags off the vector width and several sequences decoded in parallel
+    for (int tag : {5, 13, 37}) {
+        std::vector<int> seq_lod = {0, 1, 7, 20, 21, 40};
+        Tensor4f emission(Shape(seq_lod.back(), tag, 1, 1));
+        Tensor4f transition(Shape(tag + 2, tag, 1, 1));
+        fill_tensor_host_rand(emission, -1.f, 1.f);
+        fill_tensor_host_rand(transition, -1.f, 1.f);
+        emission.set_seq_offset(seq_lod);
+        test(emission, transition, 0);
+    }
 }
 
 int main(int argc, const char** argv) {
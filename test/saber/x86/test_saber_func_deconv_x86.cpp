@@ -0,0 +1,128 @@
+#include <vector>
+#include "saber/core/context.h"
+#include "saber/funcs/deconv.h"
+#include "saber/funcs/deconv_act.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+struct DeconvCase {
+    int num, ic, h, w, oc, k, stride, pad, dila, group;
+};
+
+/// reference deconv scattering every input, weights are [group, ic / group, oc / group, kh, kw]
+void compute_ref_deconv(const Tensor4f& src, Tensor4f& dst, const Tensor4f& weight, const Tensor4f& bias,
+                        const DeconvCase& c, bool relu) {
+    const int ic_g = c.ic / c.group;
+    const int oc_g = c.oc / c.group;
+    const int oh = dst.height();
+    const int ow = dst.width();
+    const float* in = src.data();
+    const float* w = weight.data();
+    float* out = dst.mutable_data();
+    for (int n = 0; n < c.num; ++n) {
+        for (int oc = 0; oc < c.oc; ++oc) {
+            for (int i = 0; i < oh * ow; ++i) {
+                out[(n * c.oc + oc) * oh * ow + i] = bias.valid_size() > 0 ? bias.data()[oc] : 0.f;
+            }
+        }
+        for (int g = 0; g < c.group; ++g)
+        for (int i = 0; i < ic_g; ++i)
+        for (int o = 0; o < oc_g; ++o)
+        for (int iy = 0; iy < c.h; ++iy)
+        for (int ix = 0; ix < c.w; ++ix)
+        for (int ky = 0; ky < c.k; ++ky)
+        for (int kx = 0; kx < c.k; ++kx) {
+            const int oy = iy * c.stride - c.pad + ky * c.dila;
+            const int ox = ix * c.stride - c.pad + kx * c.dila;
+            if (oy < 0 || oy >= oh || ox < 0 || ox >= ow) {
+                continue;
+            }
+            const float x = in[((n * c.ic + g * ic_g + i) * c.h + iy) * c.w + ix];
+            const float wv = w[(((g * ic_g + i) * oc_g + o) * c.k + ky) * c.k + kx];
+            out[((n * c.oc + g * oc_g + o) * oh + oy) * ow + ox] += x * wv;
+        }
+    }
+    if (relu) {
+        for (int i = 0; i < dst.valid_size(); ++i) {
+            out[i] = out[i] > 0.f ? out[i] : 0.f;
+        }
+    }
+}
+
+void test_deconv(const DeconvCase& c, bool with_bias, bool relu) {
+    LOG(INFO) << "deconv n" << c.num << " ic" << c.ic << " h" << c.h << " w" << c.w << " oc" << c.oc
+              << " k" << c.k << " s" << c.stride << " p" << c.pad << " d" << c.dila << " g" << c.group
+              << (relu ? " relu" : "");
+    Tensor4f src_in, dst_saber, dst_ref;
+    Tensor4f weight(Shape(c.oc / c.group, c.ic, c.k, c.k));
+    Tensor4f bias;
+    src_in.re_alloc(Shape(c.num, c.ic, c.h, c.w));
+    fill_tensor_host_rand(src_in, -1.f, 1.f);
+    fill_tensor_host_rand(weight, -1.f, 1.f);
+    if (with_bias) {
+        bias.re_alloc(Shape(1, c.oc, 1, 1));
+        fill_tensor_host_rand(bias, -1.f, 1.f);
+    }
+
+    Context<X86> ctx_host;
+    std::vector<Tensor4f*> input{&src_in};
+    std::vector<Tensor4f*> output{&dst_saber};
+    ConvParam<Tensor4f> conv_param(c.group, c.pad, c.pad, c.stride, c.stride, c.dila, c.dila,
+                                   &weight, &bias);
+    if (relu) {
+        DeconvAct<X86, AK_FLOAT> op;
+        ActivationParam<Tensor4f> act_param(Active_relu);
+        ConvActiveParam<Tensor4f> param(conv_param, act_param);
+        op.compute_output_shape(input, output, param);
+        dst_saber.re_alloc(dst_saber.valid_shape());
+        SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+        op(input, output, param, ctx_host);
+    } else {
+        Deconv<X86, AK_FLOAT> op;
+        op.compute_output_shape(input, output, conv_param);
+        dst_saber.re_alloc(dst_saber.valid_shape());
+        SABER_CHECK(op.init(input, output, conv_param, SPECIFY, SABER_IMPL, ctx_host));
+        op(input, output, conv_param, ctx_host);
+    }
+
+    dst_ref.re_alloc(dst_saber.valid_shape());
+    compute_ref_deconv(src_in, dst_ref, weight, bias, c, relu);
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst_saber.data(), dst_ref.data(), dst_ref.valid_size(), max_ratio, max_diff);
+    CHECK_LE(max_diff, 1e-4) << "Test Failed";
+}
+
+TEST(TestSaberFuncX86, test_func_deconv) {
+    Env<X86>::env_init();
+    const DeconvCase cases[] = {
+        // gemm and col2im: 2x and 4x upsampling, a stride 1 deconv, dilation with groups, 1x1
+        {2, 16, 9, 13, 8, 4, 2, 1, 1, 1},
+        {1, 8, 7, 5, 3, 8, 4, 2, 1, 1},
+        {1, 6, 11, 10, 12, 3, 1, 1, 1, 1},
+        {2, 8, 6, 7, 4, 3, 2, 2, 2, 2},
+        {2, 16, 5, 9, 24, 1, 1, 0, 1, 1},
+        // direct depthwise: bilinear 2x, 4x and 8x upsampling, and a kernel the stride doesn't divide
+        {2, 21, 9, 13, 21, 4, 2, 1, 1, 21},
+        {1, 5, 8, 7, 5, 8, 4, 2, 1, 5},
+        {1, 3, 6, 5, 3, 16, 8, 4, 1, 3},
+        {1, 4, 7, 9, 4, 3, 2, 1, 1, 4},
+    };
+    for (auto& c : cases) {
+        test_deconv(c, true, false);
+        test_deconv(c, false, true);
+    }
+}
+
+int main(int argc, const char** argv) {
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include <vector>
+#include <cmath>
+#include "saber/core/context.h"
+#include "saber/funcs/priorbox.h"
+#include "saber/funcs/detection_output.h"
+#include "saber/funcs/multiclass_nms.h"
+#include "saber/funcs/impl/detection_helper.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+void check_rows(const Tensor4f& out, const std::vector<float>& ref) {
+    std::vector<float> expect = ref;
+    if (expect.empty()) {
+        expect.assign(7, -1.f);
+    }
+    CHECK_EQ(out.valid_size(), expect.size()) << "detections don't match";
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(out.data(), expect.data(), expect.size(), max_ratio, max_diff);
+    CHECK_LE(max_diff, 1e-5) << "Test Failed";
+}
+
+/// random valid boxes [num, 4] in the unit square, some of them large so that they overlap
+void fill_boxes(float* boxes, int num) {
+    for (int i = 0; i < num; ++i) {
+        float cx = (float)rand() / RAND_MAX;
+        float cy = (float)rand() / RAND_MAX;
+        float w = 0.05f + 0.4f * rand() / RAND_MAX;
+        float h = 0.05f + 0.4f * rand() / RAND_MAX;
+        boxes[4 * i] = cx - w / 2;
+        boxes[4 * i + 1] = cy - h / 2;
+        boxes[4 * i + 2] = cx + w / 2;
+        boxes[4 * i + 3] = cy + h / 2;
+    }
+}
+
+void test_priorbox(std::vector<PriorType> order, bool clip) {
+    const int fh = 5;
+    const int fw = 7;
+    const int img_h = 300;
+    const int img_w = 300;
+    Tensor4f feature(Shape(1, 8, fh, fw));
+    Tensor4f image(Shape(1, 3, img_h, img_w));
+    Tensor4f dst_saber;
+    std::vector<Tensor4f*> input{&feature, &image};
+    std::vector<Tensor4f*> output{&dst_saber};
+    std::vector<float> min_size{60.f, 111.f};
+    std::vector<float> max_size{111.f, 162.f};
+    std::vector<float> aspect{2.f, 3.f};
+    std::vector<float> variance{0.1f, 0.1f, 0.2f, 0.2f};
+    PriorBoxParam<Tensor4f> param(variance, true, clip, 0, 0, 0.f, 0.f, 0.5f, order,
+                                  min_size, max_size, aspect);
+    Context<X86> ctx_host;
+    PriorBox<X86, AK_FLOAT> op;
+    op.compute_output_shape(input, output, param);
+    dst_saber.re_alloc(dst_saber.valid_shape());
+    SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+    op(input, output, param, ctx_host);
+
+    // the boxes of every location in the given order
+    std::vector<float> ref;
+    const float step_w = (float)img_w / fw;
+    const float step_h = (float)img_h / fh;
+    auto push = [&](float cx, float cy, float bw, float bh) {
+        float box[4] = {(cx - bw / 2.f) / img_w, (cy - bh / 2.f) / img_h,
+                        (cx + bw / 2.f) / img_w, (cy + bh / 2.f) / img_h};
+        for (float v : box) {
+            ref.push_back(clip ? std::min(std::max(v, 0.f), 1.f) : v);
+        }
+    };
+    for (int h = 0; h < fh; ++h) {
+        for (int w = 0; w < fw; ++w) {
+            float cx = (w + 0.5f) * step_w;
+            float cy = (h + 0.5f) * step_h;
+            for (int s = 0; s < min_size.size(); ++s) {
+                for (auto type : order) {
+                    if (type == PRIOR_MIN) {
+                        push(cx, cy, min_size[s], min_size[s]);
+                    } else if (type == PRIOR_MAX) {
+                        float size = sqrtf(min_size[s] * max_size[s]);
+                        push(cx, cy, size, size);
+                    } else {
+                        for (float ar : param.aspect_ratio) {
+                            if (fabs(ar - 1.f) > 1e-6) {
+                                push(cx, cy, min_size[s] * sqrt(ar), min_size[s] / sqrt(ar));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    const int boxes = ref.size();
+    for (int i = 0; i < boxes; ++i) {
+        ref.push_back(variance[i % 4]);
+    }
+    CHECK_EQ(dst_saber.valid_size(), ref.size());
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst_saber.data(), ref.data(), ref.size(), max_ratio, max_diff);
+    CHECK_LE(max_diff, 1e-6) << "Test Failed";
+}
+
+/// decoding of the cuda kernels, one box
+void ref_decode(const float* loc, const float* prior, const float* var, CodeType type,
+                bool var_in_target, float* box) {
+    float v[4] = {1.f, 1.f, 1.f, 1.f};
+    if (!var_in_target) {
+        for (int k = 0; k < 4; ++k) {
+            v[k] = var[k];
+        }
+    }
+    float pw = prior[2] - prior[0];
+    float ph = prior[3] - prior[1];
+    if (type == CORNER) {
+        for (int k = 0; k < 4; ++k) {
+            box[k] = prior[k] + loc[k] * v[k];
+        }
+    } else if (type == CORNER_SIZE) {
+        box[0] = prior[0] + loc[0] * v[0] * pw;
+        box[1] = prior[1] + loc[1] * v[1] * ph;
+        box[2] = prior[2] + loc[2] * v[2] * pw;
+        box[3] = prior[3] + loc[3] * v[3] * ph;
+    } else {
+        float cx = v[0] * loc[0] * pw + (prior[0] + prior[2]) / 2.f;
+        float cy = v[1] * loc[1] * ph + (prior[1] + prior[3]) / 2.f;
+        float w = expf(v[2] * loc[2]) * pw;
+        float h = expf(v[3] * loc[3]) * ph;
+        box[0] = cx - w / 2.f;
+        box[1] = cy - h / 2.f;
+        box[2] = cx + w / 2.f;
+        box[3] = cy + h / 2.f;
+    }
+}
+
+void test_detection_output(int num, int priors, int classes, bool share_location, CodeType type,
+                           bool var_in_target, int nms_top_k, int keep_top_k, float eta) {
+    LOG(INFO) << "detection output num " << num << " priors " << priors << " classes " << classes
+              << " share " << share_location << " code " << type << " nms_top_k " << nms_top_k
+              << " keep_top_k " << keep_top_k << " eta " << eta;
+    const int loc_classes = share_location ? 1 : classes;
+    Tensor4f loc(Shape(num, priors * loc_classes * 4, 1, 1));
+    Tensor4f conf(Shape(num, priors * classes, 1, 1));
+    Tensor4f prior(Shape(1, 1, 2, priors * 4));
+    Tensor4f dst_saber;
+    fill_tensor_host_rand(loc, -0.5f, 0.5f);
+    fill_tensor_host_rand(conf, 0.f, 1.f);
+    float* prior_data = prior.mutable_data();
+    fill_boxes(prior_data, priors);
+    for (int i = 0; i < priors * 4; ++i) {
+        prior_data[priors * 4 + i] = i % 4 < 2 ? 0.1f : 0.2f;
+    }
+
+    Context<X86> ctx_host;
+    std::vector<Tensor4f*> input{&loc, &conf, &prior};
+    std::vector<Tensor4f*> output{&dst_saber};
+    DetectionOutputParam<Tensor4f> param(classes, 0, keep_top_k, nms_top_k, 0.45f, 0.3f,
+                                         share_location, var_in_target, type, eta);
+    DetectionOutput<X86, AK_FLOAT> op;
+    op.compute_output_shape(input, output, param);
+    dst_saber.re_alloc(dst_saber.valid_shape());
+    SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+    op(input, output, param, ctx_host);
+
+    // boxes as [num, loc classes, priors, 4] and scores as [num, classes, priors] for nms_detect
+    std::vector<float> bbox(num * loc_classes * priors * 4);
+    std::vector<float> scores(num * classes * priors);
+    for (int n = 0; n < num; ++n) {
+        for (int p = 0; p < priors; ++p) {
+            for (int c = 0; c < loc_classes; ++c) {
+                const float* l = loc.data() + ((n * priors + p) * loc_classes + c) * 4;
+                ref_decode(l, prior_data + p * 4, prior_data + (priors + p) * 4, type, var_in_target,
+                           bbox.data() + ((n * loc_classes + c) * priors + p) * 4);
+            }
+            for (int c = 0; c < classes; ++c) {
+                scores[(n * classes + c) * priors + p] = conf.data()[(n * priors + p) * classes + c];
+            }
+        }
+    }
+    std::vector<float> ref;
+    nms_detect(bbox.data(), scores.data(), ref, num, classes, priors, 0, keep_top_k, nms_top_k,
+               0.3f, 0.45f, eta, share_location);
+    check_rows(dst_saber, ref);
+}
+
+void test_multiclass_nms(int num, int boxes, int classes, int nms_top_k, int keep_top_k) {
+    Tensor4f bbox(Shape(num, boxes, 4, 1));
+    Tensor4f conf(Shape(num, classes, boxes, 1));
+    Tensor4f dst_saber;
+    for (int n = 0; n < num; ++n) {
+        fill_boxes(bbox.mutable_data() + n * boxes * 4, boxes);
+    }
+    fill_tensor_host_rand(conf, 0.f, 1.f);
+
+    Context<X86> ctx_host;
+    std::vector<Tensor4f*> input{&bbox, &conf};
+    std::vector<Tensor4f*> output{&dst_saber};
+    MultiClassNMSParam<Tensor4f> param(0, keep_top_k, nms_top_k, 0.5f, 0.2f);
+    MultiClassNMS<X86, AK_FLOAT> op;
+    op.compute_output_shape(input, output, param);
+    dst_saber.re_alloc(dst_saber.valid_shape());
+    SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+    op(input, output, param, ctx_host);
+
+    std::vector<float> ref;
+    nms_detect(bbox.data(), conf.data(), ref, num, classes, boxes, 0, keep_top_k, nms_top_k,
+               0.2f, 0.5f, 1.f, true);
+    check_rows(dst_saber, ref);
+}
+
+TEST(TestSaberFuncX86, test_func_priorbox) {
+    Env<X86>::env_init();
+    test_priorbox({PRIOR_MIN, PRIOR_MAX, PRIOR_COM}, true);
+    test_priorbox({PRIOR_MIN, PRIOR_COM, PRIOR_MAX}, false);
+}
+
+TEST(TestSaberFuncX86, test_func_detection_output) {
+    Env<X86>::env_init();
+    srand(1);
+    test_detection_output(2, 1000, 6, true, CENTER_SIZE, false, 400, 100, 1.f);
+    test_detection_output(1, 777, 4, true, CENTER_SIZE, true, -1, -1, 1.f);
+    test_detection_output(3, 500, 5, true, CORNER, false, 200, 50, 0.9f);
+    test_detection_output(2, 300, 3, true, CORNER_SIZE, false, -1, 20, 1.f);
+    test_detection_output(2, 257, 4, false, CENTER_SIZE, false, 100, 30, 1.f);
+}
+
+TEST(TestSaberFuncX86, test_func_multiclass_nms) {
+    Env<X86>::env_init();
+    srand(2);
+    test_multiclass_nms(2, 600, 5, 300, 80);
+    test_multiclass_nms(1, 123, 3, -1, -1);
+    test_multiclass_nms(4, 50, 21, 20, 10);
+}
+
+int main(int argc, const char** argv) {
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -1,5 +1,7 @@
 #include <time.h>
 #include <stdio.h>
+#include <cmath>
+#include <algorithm>
 
 #include "saber/core/context.h"
 #include "saber/funcs/eltwise_act.h"
@@ -124,6 +126,51 @@ TEST(TestSaberEltwiseActX86, test_tensor_eltwise_act) {
     }
 }
 
+/// (a * gate) + bias then activation in one pass, gate and bias broadcast along spatial dims
+void eltwise_chain_act_ut(int n, int c, int h, int w, ActiveType act_type) {
+    Context<X86> ctx_host;
+    Tensor4f a(Shape(n, c, h, w));
+    Tensor4f gate(Shape(n, c, 1, 1));
+    Tensor4f bias(Shape(1, c, 1, 1));
+    fill_tensor_host_rand(a, -2.f, 2.f);
+    fill_tensor_host_rand(gate, -1.f, 1.f);
+    fill_tensor_host_rand(bias, -1.f, 1.f);
+    std::vector<Tensor4f*> inputs{&a, &gate, &bias};
+
+    EltwiseParam<Tensor4f> elt_param(Eltwise_prod, {1.f, 1.f, 1.f});
+    elt_param.chain_ops = {Eltwise_prod, Eltwise_sum};
+    ActivationParam<Tensor4f> act_param(act_type);
+    EltwiseActiveParam<Tensor4f> param(elt_param, act_param);
+
+    Tensor4f dst;
+    std::vector<Tensor4f*> outputs(1, &dst);
+    EltwiseActive<X86, AK_FLOAT> op_eltwise_act;
+    SABER_CHECK(op_eltwise_act.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(op_eltwise_act.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(op_eltwise_act(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    float* ref = dst_ref.mutable_data();
+    for (int i = 0; i < n * c; ++i) {
+        for (int j = 0; j < h * w; ++j) {
+            float val = a.data()[i * h * w + j] * gate.data()[i] + bias.data()[i % c];
+            ref[i * h * w + j] = act_type == Active_relu ? std::max(val, 0.f) : 1.f / (1.f + expf(-val));
+        }
+    }
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "chain act " << act_type << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-5) << "eltwise chain act check failed";
+}
+
+TEST(TestSaberEltwiseActX86, test_eltwise_chain_act) {
+    Env<X86>::env_init();
+    eltwise_chain_act_ut(2, 64, 28, 28, Active_relu);
+    eltwise_chain_act_ut(1, 96, 13, 11, Active_sigmoid);
+}
+
 int main(int argc, const char** argv) {
     // initialize logger
     logger::init(argv[0]);
@@ -1,5 +1,6 @@
 #include <time.h>
 #include <stdio.h>
+#include <algorithm>
 
 #include "saber/core/context.h"
 #include "saber/funcs/eltwise.h"
@@ -54,6 +55,15 @@ bool eltwise_test(eltwise_test_params &p) {
             }
             dst_ref.mutable_data()[i] = ref_sum;
         }
+    } else {
+        for (int i = 0; i < dst_ref.size(); i++) {
+            ref_sum = src_in[0].mutable_data()[i];
+            for (size_t j = 1; j < src_in.size(); j++) {
+                float val = src_in[j].mutable_data()[i];
+                ref_sum = p.elt_type == Eltwise_prod ? ref_sum * val : std::max(ref_sum, val);
+            }
+            dst_ref.mutable_data()[i] = ref_sum;
+        }
     }
 
     // saber dst
@@ -88,6 +98,7 @@ TEST(TestSaberEltwiseX86, test_tensor_eltwise) {
         eltwise_test_params{2, 512, 28, 28, {1.0f, 1.0f}, Eltwise_sum},
         eltwise_test_params{4, 1024, 14, 14, {1.0f, 1.0f}, Eltwise_sum},
         eltwise_test_params{4, 1024, 14, 14, {1.0f, 1.0f}, Eltwise_max},
+        eltwise_test_params{4, 1024, 14, 14, {1.0f, 1.0f, 1.0f}, Eltwise_prod},
         eltwise_test_params{8, 2048, 7, 7, {1.0f, 1.0f}, Eltwise_sum}
     };
 
@@ -103,6 +114,97 @@ TEST(TestSaberEltwiseX86, test_tensor_eltwise) {
     }
 }
 
+/// reference of broadcast inputs and an op chain, coeff scales the inputs of sums
+void compute_ref_eltwise_chain(std::vector<Tensor4f>& src, Tensor4f& dst,
+                               const std::vector<EltwiseType>& ops,
+                               const std::vector<float>& coeff) {
+    Shape out_shape = dst.valid_shape();
+    float* dst_data = dst.mutable_data();
+    for (int n = 0; n < out_shape[0]; ++n) {
+        for (int c = 0; c < out_shape[1]; ++c) {
+            for (int h = 0; h < out_shape[2]; ++h) {
+                for (int w = 0; w < out_shape[3]; ++w) {
+                    float acc = 0.f;
+                    for (int k = 0; k < src.size(); ++k) {
+                        Shape sh = src[k].valid_shape();
+                        int idx = (((sh[0] == 1 ? 0 : n) * sh[1] + (sh[1] == 1 ? 0 : c)) * sh[2]
+                                   + (sh[2] == 1 ? 0 : h)) * sh[3] + (sh[3] == 1 ? 0 : w);
+                        float val = src[k].data()[idx];
+                        EltwiseType op = k == 0 ? Eltwise_sum : ops[k - 1];
+                        if (k == 0) {
+                            acc = (ops[0] == Eltwise_sum ? coeff[0] : 1.f) * val;
+                        } else if (op == Eltwise_sum) {
+                            acc += coeff[k] * val;
+                        } else if (op == Eltwise_prod) {
+                            acc *= val;
+                        } else {
+                            acc = std::max(acc, val);
+                        }
+                    }
+                    *dst_data++ = acc;
+                }
+            }
+        }
+    }
+}
+
+void eltwise_chain_ut(std::vector<Shape> shapes, std::vector<EltwiseType> ops,
+                      std::vector<float> coeff, bool as_chain) {
+    Context<X86> ctx_host;
+    std::vector<Tensor4f> src(shapes.size());
+    std::vector<Tensor4f*> inputs;
+    for (int i = 0; i < shapes.size(); ++i) {
+        src[i].re_alloc(shapes[i]);
+        fill_tensor_host_rand(src[i], -1.f, 1.f);
+        inputs.push_back(&src[i]);
+    }
+    EltwiseParam<Tensor4f> param(ops[0], coeff);
+    if (as_chain) {
+        param.chain_ops = ops;
+    }
+    Tensor4f dst;
+    std::vector<Tensor4f*> outputs(1, &dst);
+    Eltwise<X86, AK_FLOAT> op_eltwise;
+    SABER_CHECK(op_eltwise.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(op_eltwise.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(op_eltwise(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_eltwise_chain(src, dst_ref, ops, coeff);
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "output " << dst.num() << "x" << dst.channel() << "x" << dst.height() << "x"
+              << dst.width() << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-5) << "eltwise check failed";
+}
+
+TEST(TestSaberEltwiseX86, test_eltwise_broadcast) {
+    Env<X86>::env_init();
+    // bias like add
+    eltwise_chain_ut({Shape(2, 64, 17, 19), Shape(1, 64, 1, 1)},
+                     {Eltwise_sum}, {1.f, 0.5f}, false);
+    // gate like multiply
+    eltwise_chain_ut({Shape(4, 32, 28, 28), Shape(4, 32, 1, 1)},
+                     {Eltwise_prod}, {1.f, 1.f}, false);
+    // both sides broadcast
+    eltwise_chain_ut({Shape(1, 16, 9, 1), Shape(3, 1, 1, 33)},
+                     {Eltwise_max}, {1.f, 1.f}, false);
+    eltwise_chain_ut({Shape(2, 8, 5, 7), Shape(1, 1, 5, 7), Shape(2, 8, 1, 1)},
+                     {Eltwise_sum, Eltwise_sum}, {2.f, -1.f, 3.f}, false);
+}
+
+TEST(TestSaberEltwiseX86, test_eltwise_chain) {
+    Env<X86>::env_init();
+    // (a * b) + c
+    eltwise_chain_ut({Shape(2, 64, 28, 28), Shape(2, 64, 28, 28), Shape(2, 64, 28, 28)},
+                     {Eltwise_prod, Eltwise_sum}, {1.f, 1.f, 1.f}, true);
+    // (a * gate) + bias, then max with d
+    eltwise_chain_ut({Shape(1, 128, 14, 14), Shape(1, 128, 1, 1), Shape(1, 128, 1, 1), Shape(1, 128, 14, 14)},
+                     {Eltwise_prod, Eltwise_sum, Eltwise_max}, {1.f, 1.f, 0.5f, 1.f}, true);
+}
+
 int main(int argc, const char** argv) {
     logger::init(argv[0]);
     InitTest();
@@ -0,0 +1,106 @@
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include "saber/core/context.h"
+#include "saber/funcs/fc_softmax_argmax.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: full fc, full softmax, then sort every row
+void compute_ref_fc_softmax_argmax(Tensor4f& src, Tensor4f& dst,
+                                   FcSoftmaxArgmaxParam<Tensor4f>& param) {
+    int m = src.num();
+    int k = src.valid_size() / m;
+    int n = param.fc_param.num_output;
+    int top_k = param.argmax_param.top_k;
+    const float* src_data = src.data();
+    const float* weights = param.fc_param.weights->data();
+    const float* bias = param.fc_param.bias ? param.fc_param.bias->data() : nullptr;
+    float* dst_data = dst.mutable_data();
+    std::vector<float> prob(n);
+    std::vector<int> order(n);
+    for (int i = 0; i < m; ++i) {
+        float max_val = -FLT_MAX;
+        for (int j = 0; j < n; ++j) {
+            float sum = bias ? bias[j] : 0.f;
+            for (int c = 0; c < k; ++c) {
+                sum += src_data[i * k + c] * weights[j * k + c];
+            }
+            prob[j] = sum;
+            max_val = std::max(max_val, sum);
+        }
+        float sum = 0.f;
+        for (int j = 0; j < n; ++j) {
+            prob[j] = expf(prob[j] - max_val);
+            sum += prob[j];
+        }
+        for (int j = 0; j < n; ++j) {
+            prob[j] /= sum;
+            order[j] = j;
+        }
+        std::partial_sort(order.begin(), order.begin() + top_k, order.end(),
+                          [&prob](int a, int b) { return prob[a] > prob[b]; });
+        for (int j = 0; j < top_k; ++j) {
+            dst_data[i * 2 * top_k + j] = order[j];
+            dst_data[i * 2 * top_k + top_k + j] = prob[order[j]];
+        }
+    }
+}
+
+void fc_softmax_argmax_ut(int num, int in_channel, int vocab, int top_k, bool with_bias) {
+    Context<X86> ctx_host;
+    Tensor4f src(Shape(num, in_channel, 1, 1));
+    Tensor4f weights(Shape(vocab, in_channel, 1, 1));
+    Tensor4f bias(Shape(1, 1, 1, vocab));
+    fill_tensor_host_rand(src, -1.f, 1.f);
+    fill_tensor_host_rand(weights, -1.f, 1.f);
+    fill_tensor_host_rand(bias, -1.f, 1.f);
+
+    FcParam<Tensor4f> fc_param(&weights, with_bias ? &bias : nullptr, vocab);
+    SoftmaxParam<Tensor4f> softmax_param(1);
+    ArgmaxParam<Tensor4f> argmax_param(true, top_k);
+    FcSoftmaxArgmaxParam<Tensor4f> param(fc_param, softmax_param, argmax_param);
+
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    FcSoftmaxArgmax<X86, AK_FLOAT> fc_softmax_argmax;
+    SABER_CHECK(fc_softmax_argmax.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(fc_softmax_argmax.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(fc_softmax_argmax(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_fc_softmax_argmax(src, dst_ref, param);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "num " << num << ", vocab " << vocab << ", top " << top_k
+              << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-4) << "fc softmax argmax check failed";
+}
+
+TEST(TestSaberFuncX86, test_fc_softmax_argmax) {
+    Env<X86>::env_init();
+
+    fc_softmax_argmax_ut(1, 64, 1000, 5, true);
+    fc_softmax_argmax_ut(4, 128, 50000, 10, true);
+    fc_softmax_argmax_ut(3, 32, 777, 1, false);
+    fc_softmax_argmax_ut(16, 256, 30000, 20, false);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <vector>
+#include <cmath>
+#include "saber/core/context.h"
+#include "saber/funcs/layer_norm.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: two pass mean and variance of every row in double
+void compute_ref_layer_norm(Tensor4f& src, Tensor4f& dst, int axis, float eps,
+                            const float* scale, const float* bias) {
+    int inner = src.count_valid(axis, src.dims());
+    int outer = src.valid_size() / inner;
+    const float* src_data = src.data();
+    float* dst_data = dst.mutable_data();
+    for (int i = 0; i < outer; ++i) {
+        const float* row = src_data + i * inner;
+        double mean = 0.;
+        for (int j = 0; j < inner; ++j) {
+            mean += row[j];
+        }
+        mean /= inner;
+        double var = 0.;
+        for (int j = 0; j < inner; ++j) {
+            var += (row[j] - mean) * (row[j] - mean);
+        }
+        var /= inner;
+        double inv_std = 1. / (std::sqrt(var) + eps);
+        for (int j = 0; j < inner; ++j) {
+            double v = (row[j] - mean) * inv_std;
+            v = v * (scale ? scale[j] : 1.f) + (bias ? bias[j] : 0.f);
+            dst_data[i * inner + j] = v;
+        }
+    }
+}
+
+void layer_norm_ut(Shape shape, int axis, float offset, bool with_affine) {
+    Context<X86> ctx_host;
+    Tensor4f src(shape);
+    // an offset far from zero checks the statistics don't cancel
+    fill_tensor_host_rand(src, offset - 1.f, offset + 1.f);
+    int inner = src.count_valid(axis, src.dims());
+    Tensor4f scale(Shape(1, 1, 1, inner));
+    Tensor4f bias(Shape(1, 1, 1, inner));
+    fill_tensor_host_rand(scale, 0.5f, 1.5f);
+    fill_tensor_host_rand(bias, -1.f, 1.f);
+    float eps = 1e-5f;
+
+    LayerNormParam<Tensor4f> param(axis, eps, with_affine ? &scale : nullptr,
+                                   with_affine ? &bias : nullptr);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    LayerNorm<X86, AK_FLOAT> layer_norm;
+    SABER_CHECK(layer_norm.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(layer_norm.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(layer_norm(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_layer_norm(src, dst_ref, axis, eps, with_affine ? scale.data() : nullptr,
+                           with_affine ? bias.data() : nullptr);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "inner " << inner << ", offset " << offset << ", max_ratio " << max_ratio
+              << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-3) << "layer norm check failed";
+}
+
+TEST(TestSaberFuncX86, test_layer_norm) {
+    Env<X86>::env_init();
+
+    layer_norm_ut(Shape(128, 768, 1, 1), 1, 0.f, true);
+    layer_norm_ut(Shape(7, 3, 5, 11), 1, 100.f, true);
+    layer_norm_ut(Shape(2, 4, 6, 13), 2, 0.f, false);
+    layer_norm_ut(Shape(33, 1, 1, 1), 1, 0.f, true);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "saber/core/context.h"
+#include "saber/funcs/lrn.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: the window sum of squares of every pixel on its own, in double
+void compute_ref_lrn(Tensor4f& src, Tensor4f& dst, int size, float alpha, float beta, float k) {
+    int num = src.num();
+    int channel = src.channel();
+    int spatial = src.height() * src.width();
+    int pre_pad = (size - 1) / 2;
+    const float* src_data = src.data();
+    float* dst_data = dst.mutable_data();
+    for (int n = 0; n < num; ++n) {
+        for (int c = 0; c < channel; ++c) {
+            for (int i = 0; i < spatial; ++i) {
+                double sum = 0.;
+                for (int j = std::max(c - pre_pad, 0); j <= std::min(c - pre_pad + size - 1, channel - 1); ++j) {
+                    double v = src_data[(n * channel + j) * spatial + i];
+                    sum += v * v;
+                }
+                int index = (n * channel + c) * spatial + i;
+                dst_data[index] = src_data[index] * std::pow(k + alpha * sum, -beta);
+            }
+        }
+    }
+}
+
+void lrn_ut(Shape shape, int size, float alpha, float beta, float k) {
+    Context<X86> ctx_host;
+    Tensor4f src(shape);
+    fill_tensor_host_rand(src, -2.f, 2.f);
+
+    LrnParam<Tensor4f> param(size, alpha, beta, k, ACROSS_CHANNELS);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    Lrn<X86, AK_FLOAT> lrn;
+    SABER_CHECK(lrn.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(lrn.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(lrn(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_lrn(src, dst_ref, size, alpha, beta, k);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "size " << size << ", beta " << beta << ", max_ratio " << max_ratio
+              << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-4) << "lrn check failed";
+}
+
+TEST(TestSaberFuncX86, test_lrn) {
+    Env<X86>::env_init();
+
+    // alexnet and googlenet settings, then the other exponents of the vector paths
+    lrn_ut(Shape(2, 96, 27, 27), 5, 1e-4f, 0.75f, 1.f);
+    lrn_ut(Shape(1, 64, 13, 11), 5, 1e-2f, 0.75f, 2.f);
+    lrn_ut(Shape(1, 7, 5, 3), 3, 0.1f, 0.5f, 1.f);
+    lrn_ut(Shape(3, 9, 4, 5), 4, 0.1f, 1.f, 1.f);
+    lrn_ut(Shape(1, 16, 6, 7), 5, 0.1f, 0.6f, 1.f);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
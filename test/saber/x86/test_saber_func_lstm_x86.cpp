@@ -303,6 +303,104 @@ void lstm_ut(int word_size = 222,
 
 }
 
+/**
+ * run every sequence in one call, then again in two chunks where the second chunk starts
+ * from the state exported by the first one, the tail of both outputs must be the same
+ */
+void lstm_stream_ut(int word_size, int hidden_size, std::vector<int> lengths, int split, bool with_peephole) {
+    typedef Tensor<X86, AK_FLOAT, NCHW> TensorHf4;
+    Context<X86> ctx_host;
+    int batch_size = lengths.size();
+    std::vector<int> offsets(1, 0);
+    std::vector<int> first_offsets(1, 0);
+    std::vector<int> second_offsets(1, 0);
+    for (int i = 0; i < batch_size; ++i) {
+        CHECK_GT(lengths[i], split) << "every sequence should be longer than the split point";
+        offsets.push_back(offsets[i] + lengths[i]);
+        first_offsets.push_back(first_offsets[i] + split);
+        second_offsets.push_back(second_offsets[i] + lengths[i] - split);
+    }
+
+    Shape shape_weight({1, 1, 1, hidden_size * hidden_size * 4 + hidden_size * word_size * 4});
+    Shape shape_bias({1, 1, 1, hidden_size * (with_peephole ? 7 : 4)});
+    TensorHf4 weight(shape_weight);
+    TensorHf4 bias(shape_bias);
+    TensorHf4 x(Shape({offsets[batch_size], word_size, 1, 1}));
+    TensorHf4 x_first(Shape({first_offsets[batch_size], word_size, 1, 1}));
+    TensorHf4 x_second(Shape({second_offsets[batch_size], word_size, 1, 1}));
+    fill_tensor_host_rand(weight);
+    fill_tensor_host_rand(bias);
+    fill_tensor_host_rand(x);
+    for (int i = 0; i < batch_size; ++i) {
+        memcpy(x_first.mutable_data() + first_offsets[i] * word_size, x.data() + offsets[i] * word_size,
+               split * word_size * sizeof(float));
+        memcpy(x_second.mutable_data() + second_offsets[i] * word_size,
+               x.data() + (offsets[i] + split) * word_size,
+               (lengths[i] - split) * word_size * sizeof(float));
+    }
+    x.set_seq_offset(offsets);
+    x_first.set_seq_offset(first_offsets);
+    x_second.set_seq_offset(second_offsets);
+
+    TensorHf4 out, out_first, out_second;
+    TensorHf4 last_hidden, last_cell, init_hidden, init_cell;
+    LstmParam<TensorHf4> param(&weight, &bias, nullptr, Active_unknow, Active_sigmoid, Active_tanh, Active_tanh,
+                               with_peephole, false, false);
+    Lstm<X86, AK_FLOAT> lstm_op;
+    std::vector<TensorHf4*> inputs(1, &x);
+    std::vector<TensorHf4*> outputs(1, &out);
+    SABER_CHECK(lstm_op.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(lstm_op.compute_output_shape(inputs, outputs, param));
+    out.re_alloc(out.valid_shape());
+    SABER_CHECK(lstm_op(inputs, outputs, param, ctx_host));
+
+    inputs[0] = &x_first;
+    outputs[0] = &out_first;
+    param.set_state(nullptr, nullptr, &last_hidden, &last_cell);
+    SABER_CHECK(lstm_op.compute_output_shape(inputs, outputs, param));
+    out_first.re_alloc(out_first.valid_shape());
+    SABER_CHECK(lstm_op(inputs, outputs, param, ctx_host));
+
+    init_hidden.re_alloc(last_hidden.valid_shape());
+    init_hidden.copy_from(last_hidden);
+    init_cell.re_alloc(last_cell.valid_shape());
+    init_cell.copy_from(last_cell);
+    inputs[0] = &x_second;
+    outputs[0] = &out_second;
+    param.set_state(&init_hidden, &init_cell, &last_hidden, &last_cell);
+    SABER_CHECK(lstm_op.compute_output_shape(inputs, outputs, param));
+    out_second.re_alloc(out_second.valid_shape());
+    SABER_CHECK(lstm_op(inputs, outputs, param, ctx_host));
+
+    double maxdiff = 0;
+    double maxratio = 0;
+    for (int i = 0; i < batch_size; ++i) {
+        tensor_cmp_host(out_second.data() + second_offsets[i] * hidden_size,
+                        out.data() + (offsets[i] + split) * hidden_size,
+                        (lengths[i] - split) * hidden_size, maxratio, maxdiff);
+        CHECK(abs(maxratio) <= 0.001 || abs(maxdiff) < 0.001) << "stream failed : ratio " << maxratio << "," << maxdiff;
+        tensor_cmp_host(last_hidden.data() + i * hidden_size,
+                        out.data() + (offsets[i + 1] - 1) * hidden_size,
+                        hidden_size, maxratio, maxdiff);
+        CHECK(abs(maxratio) <= 0.001 || abs(maxdiff) < 0.001) << "last hidden failed : ratio " << maxratio << "," << maxdiff;
+    }
+    LOG(INFO) << "stream passed";
+}
+
+TEST(TestSaberFuncX86, test_tensor_lstm_stream) {
+    Env<X86>::env_init();
+
+    lstm_stream_ut(222, 333, {10}, 4, true);
+    lstm_stream_ut(222, 333, {10}, 4, false);
+    lstm_stream_ut(222, 333, {3, 9, 5, 12}, 2, true);
+    lstm_stream_ut(222, 333, {3, 9, 5, 12}, 1, false);
+    // batch 1 wide enough to split the recurrence over 4 threads
+    {
+        ScopedX86Threads threads(4);
+        lstm_stream_ut(128, 512, {12}, 5, true);
+    }
+}
+
 TEST(TestSaberFuncX86, test_tensor_lstm) {
     Env<X86>::env_init();
 
@@ -314,6 +412,12 @@ TEST(TestSaberFuncX86, test_tensor_lstm) {
     lstm_ut<X86,X86>(222,333,{0,10},false, false,Active_sigmoid,Active_tanh,Active_tanh,0,SABER_IMPL);
     lstm_ut<X86,X86>(222,333,{0,10},true, true,Active_sigmoid,Active_tanh,Active_tanh,0,SABER_IMPL);
     lstm_ut<X86,X86>(222,333,{0,10},true, false,Active_sigmoid,Active_tanh,Active_tanh,0,SABER_IMPL);
+    {
+        // batch 1 wide enough to split the recurrence over 4 threads
+        ScopedX86Threads threads(4);
+        lstm_ut<X86,X86>(128,512,{0,20},false, true,Active_sigmoid,Active_tanh,Active_tanh,0,SABER_IMPL);
+        lstm_ut<X86,X86>(128,1030,{0,20},true, false,Active_sigmoid,Active_tanh,Active_tanh,0,SABER_IMPL);
+    }
 
     lstm_ut<X86,X86>(222,333,{0,1,3,5,10},false, false,Active_sigmoid,Active_tanh,Active_tanh,100,VENDER_IMPL);
     lstm_ut<X86,X86>(222,333,{0,1,3,5,10},false, true,Active_sigmoid,Active_tanh,Active_tanh,100,VENDER_IMPL);
@@ -0,0 +1,90 @@
+#include <vector>
+#include "saber/core/context.h"
+#include "saber/funcs/mat_mul.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: one naive gemm for every num * channel matrix, y is broadcast when it has one
+void compute_ref_mat_mul(Tensor4f& x, Tensor4f& y, Tensor4f& dst, MatMulParam<Tensor4f>& param) {
+    int batch = x.num() * x.channel();
+    int m = param._is_transpose_X ? x.width() : x.height();
+    int k = param._is_transpose_X ? x.height() : x.width();
+    int n = param._is_transpose_Y ? y.height() : y.width();
+    bool batched_y = y.num() * y.channel() != 1;
+    const float* x_data = x.data();
+    const float* y_data = y.data();
+    float* dst_data = dst.mutable_data();
+    for (int b = 0; b < batch; ++b) {
+        const float* xb = x_data + b * m * k;
+        const float* yb = y_data + (batched_y ? b * k * n : 0);
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < n; ++j) {
+                float sum = 0.f;
+                for (int c = 0; c < k; ++c) {
+                    float xv = param._is_transpose_X ? xb[c * m + i] : xb[i * k + c];
+                    float yv = param._is_transpose_Y ? yb[j * k + c] : yb[c * n + j];
+                    sum += xv * yv;
+                }
+                dst_data[b * m * n + i * n + j] = sum;
+            }
+        }
+    }
+}
+
+void mat_mul_ut(int num, int channel, int m, int k, int n, bool trans_x, bool trans_y, bool broadcast_y) {
+    Context<X86> ctx_host;
+    Tensor4f x(trans_x ? Shape(num, channel, k, m) : Shape(num, channel, m, k));
+    Shape y_shape = trans_y ? Shape(num, channel, n, k) : Shape(num, channel, k, n);
+    if (broadcast_y) {
+        y_shape[0] = 1;
+        y_shape[1] = 1;
+    }
+    Tensor4f y(y_shape);
+    fill_tensor_host_rand(x, -1.f, 1.f);
+    fill_tensor_host_rand(y, -1.f, 1.f);
+
+    MatMulParam<Tensor4f> param(trans_x, trans_y);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs{&x, &y};
+    std::vector<Tensor4f*> outputs(1, &dst);
+    MatMul<X86, AK_FLOAT> mat_mul;
+    SABER_CHECK(mat_mul.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(mat_mul.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(mat_mul(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_mat_mul(x, y, dst_ref, param);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "batch " << num << "x" << channel << ", m " << m << ", k " << k << ", n " << n
+              << ", trans " << trans_x << trans_y << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-4) << "mat mul check failed";
+}
+
+TEST(TestSaberFuncX86, test_mat_mul) {
+    Env<X86>::env_init();
+
+    // scores and context of attention heads, and a shared projection
+    mat_mul_ut(2, 12, 32, 64, 32, false, true, false);
+    mat_mul_ut(2, 12, 32, 32, 64, false, false, false);
+    mat_mul_ut(1, 3, 17, 5, 9, true, false, false);
+    mat_mul_ut(4, 2, 7, 33, 15, true, true, true);
+    mat_mul_ut(1, 1, 64, 128, 96, false, false, false);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
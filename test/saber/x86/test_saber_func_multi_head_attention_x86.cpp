@@ -0,0 +1,163 @@
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include "saber/core/context.h"
+#include "saber/funcs/multi_head_attention.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: naive q k v projection, then every head of every sequence on its own
+void compute_ref_multi_head_attention(Tensor4f& src, Tensor4f& dst,
+                                      MultiHeadAttentionParam<Tensor4f>& param) {
+    int words = src.num();
+    int dim = src.valid_size() / words;
+    FcParam<Tensor4f>& fc_param = param.fc_param;
+    std::vector<float> qkv(src.data(), src.data() + src.valid_size());
+    int qkv_dim = dim;
+    if (fc_param.weights) {
+        qkv_dim = fc_param.num_output;
+        const float* weights = fc_param.weights->data();
+        const float* bias = fc_param.bias ? fc_param.bias->data() : nullptr;
+        qkv.assign(words * qkv_dim, 0.f);
+        for (int i = 0; i < words; ++i) {
+            for (int j = 0; j < qkv_dim; ++j) {
+                float sum = bias ? bias[j] : 0.f;
+                for (int c = 0; c < dim; ++c) {
+                    sum += src.data()[i * dim + c] * weights[j * dim + c];
+                }
+                qkv[i * qkv_dim + j] = sum;
+            }
+        }
+    }
+    int hidden = qkv_dim / 3;
+    int head_dim = hidden / param.head_num;
+    float scale = param.scale > 0.f ? param.scale : 1.f / sqrtf(head_dim);
+    std::vector<int> offset = src.get_seq_offset();
+    if (offset.empty()) {
+        offset = {0, words};
+    }
+    float* dst_data = dst.mutable_data();
+    for (int s = 0; s + 1 < offset.size(); ++s) {
+        int start = offset[s];
+        int len = offset[s + 1] - start;
+        std::vector<float> prob(len);
+        for (int h = 0; h < param.head_num; ++h) {
+            for (int i = 0; i < len; ++i) {
+                const float* q = &qkv[(start + i) * qkv_dim + h * head_dim];
+                float max_val = -FLT_MAX;
+                for (int j = 0; j < len; ++j) {
+                    const float* k = &qkv[(start + j) * qkv_dim + hidden + h * head_dim];
+                    float dot = 0.f;
+                    for (int c = 0; c < head_dim; ++c) {
+                        dot += q[c] * k[c];
+                    }
+                    prob[j] = dot * scale;
+                    max_val = std::max(max_val, prob[j]);
+                }
+                float sum = 0.f;
+                for (int j = 0; j < len; ++j) {
+                    prob[j] = expf(prob[j] - max_val);
+                    sum += prob[j];
+                }
+                for (int c = 0; c < head_dim; ++c) {
+                    float out = 0.f;
+                    for (int j = 0; j < len; ++j) {
+                        out += prob[j] / sum * qkv[(start + j) * qkv_dim + 2 * hidden + h * head_dim + c];
+                    }
+                    dst_data[(start + i) * hidden + h * head_dim + c] = out;
+                }
+            }
+        }
+    }
+}
+
+void check_multi_head_attention(Tensor4f& src, MultiHeadAttentionParam<Tensor4f>& param) {
+    Context<X86> ctx_host;
+    int words = src.num();
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    MultiHeadAttention<X86, AK_FLOAT> attention;
+    SABER_CHECK(attention.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(attention.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(attention(inputs, outputs, param, ctx_host));
+    CHECK(dst.get_seq_offset() == src.get_seq_offset()) << "seq offset is not passed on";
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_multi_head_attention(src, dst_ref, param);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "words " << words << ", hidden " << dst.valid_size() / words
+              << ", heads " << param.head_num << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-4) << "multi head attention check failed";
+}
+
+void multi_head_attention_ut(std::vector<int> seq_offset, int dim, int hidden, int head_num,
+                             bool with_weights) {
+    int words = seq_offset.back();
+    Tensor4f src(Shape(words, with_weights ? dim : 3 * hidden, 1, 1));
+    src.set_seq_offset(seq_offset);
+    Tensor4f weights(Shape(3 * hidden, dim, 1, 1));
+    Tensor4f bias(Shape(1, 1, 1, 3 * hidden));
+    fill_tensor_host_rand(src, -1.f, 1.f);
+    fill_tensor_host_rand(weights, -0.3f, 0.3f);
+    fill_tensor_host_rand(bias, -0.3f, 0.3f);
+
+    MultiHeadAttentionParam<Tensor4f> param(head_num);
+    if (with_weights) {
+        FcParam<Tensor4f> fc_param(&weights, &bias, 3 * hidden);
+        param = MultiHeadAttentionParam<Tensor4f>(fc_param, head_num);
+    }
+
+    check_multi_head_attention(src, param);
+}
+
+/// one sequence of len words, every query scores the key of the dominant word far above the others
+void multi_head_attention_dominant_ut(int len, int dominant) {
+    const int hidden = 16;
+    Tensor4f src(Shape(len, 3 * hidden, 1, 1));
+    src.set_seq_offset({0, len});
+    fill_tensor_host_rand(src, -1.f, 1.f);
+    for (int i = 0; i < len; ++i) {
+        float* word = src.mutable_data() + i * 3 * hidden;
+        for (int c = 0; c < hidden; ++c) {
+            word[c] = 1.f;
+            word[hidden + c] = i == dominant ? 1.f : -100.f;
+        }
+    }
+    MultiHeadAttentionParam<Tensor4f> param(1);
+    check_multi_head_attention(src, param);
+}
+
+TEST(TestSaberFuncX86, test_multi_head_attention) {
+    Env<X86>::env_init();
+
+    // sequences of different lengths share no scores
+    multi_head_attention_ut({0, 5, 17, 18, 40}, 64, 64, 4, true);
+    multi_head_attention_ut({0, 32, 64}, 128, 96, 12, true);
+    multi_head_attention_ut({0, 9}, 0, 48, 3, false);
+    multi_head_attention_ut({0, 3, 3, 10}, 0, 16, 1, false);
+
+    // the row max of the scores in the first lane of a later vector
+    for (int dominant : {0, 8, 16, 31}) {
+        multi_head_attention_dominant_ut(32, dominant);
+    }
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
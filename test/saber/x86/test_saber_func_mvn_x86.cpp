@@ -0,0 +1,84 @@
+#include <vector>
+#include <cmath>
+#include "saber/core/context.h"
+#include "saber/funcs/mvn.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: two pass mean and variance of every image or every channel in double
+void compute_ref_mvn(Tensor4f& src, Tensor4f& dst, bool normalize_variance, bool across_channels,
+                     float eps) {
+    int rows = across_channels ? src.num() : src.num() * src.channel();
+    int inner = src.valid_size() / rows;
+    const float* src_data = src.data();
+    float* dst_data = dst.mutable_data();
+    for (int i = 0; i < rows; ++i) {
+        const float* row = src_data + i * inner;
+        double mean = 0.;
+        for (int j = 0; j < inner; ++j) {
+            mean += row[j];
+        }
+        mean /= inner;
+        double var = 0.;
+        for (int j = 0; j < inner; ++j) {
+            var += (row[j] - mean) * (row[j] - mean);
+        }
+        var /= inner;
+        double inv_std = normalize_variance ? 1. / (std::sqrt(var) + eps) : 1.;
+        for (int j = 0; j < inner; ++j) {
+            dst_data[i * inner + j] = (row[j] - mean) * inv_std;
+        }
+    }
+}
+
+void mvn_ut(Shape shape, bool normalize_variance, bool across_channels, float offset) {
+    Context<X86> ctx_host;
+    Tensor4f src(shape);
+    fill_tensor_host_rand(src, offset - 1.f, offset + 1.f);
+    float eps = 1e-9f;
+
+    MvnParam<Tensor4f> param(normalize_variance, across_channels, eps);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    Mvn<X86, AK_FLOAT> mvn;
+    SABER_CHECK(mvn.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(mvn.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(mvn(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_mvn(src, dst_ref, normalize_variance, across_channels, eps);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "normalize_variance " << normalize_variance << ", across_channels " << across_channels
+              << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-3) << "mvn check failed";
+}
+
+TEST(TestSaberFuncX86, test_mvn) {
+    Env<X86>::env_init();
+
+    for (bool normalize_variance : {true, false}) {
+        for (bool across_channels : {true, false}) {
+            mvn_ut(Shape(2, 16, 14, 14), normalize_variance, across_channels, 0.f);
+            mvn_ut(Shape(3, 5, 7, 3), normalize_variance, across_channels, 50.f);
+        }
+    }
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
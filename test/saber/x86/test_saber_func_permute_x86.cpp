@@ -0,0 +1,203 @@
+#include <vector>
+#include <cmath>
+#include "saber/core/context.h"
+#include "saber/funcs/permute.h"
+#include "saber/funcs/permute_power.h"
+#include "saber/funcs/transpose.h"
+#include "saber/funcs/shuffle_channel.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference permute of a 4d tensor, dst dim i is src dim order[i], then pow(x * scale + shift, power)
+void compute_ref_permute(const Tensor4f& src, Tensor4f& dst, std::vector<int> order,
+                         float scale = 1.f, float shift = 0.f, float power = 1.f) {
+    Shape in_shape = src.valid_shape();
+    Shape out_shape = in_shape;
+    for (int i = 0; i < 4; ++i) {
+        out_shape[i] = in_shape[order[i]];
+    }
+    dst.re_alloc(out_shape);
+    Shape in_stride = src.get_stride();
+    const float* in = src.data();
+    float* out = dst.mutable_data();
+    int idx[4];
+    for (idx[0] = 0; idx[0] < out_shape[0]; ++idx[0])
+    for (idx[1] = 0; idx[1] < out_shape[1]; ++idx[1])
+    for (idx[2] = 0; idx[2] < out_shape[2]; ++idx[2])
+    for (idx[3] = 0; idx[3] < out_shape[3]; ++idx[3]) {
+        int in_offset = 0;
+        for (int i = 0; i < 4; ++i) {
+            in_offset += idx[i] * in_stride[order[i]];
+        }
+        *out++ = pow(in[in_offset] * scale + shift, power);
+    }
+}
+
+void check(const Tensor4f& dst, const Tensor4f& ref) {
+    CHECK_EQ(dst.valid_shape() == ref.valid_shape(), true) << "wrong output shape";
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), ref.data(), ref.valid_size(), max_ratio, max_diff);
+    CHECK_LE(max_diff, 1e-5) << "Test Failed";
+}
+
+void test_permute(Shape shape, std::vector<int> order) {
+    LOG(INFO) << "permute " << shape[0] << "x" << shape[1] << "x" << shape[2] << "x" << shape[3]
+              << " by " << order[0] << order[1] << order[2] << order[3];
+    Tensor4f src_in, dst_saber, dst_ref;
+    src_in.re_alloc(shape);
+    fill_tensor_host_rand(src_in, -1.f, 1.f);
+    compute_ref_permute(src_in, dst_ref, order);
+
+    Context<X86> ctx_host;
+    std::vector<Tensor4f*> input{&src_in};
+    std::vector<Tensor4f*> output{&dst_saber};
+    Permute<X86, AK_FLOAT> op;
+    PermuteParam<Tensor4f> param(order);
+    op.compute_output_shape(input, output, param);
+    dst_saber.re_alloc(dst_saber.valid_shape());
+    SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+    op(input, output, param, ctx_host);
+    check(dst_saber, dst_ref);
+}
+
+void test_permute_power(Shape shape, std::vector<int> order, float scale, float shift, float power) {
+    Tensor4f src_in, dst_saber, dst_ref;
+    src_in.re_alloc(shape);
+    fill_tensor_host_rand(src_in, 0.f, 1.f);
+    compute_ref_permute(src_in, dst_ref, order, scale, shift, power);
+
+    Context<X86> ctx_host;
+    std::vector<Tensor4f*> input{&src_in};
+    std::vector<Tensor4f*> output{&dst_saber};
+    PermutePower<X86, AK_FLOAT> op;
+    PermutePowerParam<Tensor4f> param(PermuteParam<Tensor4f>(order),
+                                      PowerParam<Tensor4f>(power, scale, shift));
+    op.compute_output_shape(input, output, param);
+    dst_saber.re_alloc(dst_saber.valid_shape());
+    SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+    op(input, output, param, ctx_host);
+    check(dst_saber, dst_ref);
+}
+
+TEST(TestSaberFuncX86, test_func_permute) {
+    Env<X86>::env_init();
+    // nchw to nhwc and back, the transpose of h and w, and orders of no 2d transpose
+    std::vector<std::vector<int> > orders = {{0, 2, 3, 1}, {0, 3, 1, 2}, {0, 1, 3, 2},
+                                             {1, 0, 2, 3}, {0, 2, 1, 3}, {3, 2, 1, 0},
+                                             {2, 0, 3, 1}, {0, 1, 2, 3}};
+    std::vector<Shape> shapes = {Shape(2, 3, 224, 224), Shape(1, 64, 56, 56), Shape(3, 17, 9, 131),
+                                 Shape(1, 1, 70, 1), Shape(4, 8, 1, 33)};
+    for (auto& shape : shapes) {
+        for (auto& order : orders) {
+            test_permute(shape, order);
+        }
+    }
+}
+
+TEST(TestSaberFuncX86, test_func_permute_power) {
+    test_permute_power(Shape(1, 3, 67, 45), {0, 2, 3, 1}, 1.f / 255, -0.5f, 1.f);
+    test_permute_power(Shape(2, 40, 13, 9), {0, 3, 1, 2}, 2.f, 0.5f, 2.f);
+    test_permute_power(Shape(2, 5, 13, 9), {3, 1, 0, 2}, 0.5f, 1.f, 0.5f);
+}
+
+TEST(TestSaberFuncX86, test_func_transpose) {
+    for (auto shape : {Shape(2, 3, 67, 129), Shape(1, 8, 1, 16)}) {
+        Tensor4f src_in, dst_saber, dst_ref;
+        src_in.re_alloc(shape);
+        fill_tensor_host_rand(src_in, -1.f, 1.f);
+        compute_ref_permute(src_in, dst_ref, {0, 1, 3, 2});
+
+        Context<X86> ctx_host;
+        std::vector<Tensor4f*> input{&src_in};
+        std::vector<Tensor4f*> output{&dst_saber};
+        Transpose<X86, AK_FLOAT> op;
+        TransposeParam<Tensor4f> param;
+        op.compute_output_shape(input, output, param);
+        dst_saber.re_alloc(dst_saber.valid_shape());
+        SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+        op(input, output, param, ctx_host);
+        check(dst_saber, dst_ref);
+    }
+}
+
+TEST(TestSaberFuncX86, test_func_shuffle_channel) {
+    const int num = 2;
+    const int h = 7;
+    const int w = 5;
+    for (int group : {1, 2, 3, 4}) {
+        const int channel = group * 6;
+        Shape shape(num, channel, h, w);
+        Tensor4f src_in, dst_saber, dst_ref;
+        src_in.re_alloc(shape);
+        fill_tensor_host_rand(src_in, -1.f, 1.f);
+        // channel g * c / group + k of the input is channel k * group + g of the output
+        dst_ref.re_alloc(shape);
+        const int per_group = channel / group;
+        for (int n = 0; n < num; ++n) {
+            for (int g = 0; g < group; ++g) {
+                for (int k = 0; k < per_group; ++k) {
+                    const float* in = src_in.data() + (n * channel + g * per_group + k) * h * w;
+                    float* out = dst_ref.mutable_data() + (n * channel + k * group + g) * h * w;
+                    std::copy(in, in + h * w, out);
+                }
+            }
+        }
+
+        Context<X86> ctx_host;
+        std::vector<Tensor4f*> input{&src_in};
+        std::vector<Tensor4f*> output{&dst_saber};
+        ShuffleChannel<X86, AK_FLOAT> op;
+        ShuffleChannelParam<Tensor4f> param(group);
+        op.compute_output_shape(input, output, param);
+        dst_saber.re_alloc(dst_saber.valid_shape());
+        SABER_CHECK(op.init(input, output, param, SPECIFY, SABER_IMPL, ctx_host));
+        op(input, output, param, ctx_host);
+        check(dst_saber, dst_ref);
+    }
+}
+
+TEST(TestSaberFuncX86, test_func_transpose_kernel_isa) {
+    // the op runs the best level of the host, the tile of every other level is checked here
+    for (int isa = X86_ISA_SCALAR; isa <= x86_detect_isa(); ++isa) {
+        const X86Kernels* kernels = x86_kernels_of((X86Isa)isa);
+        if (kernels == nullptr) {
+            continue;
+        }
+        LOG(INFO) << "transpose at " << x86_isa_name((X86Isa)isa);
+        // full tiles, tails in one or both dims, and blocks narrower than a tile
+        for (auto dims : std::vector<std::vector<int> >{{16, 16}, {64, 64}, {17, 9}, {3, 33}, {35, 2}}) {
+            const int rows = dims[0];
+            const int cols = dims[1];
+            const int src_ld = cols + 3;
+            const int dst_ld = rows + 5;
+            std::vector<float> src(rows * src_ld);
+            for (int i = 0; i < src.size(); ++i) {
+                src[i] = (i % 97) * 0.25f - 7.f;
+            }
+            std::vector<float> dst(cols * dst_ld, -1.f);
+            kernels->transpose(src.data(), src_ld, dst.data(), dst_ld, rows, cols, 0.5f, 1.f);
+            for (int c = 0; c < cols; ++c) {
+                for (int r = 0; r < dst_ld; ++r) {
+                    float ref = r < rows ? src[r * src_ld + c] * 0.5f + 1.f : -1.f;
+                    CHECK_EQ(dst[c * dst_ld + r], ref) << "wrong transpose of " << rows << "x" << cols
+                                                       << " at " << r << ", " << c;
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, const char** argv) {
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "saber/core/context.h"
+#include "saber/funcs/pooling.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: every output pixel on its own, averages divide as caffe does
+void compute_ref_pooling(Tensor4f& src, Tensor4f& dst, PoolingParam<Tensor4f>& param) {
+    int planes = src.num() * src.channel();
+    int in_h = src.height();
+    int in_w = src.width();
+    int out_h = dst.height();
+    int out_w = dst.width();
+    const float* src_data = src.data();
+    float* dst_data = dst.mutable_data();
+    for (int p = 0; p < planes; ++p) {
+        const float* plane = src_data + p * in_h * in_w;
+        for (int oh = 0; oh < out_h; ++oh) {
+            for (int ow = 0; ow < out_w; ++ow) {
+                int h_start = oh * param.stride_h - param.pad_h;
+                int w_start = ow * param.stride_w - param.pad_w;
+                int h_end = std::min(h_start + param.window_h, in_h + param.pad_h);
+                int w_end = std::min(w_start + param.window_w, in_w + param.pad_w);
+                int pool_size = (h_end - h_start) * (w_end - w_start);
+                if (param.global_pooling) {
+                    h_start = w_start = 0;
+                    h_end = in_h;
+                    w_end = in_w;
+                    pool_size = in_h * in_w;
+                }
+                h_start = std::max(h_start, 0);
+                w_start = std::max(w_start, 0);
+                h_end = std::min(h_end, in_h);
+                w_end = std::min(w_end, in_w);
+                float max_val = -FLT_MAX;
+                double sum = 0.;
+                for (int h = h_start; h < h_end; ++h) {
+                    for (int w = w_start; w < w_end; ++w) {
+                        max_val = std::max(max_val, plane[h * in_w + w]);
+                        sum += plane[h * in_w + w];
+                    }
+                }
+                float val = max_val;
+                if (param.pooling_type == Pooling_average_include_padding) {
+                    val = sum / pool_size;
+                } else if (param.pooling_type == Pooling_average_exclude_padding) {
+                    val = sum / ((h_end - h_start) * (w_end - w_start));
+                }
+                dst_data[(p * out_h + oh) * out_w + ow] = val;
+            }
+        }
+    }
+}
+
+void pooling_nchw_ut(Shape shape, int window, int stride, int pad, PoolingType type, bool global) {
+    Context<X86> ctx_host;
+    Tensor4f src(shape);
+    fill_tensor_host_rand(src, -1.f, 1.f);
+
+    PoolingParam<Tensor4f> param(window, window, pad, pad, stride, stride, type, global);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    Pooling<X86, AK_FLOAT, AK_FLOAT, AK_FLOAT, NCHW, NCHW, NCHW> pool;
+    SABER_CHECK(pool.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(pool.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(pool(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_pooling(src, dst_ref, param);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "in " << shape[2] << "x" << shape[3] << ", window " << window << ", stride " << stride
+              << ", pad " << pad << ", type " << type << ", global " << global
+              << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-5) << "pooling check failed";
+}
+
+TEST(TestSaberFuncX86, test_pooling_nchw) {
+    Env<X86>::env_init();
+
+    for (auto type : {Pooling_max, Pooling_average_include_padding, Pooling_average_exclude_padding}) {
+        // resnet stem, vgg and inception windows, then ceil mode outputs of odd sizes
+        pooling_nchw_ut(Shape(1, 64, 112, 112), 3, 2, 1, type, false);
+        pooling_nchw_ut(Shape(2, 32, 56, 56), 2, 2, 0, type, false);
+        pooling_nchw_ut(Shape(1, 16, 28, 28), 3, 1, 1, type, false);
+        pooling_nchw_ut(Shape(1, 8, 13, 17), 3, 2, 0, type, false);
+        pooling_nchw_ut(Shape(1, 3, 9, 7), 5, 3, 2, type, false);
+        // global pooling, by the flag and by a window of the whole image
+        pooling_nchw_ut(Shape(2, 2048, 7, 7), 7, 1, 0, type, true);
+        pooling_nchw_ut(Shape(1, 1024, 14, 14), 14, 1, 0, type, false);
+    }
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
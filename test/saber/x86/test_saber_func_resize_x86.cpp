@@ -0,0 +1,93 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "saber/core/context.h"
+#include "saber/funcs/resize.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: every output pixel on its own, source coordinates clamped to the last row and column
+void compute_ref_resize(Tensor4f& src, Tensor4f& dst, float scale_w, float scale_h, ResizeType type) {
+    int planes = src.num() * src.channel();
+    int in_h = src.height();
+    int in_w = src.width();
+    int out_h = dst.height();
+    int out_w = dst.width();
+    const float* src_data = src.data();
+    float* dst_data = dst.mutable_data();
+    for (int p = 0; p < planes; ++p) {
+        const float* plane = src_data + p * in_h * in_w;
+        for (int oh = 0; oh < out_h; ++oh) {
+            float fy = oh * (1.f / scale_h);
+            int y0 = std::min((int)fy, in_h - 1);
+            int y1 = std::min(y0 + 1, in_h - 1);
+            float dy = fy - y0;
+            for (int ow = 0; ow < out_w; ++ow) {
+                float fx = ow * (1.f / scale_w);
+                int x0 = std::min((int)fx, in_w - 1);
+                int x1 = std::min(x0 + 1, in_w - 1);
+                float dx = fx - x0;
+                float v;
+                if (type == Resize_nearest) {
+                    v = plane[y0 * in_w + x0];
+                } else {
+                    float top = plane[y0 * in_w + x0] * (1.f - dx) + plane[y0 * in_w + x1] * dx;
+                    float bottom = plane[y1 * in_w + x0] * (1.f - dx) + plane[y1 * in_w + x1] * dx;
+                    v = top * (1.f - dy) + bottom * dy;
+                }
+                dst_data[(p * out_h + oh) * out_w + ow] = v;
+            }
+        }
+    }
+}
+
+void resize_ut(Shape shape, float scale_w, float scale_h, ResizeType type) {
+    Context<X86> ctx_host;
+    Tensor4f src(shape);
+    fill_tensor_host_rand(src, -1.f, 1.f);
+
+    ResizeParam<Tensor4f> param(scale_w, scale_h, type);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    Resize<X86, AK_FLOAT> resize;
+    SABER_CHECK(resize.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(resize.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(resize(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_resize(src, dst_ref, scale_w, scale_h, type);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "out " << dst.height() << "x" << dst.width() << ", type " << type
+              << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-5) << "resize check failed";
+}
+
+TEST(TestSaberFuncX86, test_resize) {
+    Env<X86>::env_init();
+
+    for (auto type : {Resize_bilinear, Resize_nearest}) {
+        resize_ut(Shape(2, 3, 17, 23), 2.f, 2.f, type);
+        resize_ut(Shape(1, 8, 32, 40), 0.5f, 0.75f, type);
+        resize_ut(Shape(1, 2, 9, 13), 1.7f, 3.f, type);
+        resize_ut(Shape(1, 1, 1, 5), 4.f, 4.f, type);
+    }
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "saber/core/context.h"
+#include "saber/funcs/roi_pooling.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: max of every bin over the pixels of the image, empty bins give 0
+void compute_ref_roi_pool(Tensor4f& src, Tensor4f& rois, Tensor4f& dst, int pooled_h, int pooled_w,
+                          float spatial_scale) {
+    int channel = src.channel();
+    int in_h = src.height();
+    int in_w = src.width();
+    const float* src_data = src.data();
+    float* dst_data = dst.mutable_data();
+    for (int r = 0; r < rois.num(); ++r) {
+        const float* roi = rois.data() + r * 5;
+        int start_w = roundf(roi[1] * spatial_scale);
+        int start_h = roundf(roi[2] * spatial_scale);
+        int roi_w = std::max((int)roundf(roi[3] * spatial_scale) - start_w + 1, 1);
+        int roi_h = std::max((int)roundf(roi[4] * spatial_scale) - start_h + 1, 1);
+        float bin_h = (float)roi_h / pooled_h;
+        float bin_w = (float)roi_w / pooled_w;
+        for (int c = 0; c < channel; ++c) {
+            const float* plane = src_data + ((int)roi[0] * channel + c) * in_h * in_w;
+            for (int ph = 0; ph < pooled_h; ++ph) {
+                for (int pw = 0; pw < pooled_w; ++pw) {
+                    int h_start = (int)floorf(ph * bin_h) + start_h;
+                    int h_end = (int)ceilf((ph + 1) * bin_h) + start_h;
+                    int w_start = (int)floorf(pw * bin_w) + start_w;
+                    int w_end = (int)ceilf((pw + 1) * bin_w) + start_w;
+                    float val = -FLT_MAX;
+                    bool empty = true;
+                    for (int h = std::max(h_start, 0); h < std::min(h_end, in_h); ++h) {
+                        for (int w = std::max(w_start, 0); w < std::min(w_end, in_w); ++w) {
+                            val = std::max(val, plane[h * in_w + w]);
+                            empty = false;
+                        }
+                    }
+                    dst_data[((r * channel + c) * pooled_h + ph) * pooled_w + pw] = empty ? 0.f : val;
+                }
+            }
+        }
+    }
+}
+
+void roi_pool_ut(Shape shape, int roi_num, int pooled_h, int pooled_w, float spatial_scale) {
+    Context<X86> ctx_host;
+    Tensor4f src(shape);
+    fill_tensor_host_rand(src, -1.f, 1.f);
+    // boxes in image coordinates, some of them running over the border
+    Tensor4f rois(Shape(roi_num, 5, 1, 1));
+    float* roi_data = rois.mutable_data();
+    float img_h = shape[2] / spatial_scale;
+    float img_w = shape[3] / spatial_scale;
+    for (int r = 0; r < roi_num; ++r) {
+        float x1 = std::rand() % (int)img_w;
+        float y1 = std::rand() % (int)img_h;
+        roi_data[r * 5] = r % shape[0];
+        roi_data[r * 5 + 1] = x1;
+        roi_data[r * 5 + 2] = y1;
+        roi_data[r * 5 + 3] = x1 + std::rand() % (int)(img_w * 0.6f);
+        roi_data[r * 5 + 4] = y1 + std::rand() % (int)(img_h * 0.6f);
+    }
+
+    RoiPoolParam<Tensor4f> param(pooled_h, pooled_w, spatial_scale);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs{&src, &rois};
+    std::vector<Tensor4f*> outputs(1, &dst);
+    RoiPool<X86, AK_FLOAT> roi_pool;
+    SABER_CHECK(roi_pool.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(roi_pool.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(roi_pool(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_roi_pool(src, rois, dst_ref, pooled_h, pooled_w, spatial_scale);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "rois " << roi_num << ", pooled " << pooled_h << "x" << pooled_w
+              << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-6) << "roi pooling check failed";
+}
+
+TEST(TestSaberFuncX86, test_roi_pool) {
+    Env<X86>::env_init();
+
+    roi_pool_ut(Shape(2, 16, 38, 50), 32, 7, 7, 0.0625f);
+    roi_pool_ut(Shape(1, 5, 20, 13), 9, 3, 4, 0.5f);
+    roi_pool_ut(Shape(1, 3, 6, 6), 5, 6, 6, 1.f);
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include <time.h>
 #include <stdio.h>
 #include <vector>
+#include <cmath>
+#include <algorithm>
 
 #include "saber/core/context.h"
 #include "saber/funcs/softmax.h"
@@ -8,49 +10,42 @@
 #include "saber/core/tensor_op.h"
 #include "saber/saber_types.h"
 #include "x86_test_common.h"
+#include "saber/funcs/impl/x86/x86_kernels.h"
 using namespace anakin::saber;
 using namespace std;
 
 typedef TargetWrapper<X86> X86_API;
 typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
 
-void test(int num, int channel) {
-    int num_in = num;
-    int ch_in = channel;
-    int h_in = 1;
-    int w_in = 1;
-    int d = ch_in * h_in * w_in;
-
-    LOG(INFO) << " input size, num=" << num_in
-              << ", channel=" << ch_in
-              << ", height=" << h_in
-              << ", width=" << w_in;
-
-    Shape shape_in(num_in, ch_in, h_in, w_in);
-    Shape shape_out(num_in, ch_in, h_in, w_in);
-
-    Tensor4f src_in, dst_saber, dst_ref;
-    src_in.re_alloc(shape_in);
-    fill_tensor_host_rand(src_in, 0.1f, 10.f);
-
-    std::vector<float> ref_sum(num_in, 0.f);
-    for (int i = 0; i < num_in; i++) {
-        for (int j = 0; j < d; j++) {
-            ref_sum[i] += expf(src_in.data()[i * d + j]);
+/// reference softmax of a [outer, n, inner] tensor along n
+void compute_ref_softmax(const float* src, float* dst, int outer, int n, int inner) {
+    for (int o = 0; o < outer; ++o) {
+        for (int i = 0; i < inner; ++i) {
+            const float* x = src + o * n * inner + i;
+            float* y = dst + o * n * inner + i;
+            double max = x[0];
+            for (int k = 1; k < n; ++k) {
+                max = std::max(max, (double)x[k * inner]);
+            }
+            double sum = 0;
+            for (int k = 0; k < n; ++k) {
+                sum += exp(x[k * inner] - max);
+            }
+            for (int k = 0; k < n; ++k) {
+                y[k * inner] = exp(x[k * inner] - max) / sum;
+            }
         }
     }
+}
 
-    LOG(INFO) << "reference src_data: ";
-//    print_tensor_host(src_in);
-    dst_ref.re_alloc(shape_out);
-    for (int i = 0; i < num_in; ++i) {
-        for (int j = 0; j < d; j++) {
-            dst_ref.mutable_data()[i * d + j]
-                    = expf(src_in.data()[i * d + j]) / ref_sum[i];
-        }
-    }
-     LOG(INFO) << "reference dst_data: ";
-//     print_tensor_host(dst_ref);
+void check_softmax(Tensor4f& src_in, int axis) {
+    Shape shape_in = src_in.valid_shape();
+    Tensor4f dst_saber, dst_ref;
+    int n = shape_in[axis];
+    int inner = shape_in.count(axis + 1);
+    int outer = shape_in.count() / (n * inner);
+    dst_ref.re_alloc(shape_in);
+    compute_ref_softmax(src_in.data(), dst_ref.mutable_data(), outer, n, inner);
 
     // saber dst
     Context<X86> ctx_host;
@@ -60,25 +55,42 @@ void test(int num, int channel) {
 
     input_softmax.push_back(&src_in);
 
-    dst_saber.re_alloc(shape_out);
+    dst_saber.re_alloc(shape_in);
     output_softmax.push_back(&dst_saber);
 
     Softmax<X86, AK_FLOAT> op_softmax;
-    SoftmaxParam<Tensor4f> smx_pm;
+    SoftmaxParam<Tensor4f> smx_pm(axis);
 
-    op_softmax.init(input_softmax, output_softmax, smx_pm, SPECIFY, SABER_IMPL, ctx_host);
+    SABER_CHECK(op_softmax.init(input_softmax, output_softmax, smx_pm, SPECIFY, SABER_IMPL, ctx_host));
 
     op_softmax(input_softmax, output_softmax, smx_pm, ctx_host);
-    // LOG(INFO) << "saber dst_data: ";
-    // print_tensor_host(*output_softmax[0]);
 
-    bool flag = compare_tensor(dst_saber, dst_ref, 1e-6);
-    if (flag == true) {
-        LOG(INFO) << "Test Passed";
-    }
-    else {
-        LOG(ERROR) << "Test Failed";
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst_saber.data(), dst_ref.data(), dst_ref.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK_LE(max_diff, 1e-5) << "Test Failed";
+}
+
+void test(Shape shape_in, int axis, float min = 0.1f, float max = 10.f) {
+    LOG(INFO) << " input size, num=" << shape_in[0]
+              << ", channel=" << shape_in[1]
+              << ", height=" << shape_in[2]
+              << ", width=" << shape_in[3]
+              << ", axis=" << axis;
+
+    Tensor4f src_in;
+    src_in.re_alloc(shape_in);
+    fill_tensor_host_rand(src_in, min, max);
+    check_softmax(src_in, axis);
+}
+
+/// a row of n low values but one, whose exp of the others underflows
+void fill_dominant(float* row, int n, int index) {
+    for (int i = 0; i < n; ++i) {
+        row[i] = -10000.f;
     }
+    row[index] = 5.f;
 }
 
 
@@ -86,13 +98,55 @@ TEST(TestSaberSoftmaxX86, test_tensor_softmax) {
     Env<X86>::env_init();
 
     LOG(INFO) << "case 1:";
-    test(1, 16);
+    test(Shape(1, 16, 1, 1), 1);
     LOG(INFO) << "case 2:";
-    test(1, 25);
+    test(Shape(1, 25, 1, 1), 1);
     LOG(INFO) << "case 3:";
-    test(1, 1000);
+    test(Shape(1, 1000, 1, 1), 1);
     LOG(INFO) << "case 4:";
-    test(2, 1000);
+    test(Shape(2, 1000, 1, 1), 1);
+}
+
+TEST(TestSaberSoftmaxX86, test_softmax_axis) {
+    // per pixel softmax over channels, the axis is strided
+    test(Shape(2, 21, 17, 19), 1, -10.f, 10.f);
+    test(Shape(1, 5, 4, 3), 2, -10.f, 10.f);
+    test(Shape(3, 4, 5, 37), 3, -10.f, 10.f);
+    test(Shape(7, 3, 2, 2), 0, -10.f, 10.f);
+    // few long rows are split across threads
+    test(Shape(1, 1, 3, 100003), 3, -20.f, 20.f);
+    test(Shape(2, 50000, 1, 1), 1, -20.f, 20.f);
+}
+
+TEST(TestSaberSoftmaxX86, test_softmax_dominant) {
+    // the max in the first lane of a later vector, of a sse, avx or avx512 row
+    for (int index : {0, 4, 8, 16, 31}) {
+        Tensor4f src_in;
+        src_in.re_alloc(Shape(2, 32, 1, 1));
+        fill_dominant(src_in.mutable_data(), 32, index);
+        fill_dominant(src_in.mutable_data() + 32, 32, 31 - index);
+        check_softmax(src_in, 1);
+    }
+
+    // the stat kernel of every level the host runs
+    for (int isa = X86_ISA_SCALAR; isa <= x86_detect_isa(); ++isa) {
+        const X86Kernels* kernels = x86_kernels_of((X86Isa)isa);
+        if (kernels == nullptr) {
+            continue;
+        }
+        LOG(INFO) << "softmax stat at " << x86_isa_name((X86Isa)isa);
+        for (int n : {32, 37, 67}) {
+            for (int index = 0; index < n; ++index) {
+                std::vector<float> row(n);
+                fill_dominant(row.data(), n, index);
+                float max = 0.f;
+                float sum = 0.f;
+                kernels->softmax_stat(row.data(), n, max, sum);
+                CHECK_EQ(max, 5.f) << "wrong max of the dominant value at " << index;
+                CHECK_LE(fabs(sum - 1.f), 1e-5) << "wrong sum of the dominant value at " << index;
+            }
+        }
+    }
 }
 
 int main(int argc, const char** argv) {
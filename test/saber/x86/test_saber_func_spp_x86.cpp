@@ -0,0 +1,112 @@
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "saber/core/context.h"
+#include "saber/funcs/spp.h"
+#include "test_saber_func_x86.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "x86_test_common.h"
+
+using namespace anakin::saber;
+
+typedef Tensor<X86, AK_FLOAT, NCHW> Tensor4f;
+
+/// reference: the caffe pooling of every level, with the window and padding of the spp layer
+void compute_ref_spp(Tensor4f& src, Tensor4f& dst, int pyramid_height, PoolingType type) {
+    int planes = src.num() * src.channel();
+    int in_h = src.height();
+    int in_w = src.width();
+    const float* src_data = src.data();
+    float* dst_data = dst.mutable_data();
+    for (int p = 0; p < planes; ++p) {
+        const float* plane = src_data + p * in_h * in_w;
+        float* out = dst_data + p * dst.width();
+        for (int level = 0; level < pyramid_height; ++level) {
+            int bins = 1 << level;
+            int kernel_h = (int)ceilf(in_h / (float)bins);
+            int kernel_w = (int)ceilf(in_w / (float)bins);
+            int pad_h = (kernel_h * bins - in_h + 1) / 2;
+            int pad_w = (kernel_w * bins - in_w + 1) / 2;
+            for (int ph = 0; ph < bins; ++ph) {
+                for (int pw = 0; pw < bins; ++pw) {
+                    int h_start = ph * kernel_h - pad_h;
+                    int w_start = pw * kernel_w - pad_w;
+                    int h_end = std::min(h_start + kernel_h, in_h + pad_h);
+                    int w_end = std::min(w_start + kernel_w, in_w + pad_w);
+                    int pool_size = (h_end - h_start) * (w_end - w_start);
+                    h_start = std::max(h_start, 0);
+                    w_start = std::max(w_start, 0);
+                    h_end = std::min(h_end, in_h);
+                    w_end = std::min(w_end, in_w);
+                    float max_val = -FLT_MAX;
+                    double sum = 0.;
+                    for (int h = h_start; h < h_end; ++h) {
+                        for (int w = w_start; w < w_end; ++w) {
+                            max_val = std::max(max_val, plane[h * in_w + w]);
+                            sum += plane[h * in_w + w];
+                        }
+                    }
+                    int valid = (h_end - h_start) * (w_end - w_start);
+                    float val = 0.f;
+                    if (valid > 0) {
+                        if (type == Pooling_max) {
+                            val = max_val;
+                        } else if (type == Pooling_average_include_padding) {
+                            val = sum / pool_size;
+                        } else {
+                            val = sum / valid;
+                        }
+                    }
+                    out[ph * bins + pw] = val;
+                }
+            }
+            out += bins * bins;
+        }
+    }
+}
+
+void spp_ut(Shape shape, int pyramid_height, PoolingType type) {
+    Context<X86> ctx_host;
+    Tensor4f src(shape);
+    fill_tensor_host_rand(src, -1.f, 1.f);
+
+    SPPParam<Tensor4f> param(pyramid_height, type);
+    Tensor4f dst;
+    std::vector<Tensor4f*> inputs(1, &src);
+    std::vector<Tensor4f*> outputs(1, &dst);
+    Spp<X86, AK_FLOAT> spp;
+    SABER_CHECK(spp.compute_output_shape(inputs, outputs, param));
+    dst.re_alloc(dst.valid_shape());
+    SABER_CHECK(spp.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(spp(inputs, outputs, param, ctx_host));
+
+    Tensor4f dst_ref(dst.valid_shape());
+    compute_ref_spp(src, dst_ref, pyramid_height, type);
+
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(dst.data(), dst_ref.data(), dst.valid_size(), max_ratio, max_diff);
+    LOG(INFO) << "pyramid_height " << pyramid_height << ", type " << type
+              << ", max_ratio " << max_ratio << ", max_diff " << max_diff;
+    CHECK(max_diff < 1e-5) << "spp check failed";
+}
+
+TEST(TestSaberFuncX86, test_spp) {
+    Env<X86>::env_init();
+
+    for (auto type : {Pooling_max, Pooling_average_include_padding, Pooling_average_exclude_padding}) {
+        spp_ut(Shape(2, 16, 13, 13), 3, type);
+        spp_ut(Shape(1, 8, 20, 31), 4, type);
+        spp_ut(Shape(1, 3, 5, 7), 3, type);
+    }
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -328,6 +328,12 @@ TEST(TestSaberFuncX86, test_func_gru_x86) {
     gru_ut<X86,X86>(222,333,{0,2,5,12,30}, false,Active_sigmoid,Active_relu,100);
     gru_ut<X86,X86>(222,333,{0,30},        true,Active_sigmoid,Active_tanh,100);
     gru_ut<X86,X86>(222,333,{0,30},        false,Active_sigmoid,Active_tanh,100);
+    {
+        // batch 1 wide enough to split the recurrence over 4 threads
+        ScopedX86Threads threads(4);
+        gru_ut<X86,X86>(128,512,{0,20},        true,Active_sigmoid,Active_tanh,100);
+        gru_ut<X86,X86>(128,1030,{0,20},       false,Active_sigmoid,Active_relu,100);
+    }
 
     gru_ut<X86,X86>(222,333,{0,2,5,12,30}, true,Active_sigmoid,Active_tanh,100,VENDER_IMPL);
     gru_ut<X86,X86>(222,333,{0,2,5,12,30}, false,Active_sigmoid,Active_tanh,100,VENDER_IMPL);
@@ -339,6 +345,108 @@ TEST(TestSaberFuncX86, test_func_gru_x86) {
 }
 
 
+/**
+ * run every sequence in one call, then again in two chunks where the second chunk starts
+ * from the last hidden exported by the first one, the tail of both outputs must be the same
+ */
+void gru_stream_ut(int word_size, int hidden_size, std::vector<int> lengths, int split) {
+    typedef Tensor<X86, AK_FLOAT, NCHW> TensorHf4;
+    Context<X86> ctx_host;
+    int batch_size = lengths.size();
+    std::vector<int> offsets(1, 0);
+    std::vector<int> first_offsets(1, 0);
+    std::vector<int> second_offsets(1, 0);
+    for (int i = 0; i < batch_size; ++i) {
+        CHECK_GT(lengths[i], split) << "every sequence should be longer than the split point";
+        offsets.push_back(offsets[i] + lengths[i]);
+        first_offsets.push_back(first_offsets[i] + split);
+        second_offsets.push_back(second_offsets[i] + lengths[i] - split);
+    }
+
+    Shape shape_weight({1, 1, 1, hidden_size * word_size * 3 + hidden_size * hidden_size * 3});
+    Shape shape_bias({1, 1, 1, hidden_size * 3});
+    TensorHf4 weight(shape_weight);
+    TensorHf4 bias(shape_bias);
+    TensorHf4 x(Shape({offsets[batch_size], word_size, 1, 1}));
+    TensorHf4 x_first(Shape({first_offsets[batch_size], word_size, 1, 1}));
+    TensorHf4 x_second(Shape({second_offsets[batch_size], word_size, 1, 1}));
+    fill_tensor_host_rand(weight);
+    fill_tensor_host_rand(bias);
+    fill_tensor_host_rand(x);
+    for (int i = 0; i < batch_size; ++i) {
+        memcpy(x_first.mutable_data() + first_offsets[i] * word_size, x.data() + offsets[i] * word_size,
+               split * word_size * sizeof(float));
+        memcpy(x_second.mutable_data() + second_offsets[i] * word_size,
+               x.data() + (offsets[i] + split) * word_size,
+               (lengths[i] - split) * word_size * sizeof(float));
+    }
+    x.set_seq_offset(offsets);
+    x_first.set_seq_offset(first_offsets);
+    x_second.set_seq_offset(second_offsets);
+
+    TensorHf4 out, out_first, out_second;
+    TensorHf4 last_hidden, init_hidden;
+    GruParam<TensorHf4> param(&weight, &bias, GRU_ORIGIN, Active_sigmoid, Active_tanh);
+    Gru<X86, AK_FLOAT> gru_op;
+    std::vector<TensorHf4*> inputs(1, &x);
+    std::vector<TensorHf4*> outputs(1, &out);
+    SABER_CHECK(gru_op.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx_host));
+    SABER_CHECK(gru_op.compute_output_shape(inputs, outputs, param));
+    out.re_alloc(out.valid_shape());
+    param.set_state(nullptr, &last_hidden);
+    SABER_CHECK(gru_op(inputs, outputs, param, ctx_host));
+
+    // the last hidden of a whole run is the output of the last word of every sequence
+    double maxdiff = 0;
+    double maxratio = 0;
+    CHECK_EQ(last_hidden.valid_size(), batch_size * hidden_size) << "wrong last hidden size";
+    for (int i = 0; i < batch_size; ++i) {
+        tensor_cmp_host(last_hidden.data() + i * hidden_size,
+                        out.data() + (offsets[i + 1] - 1) * hidden_size,
+                        hidden_size, maxratio, maxdiff);
+        CHECK(maxdiff == 0) << "last hidden failed : ratio " << maxratio << "," << maxdiff;
+    }
+
+    inputs[0] = &x_first;
+    outputs[0] = &out_first;
+    SABER_CHECK(gru_op.compute_output_shape(inputs, outputs, param));
+    out_first.re_alloc(out_first.valid_shape());
+    SABER_CHECK(gru_op(inputs, outputs, param, ctx_host));
+
+    init_hidden.re_alloc(last_hidden.valid_shape());
+    init_hidden.copy_from(last_hidden);
+    inputs[0] = &x_second;
+    outputs[0] = &out_second;
+    param.set_state(&init_hidden, &last_hidden);
+    SABER_CHECK(gru_op.compute_output_shape(inputs, outputs, param));
+    out_second.re_alloc(out_second.valid_shape());
+    SABER_CHECK(gru_op(inputs, outputs, param, ctx_host));
+
+    for (int i = 0; i < batch_size; ++i) {
+        tensor_cmp_host(out_second.data() + second_offsets[i] * hidden_size,
+                        out.data() + (offsets[i] + split) * hidden_size,
+                        (lengths[i] - split) * hidden_size, maxratio, maxdiff);
+        CHECK(abs(maxratio) <= 0.001 || abs(maxdiff) < 0.001) << "stream failed : ratio " << maxratio << "," << maxdiff;
+        tensor_cmp_host(last_hidden.data() + i * hidden_size,
+                        out.data() + (offsets[i + 1] - 1) * hidden_size,
+                        hidden_size, maxratio, maxdiff);
+        CHECK(abs(maxratio) <= 0.001 || abs(maxdiff) < 0.001) << "last hidden failed : ratio " << maxratio << "," << maxdiff;
+    }
+    LOG(INFO) << "stream passed";
+}
+
+TEST(TestSaberFuncX86, test_func_gru_x86_stream) {
+    Env<X86>::env_init();
+
+    gru_stream_ut(222, 333, {10}, 4);
+    gru_stream_ut(222, 333, {3, 9, 5, 12}, 2);
+    gru_stream_ut(222, 336, {3, 9, 5, 12}, 1);
+    {
+        // batch 1 wide enough to split the recurrence over 4 threads
+        ScopedX86Threads threads(4);
+        gru_stream_ut(128, 512, {12}, 5);
+    }
+}
 
 int main(int argc, const char** argv) {
     // initial logger
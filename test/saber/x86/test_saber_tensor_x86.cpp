@@ -219,6 +219,37 @@ TEST(TestSaberTensorX86, test_tensor_deepcopy) {
     print_tensor_host(thost41);
 }
 
+TEST(TestSaberTensorX86, test_tensor_swap_buffer) {
+    //! bind caller memory to an owned tensor and give it back, as Net::bind_in and unbind do
+    Shape sh0(1, 2, 4, 4);
+    Shape sh1(2, 2, 4, 4);
+    Tensor4f owner(sh0);
+    fill_tensor_host_const(owner, 1.f);
+    const float* owner_data = owner.data();
+    Tensor4f caller(sh1);
+    fill_tensor_host_const(caller, 2.f);
+    caller.set_seq_offset({0, 1, 2});
+
+    LOG(INFO) << "|--bind caller memory";
+    Tensor4f stash;
+    stash.set_shape(caller.valid_shape());
+    stash.share_from(caller);
+    owner.swap_buffer(stash);
+    CHECK_EQ(owner.data(), caller.data()) << "tensor should be on caller memory";
+    CHECK_EQ(owner.valid_size(), sh1.count()) << "tensor should take the caller shape";
+    CHECK_EQ(owner.get_seq_offset().size(), 3) << "tensor should take the caller seq offset";
+    CHECK_EQ(stash.data(), owner_data) << "stash should keep the tensor memory";
+
+    LOG(INFO) << "|--give the memory back";
+    owner.swap_buffer(stash);
+    CHECK_EQ(owner.data(), owner_data) << "tensor should be on its own memory";
+    CHECK_EQ(owner.valid_size(), sh0.count()) << "tensor should get its shape back";
+    CHECK_EQ(owner.data()[0], 1.f) << "tensor memory should be untouched";
+    //! the tensor owns its buffer again, so it can grow
+    owner.reshape(Shape(4, 2, 4, 4));
+    CHECK_EQ(owner.valid_size(), 4 * sh0.count()) << "owned tensor should grow";
+}
+
 
 int main(int argc, const char** argv){
     // initial logger
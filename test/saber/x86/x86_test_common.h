@@ -21,9 +21,14 @@ limitations under the License. */
 #include "saber/core/tensor_op.h"
 #include "saber/core/context.h"
 #include "saber/saber_types.h"
+#include "saber/core/impl/x86/x86_thread.h"
 
 #include "utils/logger/logger.h"
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
 template <typename T>
 bool compare_tensor(T& data, T& ref_data, float eps = 1e-4) {
     typedef typename T::Dtype data_t;
@@ -54,4 +59,23 @@ bool compare_tensor(T& data, T& ref_data, float eps = 1e-4) {
 
 #define ARRAY_SIZE(array)  (sizeof(array) / sizeof(*array))
 
+/**
+ * omp and mkl threads of the kernels initialized and run in a scope, so paths that split
+ * work over the threads run the same whatever the host has
+ */
+class ScopedX86Threads {
+public:
+    explicit ScopedX86Threads(int thread_num) {
+#ifdef USE_OPENMP
+        _saved = omp_get_max_threads();
+#endif
+        anakin::saber::x86_set_thread_num(thread_num);
+    }
+    ~ScopedX86Threads() {
+        anakin::saber::x86_set_thread_num(_saved);
+    }
+private:
+    int _saved{1};
+};
+
 #endif